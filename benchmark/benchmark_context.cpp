@@ -0,0 +1,115 @@
+///
+/// \file      benchmark_context.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "benchmark_context.hpp"
+#include <system_error>
+#include <utility>
+#include "backend/database/database_interface.hpp"
+#include "backend/processor/initializer/pipeline_settings.hpp"
+#include <opencv2/imgcodecs.hpp>
+
+namespace joda::bench {
+
+///
+/// \brief      Writes the synthetic image and loads it as first tile of a pipeline
+/// \author     Joachim Danmayr
+/// \param[in]  scene     Content of the image
+/// \param[in]  depth     CV_8U or CV_16U
+/// \param[in]  tileSize  Width and height of the image and its tile
+/// \param[in]  seed      Seed of the image generator
+///
+BenchmarkContext::BenchmarkContext(Scene scene, int32_t depth, int32_t tileSize, uint64_t seed)
+{
+  const auto bitDepth = std::string(depth == CV_8U ? "8" : "16");
+  mName               = toString(scene) + ", " + bitDepth + " bit, " + std::to_string(tileSize) + " px";
+
+  const auto folder = std::filesystem::temp_directory_path() / "imagec_benchmark";
+  std::filesystem::create_directories(folder);
+  mImageFile = folder / (std::to_string(static_cast<int>(scene)) + "_" + bitDepth + "_" + std::to_string(tileSize) + "_" +
+                         std::to_string(seed) + ".tif");
+  cv::imwrite(mImageFile.string(), createImage(scene, {tileSize, tileSize}, depth, seed));
+
+  mImageSetup.imageTileSettings.tileWidth  = tileSize;
+  mImageSetup.imageTileSettings.tileHeight = tileSize;
+  mPipelineSetup.realSizesUnit             = enums::Units::Pixels;
+  mImageContext                            = std::make_unique<processor::PipelineInitializer>(mImageSetup, mPipelineSetup, mImageFile, folder);
+
+  mGlobalContext.workingDirectory    = folder;
+  mGlobalContext.resultsOutputFolder = folder;
+  mGlobalContext.database            = std::make_unique<db::PreviewDatabase>();
+  mObjects                           = std::make_shared<atom::ObjectList>();
+  mIterationContext                  = std::make_unique<processor::IterationContext>(mObjects, folder, mImageFile, 0);
+  mContext = std::make_unique<processor::ProcessContext>(mGlobalContext, *mImageContext, *mIterationContext);
+
+  settings::PipelineSettings pipelineSetup;
+  pipelineSetup.source         = settings::PipelineSettings::Source::FROM_FILE;
+  pipelineSetup.cStackIndex    = 0;
+  pipelineSetup.tStackIndex    = 0;
+  pipelineSetup.zStackIndex    = 0;
+  pipelineSetup.zProjection    = enums::ZProjection::NONE;
+  pipelineSetup.defaultClassId = enums::ClassId::C1;
+  mImageContext->initPipeline(pipelineSetup, {0, 0}, {.tStack = 0, .zStack = 0, .cStack = 0}, *mContext, 0);
+  mLoadedTile = mContext->getActImage().clone(mContext->getActImage().image);
+}
+
+BenchmarkContext::~BenchmarkContext()
+{
+  std::error_code ec;
+  std::filesystem::remove(mImageFile, ec);
+}
+
+///
+/// \brief      Objects each run starts with, e.g. for measurements
+/// \author     Joachim Danmayr
+///
+void BenchmarkContext::setObjects(std::vector<atom::ROI> &&objects)
+{
+  mInputObjects = std::move(objects);
+  reset();
+}
+
+///
+/// \brief      Executes the step once and uses the result as input of the following runs,
+///             e.g. to threshold the image before benchmarking the watershed
+/// \author     Joachim Danmayr
+///
+void BenchmarkContext::prepare(const settings::PipelineStep &step)
+{
+  run(step);
+  mLoadedTile = mContext->getActImage().clone(mContext->getActImage().image);
+}
+
+///
+/// \brief      Restores the loaded tile and the input objects
+/// \author     Joachim Danmayr
+///
+void BenchmarkContext::reset()
+{
+  mContext->getActImage() = mLoadedTile.clone(mLoadedTile.image);
+  mObjects->clearAll();
+  for(const auto &roi : mInputObjects) {
+    mObjects->push_back(roi.clone());
+  }
+}
+
+///
+/// \brief      Executes the step on the input of the benchmark
+/// \author     Joachim Danmayr
+/// \return     Number of objects afterwards, returned to the benchmark so the run can not be optimized away
+///
+auto BenchmarkContext::run(const settings::PipelineStep &step) -> size_t
+{
+  reset();
+  step(*mContext, mContext->getActImage().image, mContext->getActObjects());
+  return mContext->getActObjects().sizeList();
+}
+
+}    // namespace joda::bench
@@ -0,0 +1,83 @@
+///
+/// \file      benchmark_context.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/artifacts/image/image.hpp"
+#include "backend/artifacts/object_list/object_list.hpp"
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/processor/context/process_context.hpp"
+#include "backend/processor/initializer/pipeline_initializer.hpp"
+#include "backend/settings/pipeline/pipeline_step.hpp"
+#include "backend/settings/project_settings/project_image_setup.hpp"
+#include "backend/settings/project_settings/project_pipeline_setup.hpp"
+#include "synthetic_data.hpp"
+
+namespace joda::bench {
+
+///
+/// \class      BenchmarkContext
+/// \author     Joachim Danmayr
+/// \brief      Process context of one tile of a synthetic image. The image is written
+///             to a temporary TIFF file and loaded by the PipelineInitializer like in
+///             a job. Each run starts from the loaded tile and the given objects, so
+///             all runs of a benchmark process the same input.
+///
+class BenchmarkContext
+{
+public:
+  /////////////////////////////////////////////////////
+  BenchmarkContext(Scene scene, int32_t depth, int32_t tileSize, uint64_t seed = 42);
+  ~BenchmarkContext();
+  BenchmarkContext(const BenchmarkContext &)            = delete;
+  BenchmarkContext &operator=(const BenchmarkContext &) = delete;
+
+  void setObjects(std::vector<atom::ROI> &&objects);
+  void prepare(const settings::PipelineStep &step);
+  void reset();
+  auto run(const settings::PipelineStep &step) -> size_t;
+
+  [[nodiscard]] auto getName() const -> const std::string &
+  {
+    return mName;
+  }
+
+  [[nodiscard]] auto getImageContext() const -> const processor::PipelineInitializer &
+  {
+    return *mImageContext;
+  }
+
+  [[nodiscard]] auto getObjects() -> atom::ObjectList &
+  {
+    return *mObjects;
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  std::string mName;    // Scene, bit depth and tile size, part of the benchmark names
+  std::filesystem::path mImageFile;
+  settings::ProjectImageSetup mImageSetup;
+  settings::ProjectPipelineSetup mPipelineSetup;
+  std::unique_ptr<processor::PipelineInitializer> mImageContext;
+  processor::GlobalContext mGlobalContext;
+  std::shared_ptr<atom::ObjectList> mObjects;
+  std::unique_ptr<processor::IterationContext> mIterationContext;
+  std::unique_ptr<processor::ProcessContext> mContext;
+  atom::ImagePlane mLoadedTile;            // Input image of each run
+  std::vector<atom::ROI> mInputObjects;    // Input objects of each run
+};
+
+}    // namespace joda::bench
@@ -0,0 +1,30 @@
+///
+/// \file      benchmark_main.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Entry point of the benchmark suite. Results are written machine readable
+///            using the Catch2 reporters, e.g. --reporter XML::out=results.xml
+///
+
+#include <unistd.h>
+#include "backend/helper/reader/image_reader.hpp"
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char **argv)
+{
+  joda::image::reader::ImageReader::init(1e9);
+
+  sleep(1);
+
+  int result = Catch::Session().run(argc, argv);
+
+  joda::image::reader::ImageReader::destroy();
+
+  return result;
+}
@@ -0,0 +1,59 @@
+///
+/// \file      database_benchmark.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Benchmark of storing the objects of a tile in the results database.
+///
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include "backend/commands/object_functions/measure_intensity/measure_intensity_settings.hpp"
+#include "backend/database/database.hpp"
+#include "backend/settings/pipeline/pipeline_step.hpp"
+#include "benchmark_context.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::bench {
+
+TEST_CASE("benchmark::database_insert_objects", "[benchmark][database]")
+{
+  constexpr int32_t TILE_SIZE = 2048;
+  const auto dbFile           = std::filesystem::temp_directory_path() / "imagec_benchmark" / "benchmark.icdb";
+
+  // Objects are stored with one intensity measurement like in a real job
+  settings::MeasureIntensitySettings measure;
+  measure.inputClasses = {enums::ClassIdIn::C1};
+  measure.planesIn     = {{.zProjection = enums::ZProjection::NONE, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 0}}};
+  const settings::PipelineStep step{.$measureIntensity = measure};
+
+  BenchmarkContext context(Scene::BLOBS, CV_16U, TILE_SIZE);
+  std::filesystem::remove(dbFile);
+  db::Database database;
+  database.openDatabase(dbFile);
+
+  int32_t workUnit = 0;
+  for(const int32_t nrOfObjects : {1000, 5000, 20000}) {
+    context.setObjects(createObjects(enums::ClassId::C1, nrOfObjects, {TILE_SIZE, TILE_SIZE}, 1));
+    context.run(step);
+    BENCHMARK(std::to_string(nrOfObjects) + " objects")
+    {
+      // Each insert is a new work unit, the work units table does not allow duplicates
+      database.insertObjects(context.getImageContext(), enums::Units::Pixels, context.getObjects(),
+                             {.imageId = context.getImageContext().getImageId(), .tileX = workUnit++});
+      return workUnit;
+    };
+  }
+
+  database.closeDatabase();
+  std::filesystem::remove(dbFile);
+}
+
+}    // namespace joda::bench
@@ -0,0 +1,115 @@
+///
+/// \file      image_functions_benchmark.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Benchmarks of the image functions and the classifier for each
+///            scene, bit depth and tile size.
+///
+
+#include <cstdint>
+#include <optional>
+#include "backend/commands/classification/classifier/classifier_settings.hpp"
+#include "backend/commands/image_functions/rank_filter/rank_filter_settings.hpp"
+#include "backend/commands/image_functions/rolling_ball/rolling_ball_settings.hpp"
+#include "backend/commands/image_functions/threshold/threshold_settings.hpp"
+#include "backend/commands/image_functions/threshold_adaptive/threshold_adaptive_settings.hpp"
+#include "backend/commands/image_functions/watershed/watershed_settings.hpp"
+#include "backend/settings/pipeline/pipeline_step.hpp"
+#include "benchmark_context.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::bench {
+
+namespace {
+
+constexpr Scene SCENES[]       = {Scene::BLOBS, Scene::TEXTURED_BACKGROUND, Scene::DENSE_NUCLEI};
+constexpr int32_t DEPTHS[]     = {CV_8U, CV_16U};
+constexpr int32_t TILE_SIZES[] = {512, 1024, 2048};
+
+///
+/// \brief  Benchmarks the step for each scene, bit depth and tile size
+/// \param[in]  step     Step to benchmark
+/// \param[in]  prepare  Executed once before the benchmark, e.g. to create a binary image
+///
+void benchmarkStep(const settings::PipelineStep &step, const std::optional<settings::PipelineStep> &prepare = std::nullopt)
+{
+  for(const auto scene : SCENES) {
+    for(const auto depth : DEPTHS) {
+      for(const auto tileSize : TILE_SIZES) {
+        BenchmarkContext context(scene, depth, tileSize);
+        if(prepare.has_value()) {
+          context.prepare(prepare.value());
+        }
+        BENCHMARK(context.getName())
+        {
+          return context.run(step);
+        };
+      }
+    }
+  }
+}
+
+auto otsuThreshold() -> settings::PipelineStep
+{
+  settings::ThresholdSettings threshold;
+  threshold.modelClasses = {{.method = settings::ThresholdSettings::Methods::OTSU, .pixelClassId = 1}};
+  return settings::PipelineStep{.$threshold = threshold};
+}
+
+}    // namespace
+
+TEST_CASE("benchmark::threshold", "[benchmark][image_functions]")
+{
+  benchmarkStep(otsuThreshold());
+}
+
+TEST_CASE("benchmark::threshold_adaptive", "[benchmark][image_functions]")
+{
+  settings::ThresholdAdaptiveSettings threshold;
+  threshold.modelClasses = {{.method = settings::ThresholdAdaptiveSettings::Methods::MEAN, .kernelSize = 15, .pixelClassId = 1}};
+  benchmarkStep(settings::PipelineStep{.$thresholdAdaptive = threshold});
+}
+
+TEST_CASE("benchmark::rank_filter", "[benchmark][image_functions]")
+{
+  settings::RankFilterSettings rank;
+  rank.mode   = settings::RankFilterSettings::Mode::MEDIAN;
+  rank.radius = 3;
+  benchmarkStep(settings::PipelineStep{.$rank = rank});
+}
+
+TEST_CASE("benchmark::rolling_ball", "[benchmark][image_functions]")
+{
+  settings::RollingBallSettings rollingBall;
+  rollingBall.ballType = settings::RollingBallSettings::BallType::BALL;
+  rollingBall.ballSize = 20;
+  benchmarkStep(settings::PipelineStep{.$rollingBall = rollingBall});
+}
+
+TEST_CASE("benchmark::watershed", "[benchmark][image_functions]")
+{
+  settings::WatershedSettings watershed;
+  watershed.maximumFinderTolerance = 0.5F;
+  benchmarkStep(settings::PipelineStep{.$watershed = watershed}, otsuThreshold());
+}
+
+TEST_CASE("benchmark::classifier", "[benchmark][image_functions]")
+{
+  settings::ObjectClass objectClass;
+  objectClass.pixelClassId                            = 1;
+  objectClass.outputClassNoMatch                      = enums::ClassIdIn::C2;
+  objectClass.filters.front().outputClass             = enums::ClassIdIn::C1;
+  objectClass.filters.front().metrics.minParticleSize = 5;
+  settings::ClassifierSettings classifier;
+  classifier.modelClasses = {objectClass};
+  benchmarkStep(settings::PipelineStep{.$classify = classifier}, otsuThreshold());
+}
+
+}    // namespace joda::bench
@@ -0,0 +1,99 @@
+///
+/// \file      object_functions_benchmark.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Benchmarks of the object measurements for different numbers of objects.
+///
+
+#include <cstdint>
+#include <string>
+#include "backend/commands/object_functions/colocalization/colocalization_settings.hpp"
+#include "backend/commands/object_functions/measure_distance/measure_distance_settings.hpp"
+#include "backend/commands/object_functions/measure_intensity/measure_intensity_settings.hpp"
+#include "backend/settings/pipeline/pipeline_step.hpp"
+#include "benchmark_context.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::bench {
+
+namespace {
+
+constexpr int32_t TILE_SIZE = 2048;
+
+///
+/// \brief  Objects of class C1 and, if nrOfOtherObjects is given, of class C2
+///
+auto createInput(int32_t nrOfObjects, int32_t nrOfOtherObjects) -> std::vector<atom::ROI>
+{
+  auto objects = createObjects(enums::ClassId::C1, nrOfObjects, {TILE_SIZE, TILE_SIZE}, 1);
+  for(auto &roi : createObjects(enums::ClassId::C2, nrOfOtherObjects, {TILE_SIZE, TILE_SIZE}, 2)) {
+    objects.push_back(std::move(roi));
+  }
+  return objects;
+}
+
+}    // namespace
+
+TEST_CASE("benchmark::measure_intensity", "[benchmark][object_functions]")
+{
+  settings::MeasureIntensitySettings measure;
+  measure.inputClasses = {enums::ClassIdIn::C1};
+  measure.planesIn     = {{.zProjection = enums::ZProjection::NONE, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 0}}};
+  const settings::PipelineStep step{.$measureIntensity = measure};
+
+  BenchmarkContext context(Scene::BLOBS, CV_16U, TILE_SIZE);
+  for(const int32_t nrOfObjects : {1000, 5000, 20000}) {
+    context.setObjects(createInput(nrOfObjects, 0));
+    BENCHMARK(context.getName() + ", " + std::to_string(nrOfObjects) + " objects")
+    {
+      return context.run(step);
+    };
+  }
+}
+
+TEST_CASE("benchmark::measure_distance", "[benchmark][object_functions]")
+{
+  settings::MeasureDistanceSettings measure;
+  measure.inputClassFrom = enums::ClassIdIn::C1;
+  measure.inputClassTo   = enums::ClassIdIn::C2;
+  measure.condition      = settings::DistanceMeasureConditions::ALL;
+  const settings::PipelineStep step{.$measureDistance = measure};
+
+  BenchmarkContext context(Scene::BLOBS, CV_16U, TILE_SIZE);
+  for(const int32_t nrOfObjects : {100, 500, 1000}) {
+    context.setObjects(createInput(nrOfObjects, nrOfObjects));
+    BENCHMARK(context.getName() + ", " + std::to_string(nrOfObjects) + " x " + std::to_string(nrOfObjects) + " objects")
+    {
+      return context.run(step);
+    };
+  }
+}
+
+TEST_CASE("benchmark::colocalization", "[benchmark][object_functions]")
+{
+  settings::ColocalizationSettings coloc;
+  coloc.mode            = settings::ColocalizationSettings::Mode::RECLASSIFY_COPY;
+  coloc.inputClasses    = {{.inputClassId = enums::ClassIdIn::C1, .newClassId = enums::ClassIdIn::C3},
+                           {.inputClassId = enums::ClassIdIn::C2, .newClassId = enums::ClassIdIn::C4}};
+  coloc.minIntersection = 0.1F;
+  coloc.outputClass     = enums::ClassIdIn::C5;
+  const settings::PipelineStep step{.$colocalization = coloc};
+
+  BenchmarkContext context(Scene::BLOBS, CV_16U, TILE_SIZE);
+  for(const int32_t nrOfObjects : {1000, 5000, 20000}) {
+    context.setObjects(createInput(nrOfObjects, nrOfObjects));
+    BENCHMARK(context.getName() + ", " + std::to_string(nrOfObjects) + " x " + std::to_string(nrOfObjects) + " objects")
+    {
+      return context.run(step);
+    };
+  }
+}
+
+}    // namespace joda::bench
@@ -0,0 +1,86 @@
+///
+/// \file      stripe_parallel_benchmark.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Single threaded compared to stripe parallel execution of the
+///            filters which split their work with StripeParallel.
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "backend/commands/image_functions/blur/blur.hpp"
+#include "backend/commands/image_functions/rank_filter/rank_filter.hpp"
+#include "backend/commands/image_functions/rolling_ball/rolling_ball.hpp"
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include "synthetic_data.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <BS_thread_pool.hpp>
+
+namespace joda::bench {
+
+namespace {
+
+constexpr int32_t TILE_SIZE = 2048;
+
+///
+/// \brief  Benchmarks the filter once with one thread and once with all threads of the pool
+///
+void benchmarkStripes(const std::function<void(cv::Mat &)> &filter)
+{
+  BS::priority_thread_pool pool(std::max(1U, std::thread::hardware_concurrency() - 1));
+  joda::thread::StripeParallel::setThreadPool(&pool);
+  const cv::Mat original = createImage(Scene::BLOBS, {TILE_SIZE, TILE_SIZE}, CV_16U, 42);
+
+  BENCHMARK("single threaded")
+  {
+    joda::thread::StripeParallel::ScopedThreadBudget budget(1);
+    cv::Mat img = original.clone();
+    filter(img);
+    return img.rows;
+  };
+  BENCHMARK("multi threaded (" + std::to_string(pool.get_thread_count() + 1) + ")")
+  {
+    cv::Mat img = original.clone();
+    filter(img);
+    return img.rows;
+  };
+  joda::thread::StripeParallel::setThreadPool(nullptr);
+}
+
+}    // namespace
+
+TEST_CASE("benchmark::stripe_parallel::rank_filter", "[benchmark][stripe_parallel]")
+{
+  settings::RankFilterSettings rank;
+  rank.mode   = settings::RankFilterSettings::Mode::MEDIAN;
+  rank.radius = 5;
+  benchmarkStripes([&rank](cv::Mat &img) { cmd::RankFilter(rank).execute(img); });
+}
+
+TEST_CASE("benchmark::stripe_parallel::rolling_ball", "[benchmark][stripe_parallel]")
+{
+  settings::RollingBallSettings rollingBall;
+  rollingBall.ballType = settings::RollingBallSettings::BallType::BALL;
+  rollingBall.ballSize = 50;
+  benchmarkStripes([&rollingBall](cv::Mat &img) { cmd::RollingBall(rollingBall).execute(img); });
+}
+
+TEST_CASE("benchmark::stripe_parallel::blur", "[benchmark][stripe_parallel]")
+{
+  settings::BlurSettings blur;
+  blur.mode       = settings::BlurSettings::Mode::BLUR_MORE;
+  blur.kernelSize = 3;
+  benchmarkStripes([&blur](cv::Mat &img) { cmd::Blur(blur).execute(img); });
+}
+
+}    // namespace joda::bench
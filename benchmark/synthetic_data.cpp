@@ -0,0 +1,159 @@
+///
+/// \file      synthetic_data.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "synthetic_data.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::bench {
+
+namespace {
+
+///
+/// \brief      Gaussian shaped spot, the intensity is added to the image
+///
+void addSpot(cv::Mat &image, const cv::Point2f &center, float radius, float intensity)
+{
+  const int32_t extent = static_cast<int32_t>(std::ceil(radius * 2));
+  const cv::Rect area  = cv::Rect(static_cast<int32_t>(center.x) - extent, static_cast<int32_t>(center.y) - extent, 2 * extent + 1, 2 * extent + 1) &
+                        cv::Rect(0, 0, image.cols, image.rows);
+  const float sigma2 = 2.0F * (radius / 2.0F) * (radius / 2.0F);
+  for(int32_t y = area.y; y < area.y + area.height; y++) {
+    auto *row = image.ptr<float>(y);
+    for(int32_t x = area.x; x < area.x + area.width; x++) {
+      const float dx = static_cast<float>(x) - center.x;
+      const float dy = static_cast<float>(y) - center.y;
+      row[x] += intensity * std::exp(-(dx * dx + dy * dy) / sigma2);
+    }
+  }
+}
+
+///
+/// \brief      Nuclei on a jittered grid, neighbours touch each other
+///
+void addNuclei(cv::Mat &image, cv::RNG &rng)
+{
+  const int32_t spacing = 24;
+  for(int32_t y = spacing / 2; y < image.rows; y += spacing) {
+    for(int32_t x = spacing / 2; x < image.cols; x += spacing) {
+      const cv::Point center(x + rng.uniform(-4, 5), y + rng.uniform(-4, 5));
+      const cv::Size axes(rng.uniform(10, 15), rng.uniform(9, 14));
+      cv::ellipse(image, center, axes, rng.uniform(0.0, 180.0), 0, 360, cv::Scalar(rng.uniform(0.45, 0.8)), cv::FILLED);
+    }
+  }
+  cv::GaussianBlur(image, image, {0, 0}, 2.0);
+}
+
+}    // namespace
+
+///
+/// \brief      Name of the scene used in the benchmark names
+/// \author     Joachim Danmayr
+///
+auto toString(Scene scene) -> std::string
+{
+  switch(scene) {
+    case Scene::BLOBS:
+      return "blobs";
+    case Scene::TEXTURED_BACKGROUND:
+      return "textured background";
+    case Scene::DENSE_NUCLEI:
+      return "dense nuclei";
+  }
+  return "";
+}
+
+///
+/// \brief      Creates a synthetic image. The same seed always creates the same image.
+/// \author     Joachim Danmayr
+/// \param[in]  scene  Content of the image
+/// \param[in]  size   Image size in pixels
+/// \param[in]  depth  CV_8U or CV_16U
+/// \param[in]  seed   Seed of the random number generator
+/// \return     Single channel image
+///
+auto createImage(Scene scene, const cv::Size &size, int32_t depth, uint64_t seed) -> cv::Mat
+{
+  if(depth != CV_8U && depth != CV_16U) {
+    throw std::invalid_argument("Only 8 and 16 bit images can be created!");
+  }
+  cv::RNG rng(seed);
+
+  // Intensities are created in the range [0, 1]
+  cv::Mat image(size, CV_32FC1);
+  rng.fill(image, cv::RNG::NORMAL, 0.1, 0.02);
+
+  switch(scene) {
+    case Scene::BLOBS: {
+      const int32_t nrOfSpots = std::max(1, size.area() / 20000);
+      for(int32_t n = 0; n < nrOfSpots; n++) {
+        addSpot(image, {rng.uniform(0.0F, static_cast<float>(size.width)), rng.uniform(0.0F, static_cast<float>(size.height))},
+                rng.uniform(3.0F, 25.0F), rng.uniform(0.3F, 0.85F));
+      }
+    } break;
+    case Scene::TEXTURED_BACKGROUND: {
+      for(int32_t y = 0; y < size.height; y++) {
+        auto *row = image.ptr<float>(y);
+        for(int32_t x = 0; x < size.width; x++) {
+          const float fx = static_cast<float>(x) / static_cast<float>(size.width);
+          const float fy = static_cast<float>(y) / static_cast<float>(size.height);
+          row[x] += 0.2F * fx * fy + 0.05F * std::sin(static_cast<float>(x) * 0.05F) * std::cos(static_cast<float>(y) * 0.07F);
+        }
+      }
+      const int32_t nrOfSpots = std::max(1, size.area() / 80000);
+      for(int32_t n = 0; n < nrOfSpots; n++) {
+        addSpot(image, {rng.uniform(0.0F, static_cast<float>(size.width)), rng.uniform(0.0F, static_cast<float>(size.height))},
+                rng.uniform(3.0F, 10.0F), rng.uniform(0.2F, 0.5F));
+      }
+    } break;
+    case Scene::DENSE_NUCLEI:
+      addNuclei(image, rng);
+      break;
+  }
+
+  cv::Mat out;
+  image.convertTo(out, depth, depth == CV_8U ? UINT8_MAX : UINT16_MAX);
+  return out;
+}
+
+///
+/// \brief      Creates round objects at random positions inside the image
+/// \author     Joachim Danmayr
+/// \param[in]  classId      Class of the objects
+/// \param[in]  nrOfObjects  Number of objects to create
+/// \param[in]  size         Image size in pixels
+/// \param[in]  seed         Seed of the random number generator
+/// \return     Objects of the first channel, z and t plane
+///
+auto createObjects(enums::ClassId classId, int32_t nrOfObjects, const cv::Size &size, uint64_t seed) -> std::vector<atom::ROI>
+{
+  static constexpr int32_t MAX_RADIUS = 12;
+  cv::RNG rng(seed);
+  std::vector<atom::ROI> objects;
+  objects.reserve(static_cast<size_t>(nrOfObjects));
+  for(int32_t n = 0; n < nrOfObjects; n++) {
+    const int32_t radius = rng.uniform(4, MAX_RADIUS + 1);
+    const cv::Rect box(rng.uniform(0, size.width - 2 * MAX_RADIUS), rng.uniform(0, size.height - 2 * MAX_RADIUS), 2 * radius + 1, 2 * radius + 1);
+    cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+    cv::circle(mask, {radius, radius}, radius, cv::Scalar(255), cv::FILLED);
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+
+    atom::ROI::RoiObjectId index{.classId = classId, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 0}};
+    objects.emplace_back(index, rng.uniform(0.5F, 1.0F), box, mask, contours.front(), enums::TileInfo{.tileSegment = {0, 0}, .tileSize = size});
+  }
+  return objects;
+}
+
+}    // namespace joda::bench
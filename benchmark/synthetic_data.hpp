@@ -0,0 +1,40 @@
+///
+/// \file      synthetic_data.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/enums/enums_classes.hpp"
+#include "backend/enums/types.hpp"
+#include <opencv2/core/mat.hpp>
+
+namespace joda::bench {
+
+///
+/// \brief      Content of a synthetic image
+/// \author     Joachim Danmayr
+///
+enum class Scene
+{
+  BLOBS,                  // Sparse bright spots of different size on a noisy background
+  TEXTURED_BACKGROUND,    // Uneven illumination and texture with a few spots, e.g. for background subtraction
+  DENSE_NUCLEI            // Touching nuclei covering most of the image, e.g. for watershed
+};
+
+auto toString(Scene scene) -> std::string;
+
+auto createImage(Scene scene, const cv::Size &size, int32_t depth, uint64_t seed) -> cv::Mat;
+auto createObjects(enums::ClassId classId, int32_t nrOfObjects, const cv::Size &size, uint64_t seed) -> std::vector<atom::ROI>;
+
+}    // namespace joda::bench
@@ -146,8 +146,9 @@ auto ROI::calcIntensity(const cv::Mat &image, const joda::enums::TileInfo &tile)
 
   const auto bound = getBoundingBoxTile(tile);
   Intensity intensityRet;
-  double count  = 0;
-  bool firstRun = true;
+  double count   = 0;
+  uint64_t sumSq = 0;
+  bool firstRun  = true;
   for(int y = 0; y < bound.height; y++) {
     const uint8_t *maskRow = mMask.ptr<uint8_t>(y);
     int imgY               = y + bound.y;
@@ -164,6 +165,7 @@ auto ROI::calcIntensity(const cv::Mat &image, const joda::enums::TileInfo &tile)
         }
         uint16_t val = imgRow[imgX];
         intensityRet.intensitySum += val;
+        sumSq += static_cast<uint64_t>(val) * val;
         if(firstRun) {
           firstRun                  = false;
           intensityRet.intensityMin = val;
@@ -181,7 +183,9 @@ auto ROI::calcIntensity(const cv::Mat &image, const joda::enums::TileInfo &tile)
     }
   }
 
-  intensityRet.intensityAvg = static_cast<float>(static_cast<double>(intensityRet.intensitySum) / count);
+  const double mean            = static_cast<double>(intensityRet.intensitySum) / count;
+  intensityRet.intensityAvg    = static_cast<float>(mean);
+  intensityRet.intensityStdDev = static_cast<float>(std::sqrt(std::max(0.0, static_cast<double>(sumSq) / count - mean * mean)));
   return intensityRet;
 }
 
@@ -311,6 +315,17 @@ double ROI::getLength(const std::vector<cv::Point> &points, bool closeShape)
   return mAreaSize * pxSizeX * pxSizeY;
 }
 
+///
+/// \brief      Volume of an object segmented in 3D
+/// \author     Joachim Danmayr
+///
+[[nodiscard]] double ROI::getVolumeSize(const ome::PhyiscalSize &physicalSize, enums::Units unit) const
+{
+  auto [pxSizeX, pxSizeY, pxSizeZ] = physicalSize.getPixelSize(unit);
+
+  return static_cast<double>(mVolume.voxelCount) * pxSizeX * pxSizeY * pxSizeZ;
+}
+
 ///
 /// \brief
 /// \todo Support pixels which are not a square
@@ -493,6 +508,19 @@ auto ROI::measureIntensityAndAdd(const enums::ImageId &imageId, const cv::Mat &i
   return mIntensity[imageId];
 }
 
+///
+/// \brief      Store an intensity measurement calculated outside of the ROI.
+///             An already existing measurement for the image is not overwritten.
+/// \author     Joachim Danmayr
+/// \param[in]  imageId    Image the intensity was measured in
+/// \param[in]  intensity  Measured intensity
+///
+void ROI::addIntensity(const enums::ImageId &imageId, const Intensity &intensity)
+{
+  std::lock_guard<std::mutex> lock(mIntensityMeasureMutex);
+  mIntensity.try_emplace(imageId, intensity);
+}
+
 ///
 /// \brief      Calculate the distance between the given object
 /// \author     Joachim Danmayr
@@ -79,6 +79,14 @@ public:
     float intensityAvg    = 0;    ///< Avg intensity of the masking area
     double intensityMin   = 0;    ///< Min intensity of the masking area
     double intensityMax   = 0;    ///< Max intensity of the masking area
+    float intensityStdDev = 0;    ///< Standard deviation of the intensity of the masking area
+    float intensityMedian = 0;    ///< Median intensity of the masking area (only if requested)
+
+    template <class Archive>
+    void serialize(Archive &ar)
+    {
+      ar(intensitySum, intensityAvg, intensityMin, intensityMax, intensityStdDev, intensityMedian);
+    }
   };
 
   struct Distance
@@ -88,6 +96,26 @@ public:
     double distanceCentroidToSurfaceMax = 0;    ///< Highest euclid distance from centroid to surface.
     double distanceSurfaceToSurfaceMin  = 0;    ///< Smallest euclid distance from surface to surface.
     double distanceSurfaceToSurfaceMax  = 0;    ///< Highest euclid distance from surface to surface.
+
+    template <class Archive>
+    void serialize(Archive &ar)
+    {
+      ar(distanceCentroidToCentroid, distanceCentroidToSurfaceMin, distanceCentroidToSurfaceMax, distanceSurfaceToSurfaceMin,
+         distanceSurfaceToSurfaceMax);
+    }
+  };
+
+  struct Volume
+  {
+    int32_t zStackEnd   = -1;    ///< Last z-stack of the object, the first one is the z-stack of the object id
+    uint64_t voxelCount = 0;     ///< Number of voxels, zero if the object was not segmented in 3D
+    cv::Point3d centroid;        ///< Unweighted 3D center of mass in real coordinates [px]
+
+    template <class Archive>
+    void serialize(Archive &ar)
+    {
+      ar(zStackEnd, voxelCount, centroid.x, centroid.y, centroid.z);
+    }
   };
 
   struct Intersecting
@@ -121,8 +149,9 @@ public:
       mIsNull(input.mIsNull), mObjectId(input.mObjectId), mId(std::move(input.mId)), mBoundingBoxReal(input.mBoundingBoxReal),
       mMask(std::move(input.mMask)), mMaskContours(std::move(input.mMaskContours)), mConfidence(input.mConfidence), mAreaSize(input.mAreaSize),
       mPerimeter(input.mPerimeter), mCircularity(input.mCircularity), mCentroid(input.mCentroid), mParentObjectId(input.mParentObjectId),
-      mTrackingId(input.mTrackingId), mIntensity(std::move(input.mIntensity)), mOriginObjectId(input.mOriginObjectId),
-      mLinkedWith(std::move(input.mLinkedWith)), mCategory(input.mCategory), mIsSelected(input.mIsSelected)
+      mTrackingId(input.mTrackingId), mIntensity(std::move(input.mIntensity)), mDistances(std::move(input.mDistances)),
+      mVolume(input.mVolume), mOriginObjectId(input.mOriginObjectId), mLinkedWith(std::move(input.mLinkedWith)), mCategory(input.mCategory),
+      mIsSelected(input.mIsSelected)
   {
     CV_Assert(mMask.type() == CV_8UC1);
   }
@@ -146,63 +175,72 @@ public:
 
   [[nodiscard]] ROI clone() const
   {
-    return {mIsNull,       mObjectId,       mId,         mConfidence,  mBoundingBoxReal, mMask,
-            mMaskContours, mAreaSize,       mPerimeter,  mCircularity, mIntensity,       mOriginObjectId,
-            mCentroid,     mParentObjectId, mTrackingId, mLinkedWith,  mIsSelected,      mCategory};
+    ROI cloned{mIsNull,       mObjectId,       mId,         mConfidence,  mBoundingBoxReal, mMask,
+               mMaskContours, mAreaSize,       mPerimeter,  mCircularity, mIntensity,       mOriginObjectId,
+               mCentroid,     mParentObjectId, mTrackingId, mLinkedWith,  mIsSelected,      mCategory};
+    cloned.mDistances = mDistances;
+    cloned.mVolume    = mVolume;
+    return cloned;
   }
 
   [[nodiscard]] ROI clone(enums::ClassId newClassId, uint64_t newParentObjectId) const
   {
-    return {mIsNull,       mObjectId,         {newClassId, mId.imagePlane},
-            mConfidence,   mBoundingBoxReal,  mMask,
-            mMaskContours, mAreaSize,         mPerimeter,
-            mCircularity,  mIntensity,        mOriginObjectId,
-            mCentroid,     newParentObjectId, mTrackingId,
-            mLinkedWith,   mIsSelected,       mCategory};
+    ROI cloned{mIsNull,       mObjectId,         {newClassId, mId.imagePlane},
+               mConfidence,   mBoundingBoxReal,  mMask,
+               mMaskContours, mAreaSize,         mPerimeter,
+               mCircularity,  mIntensity,        mOriginObjectId,
+               mCentroid,     newParentObjectId, mTrackingId,
+               mLinkedWith,   mIsSelected,       mCategory};
+    cloned.mVolume = mVolume;
+    return cloned;
   }
 
   [[nodiscard]] ROI copy() const
   {
-    return {mIsNull,
-            mGlobalUniqueObjectId++,
-            mId,
-            mConfidence,
-            mBoundingBoxReal,
-            mMask,
-            mMaskContours,
-            mAreaSize,
-            mPerimeter,
-            mCircularity,
-            mIntensity,
-            mObjectId,
-            mCentroid,
-            mParentObjectId,
-            mTrackingId,
-            mLinkedWith,
-            false,
-            mCategory};
+    ROI copied{mIsNull,
+               mGlobalUniqueObjectId++,
+               mId,
+               mConfidence,
+               mBoundingBoxReal,
+               mMask,
+               mMaskContours,
+               mAreaSize,
+               mPerimeter,
+               mCircularity,
+               mIntensity,
+               mObjectId,
+               mCentroid,
+               mParentObjectId,
+               mTrackingId,
+               mLinkedWith,
+               false,
+               mCategory};
+    copied.mVolume = mVolume;
+    return copied;
   }
 
   [[nodiscard]] ROI copy(enums::ClassId newClassId, uint64_t newParentObjectId) const
   {
-    return {mIsNull,
-            mGlobalUniqueObjectId++,
-            {newClassId, mId.imagePlane},
-            mConfidence,
-            mBoundingBoxReal,
-            mMask,
-            mMaskContours,
-            mAreaSize,
-            mPerimeter,
-            mCircularity,
-            mIntensity,
-            mObjectId,
-            mCentroid,
-            newParentObjectId,
-            mTrackingId,
-            mLinkedWith,
-            false,
-            mCategory};
+    ROI copied{mIsNull,
+               mGlobalUniqueObjectId++,
+               {newClassId, mId.imagePlane},
+               mConfidence,
+               mBoundingBoxReal,
+               mMask,
+               mMaskContours,
+               mAreaSize,
+               mPerimeter,
+               mCircularity,
+               mIntensity,
+               mObjectId,
+               mCentroid,
+               newParentObjectId,
+               mTrackingId,
+               mLinkedWith,
+               false,
+               mCategory};
+    copied.mVolume = mVolume;
+    return copied;
   }
 
   /// @brief  ATTENTION This method must be done befor the ROI is added to the spheral index
@@ -288,10 +326,32 @@ public:
     return mCircularity;
   }
 
+  ///
+  /// \brief      Set for objects segmented in 3D. The mask of such an object is
+  ///             the projection of all its planes.
+  ///
+  void setVolume(const Volume &volume)
+  {
+    mVolume = volume;
+  }
+
+  [[nodiscard]] auto getVolume() const -> const Volume &
+  {
+    return mVolume;
+  }
+
+  [[nodiscard]] bool isVolume() const
+  {
+    return mVolume.voxelCount > 0;
+  }
+
+  [[nodiscard]] double getVolumeSize(const ome::PhyiscalSize &physicalSIze, enums::Units unit) const;
+
   [[nodiscard]] ROI calcIntersection(const enums::PlaneId &iterator, const ROI &roi, float minIntersection,
                                      joda::enums::ClassId objectClassIntersectingObjectsShouldBeAssignedTo) const;
 
   auto measureIntensityAndAdd(const enums::ImageId &imageId, const cv::Mat &image, const joda::enums::TileInfo &tile) -> Intensity;
+  void addIntensity(const enums::ImageId &imageId, const Intensity &intensity);
   auto measureDistanceAndAdd(const ROI &secondRoi) -> Distance;
 
   [[nodiscard]] bool isIntersecting(const ROI &roi, float minIntersection) const;
@@ -343,9 +403,17 @@ public:
 
   static uint64_t generateNewTrackingId()
   {
-    uint64_t trackingID = mGlobalUniqueTrackingId;
-    mGlobalUniqueTrackingId++;
-    return trackingID;
+    return mGlobalUniqueTrackingId.fetch_add(1);
+  }
+
+  ///
+  /// \brief      New object and tracking IDs are generated after the given ones.
+  ///             Used when continuing a job whose objects are already stored.
+  ///
+  static void continueIdsAfter(uint64_t lastObjectId, uint64_t lastTrackingId)
+  {
+    mGlobalUniqueObjectId   = std::max(mGlobalUniqueObjectId.load(), lastObjectId + 1);
+    mGlobalUniqueTrackingId = std::max(mGlobalUniqueTrackingId.load(), lastTrackingId + 1);
   }
 
   void assignTrackingIdToAllLinkedRois(uint64_t trackingIdForLinked = 0);
@@ -392,6 +460,25 @@ public:
     }
   }
 
+  ///
+  /// \brief      Like save/load but including the intensity and distance measurements.
+  ///             Used for the pipeline cache, which must restore an object list exactly.
+  ///             Linked ROIs are pointers into the object list and are not stored.
+  ///
+  template <class Archive>
+  void saveWithMeasurements(Archive &ar) const
+  {
+    save(ar, ROI_SCHEMA_VERSION);
+    ar(mIntensity, mDistances, mVolume);
+  }
+
+  template <class Archive>
+  void loadWithMeasurements(Archive &ar)
+  {
+    load(ar, ROI_SCHEMA_VERSION);
+    ar(mIntensity, mDistances, mVolume);
+  }
+
 private:
   /////////////////////////////////////////////////////
   [[nodiscard]] uint64_t calcAreaSize() const;
@@ -426,6 +513,7 @@ private:
   // Measurements ///////////////////////////////////////////////////
   std::map<enums::ImageId, Intensity> mIntensity;
   std::map<uint64_t, Distance> mDistances;    ///< Key is the ID of the object the distance was calculated to.
+  Volume mVolume;                             ///< Only set for objects segmented in 3D
   uint64_t mOriginObjectId = 0;
   std::set<ROI *> mLinkedWith;    // Temporary object to store linked objects and create a linked object IF afterwards
 
@@ -11,7 +11,7 @@
 ///
 ///
 #include <vector>
-#include "backend/helper/duration_count/duration_count.h"
+#include "backend/helper/trace/trace.hpp"
 #undef slots
 #include <ATen/ops/upsample_nearest2d.h>
 #include <c10/core/Device.h>
@@ -93,7 +93,8 @@ auto AiFrameworkPytorch::predict(const at::Device &device, const cv::Mat &origin
   // ===============================
   // 3. Run the Model Inference
   // ===============================
-  DurationCount durationCount("Forward to libtorch");
+  static const auto SPAN_FORWARD = joda::trace::Tracer::registerSpan("Forward to libtorch");
+  joda::trace::Span span(SPAN_FORWARD);
   at::IValue output = model.forward({inputTensor});
   inputTensor       = at::Tensor();    // frees the GPU tensor
 
@@ -0,0 +1,258 @@
+///
+/// \file      volume_labeling.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "volume_labeling.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::cmd {
+
+namespace {
+
+template <typename T>
+void accumulateIntensities(const cv::Mat &labels, const cv::Mat &image, std::vector<VolumeLabeling::PlaneIntensity> &intensities)
+{
+  for(int32_t y = 0; y < labels.rows; y++) {
+    const auto *labelRow = labels.ptr<int32_t>(y);
+    const auto *imageRow = image.ptr<T>(y);
+    for(int32_t x = 0; x < labels.cols; x++) {
+      if(labelRow[x] == 0) {
+        continue;
+      }
+      auto &intensity  = intensities[static_cast<size_t>(labelRow[x])];
+      const auto value = static_cast<double>(imageRow[x]);
+      intensity.min    = std::min(intensity.min, value);
+      intensity.max    = std::max(intensity.max, value);
+      intensity.sum += value;
+      intensity.sumOfSquares += value * value;
+      intensity.pixelCount++;
+    }
+  }
+}
+
+}    // namespace
+
+void VolumeLabeling::PlaneIntensity::add(const PlaneIntensity &other)
+{
+  pixelCount += other.pixelCount;
+  sum += other.sum;
+  sumOfSquares += other.sumOfSquares;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+}
+
+VolumeLabeling::VolumeLabeling(Connectivity connectivity) : mConnectivity(connectivity)
+{
+}
+
+///
+/// \brief      Labels the plane and connects its objects with the objects of the last plane
+/// \author     Joachim Danmayr
+/// \param[in]  zStack      Z-stack of the plane, must follow the last added plane
+/// \param[in]  foreground  CV_8UC1 mask, all pixels not zero are part of an object
+/// \param[in]  channels    Images of this plane the per plane intensities are measured in
+///
+void VolumeLabeling::addPlane(int32_t zStack, const cv::Mat &foreground, const std::vector<Channel> &channels)
+{
+  if(foreground.type() != CV_8UC1) {
+    throw std::invalid_argument("Volume labeling needs a 8 bit foreground mask!");
+  }
+  if(!mLastLabels.empty() && (zStack != mLastZStack + 1 || foreground.size() != mLastLabels.size())) {
+    throw std::invalid_argument("Planes of a volume must be added in z-order and must have the same size!");
+  }
+
+  cv::Mat labels;
+  cv::Mat stats;
+  cv::Mat centroids;
+  const int32_t nrOfLabels =
+      cv::connectedComponentsWithStats(foreground, labels, stats, centroids, mConnectivity == Connectivity::FACE ? 4 : 8, CV_32S);
+
+  //
+  // Each object of this plane starts as a new object
+  //
+  const auto firstLabel = static_cast<uint32_t>(mParents.size()) - 1;
+  for(int32_t n = 1; n < nrOfLabels; n++) {
+    const auto label = firstLabel + static_cast<uint32_t>(n);
+    const auto area  = stats.at<int32_t>(n, cv::CC_STAT_AREA);
+    mParents.push_back(label);
+
+    Object &object     = mObjects[label];
+    object.zStackStart = zStack;
+    object.zStackEnd   = zStack;
+    object.voxelCount  = static_cast<uint64_t>(area);
+    object.voxelSum    = cv::Point3d(centroids.at<double>(n, 0), centroids.at<double>(n, 1), static_cast<double>(zStack)) * area;
+    object.boundingBox = {stats.at<int32_t>(n, cv::CC_STAT_LEFT), stats.at<int32_t>(n, cv::CC_STAT_TOP), stats.at<int32_t>(n, cv::CC_STAT_WIDTH),
+                          stats.at<int32_t>(n, cv::CC_STAT_HEIGHT)};
+    object.projection  = labels(object.boundingBox) == n;
+  }
+
+  for(const auto &channel : channels) {
+    if(channel.image == nullptr || channel.image->size() != foreground.size()) {
+      throw std::invalid_argument("Measured image must have the size of the foreground mask!");
+    }
+    std::vector<PlaneIntensity> intensities(static_cast<size_t>(nrOfLabels));
+    switch(channel.image->type()) {
+      case CV_8UC1:
+        accumulateIntensities<uint8_t>(labels, *channel.image, intensities);
+        break;
+      case CV_16UC1:
+        accumulateIntensities<uint16_t>(labels, *channel.image, intensities);
+        break;
+      default:
+        throw std::invalid_argument("Only 8 and 16 bit gray scale images can be measured!");
+    }
+    for(int32_t n = 1; n < nrOfLabels; n++) {
+      mObjects.at(firstLabel + static_cast<uint32_t>(n)).planeIntensities[{zStack, channel.cStack}] = intensities[static_cast<size_t>(n)];
+    }
+  }
+
+  //
+  // Connect with the objects of the last plane
+  //
+  if(!mLastLabels.empty()) {
+    const int32_t reach = mConnectivity == Connectivity::FACE ? 0 : 1;
+    for(int32_t y = 0; y < labels.rows; y++) {
+      const auto *labelRow = labels.ptr<int32_t>(y);
+      for(int32_t x = 0; x < labels.cols; x++) {
+        if(labelRow[x] == 0) {
+          continue;
+        }
+        for(int32_t yy = std::max(0, y - reach); yy <= std::min(labels.rows - 1, y + reach); yy++) {
+          const auto *lastRow = mLastLabels.ptr<int32_t>(yy);
+          for(int32_t xx = std::max(0, x - reach); xx <= std::min(labels.cols - 1, x + reach); xx++) {
+            if(lastRow[xx] != 0) {
+              unite(static_cast<uint32_t>(lastRow[xx]), firstLabel + static_cast<uint32_t>(labelRow[x]));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  //
+  // Objects not reaching into this plane are finished
+  //
+  for(auto it = mObjects.begin(); it != mObjects.end();) {
+    if(it->second.zStackEnd < zStack) {
+      mFinished.push_back(std::move(it->second));
+      it = mObjects.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  //
+  // Relabel the remaining objects to 1..n, so the union find does not grow with the z-stacks
+  //
+  std::map<uint32_t, uint32_t> newLabels;
+  std::map<uint32_t, Object> objects;
+  for(auto &[root, object] : mObjects) {
+    const auto newLabel = static_cast<uint32_t>(objects.size()) + 1;
+    newLabels.emplace(root, newLabel);
+    objects.emplace(newLabel, std::move(object));
+  }
+  std::vector<int32_t> lookup(static_cast<size_t>(nrOfLabels), 0);
+  for(int32_t n = 1; n < nrOfLabels; n++) {
+    lookup[static_cast<size_t>(n)] = static_cast<int32_t>(newLabels.at(findRoot(firstLabel + static_cast<uint32_t>(n))));
+  }
+  mLastLabels.create(labels.size(), CV_32SC1);
+  for(int32_t y = 0; y < labels.rows; y++) {
+    const auto *labelRow = labels.ptr<int32_t>(y);
+    auto *lastRow        = mLastLabels.ptr<int32_t>(y);
+    for(int32_t x = 0; x < labels.cols; x++) {
+      lastRow[x] = lookup[static_cast<size_t>(labelRow[x])];
+    }
+  }
+  mObjects = std::move(objects);
+  mParents.resize(mObjects.size() + 1);
+  std::iota(mParents.begin(), mParents.end(), 0);
+  mLastZStack = zStack;
+}
+
+///
+/// \brief      Objects which do not reach into the last added plane
+/// \author     Joachim Danmayr
+///
+auto VolumeLabeling::takeFinishedObjects() -> std::vector<Object>
+{
+  return std::exchange(mFinished, {});
+}
+
+///
+/// \brief      Finishes all objects, afterwards a new volume can be added
+/// \author     Joachim Danmayr
+///
+auto VolumeLabeling::finish() -> std::vector<Object>
+{
+  for(auto &[_, object] : mObjects) {
+    mFinished.push_back(std::move(object));
+  }
+  mObjects.clear();
+  mLastLabels.release();
+  mParents    = {0};
+  mLastZStack = -1;
+  return takeFinishedObjects();
+}
+
+auto VolumeLabeling::findRoot(uint32_t label) -> uint32_t
+{
+  while(mParents[label] != label) {
+    mParents[label] = mParents[mParents[label]];
+    label           = mParents[label];
+  }
+  return label;
+}
+
+///
+/// \brief      Both labels belong to one object, the object with the lower label remains
+/// \author     Joachim Danmayr
+///
+void VolumeLabeling::unite(uint32_t labelA, uint32_t labelB)
+{
+  auto rootA = findRoot(labelA);
+  auto rootB = findRoot(labelB);
+  if(rootA == rootB) {
+    return;
+  }
+  if(rootB < rootA) {
+    std::swap(rootA, rootB);
+  }
+  mParents[rootB] = rootA;
+  auto source     = mObjects.extract(rootB);
+  merge(mObjects.at(rootA), std::move(source.mapped()));
+}
+
+void VolumeLabeling::merge(Object &target, Object &&source)
+{
+  target.zStackStart = std::min(target.zStackStart, source.zStackStart);
+  target.zStackEnd   = std::max(target.zStackEnd, source.zStackEnd);
+  target.voxelCount += source.voxelCount;
+  target.voxelSum += source.voxelSum;
+
+  const cv::Rect boundingBox = target.boundingBox | source.boundingBox;
+  if(boundingBox != target.boundingBox) {
+    cv::Mat projection = cv::Mat::zeros(boundingBox.size(), CV_8UC1);
+    target.projection.copyTo(projection(target.boundingBox - boundingBox.tl()));
+    target.projection  = projection;
+    target.boundingBox = boundingBox;
+  }
+  cv::Mat area = target.projection(source.boundingBox - boundingBox.tl());
+  cv::bitwise_or(area, source.projection, area);
+
+  for(const auto &[plane, intensity] : source.planeIntensities) {
+    target.planeIntensities[plane].add(intensity);
+  }
+}
+
+}    // namespace joda::cmd
@@ -0,0 +1,96 @@
+///
+/// \file      volume_labeling.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/types.hpp>
+
+namespace joda::cmd {
+
+///
+/// \class      VolumeLabeling
+/// \author     Joachim Danmayr
+/// \brief      3D connected component labeling of a z-stack which is added plane by plane.
+///             Only the labels of the last plane and the objects reaching into it are kept,
+///             objects which ended before are handed out by takeFinishedObjects().
+///             This way the memory does not grow with the number of z-stacks.
+///
+class VolumeLabeling
+{
+public:
+  /////////////////////////////////////////////////////
+  enum class Connectivity
+  {
+    FACE,    // 6 neighbours, voxels must share a face
+    FULL     // 26 neighbours, voxels sharing an edge or corner are connected too
+  };
+
+  struct Channel
+  {
+    int32_t cStack       = 0;
+    const cv::Mat *image = nullptr;    // CV_8UC1 or CV_16UC1, same size as the foreground
+  };
+
+  struct PlaneIntensity
+  {
+    uint64_t pixelCount = 0;
+    double sum          = 0;
+    double sumOfSquares = 0;
+    double min          = std::numeric_limits<double>::max();
+    double max          = std::numeric_limits<double>::lowest();
+
+    void add(const PlaneIntensity &other);
+  };
+
+  struct Object
+  {
+    int32_t zStackStart = 0;
+    int32_t zStackEnd   = 0;
+    uint64_t voxelCount = 0;
+    cv::Point3d voxelSum;                                                     // Sum of all voxel coordinates
+    cv::Rect boundingBox;                                                     // Bounding box of the projection in tile coordinates
+    cv::Mat projection;                                                       // All planes of the object projected to one mask
+    std::map<std::pair<int32_t, int32_t>, PlaneIntensity> planeIntensities;    // Key is the z- and c-stack
+
+    [[nodiscard]] cv::Point3d getCentroid() const
+    {
+      return voxelSum / static_cast<double>(voxelCount);
+    }
+  };
+
+  /////////////////////////////////////////////////////
+  explicit VolumeLabeling(Connectivity connectivity);
+  void addPlane(int32_t zStack, const cv::Mat &foreground, const std::vector<Channel> &channels = {});
+  [[nodiscard]] auto takeFinishedObjects() -> std::vector<Object>;
+  [[nodiscard]] auto finish() -> std::vector<Object>;
+
+private:
+  /////////////////////////////////////////////////////
+  auto findRoot(uint32_t label) -> uint32_t;
+  void unite(uint32_t labelA, uint32_t labelB);
+  static void merge(Object &target, Object &&source);
+
+  /////////////////////////////////////////////////////
+  Connectivity mConnectivity;
+  int32_t mLastZStack = -1;
+  cv::Mat mLastLabels;                     // CV_32SC1, label of the last plane, 0 is background
+  std::vector<uint32_t> mParents = {0};    // Union find of the labels
+  std::map<uint32_t, Object> mObjects;     // Objects reaching into the last plane, key is the root label
+  std::vector<Object> mFinished;
+};
+
+}    // namespace joda::cmd
@@ -0,0 +1,110 @@
+///
+/// \file      volume_labeling_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Checks the plane by plane 3D labeling against
+///            volumes with known voxel count and centroid.
+///
+
+#include <stdexcept>
+#include <vector>
+#include "backend/commands/classification/volume_segmentation/volume_labeling.hpp"
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+namespace joda::test {
+
+using joda::cmd::VolumeLabeling;
+
+namespace {
+
+cv::Mat createPlane(const std::vector<cv::Rect> &boxes)
+{
+  cv::Mat plane = cv::Mat::zeros(32, 32, CV_8UC1);
+  for(const auto &box : boxes) {
+    plane(box).setTo(255);
+  }
+  return plane;
+}
+
+}    // namespace
+
+///
+/// \brief  A cube over several planes is one object
+///
+TEST_CASE("volume::labeling::cube", "[volume_labeling]")
+{
+  VolumeLabeling labeling(VolumeLabeling::Connectivity::FACE);
+  cv::Mat intensity(32, 32, CV_16UC1, cv::Scalar(100));
+  for(int32_t z = 0; z < 5; z++) {
+    labeling.addPlane(z, createPlane(z >= 1 && z <= 3 ? std::vector<cv::Rect>{{4, 6, 4, 4}} : std::vector<cv::Rect>{}),
+                      {{.cStack = 1, .image = &intensity}});
+  }
+  auto objects = labeling.finish();
+  REQUIRE(objects.size() == 1);
+  CHECK(objects[0].zStackStart == 1);
+  CHECK(objects[0].zStackEnd == 3);
+  CHECK(objects[0].voxelCount == 48);
+  CHECK(objects[0].getCentroid().x == Catch::Approx(5.5));
+  CHECK(objects[0].getCentroid().y == Catch::Approx(7.5));
+  CHECK(objects[0].getCentroid().z == Catch::Approx(2));
+  CHECK(objects[0].boundingBox == cv::Rect(4, 6, 4, 4));
+  CHECK(cv::countNonZero(objects[0].projection) == 16);
+  REQUIRE(objects[0].planeIntensities.size() == 3);
+  CHECK(objects[0].planeIntensities.at({2, 1}).pixelCount == 16);
+  CHECK(objects[0].planeIntensities.at({2, 1}).sum == Catch::Approx(1600));
+}
+
+///
+/// \brief  Objects touching in no plane stay separated, objects branching in z are merged
+///
+TEST_CASE("volume::labeling::separate_and_merge", "[volume_labeling]")
+{
+  VolumeLabeling labeling(VolumeLabeling::Connectivity::FACE);
+  labeling.addPlane(0, createPlane({{0, 0, 4, 4}, {10, 0, 4, 4}, {20, 20, 4, 4}}));
+  labeling.addPlane(1, createPlane({{0, 0, 14, 4}, {20, 20, 4, 4}}));
+  labeling.addPlane(2, createPlane({{20, 20, 4, 4}}));
+  auto finished = labeling.takeFinishedObjects();
+  REQUIRE(finished.size() == 1);
+  CHECK(finished[0].voxelCount == 16 + 16 + 56);
+  CHECK(finished[0].boundingBox == cv::Rect(0, 0, 14, 4));
+
+  auto objects = labeling.finish();
+  REQUIRE(objects.size() == 1);
+  CHECK(objects[0].voxelCount == 48);
+  CHECK(objects[0].zStackEnd == 2);
+}
+
+///
+/// \brief  Voxels sharing only a corner are connected with full connectivity only
+///
+TEST_CASE("volume::labeling::connectivity", "[volume_labeling]")
+{
+  for(auto connectivity : {VolumeLabeling::Connectivity::FACE, VolumeLabeling::Connectivity::FULL}) {
+    VolumeLabeling labeling(connectivity);
+    labeling.addPlane(0, createPlane({{4, 4, 2, 2}}));
+    labeling.addPlane(1, createPlane({{6, 6, 2, 2}}));
+    auto objects = labeling.finish();
+    CHECK(objects.size() == (connectivity == VolumeLabeling::Connectivity::FULL ? 1 : 2));
+  }
+}
+
+///
+/// \brief  Planes must be added in order
+///
+TEST_CASE("volume::labeling::order", "[volume_labeling]")
+{
+  VolumeLabeling labeling(VolumeLabeling::Connectivity::FACE);
+  labeling.addPlane(0, createPlane({}));
+  CHECK_THROWS_AS(labeling.addPlane(2, createPlane({})), std::invalid_argument);
+  CHECK_THROWS_AS(labeling.addPlane(1, cv::Mat::zeros(16, 16, CV_8UC1)), std::invalid_argument);
+}
+
+}    // namespace joda::test
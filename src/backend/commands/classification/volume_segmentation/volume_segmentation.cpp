@@ -0,0 +1,131 @@
+///
+/// \file      volume_segmentation.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "volume_segmentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "backend/artifacts/object_list/object_list.hpp"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::cmd {
+
+VolumeSegmentation::VolumeSegmentation(const settings::VolumeSegmentationSettings &settings) : mSettings(settings)
+{
+}
+
+///
+/// \brief      Streams through the z-stacks of the actual tile. The given image is not used,
+///             each plane is loaded directly from the image file.
+/// \author     Joachim Danmayr
+///
+void VolumeSegmentation::execute(processor::ProcessContext &context, cv::Mat & /*image*/, atom::ObjectList &result)
+{
+  const auto tStack = context.getActIterator().tStack;
+  auto loadPlane    = [&context, tStack](int32_t cStack, int32_t zStack) {
+    cv::Mat plane = context.loadImagePlane({.tStack = tStack, .zStack = zStack, .cStack = cStack});
+    if(plane.channels() > 1) {
+      cv::cvtColor(plane, plane, cv::COLOR_BGR2GRAY);
+    }
+    return plane;
+  };
+  auto toCStack = [&context](int32_t cStack) {
+    return cStack < 0 ? context.getActIterator().cStack : cStack;
+  };
+
+  const int32_t cStackSegmentation = toCStack(mSettings.cStackIndex);
+  std::set<int32_t> cStacksToMeasure;
+  for(const auto cStack : mSettings.measureChannels) {
+    // -2 is off
+    if(cStack >= -1) {
+      cStacksToMeasure.emplace(toCStack(cStack));
+    }
+  }
+
+  VolumeLabeling labeling(mSettings.connectivity == settings::VolumeSegmentationSettings::Connectivity::FULL ? VolumeLabeling::Connectivity::FULL
+                                                                                                             : VolumeLabeling::Connectivity::FACE);
+  const int32_t nrOfZStacks = context.getNrOfZStacks();
+  for(int32_t zStack = 0; zStack < nrOfZStacks; zStack++) {
+    const cv::Mat plane = loadPlane(cStackSegmentation, zStack);
+    cv::Mat foreground;
+    cv::inRange(plane, cv::Scalar(mSettings.thresholdMin), cv::Scalar(mSettings.thresholdMax), foreground);
+
+    std::vector<cv::Mat> images;
+    std::vector<VolumeLabeling::Channel> channels;
+    images.reserve(cStacksToMeasure.size());
+    for(const auto cStack : cStacksToMeasure) {
+      images.push_back(cStack == cStackSegmentation ? plane : loadPlane(cStack, zStack));
+      channels.push_back({.cStack = cStack, .image = &images.back()});
+    }
+
+    labeling.addPlane(zStack, foreground, channels);
+    for(auto &object : labeling.takeFinishedObjects()) {
+      addObject(context, std::move(object), result);
+    }
+  }
+  for(auto &object : labeling.finish()) {
+    addObject(context, std::move(object), result);
+  }
+}
+
+///
+/// \brief      Converts the 3D object to a ROI in its first z-stack
+/// \author     Joachim Danmayr
+///
+void VolumeSegmentation::addObject(processor::ProcessContext &context, VolumeLabeling::Object &&object, atom::ObjectList &result) const
+{
+  if(object.voxelCount < static_cast<uint64_t>(mSettings.minVoxelCount) ||
+     (mSettings.maxVoxelCount >= 0 && object.voxelCount > static_cast<uint64_t>(mSettings.maxVoxelCount))) {
+    return;
+  }
+
+  std::vector<std::vector<cv::Point>> contours;
+  cv::findContours(object.projection, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+  if(contours.empty()) {
+    return;
+  }
+  const auto &contour = *std::max_element(contours.begin(), contours.end(),
+                                          [](const auto &a, const auto &b) { return cv::contourArea(a) < cv::contourArea(b); });
+
+  const auto tStack   = context.getActIterator().tStack;
+  const auto tileInfo = context.getTileInfo();
+  atom::ROI roi(atom::ROI::RoiObjectId{.classId    = context.getClassId(mSettings.outputClass),
+                                       .imagePlane = {.tStack = tStack, .zStack = object.zStackStart, .cStack = context.getActIterator().cStack}},
+                static_cast<atom::Confidence>(mSettings.thresholdMin), object.boundingBox, object.projection, contour, tileInfo);
+  if(roi.getClassId() == enums::ClassId::NONE) {
+    return;
+  }
+
+  auto centroid = object.getCentroid();
+  centroid.x += static_cast<double>(std::get<0>(tileInfo.tileSegment) * tileInfo.tileSize.width);
+  centroid.y += static_cast<double>(std::get<1>(tileInfo.tileSegment) * tileInfo.tileSize.height);
+  roi.setVolume({.zStackEnd = object.zStackEnd, .voxelCount = object.voxelCount, .centroid = centroid});
+
+  for(const auto &[plane, intensity] : object.planeIntensities) {
+    const auto count    = static_cast<double>(intensity.pixelCount);
+    const double avg    = intensity.sum / count;
+    const double stdDev = std::sqrt(std::max(0.0, intensity.sumOfSquares / count - avg * avg));
+    roi.addIntensity(enums::ImageId{.zProjection = enums::ZProjection::NONE,
+                                    .imagePlane  = {.tStack = tStack, .zStack = plane.first, .cStack = plane.second}},
+                     atom::ROI::Intensity{.intensitySum    = static_cast<uint64_t>(intensity.sum),
+                                          .intensityAvg    = static_cast<float>(avg),
+                                          .intensityMin    = intensity.min,
+                                          .intensityMax    = intensity.max,
+                                          .intensityStdDev = static_cast<float>(stdDev)});
+  }
+
+  result.push_back(roi);
+}
+
+}    // namespace joda::cmd
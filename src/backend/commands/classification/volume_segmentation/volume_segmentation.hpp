@@ -0,0 +1,45 @@
+///
+/// \file      volume_segmentation.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include "backend/commands/command.hpp"
+#include "backend/processor/context/process_context.hpp"
+#include "volume_labeling.hpp"
+#include "volume_segmentation_settings.hpp"
+
+namespace joda::cmd {
+
+///
+/// \class      VolumeSegmentation
+/// \author     Joachim Danmayr
+/// \brief      Thresholds all z-stacks of the actual tile and connects the foreground
+///             voxels to 3D objects. The z-stacks are loaded one after the other,
+///             so only two planes of the tile are in memory at the same time.
+///             Each object is stored as one ROI in its first z-stack, the mask is the
+///             projection of all planes of the object.
+///
+class VolumeSegmentation : public Command
+{
+public:
+  /////////////////////////////////////////////////////
+  VolumeSegmentation(const settings::VolumeSegmentationSettings &);
+  void execute(processor::ProcessContext &context, cv::Mat &image, atom::ObjectList &result) override;
+
+private:
+  /////////////////////////////////////////////////////
+  void addObject(processor::ProcessContext &context, VolumeLabeling::Object &&object, atom::ObjectList &result) const;
+
+  /////////////////////////////////////////////////////
+  const settings::VolumeSegmentationSettings &mSettings;
+};
+
+}    // namespace joda::cmd
@@ -0,0 +1,95 @@
+///
+/// \file      volume_segmentation_settings.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include "backend/enums/enum_memory_idx.hpp"
+#include "backend/enums/enums_classes.hpp"
+#include "backend/global_enums.hpp"
+#include "backend/settings/setting.hpp"
+#include "backend/settings/setting_base.hpp"
+#include <nlohmann/json.hpp>
+
+namespace joda::settings {
+
+struct VolumeSegmentationSettings : public SettingBase
+{
+  enum class Connectivity
+  {
+    FACE,
+    FULL
+  };
+
+  //
+  // Image channel which is thresholded in each z-stack, -1 is the channel of the pipeline
+  //
+  int32_t cStackIndex = -1;
+
+  //
+  // Voxels with an intensity in the range [thresholdMin, thresholdMax] are foreground
+  //
+  uint16_t thresholdMin = 1000;
+  uint16_t thresholdMax = UINT16_MAX;
+
+  //
+  // Face: 6 neighbours, Full: 26 neighbours
+  //
+  Connectivity connectivity = Connectivity::FACE;
+
+  //
+  // Objects with less or more voxels are discarded, -1 is no limit
+  //
+  int32_t minVoxelCount = 1;
+  int32_t maxVoxelCount = -1;
+
+  //
+  // Image channels the intensity is measured in, for each z-stack of the object
+  //
+  std::set<int32_t> measureChannels = {-1};
+
+  //
+  // Class of the found objects
+  //
+  enums::ClassIdIn outputClass = enums::ClassIdIn::$;
+
+  /////////////////////////////////////////////////////
+  void check() const
+  {
+    CHECK_ERROR(thresholdMax >= thresholdMin, "Threshold max must be higher than threshold min.");
+    CHECK_ERROR(minVoxelCount >= 0, "Min. voxel count must not be negative.");
+    CHECK_ERROR(maxVoxelCount < 0 || maxVoxelCount >= minVoxelCount, "Max. voxel count must be higher than min. voxel count.");
+  }
+
+  settings::ObjectInputClasses getInputClasses() const override
+  {
+    return {};
+  }
+
+  [[nodiscard]] ObjectOutputClasses getOutputClasses() const override
+  {
+    return {outputClass};
+  }
+
+  [[nodiscard]] std::set<enums::MemoryIdx::Enum> getInputImageCache() const override
+  {
+    return {};
+  }
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT_EXTENDED(VolumeSegmentationSettings, cStackIndex, thresholdMin, thresholdMax, connectivity,
+                                                       minVoxelCount, maxVoxelCount, measureChannels, outputClass);
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(VolumeSegmentationSettings::Connectivity, {{VolumeSegmentationSettings::Connectivity::FACE, "Face"},
+                                                                        {VolumeSegmentationSettings::Connectivity::FULL, "Full"}});
+
+}    // namespace joda::settings
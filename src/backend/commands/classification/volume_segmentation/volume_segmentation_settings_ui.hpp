@@ -0,0 +1,141 @@
+///
+/// \file      volume_segmentation_settings_ui.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <qwidget.h>
+#include <cstdint>
+#include <string>
+#include "backend/commands/command.hpp"
+#include "backend/enums/enums_classes.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_command/command.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_base.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_combobox.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_combobox_classes_out.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_combobox_multi.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_line_edit.hpp"
+#include "ui/gui/helper/layout_generator.hpp"
+#include "ui/gui/helper/setting_generator.hpp"
+#include "volume_segmentation_settings.hpp"
+
+namespace joda::ui::gui {
+
+class VolumeSegmentation : public Command
+{
+public:
+  /////////////////////////////////////////////////////
+  inline static std::string TITLE             = "Volume segmentation";
+  inline static std::string ICON              = "cube";
+  inline static std::string DESCRIPTION       = "Threshold all z-stacks and connect the foreground to 3D objects. Needs the z-stack mode volume.";
+  inline static std::vector<std::string> TAGS = {"classifier", "classify", "objects", "3d", "volume", "z-stack"};
+
+  VolumeSegmentation(joda::settings::AnalyzeSettings *analyzeSettings, joda::settings::PipelineStep &pipelineStep,
+                     settings::VolumeSegmentationSettings &settings, QWidget *parent) :
+      Command(analyzeSettings, pipelineStep, TITLE.data(), DESCRIPTION.data(), TAGS, ICON.data(), parent, {{InOuts::ALL}, {InOuts::OBJECT}})
+  {
+    auto *tab = addTab(
+        "", [] {}, false);
+
+    //
+    //
+    //
+    mCStackIndex = generateCStackCombo<SettingComboBox<int32_t>>("Image channel", parent);
+    mCStackIndex->setValue(settings.cStackIndex);
+    mCStackIndex->connectWithSetting(&settings.cStackIndex);
+
+    //
+    //
+    //
+    mClassOut = SettingBase::create<SettingComboBoxClassesOut>(parent, {}, "Output class");
+    mClassOut->setValue(settings.outputClass);
+    mClassOut->connectWithSetting(&settings.outputClass);
+    mClassOut->setDisplayIconVisible(false);
+
+    addSetting(tab, "Input / Output", {{mCStackIndex.get(), true, 0}, {mClassOut.get(), true, 0}});
+
+    //
+    //
+    //
+    mThresholdMin = SettingBase::create<SettingLineEdit<uint16_t>>(parent, {}, "Min. threshold");
+    mThresholdMin->setPlaceholderText("[0 - 65535]");
+    mThresholdMin->setUnit("");
+    mThresholdMin->setMinMax(0, 65535);
+    mThresholdMin->setValue(settings.thresholdMin);
+    mThresholdMin->connectWithSetting(&settings.thresholdMin);
+    mThresholdMin->setShortDescription("Min. ");
+
+    //
+    //
+    //
+    mThresholdMax = SettingBase::create<SettingLineEdit<uint16_t>>(parent, {}, "Max. threshold");
+    mThresholdMax->setPlaceholderText("[0 - 65535]");
+    mThresholdMax->setUnit("");
+    mThresholdMax->setMinMax(0, 65535);
+    mThresholdMax->setValue(settings.thresholdMax);
+    mThresholdMax->connectWithSetting(&settings.thresholdMax);
+    mThresholdMax->setShortDescription("Max. ");
+
+    //
+    //
+    //
+    mConnectivity = SettingBase::create<SettingComboBox<joda::settings::VolumeSegmentationSettings::Connectivity>>(parent, {}, "Connectivity");
+    mConnectivity->addOptions({{joda::settings::VolumeSegmentationSettings::Connectivity::FACE, "Face (6 neighbours)", {}},
+                               {joda::settings::VolumeSegmentationSettings::Connectivity::FULL, "Full (26 neighbours)", {}}});
+    mConnectivity->setValue(settings.connectivity);
+    mConnectivity->connectWithSetting(&settings.connectivity);
+
+    addSetting(tab, "Segmentation", {{mThresholdMin.get(), true, 0}, {mThresholdMax.get(), false, 0}, {mConnectivity.get(), false, 0}});
+
+    //
+    //
+    //
+    mMinVoxelCount = SettingBase::create<SettingLineEdit<int32_t>>(parent, {}, "Min. voxel count");
+    mMinVoxelCount->setPlaceholderText("[0 - " + QString(std::to_string(INT32_MAX).data()) + "]");
+    mMinVoxelCount->setUnit("vx");
+    mMinVoxelCount->setMinMax(0, INT32_MAX);
+    mMinVoxelCount->setValue(settings.minVoxelCount);
+    mMinVoxelCount->connectWithSetting(&settings.minVoxelCount);
+    mMinVoxelCount->setShortDescription("Min. ");
+
+    //
+    //
+    //
+    mMaxVoxelCount = SettingBase::create<SettingLineEdit<int32_t>>(parent, {}, "Max. voxel count");
+    mMaxVoxelCount->setPlaceholderText("[-1 - " + QString(std::to_string(INT32_MAX).data()) + "]");
+    mMaxVoxelCount->setUnit("vx");
+    mMaxVoxelCount->setMinMax(-1, INT32_MAX);
+    mMaxVoxelCount->setValue(settings.maxVoxelCount);
+    mMaxVoxelCount->connectWithSetting(&settings.maxVoxelCount);
+    mMaxVoxelCount->setShortDescription("Max. ");
+
+    //
+    //
+    //
+    mMeasureChannels = generateCStackCombo<SettingComboBoxMulti<int32_t>>("Measure intensity in", parent);
+    mMeasureChannels->setValue(settings.measureChannels);
+    mMeasureChannels->connectWithSetting(&settings.measureChannels);
+
+    addSetting(tab, "Filter / Measurement", {{mMinVoxelCount.get(), true, 0}, {mMaxVoxelCount.get(), false, 0}, {mMeasureChannels.get(), true, 0}});
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  std::unique_ptr<SettingComboBox<int32_t>> mCStackIndex;
+  std::unique_ptr<SettingComboBoxClassesOut> mClassOut;
+  std::shared_ptr<SettingLineEdit<uint16_t>> mThresholdMin;
+  std::shared_ptr<SettingLineEdit<uint16_t>> mThresholdMax;
+  std::unique_ptr<SettingComboBox<joda::settings::VolumeSegmentationSettings::Connectivity>> mConnectivity;
+  std::shared_ptr<SettingLineEdit<int32_t>> mMinVoxelCount;
+  std::shared_ptr<SettingLineEdit<int32_t>> mMaxVoxelCount;
+  std::unique_ptr<SettingComboBoxMulti<int32_t>> mMeasureChannels;
+};
+
+}    // namespace joda::ui::gui
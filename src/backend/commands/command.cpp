@@ -13,19 +13,19 @@
 
 #include "command.hpp"
 #include <exception>
-#include "backend/helper/duration_count/duration_count.h"
+#include "backend/helper/trace/trace.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 
 namespace joda::cmd {
 void Command::operator()(processor::ProcessContext &context, cv::Mat &image, atom::ObjectList &result)
 {
-  const auto processName = std::string(typeid(*this).name());
-  DurationCount durationCount("Exec: " + processName);
+  static const auto SPAN_EXEC = joda::trace::Tracer::registerSpan("Exec");
+  joda::trace::Span span(SPAN_EXEC, joda::trace::Tracer::registerType(typeid(*this)));
   preCommandStep(context);
   try {
     execute(context, image, result);
   } catch(const std::exception &ex) {
-    joda::log::logError("Cmd: >" + processName + "< failed in execution. Got >" + std::string(ex.what()) + "<");
+    joda::log::logError("Cmd: >" + std::string(typeid(*this).name()) + "< failed in execution. Got >" + std::string(ex.what()) + "<");
   }
   postCommandStep(context);
 }
@@ -40,12 +40,12 @@ void Command::postCommandStep(const processor::ProcessContext & /*context*/)
 
 void ImageProcessingCommand::operator()(cv::Mat &image)
 {
-  const auto processName = std::string(typeid(*this).name());
-  DurationCount durationCount("Exec: " + processName);
+  static const auto SPAN_EXEC = joda::trace::Tracer::registerSpan("Exec");
+  joda::trace::Span span(SPAN_EXEC, joda::trace::Tracer::registerType(typeid(*this)));
   try {
     execute(image);
   } catch(const std::exception &ex) {
-    joda::log::logError("Cmd: >" + processName + "< failed in execution. Got >" + std::string(ex.what()) + "<");
+    joda::log::logError("Cmd: >" + std::string(typeid(*this).name()) + "< failed in execution. Got >" + std::string(ex.what()) + "<");
   }
 }
 
@@ -16,21 +16,13 @@
 
 #include "blur.hpp"
 #include "backend/commands/image_functions/blur/blur_settings.hpp"
+#include "backend/helper/threading/stripe_parallel.hpp"
 #include <opencv2/core/mat.hpp>
 
 namespace joda::cmd {
 
 void Blur::filter3x3(cv::Mat &image, joda::settings::BlurSettings::Mode type, int *kernel, int kernelArraySize) const
 {
-  int v1    = 0;
-  int v2    = 0;
-  int v3    = 0;    // input pixel values around the current pixel
-  int v4    = 0;
-  int v5    = 0;
-  int v6    = 0;
-  int v7    = 0;
-  int v8    = 0;
-  int v9    = 0;
   int k1    = 0;
   int k2    = 0;
   int k3    = 0;    // kernel values (used for CONVOLVE only)
@@ -67,99 +59,111 @@ void Blur::filter3x3(cv::Mat &image, joda::settings::BlurSettings::Mode type, in
 
   cv::Mat imageCopy = image.clone();
   int xEnd          = roiX + roiWidth;
-  int yEnd          = roiY + roiHeight;
-  for(int y = roiY; y < yEnd; y++) {
-    int p  = roiX + y * width;                     // points to current pixel
-    int p6 = p - (roiX > 0 ? 1 : 0);               // will point to v6, currently lower
-    int p3 = p6 - (y > 0 ? width : 0);             // will point to v3, currently lower
-    int p9 = p6 + (y < height - 1 ? width : 0);    // ...  to v9, currently lower
-    v2     = imageCopy.at<uint16_t>(p3) & 0xffff;
-    v5     = imageCopy.at<uint16_t>(p6) & 0xffff;
-    v8     = imageCopy.at<uint16_t>(p9) & 0xffff;
-    if(roiX > 0) {
-      p3++;
-      p6++;
-      p9++;
-    }
-    v3 = imageCopy.at<uint16_t>(p3) & 0xffff;
-    v6 = imageCopy.at<uint16_t>(p6) & 0xffff;
-    v9 = imageCopy.at<uint16_t>(p9) & 0xffff;
 
-    switch(type) {
-      case joda::settings::BlurSettings::Mode::GAUSSIAN:
-      case joda::settings::BlurSettings::Mode::BLUR_MORE:
-        for(int x = roiX; x < xEnd; x++, p++) {
-          if(x < width - 1) {
-            p3++;
-            p6++;
-            p9++;
-          }
-          v1                    = v2;
-          v2                    = v3;
-          v3                    = imageCopy.at<uint16_t>(p3) & 0xffff;
-          v4                    = v5;
-          v5                    = v6;
-          v6                    = imageCopy.at<uint16_t>(p6) & 0xffff;
-          v7                    = v8;
-          v8                    = v9;
-          v9                    = imageCopy.at<uint16_t>(p9) & 0xffff;
-          image.at<uint16_t>(p) = static_cast<uint16_t>((v1 + v2 + v3 + v4 + v5 + v6 + v7 + v8 + v9 + 4) / 9);
-        }
-        break;
-      case joda::settings::BlurSettings::Mode::FIND_EDGES:
-        for(int x = roiX; x < xEnd; x++, p++) {
-          if(x < width - 1) {
-            p3++;
-            p6++;
-            p9++;
-          }
-          v1            = v2;
-          v2            = v3;
-          v3            = imageCopy.at<uint16_t>(p3) & 0xffff;
-          v4            = v5;
-          v5            = v6;
-          v6            = imageCopy.at<uint16_t>(p6) & 0xffff;
-          v7            = v8;
-          v8            = v9;
-          v9            = imageCopy.at<uint16_t>(p9) & 0xffff;
-          double sum1   = v1 + 2 * v2 + v3 - v7 - 2 * v8 - v9;
-          double sum2   = v1 + 2 * v4 + v7 - v3 - 2 * v6 - v9;
-          double result = std::sqrt(sum1 * sum1 + sum2 * sum2);
-          if(result > 65535.0) {
-            result = 65535.0;
-          }
-          image.at<uint16_t>(p) = static_cast<uint16_t>(result);    // short
-        }
-        break;
-      case joda::settings::BlurSettings::Mode::CONVOLVE:
-        for(int x = roiX; x < xEnd; x++, p++) {
-          if(x < width - 1) {
-            p3++;
-            p6++;
-            p9++;
+  // Each line only reads from the copy, so the lines can be filtered in parallel
+  joda::thread::StripeParallel::forEach(roiHeight, MIN_STRIPE_HEIGHT, [&](int32_t stripeStart, int32_t stripeEnd) {
+    int v1 = 0;
+    int v2 = 0;
+    int v3 = 0;    // input pixel values around the current pixel
+    int v4 = 0;
+    int v5 = 0;
+    int v6 = 0;
+    int v7 = 0;
+    int v8 = 0;
+    int v9 = 0;
+    for(int y = roiY + stripeStart; y < roiY + stripeEnd; y++) {
+      int p  = roiX + y * width;                     // points to current pixel
+      int p6 = p - (roiX > 0 ? 1 : 0);               // will point to v6, currently lower
+      int p3 = p6 - (y > 0 ? width : 0);             // will point to v3, currently lower
+      int p9 = p6 + (y < height - 1 ? width : 0);    // ...  to v9, currently lower
+      v2     = imageCopy.at<uint16_t>(p3) & 0xffff;
+      v5     = imageCopy.at<uint16_t>(p6) & 0xffff;
+      v8     = imageCopy.at<uint16_t>(p9) & 0xffff;
+      if(roiX > 0) {
+        p3++;
+        p6++;
+        p9++;
+      }
+      v3 = imageCopy.at<uint16_t>(p3) & 0xffff;
+      v6 = imageCopy.at<uint16_t>(p6) & 0xffff;
+      v9 = imageCopy.at<uint16_t>(p9) & 0xffff;
+
+      switch(type) {
+        case joda::settings::BlurSettings::Mode::GAUSSIAN:
+        case joda::settings::BlurSettings::Mode::BLUR_MORE:
+          for(int x = roiX; x < xEnd; x++, p++) {
+            if(x < width - 1) {
+              p3++;
+              p6++;
+              p9++;
+            }
+            v1                    = v2;
+            v2                    = v3;
+            v3                    = imageCopy.at<uint16_t>(p3) & 0xffff;
+            v4                    = v5;
+            v5                    = v6;
+            v6                    = imageCopy.at<uint16_t>(p6) & 0xffff;
+            v7                    = v8;
+            v8                    = v9;
+            v9                    = imageCopy.at<uint16_t>(p9) & 0xffff;
+            image.at<uint16_t>(p) = static_cast<uint16_t>((v1 + v2 + v3 + v4 + v5 + v6 + v7 + v8 + v9 + 4) / 9);
           }
-          v1      = v2;
-          v2      = v3;
-          v3      = imageCopy.at<uint16_t>(p3) & 0xffff;
-          v4      = v5;
-          v5      = v6;
-          v6      = imageCopy.at<uint16_t>(p6) & 0xffff;
-          v7      = v8;
-          v8      = v9;
-          v9      = imageCopy.at<uint16_t>(p9) & 0xffff;
-          int sum = k1 * v1 + k2 * v2 + k3 * v3 + k4 * v4 + k5 * v5 + k6 * v6 + k7 * v7 + k8 * v8 + k9 * v9;
-          sum     = (sum + scale / 2) / scale;    // scale/2 for rounding
-          if(sum > 65535) {
-            sum = 65535;
+          break;
+        case joda::settings::BlurSettings::Mode::FIND_EDGES:
+          for(int x = roiX; x < xEnd; x++, p++) {
+            if(x < width - 1) {
+              p3++;
+              p6++;
+              p9++;
+            }
+            v1            = v2;
+            v2            = v3;
+            v3            = imageCopy.at<uint16_t>(p3) & 0xffff;
+            v4            = v5;
+            v5            = v6;
+            v6            = imageCopy.at<uint16_t>(p6) & 0xffff;
+            v7            = v8;
+            v8            = v9;
+            v9            = imageCopy.at<uint16_t>(p9) & 0xffff;
+            double sum1   = v1 + 2 * v2 + v3 - v7 - 2 * v8 - v9;
+            double sum2   = v1 + 2 * v4 + v7 - v3 - 2 * v6 - v9;
+            double result = std::sqrt(sum1 * sum1 + sum2 * sum2);
+            if(result > 65535.0) {
+              result = 65535.0;
+            }
+            image.at<uint16_t>(p) = static_cast<uint16_t>(result);    // short
           }
-          if(sum < 0) {
-            sum = 0;
+          break;
+        case joda::settings::BlurSettings::Mode::CONVOLVE:
+          for(int x = roiX; x < xEnd; x++, p++) {
+            if(x < width - 1) {
+              p3++;
+              p6++;
+              p9++;
+            }
+            v1      = v2;
+            v2      = v3;
+            v3      = imageCopy.at<uint16_t>(p3) & 0xffff;
+            v4      = v5;
+            v5      = v6;
+            v6      = imageCopy.at<uint16_t>(p6) & 0xffff;
+            v7      = v8;
+            v8      = v9;
+            v9      = imageCopy.at<uint16_t>(p9) & 0xffff;
+            int sum = k1 * v1 + k2 * v2 + k3 * v3 + k4 * v4 + k5 * v5 + k6 * v6 + k7 * v7 + k8 * v8 + k9 * v9;
+            sum     = (sum + scale / 2) / scale;    // scale/2 for rounding
+            if(sum > 65535) {
+              sum = 65535;
+            }
+            if(sum < 0) {
+              sum = 0;
+            }
+            image.at<uint16_t>(p) = static_cast<uint16_t>(sum);
           }
-          image.at<uint16_t>(p) = static_cast<uint16_t>(sum);
-        }
-        break;
+          break;
+      }
     }
-  }
+  });
 }
 
 }    // namespace joda::cmd
@@ -46,6 +46,9 @@ public:
   }
 
 private:
+  /////////////////////////////////////////////////////
+  static constexpr int32_t MIN_STRIPE_HEIGHT = 64;
+
   /////////////////////////////////////////////////////
   void filter3x3(cv::Mat &imageIn, joda::settings::BlurSettings::Mode type, int *kernel, int kernelArraySize) const;
 
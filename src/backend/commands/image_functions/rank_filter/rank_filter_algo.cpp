@@ -16,8 +16,12 @@
 
 #include "rank_filter_algo.hpp"
 #include <opencv2/core/hal/interface.h>
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include "rank_histogram.hpp"
 #include <opencv2/core/types.hpp>
 
 namespace joda::algo {
@@ -154,24 +158,37 @@ void RankFilter::doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t
   int kRadius     = this->kRadius(lineRadii.get(), lineRadiiLength);
   int cacheWidth  = width + 2 * kRadius;
   int cacheHeight = kHeight;
-  // 'cache' is the input buffer. Each line y in the image is mapped onto cache line y%cacheHeight
-  float *cache    = new float[cacheWidth * cacheHeight]{0};
   highestYinCache = std::max(0 - kHeight / 2, 0) - 1;    // this line+1 will be read into the cache first
 
-  nextY = 0;    // first thread started should begin at roi.y
-  doFiltering(ip, lineRadii, lineRadiiLength, cache, cacheWidth * cacheHeight, cacheWidth, cacheHeight, filterType, minMaxOutliersSign, threshold);
+  // For larger kernels the sliding histogram is faster than selecting from all kernel points. Same result.
+  if(filterType == MEDIAN && kRadius >= HISTOGRAM_MIN_RADIUS && RankHistogram::supports(ip)) {
+    RankHistogram::filter(ip, lineRadii.get(), kHeight, kRadius, this->kNPoints(lineRadii.get(), lineRadiiLength) / 2);
+    return;
+  }
+
+  double minVal = 0;
+  double maxVal = 0;
+  cv::Point minLoc;
+  cv::Point maxLoc;
+  cv::minMaxLoc(ip, &minVal, &maxVal, &minLoc, &maxLoc);
+  auto maxValue = static_cast<float>(maxVal);
+
+  // Each stripe reads the unfiltered image, so the result does not depend on the number of stripes
+  const cv::Mat pixels = ip.clone();
 
-  delete[] cache;
+  nextY = 0;    // first thread started should begin at roi.y
+  joda::thread::StripeParallel::forEach(ip.rows, std::max(MIN_STRIPE_HEIGHT, kHeight), [&](int32_t yStart, int32_t yEnd) {
+    // 'cache' is the input buffer. Each line y in the image is mapped onto cache line y%cacheHeight
+    std::vector<float> cache(static_cast<size_t>(cacheWidth) * static_cast<size_t>(cacheHeight), 0.0F);
+    doFiltering(pixels, ip, yStart, yEnd, lineRadii, lineRadiiLength, cache.data(), cache.size(), cacheWidth, cacheHeight, filterType,
+                minMaxOutliersSign, threshold, maxValue);
+  });
 }
 
-// Filter a grayscale image or one channel of an RGB image using one thread
-//
-// Synchronization: unless a thread is waiting, we avoid the overhead of 'synchronized'
-// statements. That's because a thread waiting for another one should be rare.
+// Filter the lines [yStart, yEnd) of a grayscale image using one thread.
+// Several threads can work on different stripes of the same image, each one with its own cache.
 //
 // Data handling: The area needed for processing a line is written into the array 'cache'.
-// This is a stripe of sufficient width for all threads to have each thread processing one
-// line, and some extra space if one thread is finished to start the next line.
 // This array is padded at the edges of the image so that a surrounding with radius kRadius
 // for each pixel processed is within 'cache'. Out-of-image
 // pixels are set to the value of the nearest edge pixel. When adding a new line, the lines in
@@ -187,8 +204,9 @@ void RankFilter::doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t
 // For outliers, calculate the median only if the pixel deviates by more than the threshold
 // from any pixel in the area. Therfore min or max is calculated; this is a much faster
 // operation than the median.
-void RankFilter::doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t lineRadiiLength, float *cache, size_t cacheLength, int cacheWidth,
-                             int cacheHeight, int filterType, float minMaxOutliersSign, float threshold)
+void RankFilter::doFiltering(const cv::Mat &pixels, cv::Mat &ip, int yStart, int yEnd, std::shared_ptr<int> lineRadii, size_t lineRadiiLength,
+                             float *cache, size_t cacheLength, int cacheWidth, int cacheHeight, int filterType, float minMaxOutliersSign,
+                             float threshold, float maxValue)
 {
   int width  = ip.cols;
   int height = ip.rows;
@@ -212,46 +230,38 @@ void RankFilter::doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t
   bool minOrMaxOrOutliers = minOrMax || filterType == OUTLIERS;
   bool sumFilter          = filterType == MEAN || filterType == VARIANCE;
   bool medianFilter       = filterType == MEDIAN || filterType == OUTLIERS;
-  double *sums            = sumFilter ? new double[2] : nullptr;
-  float *medianBuf1       = (medianFilter || filterType == REMOVE_NAN) ? new float[kNPoints] : nullptr;
-  float *medianBuf2       = (medianFilter || filterType == REMOVE_NAN) ? new float[kNPoints] : nullptr;
+  std::vector<double> sums(sumFilter ? 2 : 0);
+  std::vector<float> medianBuf1((medianFilter || filterType == REMOVE_NAN) ? kNPoints : 0);
+  std::vector<float> medianBuf2((medianFilter || filterType == REMOVE_NAN) ? kNPoints : 0);
 
   bool smallKernel = kRadius < 2;
 
-  double minVal = 0;
-  double maxVal = 0;
-  cv::Point minLoc;
-  cv::Point maxLoc;
-  cv::minMaxLoc(ip, &minVal, &maxVal, &minLoc, &maxLoc);
-
   // Object pixels  = ip.getPixels();
-  bool isFloat   = false;
-  float maxValue = static_cast<float>(maxVal);
-  float *values  = new float[width]{0};
+  bool isFloat = false;
+  std::vector<float> values(static_cast<size_t>(width), 0.0F);
 
-  int previousY = kHeight / 2 - cacheHeight;
+  // Kernel pointers must point to cache line (yStart - kHeight/2) % cacheHeight for the first line of the stripe
+  int previousY = yStart - (yStart + cacheHeight - kHeight / 2) % cacheHeight;
 
-  for(int y = 0; y < height; y++) {
+  for(int y = yStart; y < yEnd; y++) {
     for(int i = 0; i < static_cast<int>(cachePointersLength); i++) {    // shift kernel pointers to new line
       cachePointers.get()[i] = (cachePointers.get()[i] + cacheWidth * (y - previousY)) % static_cast<int32_t>(cacheLength);
     }
     previousY = y;
 
-    int yStartReading = y == 0 ? std::max(0 - kHeight / 2, 0) : y + kHeight / 2;
+    int yStartReading = y == yStart ? std::max(yStart - kHeight / 2, 0) : y + kHeight / 2;
     for(int yNew = yStartReading; yNew <= y + kHeight / 2; yNew++) {    // only 1 line except at start
-      readLineToCacheOrPad(ip, width, height, 0, xminInside, widthInside, cache, cacheWidth, cacheHeight, padLeft, padRight, kHeight, yNew);
+      readLineToCacheOrPad(pixels, width, height, 0, xminInside, widthInside, cache, cacheWidth, cacheHeight, padLeft, padRight, kHeight, yNew);
     }
 
-    int cacheLineP = cacheWidth * (y % cacheHeight) + kRadius;                                           // points to pixel (roi.x, y)
-    filterLine(values, width, cache, cachePointers, cachePointersLength, kNPoints, cacheLineP, ip, y,    // F I L T E R
-               sums, medianBuf1, medianBuf2, minMaxOutliersSign, maxValue, isFloat, filterType, smallKernel, sumFilter, minOrMax, minOrMaxOrOutliers,
-               threshold);
-    if(!isFloat) {                                          // Float images: data are written already during 'filterLine'
-      writeLineToPixels(values, ip, y * width, ip.cols);    // W R I T E
+    int cacheLineP = cacheWidth * (y % cacheHeight) + kRadius;                                                  // points to pixel (roi.x, y)
+    filterLine(values.data(), width, cache, cachePointers, cachePointersLength, kNPoints, cacheLineP, ip, y,    // F I L T E R
+               sums.data(), medianBuf1.data(), medianBuf2.data(), minMaxOutliersSign, maxValue, isFloat, filterType, smallKernel, sumFilter,
+               minOrMax, minOrMaxOrOutliers, threshold);
+    if(!isFloat) {                                                 // Float images: data are written already during 'filterLine'
+      writeLineToPixels(values.data(), ip, y * width, ip.cols);    // W R I T E
     }
   }    // while (true); loop over y (lines)
-
-  delete[] values;
 }
 
 // returns the minimum of the array, which may be modified concurrently, but not less than 0
@@ -343,7 +353,7 @@ void RankFilter::filterLine(float *values, int width, float *cache, std::shared_
  *	more than one line (padding by duplicating the y=0 row).
  */
 
-void RankFilter::readLineToCacheOrPad(cv::Mat &pixels, int width, int height, int roiY, int xminInside, int widthInside, float *cache, int cacheWidth,
+void RankFilter::readLineToCacheOrPad(const cv::Mat &pixels, int width, int height, int roiY, int xminInside, int widthInside, float *cache, int cacheWidth,
                                       int cacheHeight, int padLeft, int padRight, int kHeight, int y)
 {
   int lineInCache = y % cacheHeight;
@@ -365,7 +375,7 @@ void RankFilter::readLineToCacheOrPad(cv::Mat &pixels, int width, int height, in
 
 /** Read a line into the cache (includes conversion to flaot). Pad with edge pixels in x if necessary */
 
-void RankFilter::readLineToCache(cv::Mat &pixels, int pixelLineP, int xminInside, int widthInside, float *cache, int cacheLineP, int padLeft,
+void RankFilter::readLineToCache(const cv::Mat &pixels, int pixelLineP, int xminInside, int widthInside, float *cache, int cacheLineP, int padLeft,
                                  int padRight)
 {
   for(int pp = pixelLineP + xminInside, cp = cacheLineP + padLeft; pp < pixelLineP + xminInside + widthInside; pp++, cp++) {
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <opencv2/core.hpp>
 #include <opencv2/core/mat.hpp>
@@ -40,26 +41,30 @@ public:
   void rank(cv::Mat &ip, double radius, int filterType);
   void rank(cv::Mat &ip, double radius, int filterType, int whichOutliers, float threshold);
   void rank(cv::Mat &ip, double radius, int filterType, int whichOutliers, float threshold, bool lightBackground, bool dontSubtract);
+  std::shared_ptr<int> makeLineRadii(double radius, size_t &length);
+  int kRadius(int *lineRadii, size_t length);
+  int kHeight(int *lineRadii, size_t length);
+  int kNPoints(int *lineRadii, size_t length);
 
 private:
+  /////////////////////////////////////////////////////
+  static constexpr int MIN_STRIPE_HEIGHT    = 32;
+  static constexpr int HISTOGRAM_MIN_RADIUS = 2;    // Smaller median kernels are faster with selection
+
   /////////////////////////////////////////////////////
   void filterLine(float *values, int width, float *cache, std::shared_ptr<int> cachePoints, size_t cachePointersLength, int kNPoints, int cacheLineP,
                   cv::Mat &roi, int y, double *sums, float *medianBuf1, float *medianBuf2, float minMaxOutliersSign, float maxValue, bool isFloat,
                   int filterType, bool smallKernel, bool sumFilter, bool minOrMax, bool minOrMaxOrOutliers, float threshold);
 
-  void readLineToCacheOrPad(cv::Mat &pixels, int width, int height, int roiY, int xminInside, int widthInside, float *cache, int cacheWidth,
+  void readLineToCacheOrPad(const cv::Mat &pixels, int width, int height, int roiY, int xminInside, int widthInside, float *cache, int cacheWidth,
                             int cacheHeight, int padLeft, int padRight, int kHeight, int y);
 
   void doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t lineRadiiLength, int filterType, float minMaxOutliersSign, float threshold,
                    int &nextY);
   bool isMultiStepFilter(int filterType);
-  std::shared_ptr<int> makeLineRadii(double radius, size_t &length);
-  int kRadius(int *lineRadii, size_t length);
-  void doFiltering(cv::Mat &ip, std::shared_ptr<int> lineRadii, size_t lineRadiiLength, float *cache, size_t cacheLength, int cacheWidth,
-                   int cacheHeight, int filterType, float minMaxOutliersSign, float threshold);
+  void doFiltering(const cv::Mat &pixels, cv::Mat &ip, int yStart, int yEnd, std::shared_ptr<int> lineRadii, size_t lineRadiiLength, float *cache,
+                   size_t cacheLength, int cacheWidth, int cacheHeight, int filterType, float minMaxOutliersSign, float threshold, float maxValue);
 
-  int kHeight(int *lineRadii, size_t length);
-  int kNPoints(int *lineRadii, size_t length);
   std::shared_ptr<int> makeCachePointers(int *lineRadii, size_t lineRadiiLength, int cacheWidth, size_t &length);
   static float getAreaMax(float *cache, int xCache0, std::shared_ptr<int> kernel, size_t kernelLength, int ignoreRight, float max, float sign);
   static float getSideMax(float *cache, int xCache0, std::shared_ptr<int> kernel, size_t kernelLength, bool isRight, float sign);
@@ -70,7 +75,7 @@ private:
   static float getNaNAwareMedian(float *cache, int xCache0, std::shared_ptr<int> kernel, size_t kernelLength, float *aboveBuf, float *belowBuf,
                                  int kNPoints, float guess);
   static void writeLineToPixels(float *values, cv::Mat &pixels, int pixelP, int length);
-  static void readLineToCache(cv::Mat &pixels, int pixelLineP, int xminInside, int widthInside, float *cache, int cacheLineP, int padLeft,
+  static void readLineToCache(const cv::Mat &pixels, int pixelLineP, int xminInside, int widthInside, float *cache, int cacheLineP, int padLeft,
                               int padRight);
   static float findNthLowestNumber(float *buf, int bufLength, int n);
 
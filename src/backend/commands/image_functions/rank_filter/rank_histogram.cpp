@@ -0,0 +1,181 @@
+///
+/// \file      rank_histogram.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "rank_histogram.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include <opencv2/core.hpp>
+
+namespace joda::algo {
+
+SlidingHistogram::SlidingHistogram(uint32_t nrOfBins, uint32_t blockShift) : mBlockShift(blockShift), mBlockSize(1U << blockShift)
+{
+  const uint32_t nrOfBlocks = (nrOfBins + mBlockSize - 1) >> mBlockShift;
+  mCoarse.resize(nrOfBlocks, 0);
+  mFine.resize(static_cast<size_t>(nrOfBlocks) << mBlockShift, 0);
+}
+
+///
+/// \brief      Value with the given rank, n = 0 is the smallest value.
+///             n must be smaller than the number of values in the histogram.
+/// \author     Joachim Danmayr
+///
+auto SlidingHistogram::getNth(int32_t n) -> uint32_t
+{
+  const uint32_t blockMask = mBlockSize - 1;
+  while(mBelow > n) {
+    if((mActBin & blockMask) == 0) {
+      const int32_t prevBlock = mCoarse[(mActBin >> mBlockShift) - 1];
+      if(mBelow - prevBlock > n) {
+        mBelow -= prevBlock;
+        mActBin -= mBlockSize;
+        continue;
+      }
+    }
+    mActBin--;
+    mBelow -= mFine[mActBin];
+  }
+  while(mBelow + mFine[mActBin] <= n) {
+    if((mActBin & blockMask) == 0) {
+      const int32_t block = mCoarse[mActBin >> mBlockShift];
+      if(mBelow + block <= n) {
+        mBelow += block;
+        mActBin += mBlockSize;
+        continue;
+      }
+    }
+    mBelow += mFine[mActBin];
+    mActBin++;
+  }
+  return mActBin;
+}
+
+///
+/// \brief      Only unsigned integer images can be binned
+/// \author     Joachim Danmayr
+///
+auto RankHistogram::supports(const cv::Mat &image) -> bool
+{
+  return image.channels() == 1 && (image.depth() == CV_8U || image.depth() == CV_16U);
+}
+
+///
+/// \brief      Replaces each pixel by the value with the given rank in the kernel area
+/// \author     Joachim Danmayr
+/// \param[in,out]  image      8 or 16 bit image
+/// \param[in]  lineRadii      Left and right extend of each kernel line (2*kHeight values)
+/// \param[in]  kHeight        Kernel height
+/// \param[in]  kRadius        Kernel radius in x and y direction
+/// \param[in]  rank           Rank to pick, 0 = min, nrOfKernelPoints/2 = median
+///
+void RankHistogram::filter(cv::Mat &image, const int *lineRadii, int kHeight, int kRadius, int32_t rank)
+{
+  if(image.empty()) {
+    return;
+  }
+  double minVal = 0;
+  double maxVal = 0;
+  cv::minMaxLoc(image, &minVal, &maxVal);
+  const auto nrOfBins = static_cast<uint32_t>(maxVal) + 1;
+
+  // Border replicated copy, the kernel can be read without any range checks
+  cv::Mat padded;
+  cv::copyMakeBorder(image, padded, kRadius, kRadius, kRadius, kRadius, cv::BORDER_REPLICATE);
+
+  joda::thread::StripeParallel::forEach(image.rows, std::max(MIN_STRIPE_HEIGHT, kHeight), [&](int32_t yStart, int32_t yEnd) {
+    if(image.depth() == CV_8U) {
+      filterStripe<uint8_t>(padded, image, lineRadii, kHeight, kRadius, rank, nrOfBins, yStart, yEnd);
+    } else {
+      filterStripe<uint16_t>(padded, image, lineRadii, kHeight, kRadius, rank, nrOfBins, yStart, yEnd);
+    }
+  });
+}
+
+///
+/// \brief      Filters the lines [yStart, yEnd). The kernel goes left to right
+///             in even and right to left in odd lines, the histogram is only
+///             built once per stripe.
+/// \author     Joachim Danmayr
+///
+template <typename T>
+void RankHistogram::filterStripe(const cv::Mat &padded, cv::Mat &image, const int *lineRadii, int kHeight, int kRadius, int32_t rank,
+                                 uint32_t nrOfBins, int32_t yStart, int32_t yEnd)
+{
+  const int width  = image.cols;
+  const int kWidth = 2 * kRadius + 1;
+
+  // Upper and lower end of each kernel column, needed to move the kernel down
+  std::vector<int> columnTop(static_cast<size_t>(kWidth), kRadius);
+  std::vector<int> columnBottom(static_cast<size_t>(kWidth), -kRadius);
+  for(int i = 0; i < kHeight; i++) {
+    const int dy = i - kRadius;
+    for(int dx = lineRadii[2 * i]; dx <= lineRadii[2 * i + 1]; dx++) {
+      auto col          = static_cast<size_t>(dx + kRadius);
+      columnTop[col]    = std::min(columnTop[col], dy);
+      columnBottom[col] = std::max(columnBottom[col], dy);
+    }
+  }
+
+  // Pixel (x, y) of the image
+  auto px = [&padded, kRadius](int x, int y) -> uint32_t { return padded.ptr<T>(y + kRadius)[x + kRadius]; };
+
+  SlidingHistogram hist(nrOfBins, sizeof(T) == 1 ? 4 : 8);
+  int x = 0;
+  for(int i = 0; i < kHeight; i++) {
+    for(int dx = lineRadii[2 * i]; dx <= lineRadii[2 * i + 1]; dx++) {
+      hist.add(px(x + dx, yStart + i - kRadius));
+    }
+  }
+
+  for(int y = yStart; y < yEnd; y++) {
+    if(y != yStart) {    // Move down
+      for(int col = 0; col < kWidth; col++) {
+        if(columnTop[col] > columnBottom[col]) {
+          continue;    // Column not part of the kernel
+        }
+        const int dx = col - kRadius;
+        hist.remove(px(x + dx, y - 1 + columnTop[col]));
+        hist.add(px(x + dx, y + columnBottom[col]));
+      }
+    }
+
+    T *out = image.ptr<T>(y);
+    if((y - yStart) % 2 == 0) {    // Left to right
+      for(;; x++) {
+        out[x] = static_cast<T>(hist.getNth(rank));
+        if(x == width - 1) {
+          break;
+        }
+        for(int i = 0; i < kHeight; i++) {
+          const int yy = y + i - kRadius;
+          hist.remove(px(x + lineRadii[2 * i], yy));
+          hist.add(px(x + 1 + lineRadii[2 * i + 1], yy));
+        }
+      }
+    } else {    // Right to left
+      for(;; x--) {
+        out[x] = static_cast<T>(hist.getNth(rank));
+        if(x == 0) {
+          break;
+        }
+        for(int i = 0; i < kHeight; i++) {
+          const int yy = y + i - kRadius;
+          hist.remove(px(x + lineRadii[2 * i + 1], yy));
+          hist.add(px(x - 1 + lineRadii[2 * i], yy));
+        }
+      }
+    }
+  }
+}
+
+}    // namespace joda::algo
@@ -0,0 +1,116 @@
+///
+/// \file      rank_histogram.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Sliding histogram rank filter (median, min, max, percentile)
+///            for 8 and 16 bit images.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::algo {
+
+///
+/// \class      SlidingHistogram
+/// \author     Joachim Danmayr
+/// \brief      Two level histogram (fine bins grouped to coarse blocks) which
+///             remembers the position of the last rank query. Neighbouring
+///             kernel positions have nearly the same rank value, so a query
+///             mostly moves only a few bins. Whole blocks are skipped if the
+///             searched rank is not inside.
+///
+class SlidingHistogram
+{
+public:
+  /////////////////////////////////////////////////////
+  SlidingHistogram(uint32_t nrOfBins, uint32_t blockShift);
+
+  void add(uint32_t value)
+  {
+    mFine[value]++;
+    mCoarse[value >> mBlockShift]++;
+    if(value < mActBin) {
+      mBelow++;
+    }
+  }
+
+  void remove(uint32_t value)
+  {
+    mFine[value]--;
+    mCoarse[value >> mBlockShift]--;
+    if(value < mActBin) {
+      mBelow--;
+    }
+  }
+
+  auto getNth(int32_t n) -> uint32_t;
+
+  ///
+  /// \brief      Calls func(bin, count) for each non empty bin in ascending order.
+  ///             Empty blocks are skipped.
+  ///
+  template <typename FUNC>
+  void forEachBin(FUNC &&func) const
+  {
+    for(uint32_t block = 0; block < mCoarse.size(); block++) {
+      if(mCoarse[block] == 0) {
+        continue;
+      }
+      const uint32_t end = (block + 1) << mBlockShift;
+      for(uint32_t bin = block << mBlockShift; bin < end; bin++) {
+        if(mFine[bin] != 0) {
+          func(bin, mFine[bin]);
+        }
+      }
+    }
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  std::vector<int32_t> mFine;
+  std::vector<int32_t> mCoarse;
+  uint32_t mBlockShift;
+  uint32_t mBlockSize;
+  uint32_t mActBin = 0;    // Bin of the last query
+  int32_t mBelow   = 0;    // Number of values smaller than mActBin
+};
+
+///
+/// \class      RankHistogram
+/// \author     Joachim Danmayr
+/// \brief      Rank filter with the circular ImageJ kernel based on a sliding
+///             histogram. The kernel is moved in a zig-zag path over the
+///             image, so each step only updates the pixels entering and
+///             leaving the kernel at its border instead of collecting the
+///             whole kernel area. Out-of-image pixels are the nearest edge
+///             pixels, as in the ImageJ implementation.
+///
+class RankHistogram
+{
+public:
+  /////////////////////////////////////////////////////
+  static void filter(cv::Mat &image, const int *lineRadii, int kHeight, int kRadius, int32_t rank);
+  static auto supports(const cv::Mat &image) -> bool;
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr int32_t MIN_STRIPE_HEIGHT = 32;
+
+  /////////////////////////////////////////////////////
+  template <typename T>
+  static void filterStripe(const cv::Mat &padded, cv::Mat &image, const int *lineRadii, int kHeight, int kRadius, int32_t rank, uint32_t nrOfBins,
+                           int32_t yStart, int32_t yEnd);
+};
+
+}    // namespace joda::algo
@@ -0,0 +1,129 @@
+///
+/// \file      rank_histogram_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "backend/commands/image_functions/rank_filter/rank_filter_algo.hpp"
+#include "backend/commands/image_functions/rank_filter/rank_histogram.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+namespace joda::test {
+
+namespace {
+
+///
+/// \brief  Circular ImageJ kernel, same layout as RankFilter::makeLineRadii
+///
+std::vector<int> makeLineRadii(double radius)
+{
+  int r2      = static_cast<int>(radius * radius) + 1;
+  int kRadius = static_cast<int>(std::sqrt(r2 + 1e-10));
+  int kHeight = 2 * kRadius + 1;
+  std::vector<int> kernel(static_cast<size_t>(2 * kHeight + 2), 0);
+  kernel[2 * kRadius]     = -kRadius;
+  kernel[2 * kRadius + 1] = kRadius;
+  int nPoints             = 2 * kRadius + 1;
+  for(int y = 1; y <= kRadius; y++) {
+    int dx                        = static_cast<int>(std::sqrt(r2 - y * y + 1e-10));
+    kernel[2 * (kRadius - y)]     = -dx;
+    kernel[2 * (kRadius - y) + 1] = dx;
+    kernel[2 * (kRadius + y)]     = -dx;
+    kernel[2 * (kRadius + y) + 1] = dx;
+    nPoints += 4 * dx + 2;
+  }
+  kernel[kernel.size() - 2] = nPoints;
+  kernel[kernel.size() - 1] = kRadius;
+  return kernel;
+}
+
+///
+/// \brief  Sorts all kernel values of each pixel, edge pixels are repeated outside the image
+///
+template <typename T>
+cv::Mat bruteForceRank(const cv::Mat &image, const std::vector<int> &lineRadii, int32_t rank)
+{
+  const int kHeight = static_cast<int>(lineRadii.size() - 2) / 2;
+  const int kRadius = lineRadii.back();
+  cv::Mat result    = image.clone();
+  std::vector<T> values;
+  for(int y = 0; y < image.rows; y++) {
+    for(int x = 0; x < image.cols; x++) {
+      values.clear();
+      for(int i = 0; i < kHeight; i++) {
+        const int yy = std::clamp(y + i - kRadius, 0, image.rows - 1);
+        for(int dx = lineRadii[2 * i]; dx <= lineRadii[2 * i + 1]; dx++) {
+          values.push_back(image.at<T>(yy, std::clamp(x + dx, 0, image.cols - 1)));
+        }
+      }
+      std::nth_element(values.begin(), values.begin() + rank, values.end());
+      result.at<T>(y, x) = values[static_cast<size_t>(rank)];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void checkRanks(int type, int maxValue)
+{
+  cv::Mat image(97, 131, type);
+  cv::randu(image, cv::Scalar(0), cv::Scalar(maxValue));
+  for(double radius : {2.0, 4.5, 10.0, 15.0}) {
+    auto lineRadii    = makeLineRadii(radius);
+    const int kHeight = static_cast<int>(lineRadii.size() - 2) / 2;
+    const int kRadius = lineRadii.back();
+    const int nPoints = lineRadii[lineRadii.size() - 2];
+    for(int32_t rank : {0, nPoints / 2, nPoints - 1}) {
+      cv::Mat filtered = image.clone();
+      joda::algo::RankHistogram::filter(filtered, lineRadii.data(), kHeight, kRadius, rank);
+      cv::Mat diff;
+      cv::compare(filtered, bruteForceRank<T>(image, lineRadii, rank), diff, cv::CMP_NE);
+      CHECK(cv::countNonZero(diff) == 0);
+    }
+  }
+}
+
+}    // namespace
+
+///
+/// \brief  Sliding histogram must give the same ranks as sorting the kernel area
+/// \author Joachim Danmayr
+///
+TEST_CASE("rank_filter::histogram", "[rank_filter]")
+{
+  SECTION("8 bit")
+  {
+    checkRanks<uint8_t>(CV_8UC1, 256);
+  }
+
+  SECTION("16 bit")
+  {
+    checkRanks<uint16_t>(CV_16UC1, 65536);
+  }
+
+  SECTION("Median filter uses the histogram for larger radii")
+  {
+    cv::Mat image(64, 64, CV_16UC1);
+    cv::randu(image, cv::Scalar(0), cv::Scalar(4096));
+    cv::Mat filtered = image.clone();
+    joda::algo::RankFilter rank;
+    rank.rank(filtered, 6, joda::algo::RankFilter::MEDIAN);
+
+    auto lineRadii = makeLineRadii(6);
+    cv::Mat diff;
+    cv::compare(filtered, bruteForceRank<uint16_t>(image, lineRadii, lineRadii[lineRadii.size() - 2] / 2), diff, cv::CMP_NE);
+    CHECK(cv::countNonZero(diff) == 0);
+  }
+}
+
+}    // namespace joda::test
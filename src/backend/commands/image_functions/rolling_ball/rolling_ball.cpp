@@ -34,6 +34,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
 #include <opencv2/core.hpp>
 #include <opencv2/core/mat.hpp>
 #include <opencv2/core/utility.hpp>
@@ -199,22 +200,24 @@ cv::Mat RollingBall::shrinkImage(const cv::Mat &ip, int shrinkFactor)
   int sWidth         = static_cast<int>((static_cast<float>(width) + static_cast<float>(shrinkFactor) - 1) / static_cast<float>(shrinkFactor));
   int sHeight        = static_cast<int>((static_cast<float>(height) + static_cast<float>(shrinkFactor) - 1) / static_cast<float>(shrinkFactor));
   cv::Mat smallImage = cv::Mat(sHeight, sWidth, CV_32FC1, cv::Scalar(0));
-  float min;
-  float thispixel;
-  for(int ySmall = 0; ySmall < sHeight; ySmall++) {
-    for(int xSmall = 0; xSmall < sWidth; xSmall++) {
-      min = std::numeric_limits<float>::max();
-      for(int j = 0, y = shrinkFactor * ySmall; j < shrinkFactor && y < height; j++, y++) {
-        for(int k = 0, x = shrinkFactor * xSmall; k < shrinkFactor && x < width; k++, x++) {
-          thispixel = ip.at<float>(x + y * width);
-          if(thispixel < min) {
-            min = thispixel;
+  joda::thread::StripeParallel::forEach(sHeight, MIN_STRIPE_LENGTH, [&](int32_t start, int32_t end) {
+    float min;
+    float thispixel;
+    for(int ySmall = start; ySmall < end; ySmall++) {
+      for(int xSmall = 0; xSmall < sWidth; xSmall++) {
+        min = std::numeric_limits<float>::max();
+        for(int j = 0, y = shrinkFactor * ySmall; j < shrinkFactor && y < height; j++, y++) {
+          for(int k = 0, x = shrinkFactor * xSmall; k < shrinkFactor && x < width; k++, x++) {
+            thispixel = ip.at<float>(x + y * width);
+            if(thispixel < min) {
+              min = thispixel;
+            }
           }
         }
+        smallImage.at<float>(xSmall + ySmall * sWidth) = min;    // each point in small image is minimum of its neighborhood
       }
-      smallImage.at<float>(xSmall + ySmall * sWidth) = min;    // each point in small image is minimum of its neighborhood
     }
-  }
+  });
   return smallImage;
 }
 
@@ -291,76 +294,84 @@ void RollingBall::rollBall(RollingBallBall *ball, cv::Mat &fp)
   auto *zBall   = ball->data;
   int ballWidth = ball->width;
   int radiusIn  = static_cast<int>(static_cast<float>(ballWidth) / 2.0F);
-  auto *cache   = new float[width * ballWidth];    // temporarily stores the pixels we work on
-
-  for(int y = -radiusIn; y < height + radiusIn; y++) {    // for all positions of the ball center:
-    int nextLineToWriteInCache = (y + radiusIn) % ballWidth;
-    int nextLineToRead         = y + radiusIn;    // line of the input not touched yet
-    if(nextLineToRead < height) {
-      // std::copy(pixels + nextLineToRead * width, pixels + (nextLineToRead + 1) * width,cache + nextLineToWriteInCache
-      // * width);
 
-      std::copy(reinterpret_cast<float *>(fp.data) + nextLineToRead * width, reinterpret_cast<float *>(fp.data) + (nextLineToRead + 1) * width,
-                cache + nextLineToWriteInCache * width);
+  // The height of the ball at a position only depends on the unprocessed pixels. Each stripe of output lines
+  // is processed by rolling the ball over all positions touching the stripe, so stripes can run in parallel.
+  const cv::Mat pixels = fp.clone();
+  fp.setTo(-std::numeric_limits<float>::max());    // unprocessed pixels start at minus infinity
 
-      for(int x = 0, p = nextLineToRead * width; x < width; x++, p++) {
-        fp.at<float>(p) = -std::numeric_limits<float>::max();    // unprocessed pixels start at minus infinity
+  joda::thread::StripeParallel::forEach(height, std::max(MIN_STRIPE_LENGTH, 4 * ballWidth), [&](int32_t stripeStart, int32_t stripeEnd) {
+    for(int y = stripeStart - radiusIn; y < stripeEnd + radiusIn; y++) {    // for all positions of the ball center touching the stripe:
+      int y0 = y - radiusIn;                                                 // the first line to see whether the ball touches
+      if(y0 < 0) {
+        y0 = 0;
       }
-    }
-    int y0 = y - radiusIn;    // the first line to see whether the ball touches
-    if(y0 < 0) {
-      y0 = 0;
-    }
-    int yBall0 = y0 - y + radiusIn;    // y coordinate in the ball corresponding to y0
-    int yend   = y + radiusIn;         // the last line to see whether the ball touches
-    if(yend >= height) {
-      yend = height - 1;
-    }
-    for(int x = -radiusIn; x < width + radiusIn; x++) {
-      float z = std::numeric_limits<float>::max();    // the height of the ball (ball is in position x,y)
-      int x0  = x - radiusIn;
-      if(x0 < 0) {
-        x0 = 0;
+      int yBall0 = y0 - y + radiusIn;    // y coordinate in the ball corresponding to y0
+      int yend   = y + radiusIn;         // the last line to see whether the ball touches
+      if(yend >= height) {
+        yend = height - 1;
       }
-      int xBall0 = x0 - x + radiusIn;
-      int xend   = x + radiusIn;
-      if(xend >= width) {
-        xend = width - 1;
-      }
-      for(int yp = y0, yBall = yBall0; yp <= yend; yp++, yBall++) {    // for all points inside the ball
-        int cachePointer = (yp % ballWidth) * width + x0;
-        for(int xp = x0, bp = xBall0 + yBall * ballWidth; xp <= xend; xp++, cachePointer++, bp++) {
-          float zReduced = cache[cachePointer] - zBall[bp];
-          if(z > zReduced) {    // does this point imply a greater height?
-            z = zReduced;
+      int yRaise0   = std::max(y0, stripeStart);    // only lines of this stripe are raised
+      int yRaiseEnd = std::min(yend, stripeEnd - 1);
+      for(int x = -radiusIn; x < width + radiusIn; x++) {
+        float z = std::numeric_limits<float>::max();    // the height of the ball (ball is in position x,y)
+        int x0  = x - radiusIn;
+        if(x0 < 0) {
+          x0 = 0;
+        }
+        int xBall0 = x0 - x + radiusIn;
+        int xend   = x + radiusIn;
+        if(xend >= width) {
+          xend = width - 1;
+        }
+        for(int yp = y0, yBall = yBall0; yp <= yend; yp++, yBall++) {    // for all points inside the ball
+          const auto *line = pixels.ptr<float>(yp);
+          for(int xp = x0, bp = xBall0 + yBall * ballWidth; xp <= xend; xp++, bp++) {
+            float zReduced = line[xp] - zBall[bp];
+            if(z > zReduced) {    // does this point imply a greater height?
+              z = zReduced;
+            }
           }
         }
-      }
-      for(int yp = y0, yBall = yBall0; yp <= yend; yp++, yBall++)    // raise pixels to ball surface
-        for(int xp = x0, p = xp + yp * width, bp = xBall0 + yBall * ballWidth; xp <= xend; xp++, p++, bp++) {
-          float zMin = z + zBall[bp];
-          if(fp.at<float>(p) < zMin) {
-            fp.at<float>(p) = zMin;
+        for(int yp = yRaise0, yBall = yRaise0 - y + radiusIn; yp <= yRaiseEnd; yp++, yBall++) {    // raise pixels to ball surface
+          auto *line = fp.ptr<float>(yp);
+          for(int xp = x0, bp = xBall0 + yBall * ballWidth; xp <= xend; xp++, bp++) {
+            float zMin = z + zBall[bp];
+            if(line[xp] < zMin) {
+              line[xp] = zMin;
+            }
           }
         }
-      // if (x>=0&&y>=0&&x<width&&y<height) bgPixels[x+y*width] = z; //debug, ball height output
+      }
     }
-  }
-
-  // new ImagePlus("bg rolled", fp.duplicate()).show();
-  delete[] cache;
+  });
 }
 
 double RollingBall::filter3x3(cv::Mat &ip, int type)
 {
-  int width      = ip.cols;
-  int height     = ip.rows;
+  int width  = ip.cols;
+  int height = ip.rows;
+
+  // The shifts are summed up in line order afterwards, so the result does not depend on the number of threads
+  std::vector<double> shiftRows(static_cast<size_t>(height), 0.0);
+  std::vector<double> shiftCols(static_cast<size_t>(width), 0.0);
+  joda::thread::StripeParallel::forEach(height, MIN_STRIPE_LENGTH, [&](int32_t start, int32_t end) {
+    for(int y = start; y < end; y++) {
+      shiftRows[static_cast<size_t>(y)] = filter3(ip, width, y * width, 1, type);
+    }
+  });
+  joda::thread::StripeParallel::forEach(width, MIN_STRIPE_LENGTH, [&](int32_t start, int32_t end) {
+    for(int x = start; x < end; x++) {
+      shiftCols[static_cast<size_t>(x)] = filter3(ip, height, x, width, type);
+    }
+  });
+
   double shiftBy = 0;
-  for(int y = 0; y < height; y++) {
-    shiftBy += filter3(ip, width, y * width, 1, type);
+  for(const double shift : shiftRows) {
+    shiftBy += shift;
   }
-  for(int x = 0; x < width; x++) {
-    shiftBy += filter3(ip, height, x, width, type);
+  for(const double shift : shiftCols) {
+    shiftBy += shift;
   }
   return shiftBy / static_cast<double>(width) / static_cast<double>(height);
 }
@@ -52,13 +52,15 @@ private:
   static int constexpr X_DIRECTION = 0, Y_DIRECTION = 1, DIAGONAL_1A = 2, DIAGONAL_1B = 3, DIAGONAL_2A = 4,
                        DIAGONAL_2B = 5;    // filter directions
 
+  static int constexpr MIN_STRIPE_LENGTH = 32;    // min. number of lines processed by one thread
+
   /////////////////////////////////////////////////////
   void rollingBallFloatBackground(cv::Mat &fp, float radius, bool invert, bool doPresmooth, RollingBallBall *ball) const;
 
   void slidingParaboloidFloatBackground(cv::Mat &fp, float radius, bool invert, bool doPresmooth, bool correctCorners) const;
 
   void correctCorners(cv::Mat &pixels, float coeff2, float *cache, int *nextPoint) const;
-  void filter1D(cv::Mat &fp, int direction, float coeff2, float *cache, int *nextPoint) const;
+  void filter1D(cv::Mat &fp, int direction, float coeff2) const;
   float *lineSlideParabola(cv::Mat &pixels, int start, int inc, int length, float coeff2, float *cache, int *nextPoint, float *correctedEdges) const;
 
   static cv::Mat shrinkImage(const cv::Mat &ip, int shrinkFactor);
@@ -30,6 +30,8 @@
 #include <cfloat>
 #include <climits>
 #include <cstddef>
+#include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
 #include "rolling_ball.hpp"
 
 namespace joda::cmd {
@@ -68,15 +70,15 @@ void RollingBall::slidingParaboloidFloatBackground(cv::Mat &fp, float radiusIn,
   /* Slide the parabola over the image in different directions */
   /* Doing the diagonal directions at the end is faster (diagonal lines are denser,
    * so there are more such lines, and the algorithm gets faster with each iteration) */
-  filter1D(fp, X_DIRECTION, coeff2, cache, nextPoint);
-  filter1D(fp, Y_DIRECTION, coeff2, cache, nextPoint);
-  filter1D(fp, X_DIRECTION, coeff2, cache, nextPoint);    // redo for better accuracy
-  filter1D(fp, DIAGONAL_1A, coeff2diag, cache, nextPoint);
-  filter1D(fp, DIAGONAL_1B, coeff2diag, cache, nextPoint);
-  filter1D(fp, DIAGONAL_2A, coeff2diag, cache, nextPoint);
-  filter1D(fp, DIAGONAL_2B, coeff2diag, cache, nextPoint);
-  filter1D(fp, DIAGONAL_1A, coeff2diag, cache, nextPoint);    // redo for better accuracy
-  filter1D(fp, DIAGONAL_1B, coeff2diag, cache, nextPoint);
+  filter1D(fp, X_DIRECTION, coeff2);
+  filter1D(fp, Y_DIRECTION, coeff2);
+  filter1D(fp, X_DIRECTION, coeff2);    // redo for better accuracy
+  filter1D(fp, DIAGONAL_1A, coeff2diag);
+  filter1D(fp, DIAGONAL_1B, coeff2diag);
+  filter1D(fp, DIAGONAL_2A, coeff2diag);
+  filter1D(fp, DIAGONAL_2B, coeff2diag);
+  filter1D(fp, DIAGONAL_1A, coeff2diag);    // redo for better accuracy
+  filter1D(fp, DIAGONAL_1B, coeff2diag);
 
   if(invert) {
     for(uint64_t i = 0; i < length; i++) {
@@ -98,7 +100,7 @@ void RollingBall::slidingParaboloidFloatBackground(cv::Mat &fp, float radiusIn,
 /// \author
 /// \return
 ///
-void RollingBall::filter1D(cv::Mat &fp, int direction, float coeff2, float *cache, int *nextPoint) const
+void RollingBall::filter1D(cv::Mat &fp, int direction, float coeff2) const
 {
   int width     = fp.cols;
   int height    = fp.rows;
@@ -144,27 +146,37 @@ void RollingBall::filter1D(cv::Mat &fp, int direction, float coeff2, float *cach
       pointInc  = width - 1;
       break;
   }
-  for(int i = startLine; i < nLines; i++) {
-    int startPixel = i * lineInc;
-    if(direction == DIAGONAL_2B) {
-      startPixel += width - 1;
-    }
-    switch(direction) {
-      case DIAGONAL_1A:
-        length = std::min(height, width - i);
-        break;
-      case DIAGONAL_1B:
-        length = std::min(width, height - i);
-        break;
-      case DIAGONAL_2A:
-        length = std::min(height, i + 1);
-        break;
-      case DIAGONAL_2B:
-        length = std::min(width, height - i);
-        break;
-    }
-    RollingBall::lineSlideParabola(fp, startPixel, pointInc, length, coeff2, cache, nextPoint, nullptr);
+  if(nLines <= startLine) {
+    return;
   }
+
+  // The lines of one direction do not share pixels, each thread works on its own lines with its own work arrays
+  joda::thread::StripeParallel::forEach(nLines - startLine, MIN_STRIPE_LENGTH, [&](int32_t stripeStart, int32_t stripeEnd) {
+    std::vector<float> cache(static_cast<size_t>(std::max(width, height)), 0.0F);    // work array for lineSlideParabola
+    std::vector<int> nextPoint(static_cast<size_t>(std::max(width, height)), 0);     // work array for lineSlideParabola
+    int lineLength = length;
+    for(int i = startLine + stripeStart; i < startLine + stripeEnd; i++) {
+      int startPixel = i * lineInc;
+      if(direction == DIAGONAL_2B) {
+        startPixel += width - 1;
+      }
+      switch(direction) {
+        case DIAGONAL_1A:
+          lineLength = std::min(height, width - i);
+          break;
+        case DIAGONAL_1B:
+          lineLength = std::min(width, height - i);
+          break;
+        case DIAGONAL_2A:
+          lineLength = std::min(height, i + 1);
+          break;
+        case DIAGONAL_2B:
+          lineLength = std::min(width, height - i);
+          break;
+      }
+      RollingBall::lineSlideParabola(fp, startPixel, pointInc, lineLength, coeff2, cache.data(), nextPoint.data(), nullptr);
+    }
+  });
 }    // void filter1D
 
 /// \brief Process one straight line in the image by sliding a parabola along the line
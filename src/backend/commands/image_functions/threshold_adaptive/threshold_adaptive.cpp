@@ -14,6 +14,7 @@
 #include "threshold_adaptive.hpp"
 #include <string>
 #include "backend/commands/image_functions/rank_filter/rank_filter_algo.hpp"
+#include "threshold_adaptive_algo.hpp"
 
 namespace joda::cmd {
 
@@ -51,22 +52,11 @@ void Bernsen(cv::Mat &imp, int radius, double par1, double /*par2*/, int32_t /*c
   }
 
   //
-  // Maximum
+  // Minimum and maximum
   //
-  auto ipMax = imp.clone();
-  {
-    algo::RankFilter rf;
-    rf.rank(ipMax, radius, algo::RankFilter::MAX);
-  }
-
-  //
-  // Minimum
-  //
-  auto ipMin = imp.clone();
-  {
-    algo::RankFilter rf;
-    rf.rank(ipMin, radius, algo::RankFilter::MIN);
-  }
+  cv::Mat ipMin;
+  cv::Mat ipMax;
+  algo::LocalThreshold::localMinMax(imp, radius, ipMin, ipMax);
 
   cv::Mat outImg = imp.clone();
   for(int i = 0; i < static_cast<int>(imp.total()); i++) {
@@ -102,22 +92,11 @@ void Contrast(cv::Mat &imp, int radius, double /*par1*/, double /*par2*/, int32_
   }
 
   //
-  // Maximum
-  //
-  auto ipMax = imp.clone();
-  {
-    algo::RankFilter rf;
-    rf.rank(ipMax, radius, algo::RankFilter::MAX);
-  }
-
-  //
-  // Minimum
+  // Minimum and maximum
   //
-  auto ipMin = imp.clone();
-  {
-    algo::RankFilter rf;
-    rf.rank(ipMin, radius, algo::RankFilter::MIN);
-  }
+  cv::Mat ipMin;
+  cv::Mat ipMax;
+  algo::LocalThreshold::localMinMax(imp, radius, ipMin, ipMax);
 
   cv::Mat outImg = imp.clone();
   for(int i = 0; i < static_cast<int>(imp.total()); i++) {
@@ -150,11 +129,8 @@ void Mean(cv::Mat &imp, int radius, double /*par1*/, double /*par2*/, int32_t c_
   //
   // Mean
   //
-  auto ipMean = imp.clone();
-  {
-    algo::RankFilter rf;
-    rf.rank(ipMean, radius, algo::RankFilter::MEAN);
-  }
+  cv::Mat ipMean;
+  algo::LocalThreshold::localMean(imp, radius, ipMean);
 
   cv::Mat outImg = imp.clone();
   for(int i = 0; i < static_cast<int>(imp.total()); i++) {
@@ -192,29 +168,12 @@ void Median(cv::Mat &imp, int radius, double /*par1*/, double /*par2*/, int32_t
   imp = outImg;
 }
 
-cv::Mat calcHistogram(const cv::Mat &charImg)
-{
-  // Calculate the histogram of the image
-  int histSize           = UINT16_MAX + 1;    // Number of bins
-  float range[]          = {0, 65536};        // Pixel value range
-  const float *histRange = {range};
-  cv::Mat histogram;
-  cv::calcHist(&charImg, 1, nullptr, cv::Mat(), histogram, 1, &histSize, &histRange);
-  return histogram;
-}
-
 void Otsu(cv::Mat &imp, int radius, double /*par1*/, double /*par2*/, int32_t /*c_value*/, bool doIwhite)
 {
   // Otsu's threshold algorithm
   // M. Emre Celebi 6.15.2007, Fourier Library https://sourceforge.net/projects/fourier-ipal/
-  // ported to ImageJ plugin by G.Landini. Same algorithm as in Auto_Threshold, this time for local circular regions
+  // ported to ImageJ plugin by G.Landini. Same algorithm as in Auto_Threshold, this time for local regions
 
-  cv::Mat data;
-  int w = imp.cols;
-  int h = imp.rows;
-  int position;
-  int radiusx2 = radius * 2;
-  cv::Mat pixelsOut(imp.size(), CV_16UC1);
   uint16_t object;
   uint16_t backg;
 
@@ -226,96 +185,13 @@ void Otsu(cv::Mat &imp, int radius, double /*par1*/, double /*par2*/, int32_t /*
     backg  = 0xffff;
   }
 
-  int ih;
-  int roiy;
-  static const int L = 65536;    // L is for 8bit images.
-  int threshold;
-  int num_pixels;
-  double total_mean;    // mean gray-level for the whole image
-  double bcv;
-  double term;            // between-class variance, scaling term
-  double max_bcv;         // max BCV
-  double cnh[65536];      // cumulative normalized histogram
-  double mean[65536];     // mean gray-level
-  double histo[65536];    // normalized histogram
-
-  // ip.setRoi(roi);
-  for(int y = 0; y < h; y++) {
-    roiy = y - radius;
-    for(int x = 0; x < w; x++) {
-      // Todo replace by OVAL
-      int roix = x - radius;
-      if(roix < 0) {
-        roix = 0;
-      }
-      if(roiy < 0) {
-        roiy = 0;
-      }
-      int radiusx2X = radius * 2;
-      int radiusx2Y = radius * 2;
-      if(roix + radiusx2 > w) {
-        radiusx2X = radiusx2X - (roix + radiusx2X - w);
-      }
-      if(roiy + radiusx2 > h) {
-        radiusx2Y = radiusx2Y - (roiy + radiusx2Y - h);
-      }
-
-      auto roi     = cv::Rect(roix, roiy, radiusx2X, radiusx2Y);
-      cv::Mat part = imp(roi);
-      // ip.setRoi(new OvalRoi(x-radius, roiy, radiusx2, radiusx2));
-      position = x + y * w;
-      data     = calcHistogram(part);
-
-      //----
-      // Calculate total numbre of pixels
-      num_pixels = 0;
-
-      for(ih = 0; ih < L; ih++) {
-        num_pixels = num_pixels + static_cast<int>(data.at<float>(ih));
-      }
-
-      term = 1.0 / static_cast<double>(num_pixels);
-
-      // Calculate the normalized histogram
-      for(ih = 0; ih < L; ih++) {
-        histo[ih] = term * static_cast<int>(data.at<float>(ih));
-      }
-
-      // Calculate the cumulative normalized histogram
-      cnh[0] = histo[0];
-      for(ih = 1; ih < L; ih++) {
-        cnh[ih] = cnh[ih - 1] + histo[ih];
-      }
-
-      mean[0] = 0.0;
-
-      for(ih = 0 + 1; ih < L; ih++) {
-        mean[ih] = mean[ih - 1] + ih * histo[ih];
-      }
-
-      total_mean = mean[L - 1];
+  cv::Mat thresholds;
+  algo::LocalThreshold::localOtsu(imp, radius, thresholds);
 
-      //	Calculate the BCV at each gray-level and find the threshold that maximizes it
-      threshold = 0;    // Integer.MIN_VALUE;
-      max_bcv   = 0.0;
-
-      for(ih = 0; ih < L; ih++) {
-        bcv = total_mean * cnh[ih] - mean[ih];
-        bcv *= bcv / (cnh[ih] * (1.0 - cnh[ih]));
-
-        if(max_bcv < bcv) {
-          max_bcv   = bcv;
-          threshold = ih;
-        }
-      }
-
-      // std::cout << "TH: " << std::to_string(threshold) << std::endl;
-      pixelsOut.at<uint16_t>(position) =
-          ((imp.at<uint16_t>(position) & 0xffff) > threshold || (imp.at<uint16_t>(position) & 0xffff) == 65535) ? object : backg;
-    }
-  }
-  for(position = 0; position < w * h; position++) {
-    imp.at<uint16_t>(position) = pixelsOut.at<uint16_t>(position);    // update with thresholded pixels
+  for(int position = 0; position < static_cast<int>(imp.total()); position++) {
+    imp.at<uint16_t>(position) =
+        ((imp.at<uint16_t>(position) & 0xffff) > thresholds.at<uint16_t>(position) || (imp.at<uint16_t>(position) & 0xffff) == 65535) ? object
+                                                                                                                                        : backg;
   }
 }
 
@@ -0,0 +1,371 @@
+///
+/// \file      threshold_adaptive_algo.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "threshold_adaptive_algo.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "backend/commands/image_functions/rank_filter/rank_filter_algo.hpp"
+#include "backend/commands/image_functions/rank_filter/rank_histogram.hpp"
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::algo {
+
+namespace {
+
+struct Minimum
+{
+  static constexpr uint16_t IDENTITY = UINT16_MAX;
+  static uint16_t best(uint16_t a, uint16_t b)
+  {
+    return std::min(a, b);
+  }
+};
+
+struct Maximum
+{
+  static constexpr uint16_t IDENTITY = 0;
+  static uint16_t best(uint16_t a, uint16_t b)
+  {
+    return std::max(a, b);
+  }
+};
+
+///
+/// \brief      Extreme of each window [i, i + window) of the line (van Herk/Gil-Werman).
+///             The line is split into blocks of the window size, each window covers the
+///             suffix of one block and the prefix of the next one.
+/// \param[in]  in      Line with length values
+/// \param[out] prefix  Buffer with length values
+/// \param[out] suffix  Buffer with length values
+/// \param[out] out     length - window + 1 values
+///
+template <class OP>
+void slidingExtreme(const uint16_t *in, int length, int window, uint16_t *prefix, uint16_t *suffix, uint16_t *out)
+{
+  for(int i = 0; i < length; i++) {
+    prefix[i] = (i % window == 0) ? in[i] : OP::best(prefix[i - 1], in[i]);
+  }
+  for(int i = length - 1; i >= 0; i--) {
+    suffix[i] = (i % window == window - 1 || i == length - 1) ? in[i] : OP::best(suffix[i + 1], in[i]);
+  }
+  for(int i = 0; i + window <= length; i++) {
+    out[i] = OP::best(suffix[i], prefix[i + window - 1]);
+  }
+}
+
+}    // namespace
+
+///
+/// \brief      Mean of the circular ImageJ kernel around each pixel.
+///             Same result as the MEAN rank filter: out of image pixels are
+///             the nearest edge pixels and the mean is rounded to 16 bit.
+/// \author     Joachim Danmayr
+/// \param[in]  image   16 bit image
+/// \param[in]  radius  Kernel radius
+/// \param[out] mean    16 bit image with the local means
+///
+void LocalThreshold::localMean(const cv::Mat &image, double radius, cv::Mat &mean)
+{
+  RankFilter rf;
+  size_t lineRadiiLength = 0;
+  auto lineRadii         = rf.makeLineRadii(radius, lineRadiiLength);
+  const int kHeight      = rf.kHeight(lineRadii.get(), lineRadiiLength);
+  const int kRadius      = rf.kRadius(lineRadii.get(), lineRadiiLength);
+  const int kNPoints     = rf.kNPoints(lineRadii.get(), lineRadiiLength);
+  const auto bands       = makeKernelBands(lineRadii.get(), kHeight, kRadius);
+
+  // Sums of integers are exact in double precision, the order of the additions does not matter
+  cv::Mat padded;
+  cv::copyMakeBorder(image, padded, kRadius, kRadius, kRadius, kRadius, cv::BORDER_REPLICATE);
+  cv::Mat sums;
+  cv::integral(padded, sums, CV_64F);
+
+  mean.create(image.size(), CV_16UC1);
+  joda::thread::StripeParallel::forEach(image.rows, MIN_STRIPE_HEIGHT, [&](int32_t yStart, int32_t yEnd) {
+    for(int y = yStart; y < yEnd; y++) {
+      auto *out = mean.ptr<uint16_t>(y);
+      for(int x = 0; x < image.cols; x++) {
+        double sum = 0;
+        for(const auto &band : bands) {
+          const auto *top    = sums.ptr<double>(y + band.top + kRadius);
+          const auto *bottom = sums.ptr<double>(y + band.bottom + kRadius + 1);
+          const int left     = x + band.left + kRadius;
+          const int right    = x + band.right + kRadius + 1;
+          sum += bottom[right] - top[right] - bottom[left] + top[left];
+        }
+        auto value = static_cast<float>(sum / kNPoints);
+        out[x]     = static_cast<uint16_t>(static_cast<int32_t>(value + 0.5F) & 0xffff);
+      }
+    }
+  });
+}
+
+///
+/// \brief      Otsu threshold of the window [x-radius, x+radius) x [y-radius, y+radius)
+///             around each pixel. At the image border the window is shifted into the
+///             image at the left/top edge and cut at the right/bottom edge.
+///             The histogram follows a zig-zag path, the between class variance is
+///             only evaluated for occupied bins which gives the same threshold as
+///             evaluating all 65536 gray levels.
+/// \author     Joachim Danmayr
+/// \param[in]  image       16 bit image
+/// \param[in]  radius      Half window size
+/// \param[out] thresholds  16 bit image with the threshold of each pixel
+///
+void LocalThreshold::localOtsu(const cv::Mat &image, int radius, cv::Mat &thresholds)
+{
+  struct Window
+  {
+    int x0 = 0;
+    int x1 = 0;
+    int y0 = 0;
+    int y1 = 0;
+  };
+
+  const int width  = image.cols;
+  const int height = image.rows;
+  double minVal    = 0;
+  double maxVal    = 0;
+  cv::minMaxLoc(image, &minVal, &maxVal);
+  const auto nrOfBins = static_cast<uint32_t>(maxVal) + 1;
+
+  auto windowOf = [radius, width, height](int x, int y) {
+    Window win;
+    win.x0 = std::max(x - radius, 0);
+    win.x1 = std::min(win.x0 + 2 * radius, width);
+    win.y0 = std::max(y - radius, 0);
+    win.y1 = std::min(win.y0 + 2 * radius, height);
+    return win;
+  };
+
+  thresholds.create(image.size(), CV_16UC1);
+  joda::thread::StripeParallel::forEach(height, MIN_STRIPE_HEIGHT, [&](int32_t yStart, int32_t yEnd) {
+    SlidingHistogram hist(nrOfBins, 8);
+    Window act;
+
+    auto update = [&image, &hist](int y0, int y1, int x0, int x1, bool add) {
+      for(int y = y0; y < y1; y++) {
+        const auto *row = image.ptr<uint16_t>(y);
+        for(int x = x0; x < x1; x++) {
+          if(add) {
+            hist.add(row[x]);
+          } else {
+            hist.remove(row[x]);
+          }
+        }
+      }
+    };
+
+    // Removes the lines which are not part of the new window and adds the new ones
+    auto moveTo = [&](const Window &next) {
+      update(act.y0, std::min(act.y1, next.y0), act.x0, act.x1, false);
+      update(std::max(act.y0, next.y1), act.y1, act.x0, act.x1, false);
+      update(next.y0, std::min(next.y1, act.y0), act.x0, act.x1, true);
+      update(std::max(next.y0, act.y1), next.y1, act.x0, act.x1, true);
+      act.y0 = next.y0;
+      act.y1 = next.y1;
+      update(act.y0, act.y1, act.x0, std::min(act.x1, next.x0), false);
+      update(act.y0, act.y1, std::max(act.x0, next.x1), act.x1, false);
+      update(act.y0, act.y1, next.x0, std::min(next.x1, act.x0), true);
+      update(act.y0, act.y1, std::max(next.x0, act.x1), next.x1, true);
+      act.x0 = next.x0;
+      act.x1 = next.x1;
+    };
+
+    auto otsu = [&hist, &act]() -> uint16_t {
+      const int numPixels = (act.x1 - act.x0) * (act.y1 - act.y0);
+      const double term   = 1.0 / static_cast<double>(numPixels);
+      double totalMean    = 0;
+      hist.forEachBin([&](uint32_t bin, int32_t cnt) { totalMean += static_cast<double>(bin) * (term * cnt); });
+
+      double cnh     = 0;    // cumulative normalized histogram
+      double mean    = 0;
+      double maxBcv  = 0;
+      auto threshold = 0U;
+      hist.forEachBin([&](uint32_t bin, int32_t cnt) {
+        const double histo = term * cnt;
+        cnh += histo;
+        mean += static_cast<double>(bin) * histo;
+        double bcv = totalMean * cnh - mean;
+        bcv *= bcv / (cnh * (1.0 - cnh));
+        if(maxBcv < bcv) {
+          maxBcv    = bcv;
+          threshold = bin;
+        }
+      });
+      return static_cast<uint16_t>(threshold);
+    };
+
+    for(int y = yStart; y < yEnd; y++) {
+      auto *out = thresholds.ptr<uint16_t>(y);
+      if((y - yStart) % 2 == 0) {
+        for(int x = 0; x < width; x++) {
+          moveTo(windowOf(x, y));
+          out[x] = otsu();
+        }
+      } else {
+        for(int x = width - 1; x >= 0; x--) {
+          moveTo(windowOf(x, y));
+          out[x] = otsu();
+        }
+      }
+    }
+  });
+}
+
+///
+/// \brief      Combines the extreme of the rectangle around each pixel with the value in out.
+///             Separated in a horizontal and a vertical pass, the vertical pass works on
+///             whole lines so the memory is read in order.
+/// \param[in]  padded  Image padded by border pixels on each side
+/// \param[in]  rect    Rectangle relative to the pixel
+/// \param[out] lines   Buffer for the horizontal pass
+/// \param[out] prefix  Buffer for the vertical pass
+/// \param[out] out     Extreme of each pixel of the unpadded image
+///
+template <class OP>
+void LocalThreshold::rectangleExtreme(const cv::Mat &padded, int border, const KernelBand &rect, cv::Mat &lines, cv::Mat &prefix, cv::Mat &out)
+{
+  const int width   = out.cols;
+  const int height  = out.rows;
+  const int windowX = rect.right - rect.left + 1;
+  const int windowY = rect.bottom - rect.top + 1;
+  const int nrLines = height + windowY - 1;
+
+  joda::thread::StripeParallel::forEach(nrLines, MIN_STRIPE_HEIGHT, [&](int32_t start, int32_t end) {
+    const int length = width + windowX - 1;
+    std::vector<uint16_t> linePrefix(static_cast<size_t>(length));
+    std::vector<uint16_t> lineSuffix(static_cast<size_t>(length));
+    for(int n = start; n < end; n++) {
+      const auto *in = padded.ptr<uint16_t>(n + border + rect.top) + border + rect.left;
+      slidingExtreme<OP>(in, length, windowX, linePrefix.data(), lineSuffix.data(), lines.ptr<uint16_t>(n));
+    }
+  });
+
+  joda::thread::StripeParallel::forEach(width, MIN_STRIPE_HEIGHT, [&](int32_t xStart, int32_t xEnd) {
+    for(int n = 0; n < nrLines; n++) {
+      const auto *line = lines.ptr<uint16_t>(n);
+      auto *pre        = prefix.ptr<uint16_t>(n);
+      if(n % windowY == 0) {
+        std::copy(line + xStart, line + xEnd, pre + xStart);
+      } else {
+        const auto *last = prefix.ptr<uint16_t>(n - 1);
+        for(int x = xStart; x < xEnd; x++) {
+          pre[x] = OP::best(last[x], line[x]);
+        }
+      }
+    }
+    // The suffixes replace the lines, each line is only read before it is overwritten
+    for(int n = nrLines - 2; n >= 0; n--) {
+      if(n % windowY != windowY - 1) {
+        const auto *next = lines.ptr<uint16_t>(n + 1);
+        auto *line       = lines.ptr<uint16_t>(n);
+        for(int x = xStart; x < xEnd; x++) {
+          line[x] = OP::best(next[x], line[x]);
+        }
+      }
+    }
+    for(int y = 0; y < height; y++) {
+      const auto *suf = lines.ptr<uint16_t>(y);
+      const auto *pre = prefix.ptr<uint16_t>(y + windowY - 1);
+      auto *result    = out.ptr<uint16_t>(y);
+      for(int x = xStart; x < xEnd; x++) {
+        result[x] = OP::best(result[x], OP::best(suf[x], pre[x]));
+      }
+    }
+  });
+}
+
+///
+/// \brief      Min and max of the circular ImageJ kernel around each pixel.
+///             Same result as the MIN and MAX rank filter, out of image pixels
+///             are the nearest edge pixels. The cost per pixel depends on the
+///             number of different line lengths of the kernel only, not on the
+///             number of kernel pixels.
+/// \author     Joachim Danmayr
+/// \param[in]  image   16 bit image
+/// \param[in]  radius  Kernel radius
+/// \param[out] min     16 bit image with the local minimums
+/// \param[out] max     16 bit image with the local maximums
+///
+void LocalThreshold::localMinMax(const cv::Mat &image, double radius, cv::Mat &min, cv::Mat &max)
+{
+  RankFilter rf;
+  size_t lineRadiiLength = 0;
+  auto lineRadii         = rf.makeLineRadii(radius, lineRadiiLength);
+  const int kHeight      = rf.kHeight(lineRadii.get(), lineRadiiLength);
+  const int kRadius      = rf.kRadius(lineRadii.get(), lineRadiiLength);
+
+  cv::Mat padded;
+  cv::copyMakeBorder(image, padded, kRadius, kRadius, kRadius, kRadius, cv::BORDER_REPLICATE);
+  cv::Mat lines(image.rows + kHeight - 1, image.cols, CV_16UC1);
+  cv::Mat prefix(image.rows + kHeight - 1, image.cols, CV_16UC1);
+
+  min = cv::Mat(image.size(), CV_16UC1, cv::Scalar(Minimum::IDENTITY));
+  max = cv::Mat(image.size(), CV_16UC1, cv::Scalar(Maximum::IDENTITY));
+  for(const auto &rect : makeKernelRectangles(lineRadii.get(), kHeight, kRadius)) {
+    rectangleExtreme<Minimum>(padded, kRadius, rect, lines, prefix, min);
+    rectangleExtreme<Maximum>(padded, kRadius, rect, lines, prefix, max);
+  }
+}
+
+///
+/// \brief      Joins consecutive kernel lines with the same extend to rectangles.
+///             Each rectangle costs four lookups in the summed area table.
+/// \author     Joachim Danmayr
+///
+auto LocalThreshold::makeKernelBands(const int *lineRadii, int kHeight, int kRadius) -> std::vector<KernelBand>
+{
+  std::vector<KernelBand> bands;
+  for(int i = 0; i < kHeight; i++) {
+    const int dy    = i - kRadius;
+    const int left  = lineRadii[2 * i];
+    const int right = lineRadii[2 * i + 1];
+    if(!bands.empty() && bands.back().left == left && bands.back().right == right) {
+      bands.back().bottom = dy;
+    } else {
+      bands.push_back({.top = dy, .bottom = dy, .left = left, .right = right});
+    }
+  }
+  return bands;
+}
+
+///
+/// \brief      Covers the kernel with one rectangle per different line extend. Each
+///             rectangle reaches over all kernel lines containing this extend, for
+///             the convex ImageJ kernels these lines are consecutive.
+/// \author     Joachim Danmayr
+///
+auto LocalThreshold::makeKernelRectangles(const int *lineRadii, int kHeight, int kRadius) -> std::vector<KernelBand>
+{
+  std::vector<KernelBand> rectangles;
+  for(const auto &band : makeKernelBands(lineRadii, kHeight, kRadius)) {
+    auto it = std::find_if(rectangles.begin(), rectangles.end(),
+                           [&band](const KernelBand &rect) { return rect.left == band.left && rect.right == band.right; });
+    if(it != rectangles.end()) {
+      continue;
+    }
+    KernelBand rect{.top = kRadius, .bottom = -kRadius, .left = band.left, .right = band.right};
+    for(int i = 0; i < kHeight; i++) {
+      if(lineRadii[2 * i] <= band.left && lineRadii[2 * i + 1] >= band.right) {
+        rect.top    = std::min(rect.top, i - kRadius);
+        rect.bottom = std::max(rect.bottom, i - kRadius);
+      }
+    }
+    rectangles.push_back(rect);
+  }
+  return rectangles;
+}
+
+}    // namespace joda::algo
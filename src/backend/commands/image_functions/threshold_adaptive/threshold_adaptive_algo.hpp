@@ -0,0 +1,64 @@
+///
+/// \file      threshold_adaptive_algo.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Local statistics for the adaptive thresholds
+///
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::algo {
+
+///
+/// \class      LocalThreshold
+/// \author     Joachim Danmayr
+/// \brief      Per pixel statistics of a 16 bit image used by the adaptive
+///             threshold methods. The means are read from a summed area table
+///             instead of summing up the kernel area. The Otsu thresholds are
+///             calculated from a histogram which is moved over the image, only
+///             the pixels entering and leaving the window are updated. Min and
+///             max are taken over the rectangles the kernel is made of, each
+///             rectangle with the van Herk/Gil-Werman algorithm.
+///
+class LocalThreshold
+{
+public:
+  /////////////////////////////////////////////////////
+  static void localMean(const cv::Mat &image, double radius, cv::Mat &mean);
+  static void localOtsu(const cv::Mat &image, int radius, cv::Mat &thresholds);
+  static void localMinMax(const cv::Mat &image, double radius, cv::Mat &min, cv::Mat &max);
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr int32_t MIN_STRIPE_HEIGHT = 32;
+
+  ///
+  /// \brief      Rectangle of consecutive kernel lines with the same extend
+  ///
+  struct KernelBand
+  {
+    int top;
+    int bottom;
+    int left;
+    int right;
+  };
+
+  /////////////////////////////////////////////////////
+  static auto makeKernelBands(const int *lineRadii, int kHeight, int kRadius) -> std::vector<KernelBand>;
+  static auto makeKernelRectangles(const int *lineRadii, int kHeight, int kRadius) -> std::vector<KernelBand>;
+  template <class OP>
+  static void rectangleExtreme(const cv::Mat &padded, int border, const KernelBand &rect, cv::Mat &lines, cv::Mat &prefix, cv::Mat &out);
+};
+
+}    // namespace joda::algo
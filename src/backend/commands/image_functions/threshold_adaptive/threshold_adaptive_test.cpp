@@ -0,0 +1,146 @@
+///
+/// \file      threshold_adaptive_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "backend/commands/image_functions/rank_filter/rank_filter_algo.hpp"
+#include "backend/commands/image_functions/threshold_adaptive/threshold_adaptive_algo.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::test {
+
+namespace {
+
+///
+/// \brief  Otsu threshold of one window, calculated the way it was done before
+///         the sliding histogram (full 16 bit histogram per pixel).
+///
+int referenceOtsu(const cv::Mat &imp, int x, int y, int radius)
+{
+  static constexpr int L = 65536;
+  int roix               = std::max(x - radius, 0);
+  int roiy               = std::max(y - radius, 0);
+  int radiusx2X          = std::min(2 * radius, imp.cols - roix);
+  int radiusx2Y          = std::min(2 * radius, imp.rows - roiy);
+
+  std::vector<int> data(L, 0);
+  for(int yy = roiy; yy < roiy + radiusx2Y; yy++) {
+    for(int xx = roix; xx < roix + radiusx2X; xx++) {
+      data[imp.at<uint16_t>(yy, xx)]++;
+    }
+  }
+  int numPixels = 0;
+  for(int ih = 0; ih < L; ih++) {
+    numPixels += data[ih];
+  }
+  double term = 1.0 / static_cast<double>(numPixels);
+  std::vector<double> histo(L);
+  std::vector<double> cnh(L);
+  std::vector<double> mean(L);
+  for(int ih = 0; ih < L; ih++) {
+    histo[ih] = term * data[ih];
+  }
+  cnh[0] = histo[0];
+  for(int ih = 1; ih < L; ih++) {
+    cnh[ih] = cnh[ih - 1] + histo[ih];
+  }
+  mean[0] = 0.0;
+  for(int ih = 1; ih < L; ih++) {
+    mean[ih] = mean[ih - 1] + ih * histo[ih];
+  }
+  double totalMean = mean[L - 1];
+  int threshold    = 0;
+  double maxBcv    = 0.0;
+  for(int ih = 0; ih < L; ih++) {
+    double bcv = totalMean * cnh[ih] - mean[ih];
+    bcv *= bcv / (cnh[ih] * (1.0 - cnh[ih]));
+    if(maxBcv < bcv) {
+      maxBcv    = bcv;
+      threshold = ih;
+    }
+  }
+  return threshold;
+}
+
+cv::Mat createTestImage(int maxValue)
+{
+  cv::Mat image(24, 32, CV_16UC1);
+  cv::randu(image, cv::Scalar(0), cv::Scalar(maxValue));
+  cv::rectangle(image, cv::Rect(16, 0, 16, 24), cv::Scalar(maxValue / 2), -1);
+  cv::circle(image, {8, 12}, 5, cv::Scalar(maxValue - 1), -1);
+  return image;
+}
+
+bool isEqual(const cv::Mat &a, const cv::Mat &b)
+{
+  cv::Mat diff;
+  cv::compare(a, b, diff, cv::CMP_NE);
+  return cv::countNonZero(diff) == 0;
+}
+
+}    // namespace
+
+///
+/// \brief  Local statistics must give the same results as the previous implementation
+/// \author Joachim Danmayr
+///
+TEST_CASE("threshold_adaptive::local_statistics", "[threshold_adaptive]")
+{
+  for(int maxValue : {200, 65536}) {
+    const cv::Mat image = createTestImage(maxValue);
+    for(int radius : {1, 3, 9}) {
+      SECTION("Mean equals mean rank filter, radius " + std::to_string(radius) + ", max " + std::to_string(maxValue))
+      {
+        cv::Mat mean;
+        joda::algo::LocalThreshold::localMean(image, radius, mean);
+        cv::Mat reference = image.clone();
+        joda::algo::RankFilter rf;
+        rf.rank(reference, radius, joda::algo::RankFilter::MEAN);
+        CHECK(isEqual(mean, reference));
+      }
+
+      SECTION("Min and max equal min and max rank filter, radius " + std::to_string(radius) + ", max " + std::to_string(maxValue))
+      {
+        cv::Mat min;
+        cv::Mat max;
+        joda::algo::LocalThreshold::localMinMax(image, radius, min, max);
+        cv::Mat referenceMin = image.clone();
+        cv::Mat referenceMax = image.clone();
+        joda::algo::RankFilter rf;
+        rf.rank(referenceMin, radius, joda::algo::RankFilter::MIN);
+        rf.rank(referenceMax, radius, joda::algo::RankFilter::MAX);
+        CHECK(isEqual(min, referenceMin));
+        CHECK(isEqual(max, referenceMax));
+      }
+
+      SECTION("Otsu equals full histogram Otsu, radius " + std::to_string(radius) + ", max " + std::to_string(maxValue))
+      {
+        cv::Mat thresholds;
+        joda::algo::LocalThreshold::localOtsu(image, radius, thresholds);
+        int differences = 0;
+        for(int y = 0; y < image.rows; y++) {
+          for(int x = 0; x < image.cols; x++) {
+            if(thresholds.at<uint16_t>(y, x) != referenceOtsu(image, x, y, radius)) {
+              differences++;
+            }
+          }
+        }
+        CHECK(differences == 0);
+      }
+    }
+  }
+}
+
+}    // namespace joda::test
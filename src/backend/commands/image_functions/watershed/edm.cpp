@@ -32,30 +32,34 @@
 ///          "watershed" for watershed segmentation, "points" for ultimate eroded points and
 ///          "voronoi" for Voronoi segmentation of the background
 ///
-///          The EDM algorithm is similar to the 8SSEDT in
-///          F. Leymarie, M. D. Levine, in: CVGIP Image Understanding, vol. 55 (1992), pp 84-94
-///          http://dx.doi.org/10.1016/1049-9660(92)90008-Q
-///
-///          The algorithm provides a fast approximation of the EDM, with the deviation from a
-///          full calculation being between -0.09 and 0. The algorithm is exact for distances<13.
-///          For d>=13, deviations from the true result can occur, but are very rare: typically
-///          the fraction of pixels deviating from the exact result is in the 10^-5 range, with
-///          most deviations between -0.03 and -0.04.
+///          The EDM is the exact Euclidean distance transform of
+///          P. F. Felzenszwalb, D. P. Huttenlocher, in: Theory of Computing, vol. 8 (2012), pp 415-428
+///          http://dx.doi.org/10.4086/toc.2012.v008a019
+///          First the distance to the nearest background pixel in the same column is calculated,
+///          then the lower envelope of the parabolas (x-x')^2+d(x')^2 is evaluated along each row.
+///          Both passes are independent for each column respectively row and run in parallel stripes.
+///          The imageJ 8SSEDT approximation deviates from this result by at most -0.09.
 ///
 ///          Limitations:
-///          Maximum image diagonal for EDM: 46340 pixels (sqrt(2^31)); if the particles are
-///          dense enough it also works for width, height <=65534.
+///          Squared distances are calculated in double precision, there is no limit for the
+///          image size besides memory.
 ///
 ///          Version 30-Apr-2008 Michael Schmid:  more accurate EDM algorithm,
 ///                                             16-bit and float output possible,
 ///                                             parallel processing for stacks
 ///                                             Voronoi output added
 ///          Version 29-Mar-2024 Joachim Danmayr Ported to C++
+///          Version 18-Oct-2026 Joachim Danmayr Exact separable EDM in parallel stripes
 /// \see  <a href="https://imagej.net/plugins/adjustable-watershed/adjustable-watershed">Adjustable Watershed
 ///        plugin</a>
 ///
 
 #include "edm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
 #include <opencv2/core/hal/interface.h>
 #include <opencv2/core.hpp>
 #include <opencv2/core/cvstd.hpp>
@@ -70,146 +74,122 @@ namespace joda::image::func {
  *                          Note: for pixel value 255, write either -1 or (uint8_t)255.
  * @param edgesAreBackground Whether out-of-image pixels are considered background
  * @return                  The EDM, containing the distances to the nearest background pixel.
- *                          Returns null if the thread is interrupted.
+ *                          Pixels without any background pixel in the image are set to sqrt(INT_MAX).
  */
 cv::Mat Edm::makeFloatEDM(cv::Mat &ip, int backgroundValue, bool edgesAreBackground)
 {
   int width  = ip.cols;
   int height = ip.rows;
-  cv::Mat fp = cv::Mat::zeros(height, width, CV_32FC1);
+  cv::Mat fp(height, width, CV_32FC1);
+  cv::Mat colDist(height, width, CV_32SC1);    // distance to the nearest background pixel in the same column
 
-  for(int i = 0; i < width * height; i++) {
-    if(ip.at<uint8_t>(i) != backgroundValue) {
-      fp.at<float>(i) = std::numeric_limits<float>::max();
-    }
-  }
-  int **pointBufs = new int *[2];    // two buffers for two passes; low short contains x, high short y
-  for(int i = 0; i < 2; ++i) {
-    pointBufs[i] = new int[width];
-  }
+  // pass 1: columns, a stripe is a range of columns which is walked top down and bottom up
+  joda::thread::StripeParallel::forEach(width, MIN_STRIPE_LENGTH, [&](int32_t xStart, int32_t xEnd) {
+    columnDistances(ip, colDist, backgroundValue, edgesAreBackground, xStart, xEnd);
+  });
 
-  int yDist = std::numeric_limits<int>::max();    // this value is used only if edges are not background
-  // pass 1 & 2: increasing y
-  for(int x = 0; x < width; x++) {
-    pointBufs[0][x] = NO_POINT;
-    pointBufs[1][x] = NO_POINT;
-  }
-  for(int y = 0; y < height; y++) {
-    if(edgesAreBackground) {
-      yDist = y + 1;    // distance to nearest background point (along y)
+  // pass 2: rows
+  joda::thread::StripeParallel::forEach(height, MIN_STRIPE_LENGTH, [&](int32_t yStart, int32_t yEnd) {
+    std::vector<int> vertices(static_cast<size_t>(width));
+    std::vector<double> bounds(static_cast<size_t>(width) + 1);
+    for(int y = yStart; y < yEnd; y++) {
+      rowDistances(colDist, fp, edgesAreBackground, y, vertices.data(), bounds.data());
     }
-    edmLine(ip, fp, pointBufs, width, y * width, y, backgroundValue, yDist);
-  }
-  // pass 3 & 4: decreasing y
-  for(int x = 0; x < width; x++) {
-    pointBufs[0][x] = NO_POINT;
-    pointBufs[1][x] = NO_POINT;
-  }
-  for(int y = height - 1; y >= 0; y--) {
-    if(edgesAreBackground) {
-      yDist = height - y;
-    }
-    edmLine(ip, fp, pointBufs, width, y * width, y, backgroundValue, yDist);
-  }
-
-  // Cleanup
-  for(int i = 0; i < 2; ++i) {
-    delete[] pointBufs[i];
-  }
+  });
 
-  delete[] pointBufs;
-
-  cv::sqrt(fp, fp);
   return fp;
 }    //  FloatProcessor makeFloatEDM
 
 ///
-/// \brief      Handle a line; two passes: left-to-right and right-to-left
+/// \brief      Distance to the nearest background pixel in the same column for the columns [xStart, xEnd).
+///             Out of image pixels at y=-1 and y=height are background if edgesAreBackground is set.
 ///
-void Edm::edmLine(cv::Mat &bPixels, cv::Mat &fPixels, int **pointBufs, int width, int offset, int y, int backgroundValue, int yDist)
+void Edm::columnDistances(const cv::Mat &ip, cv::Mat &colDist, int backgroundValue, bool edgesAreBackground, int xStart, int xEnd)
 {
-  int *points = pointBufs[0];    // the buffer for the left-to-right pass
-  int pPrev   = NO_POINT;
-  int pDiag   = NO_POINT;    // point at (-/+1, -/+1) to current one (-1,-1 in the first pass)
-  int pNextDiag;
-  bool edgesAreBackground = yDist != std::numeric_limits<int>::max();
-  int distSqr             = std::numeric_limits<int>::max();    // this value is used only if edges are not background
-  for(int x = 0; x < width; x++, offset++) {
-    pNextDiag = points[x];
-    if(bPixels.at<uint8_t>(offset) == backgroundValue) {
-      points[x] = x | y << 16;    // remember coordinates as a candidate for nearest background point
-    } else {                      // foreground pixel:
-      if(edgesAreBackground) {
-        distSqr = (x + 1 < yDist) ? (x + 1) * (x + 1) : yDist * yDist;    // distance from edge
+  const int height = ip.rows;
+  const int edge   = edgesAreBackground ? 0 : NO_DISTANCE;
+  std::vector<int> dist(static_cast<size_t>(xEnd - xStart), edge);
+
+  for(int y = 0; y < height; y++) {    // top down
+    const auto *in = ip.ptr<uint8_t>(y);
+    auto *out      = colDist.ptr<int32_t>(y);
+    for(int x = xStart; x < xEnd; x++) {
+      int &d = dist[x - xStart];
+      if(in[x] == backgroundValue) {
+        d = 0;
+      } else if(d != NO_DISTANCE) {
+        d++;
       }
-      float dist2 = minDist2(points, pPrev, pDiag, x, y, distSqr);
-      if(fPixels.at<float>(offset) > dist2)
-        fPixels.at<float>(offset) = dist2;
+      out[x] = d;
     }
-    pPrev = points[x];
-    pDiag = pNextDiag;
   }
-  offset--;                 // now points to the last pixel in the line
-  points = pointBufs[1];    // the buffer for the right-to-left pass. Low short contains x, high short y
-  pPrev  = NO_POINT;
-  pDiag  = NO_POINT;
-  for(int x = width - 1; x >= 0; x--, offset--) {
-    pNextDiag = points[x];
-    if(bPixels.at<uint8_t>(offset) == backgroundValue) {
-      points[x] = x | y << 16;    // remember coordinates as a candidate for nearest background point
-    } else {                      // foreground pixel:
-      if(edgesAreBackground) {
-        distSqr = (width - x < yDist) ? (width - x) * (width - x) : yDist * yDist;
+
+  std::fill(dist.begin(), dist.end(), edge);
+  for(int y = height - 1; y >= 0; y--) {    // bottom up
+    auto *out = colDist.ptr<int32_t>(y);
+    for(int x = xStart; x < xEnd; x++) {
+      int &d = dist[x - xStart];
+      if(out[x] == 0) {
+        d = 0;
+      } else if(d != NO_DISTANCE) {
+        d++;
       }
-      float dist2 = minDist2(points, pPrev, pDiag, x, y, distSqr);
-      if(fPixels.at<float>(offset) > dist2) {
-        fPixels.at<float>(offset) = dist2;
+      if(d < out[x]) {
+        out[x] = d;
       }
     }
-    pPrev = points[x];
-    pDiag = pNextDiag;
   }
-}    // private void edmLine
+}
 
 ///
-/// \brief Calculates minimum distance^2 of x,y from the following three points:
-///         - points[x] (nearest point found for previous line, same x)
-///         - pPrev (nearest point found for same line, previous x), and
-///         - pDiag (nearest point found for diagonal, i.e., previous line, previous x)
-///        Sets array element points[x] to the coordinates of the point having the minimum distance to x,y
-///        If the distSqr parameter is lower than the distance^2, then distSqr is used
-///        Returns to the minimum distance^2 obtained
+/// \brief      Squared distance of each pixel in row y is the minimum of (x-x')^2+colDist(x')^2
+///             over all x'. This is the lower envelope of parabolas, each column with a background
+///             pixel adds one parabola. The result is stored as distance in fp.
+/// \param[in]  vertices  Buffer of width elements, x' of the parabolas of the envelope
+/// \param[in]  bounds    Buffer of width+1 elements, x where the envelope switches to the next parabola
 ///
-float Edm::minDist2(int *points, int pPrev, int pDiag, int x, int y, int distSqr)
+void Edm::rowDistances(const cv::Mat &colDist, cv::Mat &fp, bool edgesAreBackground, int y, int *vertices, double *bounds)
 {
-  int p0           = points[x];    // the nearest background point for the same x in the previous line
-  int nearestPoint = p0;
-  if(p0 != NO_POINT) {
-    int x0       = p0 & 0xffff;
-    int y0       = (p0 >> 16) & 0xffff;
-    int dist1Sqr = (x - x0) * (x - x0) + (y - y0) * (y - y0);
-    if(dist1Sqr < distSqr)
-      distSqr = dist1Sqr;
-  }
-  if(pDiag != p0 && pDiag != NO_POINT) {
-    int x1       = pDiag & 0xffff;
-    int y1       = (pDiag >> 16) & 0xffff;
-    int dist1Sqr = (x - x1) * (x - x1) + (y - y1) * (y - y1);
-    if(dist1Sqr < distSqr) {
-      nearestPoint = pDiag;
-      distSqr      = dist1Sqr;
+  const int width = colDist.cols;
+  const auto *f   = colDist.ptr<int32_t>(y);
+  auto *out       = fp.ptr<float>(y);
+  auto parabola   = [f](int x) { return static_cast<double>(f[x]) * static_cast<double>(f[x]) + static_cast<double>(x) * static_cast<double>(x); };
+
+  int k = -1;    // index of the rightmost parabola of the envelope
+  for(int q = 0; q < width; q++) {
+    if(f[q] == NO_DISTANCE) {
+      continue;
+    }
+    double s = -std::numeric_limits<double>::infinity();
+    while(k >= 0) {
+      s = (parabola(q) - parabola(vertices[k])) / (2.0 * (q - vertices[k]));
+      if(s > bounds[k]) {
+        break;
+      }
+      k--;
     }
+    k++;
+    vertices[k]   = q;
+    bounds[k]     = k == 0 ? -std::numeric_limits<double>::infinity() : s;
+    bounds[k + 1] = std::numeric_limits<double>::infinity();
   }
-  if(pPrev != pDiag && pPrev != NO_POINT) {
-    int x1       = pPrev & 0xffff;
-    int y1       = (pPrev >> 16) & 0xffff;
-    int dist1Sqr = (x - x1) * (x - x1) + (y - y1) * (y - y1);
-    if(dist1Sqr < distSqr) {
-      nearestPoint = pPrev;
-      distSqr      = dist1Sqr;
+
+  for(int x = 0, n = 0; x < width; x++) {
+    double distSqr = std::numeric_limits<int>::max();    // no background pixel at all
+    if(k >= 0) {
+      while(bounds[n + 1] < x) {
+        n++;
+      }
+      const double dx = x - vertices[n];
+      const double dy = f[vertices[n]];
+      distSqr         = dx * dx + dy * dy;
     }
+    if(edgesAreBackground) {
+      const double dx = std::min(x + 1, width - x);
+      distSqr         = std::min(distSqr, dx * dx);
+    }
+    out[x] = std::sqrt(static_cast<float>(distSqr));
   }
-  points[x] = nearestPoint;
-  return static_cast<float>(distSqr);
-}    // private float minDist2
+}
+
 }    // namespace joda::image::func
@@ -6,10 +6,13 @@
 /// \date      2023-02-20
 /// \brief     C++ implementation of edm algorithmr ported from imageJ
 ///            https://github.com/imagej/ImageJ/blob/master/ij/plugin/filter/EDM.java
+///            The distances are calculated with the exact separable transform of
+///            Felzenszwalb and Huttenlocher instead of the 8SSEDT approximation.
 ///
 
 #pragma once
 
+#include <cstdint>
 #include <opencv2/core/mat.hpp>
 
 namespace joda::image::func {
@@ -19,13 +22,15 @@ class Edm
 public:
   /////////////////////////////////////////////////////
   static cv::Mat makeFloatEDM(cv::Mat &ip, int backgroundValue, bool edgesAreBackground);
-  static void edmLine(cv::Mat &bPixels, cv::Mat &fPixels, int **pointBufs, int width, int offset, int y,
-                      int backgroundValue, int yDist);
-  static float minDist2(int *points, int pPrev, int pDiag, int x, int y, int distSqr);
 
 private:
   /////////////////////////////////////////////////////
-  static inline int NO_POINT = -1;    // no nearest point in array of nearest points
+  static void columnDistances(const cv::Mat &ip, cv::Mat &colDist, int backgroundValue, bool edgesAreBackground, int xStart, int xEnd);
+  static void rowDistances(const cv::Mat &colDist, cv::Mat &fp, bool edgesAreBackground, int y, int *vertices, double *bounds);
+
+  /////////////////////////////////////////////////////
+  static constexpr int32_t MIN_STRIPE_LENGTH = 32;
+  static constexpr int32_t NO_DISTANCE       = INT32_MAX;    // no background pixel in this column
 };
 
 }    // namespace joda::image::func
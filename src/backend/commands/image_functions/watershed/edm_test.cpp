@@ -0,0 +1,78 @@
+///
+/// \file      edm_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "backend/commands/image_functions/watershed/edm.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+namespace joda::test {
+
+namespace {
+
+///
+/// \brief  Distance to the nearest background pixel by checking all background pixels
+///
+cv::Mat referenceEdm(const cv::Mat &binary, bool edgesAreBackground)
+{
+  std::vector<cv::Point> background;
+  cv::findNonZero(binary == 0, background);
+
+  cv::Mat edm(binary.size(), CV_32FC1);
+  for(int y = 0; y < binary.rows; y++) {
+    for(int x = 0; x < binary.cols; x++) {
+      double distSqr = std::numeric_limits<int>::max();
+      for(const auto &pt : background) {
+        distSqr = std::min(distSqr, static_cast<double>((x - pt.x) * (x - pt.x) + (y - pt.y) * (y - pt.y)));
+      }
+      if(edgesAreBackground) {
+        const double dx = std::min(x + 1, binary.cols - x);
+        const double dy = std::min(y + 1, binary.rows - y);
+        distSqr         = std::min({distSqr, dx * dx, dy * dy});
+      }
+      edm.at<float>(y, x) = std::sqrt(static_cast<float>(distSqr));
+    }
+  }
+  return edm;
+}
+
+}    // namespace
+
+///
+/// \brief  The EDM must be the exact Euclidean distance
+/// \author Joachim Danmayr
+///
+TEST_CASE("watershed::edm", "[watershed]")
+{
+  cv::Mat binary(97, 131, CV_8UC1);
+  cv::RNG rng(7);
+  rng.fill(binary, cv::RNG::UNIFORM, 0, 1000);
+  binary = binary > 2;    // A few background pixels, large distances in between
+
+  for(bool edgesAreBackground : {false, true}) {
+    auto edm       = joda::image::func::Edm::makeFloatEDM(binary, 0, edgesAreBackground);
+    auto reference = referenceEdm(binary, edgesAreBackground);
+    CHECK(cv::norm(edm, reference, cv::NORM_INF) == 0);
+  }
+
+  SECTION("Image without background")
+  {
+    cv::Mat foreground(16, 16, CV_8UC1, cv::Scalar(255));
+    auto edm = joda::image::func::Edm::makeFloatEDM(foreground, 0, true);
+    CHECK(edm.at<float>(8, 8) == 8.0F);
+  }
+}
+
+}    // namespace joda::test
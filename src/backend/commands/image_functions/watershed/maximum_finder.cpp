@@ -47,6 +47,8 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include "backend/helper/threading/stripe_parallel.hpp"
 #include <opencv2/core.hpp>
 #include <opencv2/core/types.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -327,19 +329,11 @@ cv::Mat MaximumFinder::findMaxima(cv::Mat &ip, double tolerance, bool strict, do
   //   threshold = ip.getCalibrationTable()[(int) threshold];    // convert threshold to calibrated
   // }
   cv::Mat typeP   = cv::Mat::zeros(height, width, CV_8UC1);    // will be a notepad for pixel types
-  float globalMin = std::numeric_limits<float>::max();
-  float globalMax = -std::numeric_limits<float>::max();
-  for(int y = 0; y < ip.rows; y++) {      // find local minimum/maximum now
-    for(int x = 0; x < ip.cols; x++) {    // ImageStatistics won't work if we have no ImagePlus
-      float v = ip.at<float>(y, x);
-      if(globalMin > v) {
-        globalMin = v;
-      }
-      if(globalMax < v) {
-        globalMax = v;
-      }
-    }
-  }
+  double minVal = 0;
+  double maxVal = 0;
+  cv::minMaxLoc(ip, &minVal, &maxVal);    // ImageStatistics won't work if we have no ImagePlus
+  auto globalMin = static_cast<float>(minVal);
+  auto globalMax = static_cast<float>(maxVal);
   bool maximumPossible = globalMax > globalMin;
   if(strict && globalMax - globalMin <= tolerance) {
     maximumPossible = false;
@@ -420,43 +414,45 @@ std::shared_ptr<uint64_t> MaximumFinder::getSortedMaxPoints(cv::Mat &ip, cv::Mat
                                                             float globalMax, double threshold, size_t &maxPointSize)
 {
   // byte[] types        = (byte[]) typeP.getPixels();
-  int nMax            = 0;    // counts local maxima
   bool checkThreshold = threshold != MaximumFinder::NO_THRESHOLD;
   // long t0 = System.currentTimeMillis();
-  for(int y = 0; y < ip.rows; y++) {                              // find local maxima now
-    for(int x = 0, i = x + y * width; x < ip.cols; x++, i++) {    // for better performance with rois, restrict search to roi
-      float v     = ip.at<float>(y, x);
-      float vTrue = isEDM ? trueEdmHeight(x, y, ip) : v;    // for EDMs, use interpolated ridge height
-      if(v == globalMin) {
-        continue;
-      }
-      if(excludeEdgesNow && (x == 0 || x == width - 1 || y == 0 || y == height - 1)) {
-        continue;
-      }
-      if(checkThreshold && v < threshold) {
-        continue;
-      }
-      bool isMax = true;
-      /* check wheter we have a local maximum.
-       Note: For an EDM, we need all maxima: those of the EDM-corrected values
-       (needed by findMaxima) and those of the raw values (needed by cleanupMaxima) */
-      bool isInner = (y != 0 && y != height - 1) && (x != 0 && x != width - 1);    // not necessary, but faster than isWithin
-      for(int d = 0; d < 8; d++) {                                                 // compare with the 8 neighbor pixels
-        if(isInner || isWithin(x, y, d)) {
-          float vNeighbor     = ip.at<float>(y + DIR_Y_OFFSET[d], x + DIR_X_OFFSET[d]);
-          float vNeighborTrue = isEDM ? trueEdmHeight(x + DIR_X_OFFSET[d], y + DIR_Y_OFFSET[d], ip) : vNeighbor;
-          if(vNeighbor > v && vNeighborTrue > vTrue) {
-            isMax = false;
-            break;
+  // Each stripe only writes the types of its own lines, the image is read only
+  joda::thread::StripeParallel::forEach(ip.rows, MIN_STRIPE_HEIGHT, [&](int32_t yStart, int32_t yEnd) {
+    for(int y = yStart; y < yEnd; y++) {                            // find local maxima now
+      for(int x = 0, i = x + y * width; x < ip.cols; x++, i++) {    // for better performance with rois, restrict search to roi
+        float v     = ip.at<float>(y, x);
+        float vTrue = isEDM ? trueEdmHeight(x, y, ip) : v;    // for EDMs, use interpolated ridge height
+        if(v == globalMin) {
+          continue;
+        }
+        if(excludeEdgesNow && (x == 0 || x == width - 1 || y == 0 || y == height - 1)) {
+          continue;
+        }
+        if(checkThreshold && v < threshold) {
+          continue;
+        }
+        bool isMax = true;
+        /* check wheter we have a local maximum.
+         Note: For an EDM, we need all maxima: those of the EDM-corrected values
+         (needed by findMaxima) and those of the raw values (needed by cleanupMaxima) */
+        bool isInner = (y != 0 && y != height - 1) && (x != 0 && x != width - 1);    // not necessary, but faster than isWithin
+        for(int d = 0; d < 8; d++) {                                                 // compare with the 8 neighbor pixels
+          if(isInner || isWithin(x, y, d)) {
+            float vNeighbor     = ip.at<float>(y + DIR_Y_OFFSET[d], x + DIR_X_OFFSET[d]);
+            float vNeighborTrue = isEDM ? trueEdmHeight(x + DIR_X_OFFSET[d], y + DIR_Y_OFFSET[d], ip) : vNeighbor;
+            if(vNeighbor > v && vNeighborTrue > vTrue) {
+              isMax = false;
+              break;
+            }
           }
         }
-      }
-      if(isMax) {
-        typeP.at<uint8_t>(i) = MAXIMUM;
-        nMax++;
-      }
-    }    // for x
-  }      // for y
+        if(isMax) {
+          typeP.at<uint8_t>(i) = MAXIMUM;
+        }
+      }    // for x
+    }      // for y
+  });
+  int nMax = cv::countNonZero(typeP);    // counts local maxima, typeP contains nothing else yet
 
   // long t1 = System.currentTimeMillis();IJ.log("markMax:"+(t1-t0));
 
@@ -655,26 +651,28 @@ cv::Mat MaximumFinder::make8bit(cv::Mat &ip, cv::Mat &typeP, bool isEDM, float g
   cv::Mat outIp = cv::Mat::zeros(this->height, this->width, CV_8UC1);
   // convert possibly calibrated image to byte without damaging threshold (setMinAndMax would kill threshold)
 
-  int64_t v = 0;
-  for(int y = 0, i = 0; y < height; y++) {
-    for(int x = 0; x < width; x++, i++) {
-      float rawValue = ip.at<float>(y, x);
-      if(threshold != MaximumFinder::NO_THRESHOLD && rawValue < threshold) {
-        outIp.at<uint8_t>(i) = static_cast<uint8_t>(0);
-      } else if((typeP.at<uint8_t>(i) & MAX_AREA) != 0) {
-        outIp.at<uint8_t>(i) = static_cast<uint8_t>(255);    // prepare watershed by setting "true" maxima+surroundings to 255
-      } else {
-        v = 1 + std::round((rawValue - offset) * factor);
-        if(v < 1) {
-          outIp.at<uint8_t>(i) = static_cast<uint8_t>(1);
-        } else if(v <= 254) {
-          outIp.at<uint8_t>(i) = static_cast<uint8_t>(v & 255);
+  joda::thread::StripeParallel::forEach(height, MIN_STRIPE_HEIGHT, [&](int32_t yStart, int32_t yEnd) {
+    int64_t v = 0;
+    for(int y = yStart, i = yStart * width; y < yEnd; y++) {
+      for(int x = 0; x < width; x++, i++) {
+        float rawValue = ip.at<float>(y, x);
+        if(threshold != MaximumFinder::NO_THRESHOLD && rawValue < threshold) {
+          outIp.at<uint8_t>(i) = static_cast<uint8_t>(0);
+        } else if((typeP.at<uint8_t>(i) & MAX_AREA) != 0) {
+          outIp.at<uint8_t>(i) = static_cast<uint8_t>(255);    // prepare watershed by setting "true" maxima+surroundings to 255
         } else {
-          outIp.at<uint8_t>(i) = static_cast<uint8_t>(254);
+          v = 1 + std::round((rawValue - offset) * factor);
+          if(v < 1) {
+            outIp.at<uint8_t>(i) = static_cast<uint8_t>(1);
+          } else if(v <= 254) {
+            outIp.at<uint8_t>(i) = static_cast<uint8_t>(v & 255);
+          } else {
+            outIp.at<uint8_t>(i) = static_cast<uint8_t>(254);
+          }
         }
       }
     }
-  }
+  });
   return outIp;
 }    // byteProcessor make8bit
 
@@ -886,12 +884,7 @@ int MaximumFinder::nRadii(uint8_t *pixels, int x, int y)
 
 void MaximumFinder::watershedPostProcess(cv::Mat &ip)
 {
-  int size = ip.cols * ip.rows;
-  for(int i = 0; i < size; i++) {
-    if((ip.at<uint8_t>(i) & 255) < 255) {
-      ip.at<uint8_t>(i) = static_cast<uint8_t>(0);
-    }
-  }
+  cv::threshold(ip, ip, 254, 255, cv::THRESH_BINARY);    // everything below 255 becomes 0
   // new ImagePlus("after postprocess",ip.duplicate()).show();
 }
 
@@ -984,7 +977,6 @@ bool MaximumFinder::watershedSegment(cv::Mat &ip)
   std::shared_ptr<int> coordinates(new int[arraySize]{0}, [](int *p) { delete[] p; });
 
   int highestValue = 0;
-  int maxBinSize   = 0;
   int offset       = 0;
   int levelStart[256]{0};
   for(int v = 1; v < 255; v++) {
@@ -993,9 +985,6 @@ bool MaximumFinder::watershedSegment(cv::Mat &ip)
     if(histogram.at<float>(v) > 0) {
       highestValue = v;
     }
-    if(histogram.at<float>(v) > maxBinSize) {
-      maxBinSize = histogram.at<float>(v);
-    }
   }
 
   std::shared_ptr<int> levelOffset(new int[highestValue + 1]{0}, [](int *p) { delete[] p; });
@@ -1010,9 +999,9 @@ bool MaximumFinder::watershedSegment(cv::Mat &ip)
       }
     }    // for x
   }      // for y
-         // Create an array of the points (pixel offsets) that we set to 255 in one pass.
+         // Marks the points of a level which are set to 255 in one pass.
          // If we remember this list we need not create a snapshot of the ImageProcessor.
-  std::shared_ptr<int> setPointList(new int[std::min(maxBinSize, (width * height + 2) / 3)]{0}, [](int *p) { delete[] p; });
+  std::vector<uint8_t> setPointList(static_cast<size_t>(arraySize));
 
   // now do the segmentation, starting at the highest level and working down.
   // At each level, dilate the particle (set pixels to 255), constrained to pixels
@@ -1094,57 +1083,63 @@ bool MaximumFinder::watershedSegment(cv::Mat &ip)
  */
 
 int MaximumFinder::processLevel(int pass, cv::Mat &ip, std::shared_ptr<int> fateTable, int levelStart, int levelNPoints,
-                                std::shared_ptr<int> coordinates, std::shared_ptr<int> setPointList)
+                                std::shared_ptr<int> coordinates, std::vector<uint8_t> &setPointList)
 {
   int xmax = width - 1;
   int ymax = height - 1;
   // byte[] pixels2 = (byte[])ip2.getPixels();
+  int mask = 1 << pass;
+  // Pixels are set to 255 only after the neighborhood of all points has been checked,
+  // so the points of the level are independent of each other and can be checked in parallel.
+  joda::thread::StripeParallel::forEach(levelNPoints, MIN_STRIPE_POINTS, [&](int32_t start, int32_t end) {
+    for(int i = start, p = levelStart + start; i < end; i++, p++) {
+      int xy     = coordinates.get()[p];
+      int x      = xy & intEncodeXMask;
+      int y      = (xy & intEncodeYMask) >> intEncodeShift;
+      int offset = x + y * width;
+      int index  = 0;    // neighborhood pixel ocupation: index in fateTable
+      if(y > 0 && (ip.at<uint8_t>(offset - width) & 255) == 255) {
+        index ^= 1;
+      }
+      if(x < xmax && y > 0 && (ip.at<uint8_t>(offset - width + 1) & 255) == 255) {
+        index ^= 2;
+      }
+      if(x < xmax && (ip.at<uint8_t>(offset + 1) & 255) == 255) {
+        index ^= 4;
+      }
+      if(x < xmax && y < ymax && (ip.at<uint8_t>(offset + width + 1) & 255) == 255) {
+        index ^= 8;
+      }
+      if(y < ymax && (ip.at<uint8_t>(offset + width) & 255) == 255) {
+        index ^= 16;
+      }
+      if(x > 0 && y < ymax && (ip.at<uint8_t>(offset + width - 1) & 255) == 255) {
+        index ^= 32;
+      }
+      if(x > 0 && (ip.at<uint8_t>(offset - 1) & 255) == 255) {
+        index ^= 64;
+      }
+      if(x > 0 && y > 0 && (ip.at<uint8_t>(offset - width - 1) & 255) == 255) {
+        index ^= 128;
+      }
+      setPointList[i] = static_cast<uint8_t>((fateTable.get()[index] & mask) == mask);    // remember to set pixel to 255
+    }    // for pixel i
+  });
+
   int nChanged   = 0;
   int nUnchanged = 0;
   for(int i = 0, p = levelStart; i < levelNPoints; i++, p++) {
-    int xy     = coordinates.get()[p];
-    int x      = xy & intEncodeXMask;
-    int y      = (xy & intEncodeYMask) >> intEncodeShift;
-    int offset = x + y * width;
-    int index  = 0;    // neighborhood pixel ocupation: index in fateTable
-    if(y > 0 && (ip.at<uint8_t>(offset - width) & 255) == 255) {
-      index ^= 1;
-    }
-    if(x < xmax && y > 0 && (ip.at<uint8_t>(offset - width + 1) & 255) == 255) {
-      index ^= 2;
-    }
-    if(x < xmax && (ip.at<uint8_t>(offset + 1) & 255) == 255) {
-      index ^= 4;
-    }
-    if(x < xmax && y < ymax && (ip.at<uint8_t>(offset + width + 1) & 255) == 255) {
-      index ^= 8;
-    }
-    if(y < ymax && (ip.at<uint8_t>(offset + width) & 255) == 255) {
-      index ^= 16;
-    }
-    if(x > 0 && y < ymax && (ip.at<uint8_t>(offset + width - 1) & 255) == 255) {
-      index ^= 32;
-    }
-    if(x > 0 && (ip.at<uint8_t>(offset - 1) & 255) == 255) {
-      index ^= 64;
-    }
-    if(x > 0 && y > 0 && (ip.at<uint8_t>(offset - width - 1) & 255) == 255) {
-      index ^= 128;
-    }
-    int mask = 1 << pass;
-
-    if((fateTable.get()[index] & mask) == mask) {
-      setPointList.get()[nChanged++] = offset;    // remember to set pixel to 255
+    int xy = coordinates.get()[p];
+    if(setPointList[i] != 0) {
+      int x                         = xy & intEncodeXMask;
+      int y                         = (xy & intEncodeYMask) >> intEncodeShift;
+      ip.at<uint8_t>(x + y * width) = static_cast<uint8_t>(255);
+      nChanged++;
     } else {
       coordinates.get()[levelStart + (nUnchanged++)] = xy;    // keep this pixel for future passes
     }
-
-  }    // for pixel i
-       // IJ.log("pass="+pass+", changed="+nChanged+" unchanged="+nUnchanged);
-
-  for(int i = 0; i < nChanged; i++) {
-    ip.at<uint8_t>(setPointList.get()[i]) = static_cast<uint8_t>(255);
   }
+  // IJ.log("pass="+pass+", changed="+nChanged+" unchanged="+nUnchanged);
   return nChanged;
 }    // processLevel
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <opencv2/core/mat.hpp>
@@ -69,7 +70,7 @@ private:
   void deleteParticle(int x, int y, cv::Mat &ip, Wand &wand);
   std::shared_ptr<int> makeFateTable();
   int processLevel(int pass, cv::Mat &ip, std::shared_ptr<int> fateTable, int levelStart, int levelNPoints, std::shared_ptr<int> coordinates,
-                   std::shared_ptr<int> setPointList);
+                   std::vector<uint8_t> &setPointList);
   Polygon getMaxima(cv::Mat &ip, double tolerance, bool excludeOnEdges);
   static std::shared_ptr<int> findMaxima(std::shared_ptr<double> xx, size_t xxSize, double tolerance, int edgeMode);
   static std::shared_ptr<int> findMaxima(std::shared_ptr<double> xx, size_t xxSize, double tolerance, bool excludeOnEdges);
@@ -106,5 +107,8 @@ private:
 
   static const inline char outputTypeMasks[] = {MAX_POINT, MAX_AREA, MAX_AREA};    ///< type masks corresponding to the output types
   static const inline float SQRT2            = 1.4142135624F;
+
+  static constexpr int32_t MIN_STRIPE_HEIGHT = 32;      ///< min. number of lines a thread processes
+  static constexpr int32_t MIN_STRIPE_POINTS = 8192;    ///< min. number of points of a watershed level a thread processes
 };
 }    // namespace joda::image::func
@@ -11,7 +11,11 @@
 
 #pragma once
 
+#include <list>
+#include <set>
+#include <vector>
 #include "backend/commands/command.hpp"
+#include "measure_intensity_engine.hpp"
 #include "measure_intensity_settings.hpp"
 
 namespace joda::cmd {
@@ -26,38 +30,44 @@ public:
   void execute(processor::ProcessContext &context, cv::Mat & /*image*/, atom::ObjectList & /*result*/) override
   {
     auto &store = *context.loadObjectsFromCache();
+
+    //
+    // Collect the image planes to measure. RGB images are converted to gray scale once.
+    //
+    std::list<cv::Mat> grayPlanes;
+    std::vector<IntensityMeasurementEngine::Plane> planes;
     for(auto imageId : mSettings.planesIn) {
-      joda::atom::ImagePlane rgbPlane;
       auto const &image = *context.loadImageFromCache(enums::MemoryScope::ITERATION, imageId);
       if(image.isRgb()) {
         /// \todo Allow to specify which grayscale calculation mode should be used
-        rgbPlane       = image;
-        rgbPlane.image = cv::Mat::zeros(image.image.size(), CV_16UC1);
-        for(int i = 0; i < image.image.rows; ++i) {
-          for(int j = 0; j < image.image.cols; ++j) {
-            cv::Vec3b pixel                   = image.image.at<cv::Vec3b>(i, j);
-            uint16_t grayValue                = static_cast<uint16_t>(((pixel[2] + pixel[1] + pixel[0]) * 65535.0) / (3 * 255.0));    // BGR format
-            rgbPlane.image.at<uint16_t>(i, j) = grayValue;
-          }
-        }
+        planes.push_back({.imageId = image.getId(), .image = &grayPlanes.emplace_back(IntensityMeasurementEngine::rgbToGray(image.image))});
+      } else {
+        planes.push_back({.imageId = image.getId(), .image = &image.image});
       }
+    }
+    if(planes.empty() || planes.front().image->empty()) {
+      return;
+    }
 
-      for(const auto &classIdIn : mSettings.inputClasses) {
-        if(!store.contains(context.getClassId(classIdIn))) {
-          continue;
-        }
-        auto *classsObjects = store.at(context.getClassId(classIdIn)).get();
-        for(auto &object : *classsObjects) {
-          if(context.getClassId(classIdIn) == object.getClassId()) {
-            if(image.isRgb()) {
-              object.measureIntensityAndAdd(rgbPlane.getId(), rgbPlane.image, context.getTileInfo());
-            } else {
-              object.measureIntensityAndAdd(image.getId(), image.image, context.getTileInfo());
-            }
-          }
+    //
+    // Rasterize all objects of the requested classes once and measure all planes in one sweep
+    //
+    IntensityMeasurementEngine engine(context.getTileInfo(), planes.front().image->size(), {});
+    std::set<enums::ClassId> classesToMeasure;
+    for(const auto &classIdIn : mSettings.inputClasses) {
+      classesToMeasure.emplace(context.getClassId(classIdIn));
+    }
+    for(const auto classId : classesToMeasure) {
+      if(!store.contains(classId)) {
+        continue;
+      }
+      for(auto &object : *store.at(classId)) {
+        if(classId == object.getClassId()) {
+          engine.addRoi(&object);
         }
       }
     }
+    engine.measureAndAdd(planes);
   }
 
 private:
@@ -0,0 +1,213 @@
+///
+/// \file      measure_intensity_engine.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "measure_intensity_engine.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <opencv2/core.hpp>
+
+namespace joda::cmd {
+
+///
+/// \brief      Constructor
+/// \author     Joachim Danmayr
+/// \param[in]  tile       Tile the images belong to
+/// \param[in]  imageSize  Size of the image planes which will be measured
+/// \param[in]  options    Which optional statistics should be calculated
+///
+IntensityMeasurementEngine::IntensityMeasurementEngine(const joda::enums::TileInfo &tile, const cv::Size &imageSize, Options options) :
+    mTile(tile), mImageSize(imageSize), mOptions(options)
+{
+}
+
+///
+/// \brief      Add a ROI which should be measured. The ROI is rasterized into
+///             the first label layer it does not overlap with.
+/// \author     Joachim Danmayr
+/// \param[in]  roi  ROI to measure, the measurement is written back to it
+///
+void IntensityMeasurementEngine::addRoi(joda::atom::ROI *roi)
+{
+  if(mRois.size() >= static_cast<size_t>(INT32_MAX - 1)) {
+    throw std::runtime_error("Too many objects for intensity measurement!");
+  }
+  mRois.emplace_back(roi);
+  if(roi->getBoundingBoxReal().empty() || roi->getMask().empty()) {
+    return;
+  }
+  rasterize(static_cast<int32_t>(mRois.size()), *roi);
+}
+
+///
+/// \brief      Writes the label of the ROI to the first layer which has no
+///             pixel of another ROI at the positions of the mask.
+/// \author     Joachim Danmayr
+///
+void IntensityMeasurementEngine::rasterize(int32_t label, const joda::atom::ROI &roi)
+{
+  const auto box     = roi.getBoundingBoxTile(mTile);
+  const auto &mask   = roi.getMask();
+  const int32_t yEnd = std::min({mask.rows, box.height, mImageSize.height - box.y});
+  const int32_t xEnd = std::min({mask.cols, box.width, mImageSize.width - box.x});
+  const int32_t yBeg = std::max(0, -box.y);
+  const int32_t xBeg = std::max(0, -box.x);
+
+  auto isFree = [&](const cv::Mat &layer) {
+    for(int32_t y = yBeg; y < yEnd; y++) {
+      const auto *maskRow  = mask.ptr<uint8_t>(y);
+      const auto *labelRow = layer.ptr<int32_t>(y + box.y) + box.x;
+      for(int32_t x = xBeg; x < xEnd; x++) {
+        if(maskRow[x] > 0 && labelRow[x] != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  cv::Mat *target = nullptr;
+  for(auto &layer : mLabelLayers) {
+    if(isFree(layer)) {
+      target = &layer;
+      break;
+    }
+  }
+  if(target == nullptr) {
+    target = &mLabelLayers.emplace_back(cv::Mat::zeros(mImageSize, CV_32SC1));
+  }
+
+  for(int32_t y = yBeg; y < yEnd; y++) {
+    const auto *maskRow = mask.ptr<uint8_t>(y);
+    auto *labelRow      = target->ptr<int32_t>(y + box.y) + box.x;
+    for(int32_t x = xBeg; x < xEnd; x++) {
+      if(maskRow[x] > 0) {
+        labelRow[x] = label;
+      }
+    }
+  }
+}
+
+///
+/// \brief      Measures all added ROIs in all given planes with one sweep
+///             over each label layer and writes the results to the ROIs.
+///             Already existing measurements of a ROI are not overwritten.
+/// \author     Joachim Danmayr
+/// \param[in]  planes  16 bit image planes to measure
+///
+void IntensityMeasurementEngine::measureAndAdd(const std::vector<Plane> &planes) const
+{
+  const size_t nrOfPlanes = planes.size();
+  if(nrOfPlanes == 0 || mRois.empty()) {
+    return;
+  }
+  for(const auto &plane : planes) {
+    if(plane.image == nullptr || plane.image->type() != CV_16UC1 || plane.image->size() != mImageSize) {
+      throw std::invalid_argument("Intensity measurement needs 16 bit gray scale images of the tile size!");
+    }
+  }
+
+  // Accumulators are stored per label with all planes next to each other
+  std::vector<Accumulator> acc(mRois.size() * nrOfPlanes);
+  std::vector<const uint16_t *> rows(nrOfPlanes);
+
+  for(const auto &layer : mLabelLayers) {
+    for(int32_t y = 0; y < mImageSize.height; y++) {
+      const auto *labelRow = layer.ptr<int32_t>(y);
+      for(size_t p = 0; p < nrOfPlanes; p++) {
+        rows[p] = planes[p].image->ptr<uint16_t>(y);
+      }
+      for(int32_t x = 0; x < mImageSize.width; x++) {
+        const int32_t label = labelRow[x];
+        if(label == 0) {
+          continue;
+        }
+        Accumulator *accRoi = &acc[static_cast<size_t>(label - 1) * nrOfPlanes];
+        for(size_t p = 0; p < nrOfPlanes; p++) {
+          const uint16_t val = rows[p][x];
+          Accumulator &a     = accRoi[p];
+          a.count++;
+          a.sum += val;
+          a.sumSq += static_cast<uint64_t>(val) * val;
+          a.min = std::min(a.min, val);
+          a.max = std::max(a.max, val);
+          if(mOptions.calcMedian) {
+            a.values.emplace_back(val);
+          }
+        }
+      }
+    }
+  }
+
+  for(size_t idx = 0; idx < mRois.size(); idx++) {
+    for(size_t p = 0; p < nrOfPlanes; p++) {
+      mRois[idx]->addIntensity(planes[p].imageId, toIntensity(acc[idx * nrOfPlanes + p]));
+    }
+  }
+}
+
+///
+/// \brief      Convert the accumulated values to the intensity measurement
+/// \author     Joachim Danmayr
+///
+auto IntensityMeasurementEngine::toIntensity(Accumulator &acc) const -> joda::atom::ROI::Intensity
+{
+  joda::atom::ROI::Intensity intensity;
+  if(acc.count == 0) {
+    return intensity;
+  }
+  const auto count       = static_cast<double>(acc.count);
+  const double mean      = static_cast<double>(acc.sum) / count;
+  intensity.intensitySum = acc.sum;
+  intensity.intensityAvg = static_cast<float>(mean);
+  intensity.intensityMin = acc.min;
+  intensity.intensityMax = acc.max;
+  if(mOptions.calcStdDev) {
+    const double variance     = std::max(0.0, static_cast<double>(acc.sumSq) / count - mean * mean);
+    intensity.intensityStdDev = static_cast<float>(std::sqrt(variance));
+  }
+  if(mOptions.calcMedian && !acc.values.empty()) {
+    auto middle = acc.values.begin() + static_cast<std::ptrdiff_t>(acc.values.size() / 2);
+    std::nth_element(acc.values.begin(), middle, acc.values.end());
+    intensity.intensityMedian = static_cast<float>(*middle);
+  }
+  return intensity;
+}
+
+///
+/// \brief      Converts a BGR 8 bit image to a 16 bit gray scale image.
+///             gray = ((B + G + R) * 65535) / (3 * 255)
+/// \author     Joachim Danmayr
+///
+cv::Mat IntensityMeasurementEngine::rgbToGray(const cv::Mat &rgb)
+{
+  static const auto LUT = [] {
+    std::array<uint16_t, 3 * 255 + 1> lut{};
+    for(size_t n = 0; n < lut.size(); n++) {
+      lut[n] = static_cast<uint16_t>((static_cast<double>(n) * 65535.0) / (3 * 255.0));
+    }
+    return lut;
+  }();
+
+  cv::Mat gray(rgb.size(), CV_16UC1);
+  for(int32_t y = 0; y < rgb.rows; y++) {
+    const auto *src = rgb.ptr<cv::Vec3b>(y);
+    auto *dst       = gray.ptr<uint16_t>(y);
+    for(int32_t x = 0; x < rgb.cols; x++) {
+      dst[x] = LUT[static_cast<size_t>(src[x][0]) + src[x][1] + src[x][2]];
+    }
+  }
+  return gray;
+}
+
+}    // namespace joda::cmd
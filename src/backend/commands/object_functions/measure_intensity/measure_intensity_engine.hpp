@@ -0,0 +1,79 @@
+///
+/// \file      measure_intensity_engine.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/enums/enum_images.hpp"
+#include "backend/enums/types.hpp"
+#include <opencv2/core/mat.hpp>
+
+namespace joda::cmd {
+
+///
+/// \class      IntensityMeasurementEngine
+/// \author     Joachim Danmayr
+/// \brief      Measures the intensity of many ROIs in many image planes at once.
+///             The ROIs are rasterized into a label image once per tile. Each
+///             pixel of the tile is visited once and its value is accumulated
+///             for all given planes. Overlapping ROIs are put into separate
+///             label layers, so the result is identical to ROI::calcIntensity.
+///
+class IntensityMeasurementEngine
+{
+public:
+  /////////////////////////////////////////////////////
+  struct Options
+  {
+    bool calcStdDev = true;
+    bool calcMedian = false;
+  };
+
+  struct Plane
+  {
+    enums::ImageId imageId;
+    const cv::Mat *image = nullptr;    // CV_16UC1 with the given image size
+  };
+
+  /////////////////////////////////////////////////////
+  IntensityMeasurementEngine(const joda::enums::TileInfo &tile, const cv::Size &imageSize, Options options);
+  void addRoi(joda::atom::ROI *roi);
+  void measureAndAdd(const std::vector<Plane> &planes) const;
+
+  static cv::Mat rgbToGray(const cv::Mat &rgb);
+
+private:
+  /////////////////////////////////////////////////////
+  struct Accumulator
+  {
+    uint64_t count = 0;
+    uint64_t sum   = 0;
+    uint64_t sumSq = 0;
+    uint16_t min   = UINT16_MAX;
+    uint16_t max   = 0;
+    std::vector<uint16_t> values;    // Only filled if the median is requested
+  };
+
+  /////////////////////////////////////////////////////
+  void rasterize(int32_t label, const joda::atom::ROI &roi);
+  auto toIntensity(Accumulator &acc) const -> joda::atom::ROI::Intensity;
+
+  /////////////////////////////////////////////////////
+  joda::enums::TileInfo mTile;
+  cv::Size mImageSize;
+  Options mOptions;
+  std::vector<joda::atom::ROI *> mRois;
+  std::vector<cv::Mat> mLabelLayers;    // CV_32SC1, 0 = background, label = index in mRois + 1
+};
+
+}    // namespace joda::cmd
@@ -0,0 +1,49 @@
+///
+/// \file      object_tracking.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "object_tracking.hpp"
+#include <utility>
+#include <vector>
+#include "backend/data_analysis/object_tracker/tracking_manager.hpp"
+
+namespace joda::cmd {
+
+///
+/// \brief      Collects the objects of the input classes of this tile.
+///             Nothing is done in preview mode, there is no time series.
+/// \author     Joachim Danmayr
+///
+void ObjectTracking::execute(processor::ProcessContext &context, cv::Mat & /*image*/, atom::ObjectList & /*result*/)
+{
+  auto *tracking = context.getObjectTracking();
+  if(tracking == nullptr) {
+    return;
+  }
+  const auto &plane = context.getActIterator();
+  auto &store       = *context.loadObjectsFromCache();
+  for(const auto &classIn : mSettings.inputClasses) {
+    if(classIn == enums::ClassIdIn::UNDEFINED || classIn == enums::ClassIdIn::NONE) {
+      continue;
+    }
+    const auto classId = context.getClassId(classIn);
+    std::vector<data_analyze::object_tracker::Detection> detections;
+    if(store.contains(classId)) {
+      detections.reserve(store.at(classId)->size());
+      for(const auto &roi : *store.at(classId)) {
+        detections.push_back({.objectId = roi.getObjectId(), .center = roi.getCentroidReal(), .bbox = roi.getBoundingBoxReal()});
+      }
+    }
+    tracking->addDetections(context.getActImageId(), plane.tStack, plane.zStack, classId, mSettings.maxDistance, mSettings.maxMissedFrames,
+                            std::move(detections));
+  }
+}
+
+}    // namespace joda::cmd
@@ -0,0 +1,37 @@
+///
+/// \file      object_tracking.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include "backend/commands/command.hpp"
+#include "object_tracking_settings.hpp"
+
+namespace joda::cmd {
+
+///
+/// \class      ObjectTracking
+/// \author     Joachim Danmayr
+/// \brief      Hands the objects of the actual time frame over to the tracking
+///             manager of the processor. The tracking IDs are written to the
+///             database as soon as all tiles of the frame are finished.
+///
+class ObjectTracking : public cmd::Command
+{
+public:
+  explicit ObjectTracking(const settings::ObjectTrackingSettings &settings) : mSettings(settings)
+  {
+  }
+  void execute(processor::ProcessContext &context, cv::Mat & /*image*/, atom::ObjectList &result) override;
+
+private:
+  const settings::ObjectTrackingSettings &mSettings;
+};
+}    // namespace joda::cmd
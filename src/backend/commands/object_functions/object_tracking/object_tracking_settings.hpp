@@ -0,0 +1,56 @@
+///
+/// \file      object_tracking_settings.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include "backend/enums/enums_classes.hpp"
+#include "backend/settings/setting.hpp"
+#include "backend/settings/setting_base.hpp"
+#include "backend/settings/settings_types.hpp"
+#include <nlohmann/json.hpp>
+
+namespace joda::settings {
+
+struct ObjectTrackingSettings : public SettingBase
+{
+  //
+  // Classes to track, each class is tracked on its own
+  //
+  ObjectInputClasses inputClasses;
+
+  //
+  // Maximum distance in pixels the center of an object can move between two time frames
+  //
+  float maxDistance = 25;
+
+  //
+  // Number of time frames a track is kept alive without finding the object
+  //
+  int32_t maxMissedFrames = 2;
+
+  /////////////////////////////////////////////////////
+  void check() const
+  {
+    CHECK_ERROR(!inputClasses.empty(), "At least one input class must be given!");
+    CHECK_ERROR(maxDistance > 0, "Max. distance must be bigger than zero.");
+    CHECK_ERROR(maxMissedFrames >= 0, "Max. missed frames must not be negative.");
+  }
+
+  settings::ObjectInputClasses getInputClasses() const override
+  {
+    return inputClasses;
+  }
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT_EXTENDED(ObjectTrackingSettings, inputClasses, maxDistance, maxMissedFrames);
+};
+
+}    // namespace joda::settings
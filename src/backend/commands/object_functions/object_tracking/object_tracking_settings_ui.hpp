@@ -0,0 +1,78 @@
+///
+/// \file      object_tracking_settings_ui.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <qwidget.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "backend/commands/command.hpp"
+#include "backend/enums/enums_classes.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_command/command.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_combobox_multi_classification_in.hpp"
+#include "ui/gui/editor/widget_pipeline/widget_setting/setting_line_edit.hpp"
+#include "ui/gui/helper/icon_generator.hpp"
+#include "ui/gui/helper/layout_generator.hpp"
+#include "ui/gui/helper/setting_generator.hpp"
+#include "object_tracking_settings.hpp"
+
+namespace joda::ui::gui {
+
+class ObjectTracking : public Command
+{
+public:
+  /////////////////////////////////////////////////////
+  inline static std::string TITLE             = "Object tracking";
+  inline static std::string ICON              = "footprints";
+  inline static std::string DESCRIPTION       = "Link objects of consecutive time frames. Objects of one track get the same tracking ID.";
+  inline static std::vector<std::string> TAGS = {"tracking", "time", "video", "object"};
+
+  ObjectTracking(joda::settings::AnalyzeSettings *analyzeSettings, joda::settings::PipelineStep &pipelineStep,
+                 settings::ObjectTrackingSettings &settings, QWidget *parent) :
+      Command(analyzeSettings, pipelineStep, TITLE.data(), DESCRIPTION.data(), TAGS, ICON.data(), parent, {{InOuts::OBJECT}, {InOuts::OBJECT}})
+  {
+    auto *tab = addTab(
+        "", [] {}, false);
+    //
+    //
+    classesIn = SettingBase::create<SettingComboBoxMultiClassificationIn>(parent, {}, "Input classes");
+    classesIn->setValue(settings.inputClasses);
+    classesIn->connectWithSetting(&settings.inputClasses);
+
+    //
+    //
+    mMaxDistance = SettingBase::create<SettingSpinBox<float>>(parent, {}, "Max. distance");
+    mMaxDistance->setMinMax(0, std::numeric_limits<float>::max(), 3, 0.01);
+    mMaxDistance->setUnit("px", enums::ObjectType::LINE2D);
+    mMaxDistance->setValue(settings.maxDistance);
+    mMaxDistance->connectWithSetting(&settings.maxDistance);
+    mMaxDistance->setShortDescription("Dist. ");
+
+    //
+    //
+    mMaxMissedFrames = SettingBase::create<SettingSpinBox<int32_t>>(parent, {}, "Max. missed frames");
+    mMaxMissedFrames->setMinMax(0, 65535, 0, 1);
+    mMaxMissedFrames->setValue(settings.maxMissedFrames);
+    mMaxMissedFrames->connectWithSetting(&settings.maxMissedFrames);
+    mMaxMissedFrames->setShortDescription("Missed ");
+
+    addSetting(tab, "Tracking", {{classesIn.get(), true, 0}, {mMaxDistance.get(), true, 0}, {mMaxMissedFrames.get(), false, 0}});
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  std::unique_ptr<SettingComboBoxMultiClassificationIn> classesIn;
+  std::unique_ptr<SettingSpinBox<float>> mMaxDistance;
+  std::unique_ptr<SettingSpinBox<int32_t>> mMaxMissedFrames;
+};
+
+}    // namespace joda::ui::gui
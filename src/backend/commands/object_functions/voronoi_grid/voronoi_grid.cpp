@@ -12,84 +12,104 @@
 ///
 
 #include "voronoi_grid.hpp"
+#include <vector>
+#include "voronoi_label_map.hpp"
 
 namespace joda::cmd {
 
+///
+/// \brief      Cuts the voronoi areas with the mask objects and filters them.
+///             Which areas a mask object or a point touches is looked up in a label
+///             image of the tessellation. The exact intersection is only calculated
+///             for those pairs, the result is the same as intersecting every
+///             object with every area.
+/// \author     Joachim Danmayr
+///
 void VoronoiGrid::applyFilter(processor::ProcessContext &context, const atom::SpheralIndex &voronoiGrid, const atom::SpheralIndex &voronoiPoints,
                               atom::ObjectList &objects)
 {
-  const atom::SpheralIndex *response = objects[context.getClassId(mSettings.outputClassVoronoi)].get();
+  const auto outputClass = context.getClassId(mSettings.outputClassVoronoi);
+  std::vector<const atom::ROI *> voronoiAreas;
+  for(const atom::ROI &voronoiArea : voronoiGrid) {
+    if(voronoiArea.getClassId() == outputClass) {
+      voronoiAreas.push_back(&voronoiArea);
+    }
+  }
+  const VoronoiLabelMap labelMap(voronoiAreas);
 
-  auto filterVoronoiAreas = [this, &context, &response, &voronoiPoints, &voronoiGrid, &objects](const atom::ROI *toIntersect) {
-    for(const atom::ROI &voronoiArea : voronoiGrid) {
-      if(voronoiArea.getClassId() == context.getClassId(mSettings.outputClassVoronoi)) {
-        //
-        // Apply filter
-        //
-        auto applyFilter = [this, &context, &response, &voronoiPoints, &voronoiGrid, &objects](atom::ROI &cutedVoronoiArea) {
-          //
-          // Areas without point are filtered out
-          //
-          if(mSettings.excludeAreasWithoutPoint) {
-            for(const auto &points : mSettings.inputClassesPoints) {
-              if(!doesAreaContainsPoint(cutedVoronoiArea, voronoiPoints, {context.getClassId(points)})) {
-                return;
-              }
-            }
-          }
+  //
+  // Points which are touching an area
+  //
+  std::vector<std::vector<const atom::ROI *>> pointsOfArea(voronoiAreas.size());
+  if(mSettings.excludeAreasWithoutPoint) {
+    for(const auto &point : voronoiPoints) {
+      for(const auto areaIdx : labelMap.findAreas(point)) {
+        pointsOfArea[areaIdx].push_back(&point);
+      }
+    }
+  }
 
-          //
-          // Check area sizeW
-          //
-          const auto &physicalSize = context.getPhysicalPixelSIzeOfImage();
-          if((mSettings.minAreaSize >= 0 &&
-              cutedVoronoiArea.getAreaSize(physicalSize, context.getPipelineRealValuesUnit()) < static_cast<double>(mSettings.minAreaSize)) ||
-             (mSettings.maxAreaSize >= 0 &&
-              cutedVoronoiArea.getAreaSize(physicalSize, context.getPipelineRealValuesUnit()) > static_cast<double>(mSettings.maxAreaSize))) {
-            return;
-          }
+  auto applyFilter = [this, &context, &objects](atom::ROI &cutedVoronoiArea, const std::vector<const atom::ROI *> &points) {
+    //
+    // Areas without point are filtered out
+    //
+    if(mSettings.excludeAreasWithoutPoint) {
+      for(const auto &pointsIn : mSettings.inputClassesPoints) {
+        if(!doesAreaContainsPoint(cutedVoronoiArea, points, {context.getClassId(pointsIn)})) {
+          return;
+        }
+      }
+    }
 
-          //
-          // Remove area at the edges if filter enabled
-          //
-          if(mSettings.excludeAreasAtTheEdge) {
-            auto box       = cutedVoronoiArea.getBoundingBoxReal();
-            auto imageSize = context.getImageSize();
-            if(box.x <= 0 || box.y <= 0 || box.x + box.width >= imageSize.width || box.y + box.height >= imageSize.height) {
-              // Touches the edge
-              return;
-            }
-          }
-          objects.push_back(cutedVoronoiArea);
-        };
+    //
+    // Check area sizeW
+    //
+    const auto &physicalSize = context.getPhysicalPixelSIzeOfImage();
+    if((mSettings.minAreaSize >= 0 &&
+        cutedVoronoiArea.getAreaSize(physicalSize, context.getPipelineRealValuesUnit()) < static_cast<double>(mSettings.minAreaSize)) ||
+       (mSettings.maxAreaSize >= 0 &&
+        cutedVoronoiArea.getAreaSize(physicalSize, context.getPipelineRealValuesUnit()) > static_cast<double>(mSettings.maxAreaSize))) {
+      return;
+    }
 
-        //
-        // Mask if enabled
-        //
-        if(toIntersect != nullptr) {
-          auto cutedVoronoiArea = voronoiArea.calcIntersection(voronoiArea.getId().imagePlane, *toIntersect, 0, voronoiArea.getClassId());
-          if(!cutedVoronoiArea.isNull()) {
-            applyFilter(cutedVoronoiArea);
-          }
-        } else {
-          auto areaClone = voronoiArea.clone();
-          applyFilter(areaClone);
-        }
+    //
+    // Remove area at the edges if filter enabled
+    //
+    if(mSettings.excludeAreasAtTheEdge) {
+      auto box       = cutedVoronoiArea.getBoundingBoxReal();
+      auto imageSize = context.getImageSize();
+      if(box.x <= 0 || box.y <= 0 || box.x + box.width >= imageSize.width || box.y + box.height >= imageSize.height) {
+        // Touches the edge
+        return;
       }
     }
+    objects.push_back(cutedVoronoiArea);
   };
 
   if(!mSettings.inputClassesMask.empty()) {
+    //
+    // Mask if enabled, areas the mask object does not touch have no intersection
+    //
     for(const auto &maskIn : mSettings.inputClassesMask) {
       const auto *mask = objects.at(context.getClassId(maskIn)).get();
       for(const auto &toIntersect : *mask) {
-        if(context.getClassId(maskIn) == toIntersect.getClassId()) {
-          filterVoronoiAreas(&toIntersect);
+        if(context.getClassId(maskIn) != toIntersect.getClassId()) {
+          continue;
+        }
+        for(const auto areaIdx : labelMap.findAreas(toIntersect)) {
+          const auto *voronoiArea = voronoiAreas[areaIdx];
+          auto cutedVoronoiArea   = voronoiArea->calcIntersection(voronoiArea->getId().imagePlane, toIntersect, 0, voronoiArea->getClassId());
+          if(!cutedVoronoiArea.isNull()) {
+            applyFilter(cutedVoronoiArea, pointsOfArea[areaIdx]);
+          }
         }
       }
     }
   } else {
-    filterVoronoiAreas(nullptr);
+    for(size_t areaIdx = 0; areaIdx < voronoiAreas.size(); areaIdx++) {
+      auto areaClone = voronoiAreas[areaIdx]->clone();
+      applyFilter(areaClone, pointsOfArea[areaIdx]);
+    }
   }
 }
 }    // namespace joda::cmd
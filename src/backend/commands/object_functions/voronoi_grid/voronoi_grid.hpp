@@ -81,7 +81,9 @@ public:
   }
 
   ///
-  /// \brief      Draw voronoi grid
+  /// \brief      Draw voronoi grid. Each facet is rasterized within its bounding box
+  ///             only, the masks are the same as if the facet would be drawn into an
+  ///             image of the full size.
   /// \author     Joachim Danmayr
   /// \ref        https://learnopencv.com/delaunay-triangulation-and-voronoi-diagram-using-opencv-c-python/
   /// \param[in]   subdiv   Sub division points
@@ -93,40 +95,53 @@ public:
     std::vector<cv::Point2f> centers;
     subdiv.getVoronoiFacetList(std::vector<int>(), facets, centers);
 
+    auto [pixelWidth, pixelHeight, _] = context.getPhysicalPixelSIzeOfImage().getPixelSize(context.getPipelineRealValuesUnit());
+    double radiusPx = static_cast<double>(circleSize) / pixelWidth;     // radius in x direction (pixels)
+    double radiusPy = static_cast<double>(circleSize) / pixelHeight;    // radius in y direction (pixels)
+    const cv::Rect imageRect(0, 0, imgSize.width, imgSize.height);
+
+    // Bounding box of a polygon with one pixel margin, clipped to the image
+    auto polygonBox = [&imageRect](const std::vector<cv::Point> &polygon) {
+      auto box = cv::boundingRect(polygon);
+      return cv::Rect(box.x - 1, box.y - 1, box.width + 2, box.height + 2) & imageRect;
+    };
+    auto fillInBox = [](const cv::Rect &box, std::vector<cv::Point> polygon) {
+      for(auto &point : polygon) {
+        point -= box.tl();
+      }
+      cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+      fillConvexPoly(mask, polygon, cv::Scalar(255), 8, 0);
+      return mask;
+    };
+
     for(size_t i = 0; i < facets.size(); i++) {
       std::vector<cv::Point> ifacet;
-      // std::vector<std::vector<cv::Point>> ifacets(1);
-
-      cv::Mat points1_array(3, 1, CV_8U);
       ifacet.resize(facets[i].size());
       for(size_t j = 0; j < facets[i].size(); j++) {
         ifacet[j] = facets[i][j];
       }
 
-      cv::Mat tmpImage(imgSize, CV_8UC1);
-
-      auto [pixelWidth, pixelHeight, _] = context.getPhysicalPixelSIzeOfImage().getPixelSize(context.getPipelineRealValuesUnit());
-
-      double radiusPx = static_cast<double>(circleSize) / pixelWidth;     // radius in x direction (pixels)
-      double radiusPy = static_cast<double>(circleSize) / pixelHeight;    // radius in y direction (pixels)
       std::vector<cv::Point> circleMask;
       cv::ellipse2Poly(centers[i], cv::Size(static_cast<int32_t>(radiusPx), static_cast<int32_t>(radiusPy)), 0, 0, 360, 1, circleMask);
 
-      cv::Mat mask1 = cv::Mat::zeros(tmpImage.size(), CV_8UC1);
-      fillConvexPoly(mask1, ifacet, cv::Scalar(255), 8, 0);
-
-      cv::Mat mask2 = cv::Mat::zeros(tmpImage.size(), CV_8UC1);
-      fillConvexPoly(mask2, circleMask, cv::Scalar(255), 8, 0);
+      auto drawBox = polygonBox(ifacet);
+      if(circleSize >= 0) {
+        drawBox &= polygonBox(circleMask);
+      }
+      if(drawBox.empty()) {
+        continue;
+      }
 
-      cv::Mat resultImage = cv::Mat::zeros(tmpImage.size(), CV_8UC1);
+      cv::Mat resultImage = fillInBox(drawBox, ifacet);
       if(circleSize >= 0) {
-        cv::bitwise_and(mask1, mask2, resultImage);
-      } else {
-        resultImage = mask1;
+        cv::bitwise_and(resultImage, fillInBox(drawBox, circleMask), resultImage);
       }
 
       auto box        = cv::boundingRect(resultImage);
       cv::Mat boxMask = resultImage(box) >= 0.2;
+      if(!box.empty()) {
+        box += drawBox.tl();
+      }
 
       std::vector<std::vector<cv::Point>> contours;
       cv::findContours(boxMask, contours, cv::RETR_LIST, cv::CHAIN_APPROX_NONE);
@@ -152,12 +167,12 @@ public:
   void applyFilter(processor::ProcessContext &context, const atom::SpheralIndex &voronoiGrid, const atom::SpheralIndex &voronoiPoints,
                    atom::ObjectList &objects);
 
-  static bool doesAreaContainsPoint(const atom::ROI &voronoiArea, const atom::SpheralIndex &voronoiPoints,
+  static bool doesAreaContainsPoint(const atom::ROI &voronoiArea, const std::vector<const atom::ROI *> &voronoiPoints,
                                     const std::set<enums::ClassId> &pointsClassIn)
   {
-    for(const auto &point : voronoiPoints) {
-      if(pointsClassIn.contains(point.getClassId())) {
-        if(voronoiArea.isIntersecting(point, 0.1F)) {
+    for(const auto *point : voronoiPoints) {
+      if(pointsClassIn.contains(point->getClassId())) {
+        if(voronoiArea.isIntersecting(*point, 0.1F)) {
           return true;
         }
       }
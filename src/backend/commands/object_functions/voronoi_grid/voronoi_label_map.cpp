@@ -0,0 +1,97 @@
+///
+/// \file      voronoi_label_map.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "voronoi_label_map.hpp"
+#include <algorithm>
+
+namespace joda::cmd {
+
+///
+/// \brief      Rasterizes the masks of the areas into one label image
+/// \author     Joachim Danmayr
+/// \param[in]  areas  Voronoi areas, the index in this vector is the area index
+///
+VoronoiLabelMap::VoronoiLabelMap(const std::vector<const joda::atom::ROI *> &areas)
+{
+  for(const auto *area : areas) {
+    mBoundingBox = mBoundingBox.empty() ? area->getBoundingBoxReal() : (mBoundingBox | area->getBoundingBoxReal());
+  }
+  mLabels = cv::Mat::zeros(std::max(mBoundingBox.height, 1), std::max(mBoundingBox.width, 1), CV_32SC1);
+
+  for(size_t idx = 0; idx < areas.size(); idx++) {
+    const auto &box  = areas[idx]->getBoundingBoxReal();
+    const auto &mask = areas[idx]->getMask();
+    const auto label = static_cast<int32_t>(idx + 1);
+    for(int y = 0; y < mask.rows && y < box.height; y++) {
+      const auto *maskRow = mask.ptr<uint8_t>(y);
+      auto *labelRow      = mLabels.ptr<int32_t>(box.y - mBoundingBox.y + y) + (box.x - mBoundingBox.x);
+      for(int x = 0; x < mask.cols && x < box.width; x++) {
+        if(maskRow[x] > 0) {
+          addLabel(labelRow[x], label);
+        }
+      }
+    }
+  }
+}
+
+///
+/// \brief      Stores the label of an area in a pixel
+/// \author     Joachim Danmayr
+///
+void VoronoiLabelMap::addLabel(int32_t &pixel, int32_t label)
+{
+  if(pixel == 0) {
+    pixel = label;
+  } else if(pixel > 0) {
+    mSharedLabels.push_back({pixel, label});
+    pixel = -static_cast<int32_t>(mSharedLabels.size());
+  } else {
+    mSharedLabels[static_cast<size_t>(-pixel - 1)].push_back(label);
+  }
+}
+
+///
+/// \brief      Areas at least one pixel of the ROI is part of
+/// \author     Joachim Danmayr
+/// \param[in]  roi  ROI in real coordinates
+/// \return     Indices of the areas in ascending order
+///
+auto VoronoiLabelMap::findAreas(const joda::atom::ROI &roi) const -> std::set<size_t>
+{
+  std::set<size_t> found;
+  const auto &box    = roi.getBoundingBoxReal();
+  const auto &mask   = roi.getMask();
+  const auto overlap = box & mBoundingBox;
+  if(overlap.empty() || mask.empty()) {
+    return found;
+  }
+
+  for(int y = overlap.y; y < overlap.y + overlap.height && y - box.y < mask.rows; y++) {
+    const auto *maskRow  = mask.ptr<uint8_t>(y - box.y);
+    const auto *labelRow = mLabels.ptr<int32_t>(y - mBoundingBox.y);
+    for(int x = overlap.x; x < overlap.x + overlap.width && x - box.x < mask.cols; x++) {
+      if(maskRow[x - box.x] == 0) {
+        continue;
+      }
+      const auto label = labelRow[x - mBoundingBox.x];
+      if(label > 0) {
+        found.emplace(static_cast<size_t>(label - 1));
+      } else if(label < 0) {
+        for(const auto shared : mSharedLabels[static_cast<size_t>(-label - 1)]) {
+          found.emplace(static_cast<size_t>(shared - 1));
+        }
+      }
+    }
+  }
+  return found;
+}
+
+}    // namespace joda::cmd
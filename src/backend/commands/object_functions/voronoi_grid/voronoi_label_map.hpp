@@ -0,0 +1,48 @@
+///
+/// \file      voronoi_label_map.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "backend/artifacts/roi/roi.hpp"
+#include <opencv2/core/mat.hpp>
+
+namespace joda::cmd {
+
+///
+/// \class      VoronoiLabelMap
+/// \author     Joachim Danmayr
+/// \brief      Label image of a voronoi tessellation. Every pixel holds the index
+///             of the area it belongs to, which areas an object touches is
+///             therefore found by visiting the pixels of the object once instead
+///             of intersecting it with every area. Neighbouring areas share their
+///             border pixels, those pixels hold all their areas.
+///
+class VoronoiLabelMap
+{
+public:
+  /////////////////////////////////////////////////////
+  explicit VoronoiLabelMap(const std::vector<const joda::atom::ROI *> &areas);
+  [[nodiscard]] auto findAreas(const joda::atom::ROI &roi) const -> std::set<size_t>;
+
+private:
+  /////////////////////////////////////////////////////
+  void addLabel(int32_t &pixel, int32_t label);
+
+  /////////////////////////////////////////////////////
+  cv::Rect mBoundingBox;                              // Real coordinates covered by the label image
+  cv::Mat mLabels;                                    // CV_32SC1, 0 = no area, > 0 = area index + 1, < 0 = -(index in mSharedLabels + 1)
+  std::vector<std::vector<int32_t>> mSharedLabels;    // Labels of pixels belonging to more than one area
+};
+
+}    // namespace joda::cmd
@@ -0,0 +1,57 @@
+///
+/// \file      voronoi_label_map_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <set>
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/commands/object_functions/voronoi_grid/voronoi_label_map.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::test {
+
+namespace {
+
+auto createRoi(const cv::Rect &box) -> atom::ROI
+{
+  atom::ROI::RoiObjectId index{.classId = enums::ClassId::C1, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 0}};
+  cv::Mat mask = cv::Mat::ones(box.size(), CV_8UC1) * 255;
+  return {index, 1, box, mask, {}, {}};
+}
+
+}    // namespace
+
+///
+/// \brief  Objects find all areas they touch, also the ones sharing a border
+/// \author Joachim Danmayr
+///
+TEST_CASE("voronoi_label_map::find_areas", "[voronoi_grid]")
+{
+  const auto left  = createRoi({0, 0, 10, 10});
+  const auto right = createRoi({9, 0, 10, 10});
+  const auto below = createRoi({0, 10, 19, 5});
+  const cmd::VoronoiLabelMap labelMap({&left, &right, &below});
+
+  CHECK(labelMap.findAreas(createRoi({2, 2, 3, 3})) == std::set<size_t>{0});
+  CHECK(labelMap.findAreas(createRoi({15, 2, 2, 2})) == std::set<size_t>{1});
+  CHECK(labelMap.findAreas(createRoi({9, 5, 1, 1})) == std::set<size_t>{0, 1});
+  CHECK(labelMap.findAreas(createRoi({8, 8, 4, 4})) == std::set<size_t>{0, 1, 2});
+  CHECK(labelMap.findAreas(createRoi({-5, -5, 3, 3})).empty());
+  CHECK(labelMap.findAreas(createRoi({50, 50, 3, 3})).empty());
+
+  // Only pixels inside the mask of the object count
+  cv::Mat cornerMask            = cv::Mat::zeros(4, 4, CV_8UC1);
+  cornerMask.at<uint8_t>(0, 0) = 255;
+  atom::ROI corner(atom::ROI::RoiObjectId{.classId = enums::ClassId::C1, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 0}}, 1, {8, 8, 4, 4},
+                   cornerMask, {}, {});
+  CHECK(labelMap.findAreas(corner) == std::set<size_t>{0});
+}
+
+}    // namespace joda::test
@@ -0,0 +1,109 @@
+///
+/// \file      linear_assignment.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "linear_assignment.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace joda::data_analyze::object_tracker {
+
+///
+/// \brief      Assigns each row to at most one column and each column to at most
+///             one row so that the sum of the costs is minimal.
+///             For each row a dummy column with cost costOfNonAssignment is added,
+///             a row is only assigned if this is cheaper than leaving it alone.
+/// \author     Joachim Danmayr
+/// \param[in]  costs                Cost matrix [row][col], all rows must have the same size
+/// \param[in]  costOfNonAssignment  Cost for leaving a row unassigned
+/// \return     Assigned column for each row or -1 if the row is not assigned
+///
+auto LinearAssignment::solve(const std::vector<std::vector<double>> &costs, double costOfNonAssignment) -> std::vector<int32_t>
+{
+  const size_t nrOfRows = costs.size();
+  if(nrOfRows == 0) {
+    return {};
+  }
+  const size_t nrOfRealCols = costs.front().size();
+  const size_t nrOfCols     = nrOfRealCols + nrOfRows;
+
+  auto cost = [&](size_t row, size_t col) -> double {
+    if(col < nrOfRealCols) {
+      return costs[row][col];
+    }
+    return col - nrOfRealCols == row ? costOfNonAssignment : FORBIDDEN;
+  };
+
+  //
+  // Indices are 1-based, column 0 is the virtual start column of the augmenting path
+  //
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  std::vector<double> potentialRow(nrOfRows + 1, 0);
+  std::vector<double> potentialCol(nrOfCols + 1, 0);
+  std::vector<size_t> rowOfCol(nrOfCols + 1, 0);
+  std::vector<size_t> prevCol(nrOfCols + 1, 0);
+  std::vector<double> minSlack(nrOfCols + 1);
+  std::vector<bool> visited(nrOfCols + 1);
+
+  for(size_t row = 1; row <= nrOfRows; row++) {
+    rowOfCol[0] = row;
+    size_t col0 = 0;
+    std::fill(minSlack.begin(), minSlack.end(), INF);
+    std::fill(visited.begin(), visited.end(), false);
+    do {
+      visited[col0]   = true;
+      const size_t r0 = rowOfCol[col0];
+      double delta    = INF;
+      size_t nextCol  = 0;
+      for(size_t col = 1; col <= nrOfCols; col++) {
+        if(visited[col]) {
+          continue;
+        }
+        const double slack = cost(r0 - 1, col - 1) - potentialRow[r0] - potentialCol[col];
+        if(slack < minSlack[col]) {
+          minSlack[col] = slack;
+          prevCol[col]  = col0;
+        }
+        if(minSlack[col] < delta) {
+          delta   = minSlack[col];
+          nextCol = col;
+        }
+      }
+      for(size_t col = 0; col <= nrOfCols; col++) {
+        if(visited[col]) {
+          potentialRow[rowOfCol[col]] += delta;
+          potentialCol[col] -= delta;
+        } else {
+          minSlack[col] -= delta;
+        }
+      }
+      col0 = nextCol;
+    } while(rowOfCol[col0] != 0);
+
+    // Flip the augmenting path
+    do {
+      const size_t col1 = prevCol[col0];
+      rowOfCol[col0]    = rowOfCol[col1];
+      col0              = col1;
+    } while(col0 != 0);
+  }
+
+  std::vector<int32_t> assignment(nrOfRows, -1);
+  for(size_t col = 1; col <= nrOfRealCols; col++) {
+    if(rowOfCol[col] != 0 && costs[rowOfCol[col] - 1][col - 1] < FORBIDDEN) {
+      assignment[rowOfCol[col] - 1] = static_cast<int32_t>(col - 1);
+    }
+  }
+  return assignment;
+}
+
+}    // namespace joda::data_analyze::object_tracker
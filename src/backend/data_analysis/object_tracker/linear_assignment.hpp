@@ -0,0 +1,36 @@
+///
+/// \file      linear_assignment.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace joda::data_analyze::object_tracker {
+
+///
+/// \class      LinearAssignment
+/// \author     Joachim Danmayr
+/// \brief      Optimal assignment of rows to columns (Hungarian method with
+///             potentials and shortest augmenting paths, O(n^2 * m)).
+///             Every row may also stay unassigned for a fixed cost, so the
+///             cost matrix does not need to be square.
+///
+class LinearAssignment
+{
+public:
+  /////////////////////////////////////////////////////
+  static constexpr double FORBIDDEN = 1e12;    // Cost of pairs which must never be assigned
+
+  static auto solve(const std::vector<std::vector<double>> &costs, double costOfNonAssignment) -> std::vector<int32_t>;
+};
+
+}    // namespace joda::data_analyze::object_tracker
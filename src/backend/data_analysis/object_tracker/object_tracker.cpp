@@ -1,16 +1,27 @@
-// ===============================
-// multi_object_tracker.h
-// ===============================
+///
+/// \file      object_tracker.cpp
+/// \author    Joachim Danmayr
+/// \date      2025-12-16
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
 
 #include "object_tracker.hpp"
 #include <algorithm>
-#include <limits>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <unordered_map>
 #include <vector>
 #include "backend/artifacts/roi/roi.hpp"
+#include "linear_assignment.hpp"
 
 namespace joda::data_analyze::object_tracker {
 
-ObjectTracker::ObjectTracker(float iouThreshold, int maxMisses) : mIouThreshold(iouThreshold), maxMisses_(maxMisses)
+ObjectTracker::ObjectTracker(float maxDistance, int maxMisses) : mMaxDistance(maxDistance), maxMisses_(maxMisses)
 {
 }
 
@@ -20,36 +31,55 @@ ObjectTracker::ObjectTracker(float iouThreshold, int maxMisses) : mIouThreshold(
 ///             Afterwards replace the tracking ID in the database from an object with the new video tracking ID
 ///             for the corresponding objects.
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
+/// \param[in,out]  spotsPerFrame  Objects per time frame, the tracking ID is replaced
 ///
 void ObjectTracker::runTracker(std::map<int32_t, std::vector<joda::atom::ROI>> &spotsPerFrame)
 {
-  // We reset possible old tracking IDs
-  std::map<uint64_t, uint64_t> objectIdVsTrackerId;
-  for(auto &[tStack, frame] : spotsPerFrame) {
-    for(auto &roi : frame) {
-      objectIdVsTrackerId.emplace(roi.getObjectId(), roi.getTrackingId());
-      roi.setTrackingId(0);
-    }
+  for(auto &[frameId, spots] : spotsPerFrame) {
+    update(static_cast<TimeFrame_t>(frameId), spots);
   }
+}
 
-  // Run tracking
-  for(auto &[frameId, spots] : spotsPerFrame) {
-    update(frameId, spots);
+///
+/// \brief      Tracks the ROIs of the next frame and writes the tracking ID to the ROIs
+/// \author     Joachim Danmayr
+///
+void ObjectTracker::update(TimeFrame_t /*frame*/, std::vector<joda::atom::ROI> &rois)
+{
+  std::vector<Detection> detections;
+  detections.reserve(rois.size());
+  for(const auto &roi : rois) {
+    const auto &box = roi.getBoundingBoxReal();
+    detections.push_back({.objectId = roi.getObjectId(), .center = roi.getCentroidReal(), .bbox = box});
+  }
+  update(detections);
+  for(size_t n = 0; n < rois.size(); n++) {
+    rois[n].setTrackingId(detections[n].trackingId);
+  }
+}
+
+///
+/// \brief      Tracks the detections of the next frame. Detections which could be linked
+///             to an existing track get the ID of the track, all others start a new track.
+/// \author     Joachim Danmayr
+/// \param[in,out]  detections  Detections of the next frame, the tracking ID is set
+///
+void ObjectTracker::update(std::vector<Detection> &detections)
+{
+  for(auto &d : detections) {
+    d.trackingId = 0;
   }
-  std::cout << "Finished" << std::endl;
+  predict();
+  associate(detections);
+  createTracks(detections);
+  cleanup();
 }
 
 ///
-/// \brief
+/// \brief      Constant velocity model on the object center
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
-cv::KalmanFilter ObjectTracker::createKF(const cv::Rect &r)
+cv::KalmanFilter ObjectTracker::createKF(const cv::Point2f &center)
 {
   cv::KalmanFilter kf(4, 2);
   kf.transitionMatrix  = (cv::Mat_<float>(4, 4) << 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1);
@@ -57,121 +87,170 @@ cv::KalmanFilter ObjectTracker::createKF(const cv::Rect &r)
   setIdentity(kf.processNoiseCov, cv::Scalar::all(1e-2));
   setIdentity(kf.measurementNoiseCov, cv::Scalar::all(1e-1));
   setIdentity(kf.errorCovPost, cv::Scalar::all(1));
-  kf.statePost.at<float>(0) = r.x + r.width / 2.f;
-  kf.statePost.at<float>(1) = r.y + r.height / 2.f;
+  kf.statePost.at<float>(0) = center.x;
+  kf.statePost.at<float>(1) = center.y;
   return kf;
 }
 
 ///
-/// \brief
-/// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
-///
-float ObjectTracker::iou(const cv::Rect &a, const cv::Rect &b)
-{
-  const int inter = (a & b).area();
-  const int uni   = a.area() + b.area() - inter;
-  return uni > 0 ? static_cast<float>(inter) / uni : 0.0f;
-}
-
-///
-/// \brief
+/// \brief      Predicts the position of all tracks in the next frame
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
 void ObjectTracker::predict()
 {
   for(auto &t : mTracks) {
-    auto p   = t.kf.predict();
-    t.bbox.x = p.at<float>(0) - t.bbox.width / 2;
-    t.bbox.y = p.at<float>(1) - t.bbox.height / 2;
+    auto p      = t.kf.predict();
+    t.predicted = {p.at<float>(0), p.at<float>(1)};
+    t.bbox.x    = static_cast<int32_t>(t.predicted.x) - t.bbox.width / 2;
+    t.bbox.y    = static_cast<int32_t>(t.predicted.y) - t.bbox.height / 2;
   }
 }
 
 ///
-/// \brief
+/// \brief      Links tracks and detections.
+///             1. The detections are stored in a uniform grid with cell size maxDistance,
+///                so the candidates of a track are in the 3x3 cells around the prediction.
+///             2. Tracks and detections connected by a candidate pair form a cluster.
+///             3. Each cluster is solved optimally. Leaving a track unassigned costs
+///                maxDistance, so a pair is only linked if this reduces the total distance.
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
-void ObjectTracker::associate(std::vector<joda::atom::ROI> &detections)
+void ObjectTracker::associate(std::vector<Detection> &detections)
 {
   if(mTracks.empty() || detections.empty()) {
+    for(auto &t : mTracks) {
+      t.missed++;
+    }
     return;
   }
 
-  cv::Mat cost(mTracks.size(), detections.size(), CV_32F);
-  for(size_t i = 0; i < mTracks.size(); ++i) {
-    for(size_t j = 0; j < detections.size(); ++j) {
-      cost.at<float>(i, j) = 1.0f - iou(mTracks[i].bbox, detections[j].getBoundingBoxReal());
+  const float cellSize = std::max(mMaxDistance, 1.0F);
+  auto cellOf          = [cellSize](float pos) -> int64_t { return static_cast<int64_t>(std::floor(pos / cellSize)); };
+  auto cellKey         = [](int64_t cx, int64_t cy) -> int64_t { return (cx << 32) ^ (cy & 0xFFFFFFFF); };
+  std::unordered_map<int64_t, std::vector<int32_t>> grid;
+  for(size_t d = 0; d < detections.size(); d++) {
+    grid[cellKey(cellOf(detections[d].center.x), cellOf(detections[d].center.y))].push_back(static_cast<int32_t>(d));
+  }
+
+  //
+  // Candidate pairs and union find over tracks [0, nrOfTracks) and detections [nrOfTracks, ...)
+  //
+  struct Candidate
+  {
+    int32_t track;
+    int32_t detection;
+    double distance;
+  };
+  const auto nrOfTracks = static_cast<int32_t>(mTracks.size());
+  std::vector<Candidate> candidates;
+  std::vector<int32_t> parent(mTracks.size() + detections.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto findRoot = [&parent](int32_t idx) {
+    while(parent[idx] != idx) {
+      parent[idx] = parent[parent[idx]];
+      idx         = parent[idx];
+    }
+    return idx;
+  };
+
+  for(int32_t t = 0; t < nrOfTracks; t++) {
+    const auto &pred = mTracks[t].predicted;
+    const auto cx    = cellOf(pred.x);
+    const auto cy    = cellOf(pred.y);
+    for(int64_t dy = -1; dy <= 1; dy++) {
+      for(int64_t dx = -1; dx <= 1; dx++) {
+        auto cell = grid.find(cellKey(cx + dx, cy + dy));
+        if(cell == grid.end()) {
+          continue;
+        }
+        for(int32_t d : cell->second) {
+          const double dist = cv::norm(detections[d].center - pred);
+          if(dist <= mMaxDistance) {
+            candidates.push_back({t, d, dist});
+            parent[findRoot(t)] = findRoot(nrOfTracks + d);
+          }
+        }
+      }
     }
   }
 
-  // Simple greedy matching (Hungarian can be plugged here)
-  std::vector<bool> used(detections.size(), false);
+  //
+  // Solve each cluster
+  //
+  std::unordered_map<int32_t, std::vector<size_t>> clusters;
+  for(size_t c = 0; c < candidates.size(); c++) {
+    clusters[findRoot(candidates[c].track)].push_back(c);
+  }
 
-  for(size_t i = 0; i < mTracks.size(); ++i) {
-    int best       = -1;
-    float bestCost = 1.0f - mIouThreshold;
-    for(size_t j = 0; j < detections.size(); ++j) {
-      if(used[j]) {
-        continue;
+  std::vector<bool> matched(mTracks.size(), false);
+  for(const auto &[_, pairs] : clusters) {
+    std::unordered_map<int32_t, int32_t> rowOfTrack;
+    std::unordered_map<int32_t, int32_t> colOfDetection;
+    std::vector<int32_t> tracks;
+    std::vector<int32_t> dets;
+    for(size_t c : pairs) {
+      if(rowOfTrack.try_emplace(candidates[c].track, static_cast<int32_t>(tracks.size())).second) {
+        tracks.push_back(candidates[c].track);
       }
-      if(cost.at<float>(i, j) < bestCost) {
-        bestCost = cost.at<float>(i, j);
-        best     = static_cast<int>(j);
+      if(colOfDetection.try_emplace(candidates[c].detection, static_cast<int32_t>(dets.size())).second) {
+        dets.push_back(candidates[c].detection);
       }
     }
-    if(best >= 0) {
-      auto &d = detections[best];
+    std::vector<std::vector<double>> costs(tracks.size(), std::vector<double>(dets.size(), LinearAssignment::FORBIDDEN));
+    for(size_t c : pairs) {
+      costs[rowOfTrack.at(candidates[c].track)][colOfDetection.at(candidates[c].detection)] = candidates[c].distance;
+    }
+
+    const auto assignment = LinearAssignment::solve(costs, mMaxDistance);
+    for(size_t row = 0; row < assignment.size(); row++) {
+      if(assignment[row] < 0) {
+        continue;
+      }
+      auto &track = mTracks[tracks[row]];
+      auto &det   = detections[dets[assignment[row]]];
       cv::Mat m(2, 1, CV_32F);
-      const auto &boundingBox = d.getBoundingBoxReal();
-      m.at<float>(0)          = boundingBox.x + boundingBox.width / 2.f;
-      m.at<float>(1)          = boundingBox.y + boundingBox.height / 2.f;
-      mTracks[i].kf.correct(m);
-      mTracks[i].bbox   = boundingBox;
-      mTracks[i].missed = 0;
-      d.setTrackingId(mTracks[i].id);
-      used[best] = true;
-    } else {
-      mTracks[i].missed++;
+      m.at<float>(0) = det.center.x;
+      m.at<float>(1) = det.center.y;
+      track.kf.correct(m);
+      track.bbox           = det.bbox;
+      track.missed         = 0;
+      det.trackingId       = track.id;
+      matched[tracks[row]] = true;
+    }
+  }
+
+  for(size_t t = 0; t < mTracks.size(); t++) {
+    if(!matched[t]) {
+      mTracks[t].missed++;
     }
   }
 }
 
 ///
-/// \brief
+/// \brief      Each detection which was not linked starts a new track.
+///             The IDs are taken from the global tracking ID generator, so they
+///             never collide with the IDs used for colocalization.
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
-void ObjectTracker::createTracks(std::vector<joda::atom::ROI> &detections)
+void ObjectTracker::createTracks(std::vector<Detection> &detections)
 {
   for(auto &d : detections) {
-    if(d.getTrackingId() != 0) {
+    if(d.trackingId != 0) {
       continue;
     }
     Track t;
-    t.id   = mNextId++;
-    t.bbox = d.getBoundingBoxReal();
-    t.kf   = createKF(t.bbox);
-    d.setTrackingId(t.id);
+    t.id         = joda::atom::ROI::generateNewTrackingId();
+    t.bbox       = d.bbox;
+    t.predicted  = d.center;
+    t.kf         = createKF(d.center);
+    d.trackingId = t.id;
     mTracks.push_back(t);
   }
 }
 
 ///
-/// \brief
+/// \brief      Removes tracks which were not seen for more than maxMisses frames
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
 void ObjectTracker::cleanup()
 {
@@ -179,20 +258,9 @@ void ObjectTracker::cleanup()
 }
 
 ///
-/// \brief
+/// \brief      Tracks which are still alive
 /// \author     Joachim Danmayr
-/// \param[in]
-/// \param[out]
-/// \return
 ///
-void ObjectTracker::update(TimeFrame_t, std::vector<joda::atom::ROI> &detections)
-{
-  predict();
-  associate(detections);
-  createTracks(detections);
-  cleanup();
-}
-
 std::vector<TrackState> ObjectTracker::getActiveTracks() const
 {
   std::vector<TrackState> out;
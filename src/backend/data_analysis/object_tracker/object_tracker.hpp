@@ -19,16 +19,6 @@
 
 namespace joda::data_analyze::object_tracker {
 
-// struct Spot
-//{
-//   int posX;
-//   int posY;
-//   int width;
-//   int height;
-//   uint64_t objectId;
-//   uint64_t trackingId = 0;
-// };
-
 using TimeFrame_t = uint32_t;
 
 struct TrackState
@@ -39,18 +29,35 @@ struct TrackState
 };
 
 ///
-/// \class
+/// \brief      Object found in one time frame
+///
+struct Detection
+{
+  uint64_t objectId = 0;
+  cv::Point2f center;
+  cv::Rect bbox;
+  uint64_t trackingId = 0;    // Set by the tracker
+};
+
+///
+/// \class      ObjectTracker
 /// \author     Joachim Danmayr
-/// \brief
+/// \brief      Links objects of consecutive time frames.
+///             The position of each track is predicted with a constant velocity
+///             Kalman filter. Only detections within maxDistance of the predicted
+///             position are candidates (looked up in a uniform grid), the tracks and
+///             candidates are split into independent clusters and each cluster is
+///             solved with an optimal linear assignment.
 ///
 class ObjectTracker
 {
 public:
   /////////////////////////////////////////////////////
-  ObjectTracker(float iouThreshold = 0.3f, int maxMisses = 5);
+  ObjectTracker(float maxDistance = 25.0F, int maxMisses = 5);
 
   void runTracker(std::map<int32_t, std::vector<joda::atom::ROI>> &spotsPerFrame);
   void update(TimeFrame_t frame, std::vector<joda::atom::ROI> &detections);
+  void update(std::vector<Detection> &detections);
   std::vector<TrackState> getActiveTracks() const;
 
 private:
@@ -60,21 +67,20 @@ private:
     uint64_t id;
     cv::KalmanFilter kf;
     cv::Rect bbox;
+    cv::Point2f predicted;
     int missed = 0;
   };
 
   std::vector<Track> mTracks;
-  uint64_t mNextId = 1;
-  float mIouThreshold;
+  float mMaxDistance;
   int maxMisses_;
 
   void predict();
-  void associate(std::vector<joda::atom::ROI> &detections);
-  void createTracks(std::vector<joda::atom::ROI> &detections);
+  void associate(std::vector<Detection> &detections);
+  void createTracks(std::vector<Detection> &detections);
   void cleanup();
 
-  static cv::KalmanFilter createKF(const cv::Rect &r);
-  static float iou(const cv::Rect &a, const cv::Rect &b);
+  static cv::KalmanFilter createKF(const cv::Point2f &center);
 };
 
 }    // namespace joda::data_analyze::object_tracker
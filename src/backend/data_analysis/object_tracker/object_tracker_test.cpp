@@ -9,9 +9,88 @@
 ///            For **Commercial** please contact the copyright owner.
 ///
 
-#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "linear_assignment.hpp"
 #include "object_tracker.hpp"
+#include <catch2/catch_test_macros.hpp>
 
 namespace joda::data_analyze::object_tracker {
 
+///
+/// \brief  Optimal assignment with the option to leave rows unassigned
+/// \author Joachim Danmayr
+///
+TEST_CASE("object_tracker::linear_assignment", "[object_tracker]")
+{
+  SECTION("Optimum is found where greedy matching fails")
+  {
+    // Greedy takes (0,0) first and has to pay 100 for row 1
+    std::vector<std::vector<double>> costs = {{1, 2}, {2, 100}};
+    auto assignment                        = LinearAssignment::solve(costs, 1000);
+    std::vector<int32_t> expected          = {1, 0};
+    CHECK(assignment == expected);
+  }
+
+  SECTION("Rows stay unassigned if this is cheaper")
+  {
+    std::vector<std::vector<double>> costs = {{5, LinearAssignment::FORBIDDEN}, {30, 40}};
+    auto assignment                        = LinearAssignment::solve(costs, 10);
+    std::vector<int32_t> expected          = {0, -1};
+    CHECK(assignment == expected);
+  }
+
+  SECTION("More rows than columns")
+  {
+    std::vector<std::vector<double>> costs = {{4}, {1}, {3}};
+    auto assignment                        = LinearAssignment::solve(costs, 10);
+    std::vector<int32_t> expected          = {-1, 0, -1};
+    CHECK(assignment == expected);
+  }
+
+  SECTION("Empty")
+  {
+    CHECK(LinearAssignment::solve({}, 10).empty());
+  }
+}
+
+///
+/// \brief  Crossing objects keep their tracking ID
+/// \author Joachim Danmayr
+///
+TEST_CASE("object_tracker::tracker", "[object_tracker]")
+{
+  ObjectTracker tracker(10, 1);
+  auto makeFrame = [](float t) {
+    std::vector<Detection> frame;
+    frame.push_back({.objectId = 1, .center = {100 + 4 * t, 100}, .bbox = {}});
+    frame.push_back({.objectId = 2, .center = {140 - 4 * t, 102}, .bbox = {}});
+    frame.push_back({.objectId = 3, .center = {500, 500 + 6 * t}, .bbox = {}});
+    return frame;
+  };
+
+  auto first = makeFrame(0);
+  tracker.update(first);
+  for(int t = 1; t < 10; t++) {
+    auto frame = makeFrame(static_cast<float>(t));
+    tracker.update(frame);
+    for(size_t n = 0; n < frame.size(); n++) {
+      CHECK(frame[n].trackingId == first[n].trackingId);
+    }
+  }
+  CHECK(tracker.getActiveTracks().size() == 3);
+
+  SECTION("Lost tracks are removed and new objects get a new ID")
+  {
+    std::vector<Detection> empty;
+    tracker.update(empty);
+    tracker.update(empty);
+    CHECK(tracker.getActiveTracks().empty());
+    std::vector<Detection> frame = {{.objectId = 4, .center = {100, 100}, .bbox = {}}};
+    tracker.update(frame);
+    CHECK(frame[0].trackingId != 0);
+    CHECK(frame[0].trackingId != first[0].trackingId);
+  }
+}
+
 }    // namespace joda::data_analyze::object_tracker
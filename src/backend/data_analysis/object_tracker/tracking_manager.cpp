@@ -0,0 +1,132 @@
+///
+/// \file      tracking_manager.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "tracking_manager.hpp"
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "backend/database/database_interface.hpp"
+
+namespace joda::data_analyze::object_tracker {
+
+TrackingManager::TrackingManager(db::DatabaseInterface *database) : mDatabase(database)
+{
+}
+
+///
+/// \brief      Must be called before the first tile of the image is processed
+/// \author     Joachim Danmayr
+/// \param[in]  imageId            Image ID in the database
+/// \param[in]  tStackStart        First time frame which is processed
+/// \param[in]  tStackEnd          One after the last time frame which is processed
+/// \param[in]  nrOfZStacks        Number of z-stacks which are processed
+/// \param[in]  nrOfTilesPerFrame  Number of tiles one plane is split into
+///
+void TrackingManager::registerImage(uint64_t imageId, int32_t tStackStart, int32_t tStackEnd, int32_t nrOfZStacks, int32_t nrOfTilesPerFrame)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto &image             = mImages[imageId];
+  image.tStackStart       = tStackStart;
+  image.tStackEnd         = tStackEnd;
+  image.nrOfTilesPerFrame = nrOfTilesPerFrame;
+  image.nrOfOpenFrames    = (tStackEnd - tStackStart) * nrOfZStacks;
+}
+
+///
+/// \brief      Adds the detections of one tile. Tracking is done as soon as the frame is complete.
+/// \author     Joachim Danmayr
+/// \param[in]  imageId          Image ID in the database
+/// \param[in]  tStack           Time frame of the detections
+/// \param[in]  zStack           Z-stack of the detections
+/// \param[in]  classId          Class of the detections, each class is tracked on its own
+/// \param[in]  maxDistance      Maximum distance in pixels an object can move between two frames
+/// \param[in]  maxMissedFrames  Number of frames a track is kept without detection
+/// \param[in]  detections       Detections of the tile
+///
+void TrackingManager::addDetections(uint64_t imageId, int32_t tStack, int32_t zStack, enums::ClassId classId, float maxDistance,
+                                    int32_t maxMissedFrames, std::vector<Detection> &&detections)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto image = mImages.find(imageId);
+  if(image == mImages.end()) {
+    return;
+  }
+  auto &streams = image->second.streams;
+  auto stream   = streams.find({zStack, classId});
+  if(stream == streams.end()) {
+    Stream newStream{.tracker = ObjectTracker(maxDistance, maxMissedFrames), .nextFrame = image->second.tStackStart, .pending = {}};
+    stream = streams.emplace(std::make_pair(zStack, classId), std::move(newStream)).first;
+  }
+  auto &pending = stream->second.pending[tStack];
+  pending.insert(pending.end(), std::make_move_iterator(detections.begin()), std::make_move_iterator(detections.end()));
+}
+
+///
+/// \brief      Must be called after the objects of the tile have been written to the database.
+///             If this was the last tile of the frame, all frames which can be tracked
+///             in order are tracked. The tracking IDs of an image are collected and
+///             written to the database with one update after its last frame.
+/// \author     Joachim Danmayr
+/// \param[in]  imageId  Image ID in the database
+/// \param[in]  tStack   Time frame of the finished tile
+/// \param[in]  zStack   Z-stack of the finished tile
+///
+void TrackingManager::tileFinished(uint64_t imageId, int32_t tStack, int32_t zStack)
+{
+  std::vector<std::pair<uint64_t, uint64_t>> objectIdTrackingId;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto imageIt = mImages.find(imageId);
+    if(imageIt == mImages.end()) {
+      return;
+    }
+    auto &image         = imageIt->second;
+    auto &finishedTiles = image.finishedTiles[{tStack, zStack}];
+    finishedTiles++;
+    if(finishedTiles < image.nrOfTilesPerFrame) {
+      return;
+    }
+    image.finishedTiles.erase({tStack, zStack});
+    auto &finishedFrames = image.finishedFrames[zStack];
+    finishedFrames.emplace(tStack);
+    image.nrOfOpenFrames--;
+
+    for(auto &[key, stream] : image.streams) {
+      if(key.first != zStack) {
+        continue;
+      }
+      while(stream.nextFrame < image.tStackEnd && finishedFrames.contains(stream.nextFrame)) {
+        std::vector<Detection> detections;
+        if(auto frame = stream.pending.find(stream.nextFrame); frame != stream.pending.end()) {
+          detections = std::move(frame->second);
+          stream.pending.erase(frame);
+        }
+        stream.tracker.update(detections);
+        for(const auto &detection : detections) {
+          image.trackingIds.emplace_back(detection.objectId, detection.trackingId);
+        }
+        stream.nextFrame++;
+      }
+    }
+
+    if(image.nrOfOpenFrames <= 0) {
+      objectIdTrackingId = std::move(image.trackingIds);
+      mImages.erase(imageIt);
+    }
+  }
+
+  if(!objectIdTrackingId.empty()) {
+    mDatabase->setTrackingIds(imageId, objectIdTrackingId);
+  }
+}
+
+}    // namespace joda::data_analyze::object_tracker
@@ -0,0 +1,77 @@
+///
+/// \file      tracking_manager.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "backend/enums/enums_classes.hpp"
+#include "object_tracker.hpp"
+
+namespace joda::db {
+class DatabaseInterface;
+}
+
+namespace joda::data_analyze::object_tracker {
+
+///
+/// \class      TrackingManager
+/// \author     Joachim Danmayr
+/// \brief      Tracks objects while the processor is running.
+///             The tiles of an image are processed in parallel and in any order.
+///             Pipeline steps hand over the detections of their tile, as soon as all
+///             tiles of a time frame are finished, all frames which are complete
+///             are tracked in order. The tracking IDs are written to the database
+///             once per image, after the last frame of the image was tracked.
+///             One tracker is used per image, z-stack and class.
+///
+class TrackingManager
+{
+public:
+  /////////////////////////////////////////////////////
+  explicit TrackingManager(db::DatabaseInterface *database);
+
+  void registerImage(uint64_t imageId, int32_t tStackStart, int32_t tStackEnd, int32_t nrOfZStacks, int32_t nrOfTilesPerFrame);
+  void addDetections(uint64_t imageId, int32_t tStack, int32_t zStack, enums::ClassId classId, float maxDistance, int32_t maxMissedFrames,
+                     std::vector<Detection> &&detections);
+  void tileFinished(uint64_t imageId, int32_t tStack, int32_t zStack);
+
+private:
+  /////////////////////////////////////////////////////
+  struct Stream
+  {
+    ObjectTracker tracker;
+    int32_t nextFrame;
+    std::map<int32_t, std::vector<Detection>> pending;    // Detections of frames which are not tracked yet
+  };
+
+  struct Image
+  {
+    int32_t tStackStart       = 0;
+    int32_t tStackEnd         = 0;
+    int32_t nrOfTilesPerFrame = 1;
+    int32_t nrOfOpenFrames    = 0;
+    std::map<std::pair<int32_t, int32_t>, int32_t> finishedTiles;    // [tStack, zStack] -> finished tiles
+    std::map<int32_t, std::set<int32_t>> finishedFrames;             // zStack -> tStacks with all tiles finished
+    std::map<std::pair<int32_t, enums::ClassId>, Stream> streams;    // [zStack, class]
+    std::vector<std::pair<uint64_t, uint64_t>> trackingIds;          // [objectId, trackingId] of the tracked frames
+  };
+
+  db::DatabaseInterface *mDatabase;
+  std::map<uint64_t, Image> mImages;
+  std::mutex mMutex;
+};
+
+}    // namespace joda::data_analyze::object_tracker
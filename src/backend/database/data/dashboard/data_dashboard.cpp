@@ -121,14 +121,14 @@ auto Dashboard::convert(const std::shared_ptr<joda::table::Table> tableIn, const
   // Lamda function to create the dashboard
   // ========================================
   std::map<TabWindowKey, std::shared_ptr<joda::table::Table>> tabs;
-  auto createDashboards = [&tabs, &isImageView](const std::map<uint32_t, Entry> &entries, DashboardType dashboardType) {
+  auto createDashboards = [&tabs, &isImageView, &tableIn](const std::map<uint32_t, Entry> &entries, DashboardType dashboardType) {
     for(const auto &[key, dashData] : entries) {
       auto midiKey = TabWindowKey{dashboardType, key};
       if(!tabs.contains(midiKey)) {
         tabs[midiKey] = std::make_shared<joda::table::Table>();
       }
       auto element01 = tabs.at(midiKey);
-      setData(element01, dashData.colName, dashData.cols, isImageView, dashboardType == DashboardType::COLOC, dashData.intersectingCol);
+      setData(element01, *tableIn, dashData.colName, dashData.cols, isImageView, dashboardType == DashboardType::COLOC, dashData.intersectingCol);
     }
   };
 
@@ -147,7 +147,7 @@ auto Dashboard::convert(const std::shared_ptr<joda::table::Table> tableIn, const
 /// \param[out]
 /// \return
 ///
-void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, const std::string &description,
+void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, const joda::table::Table &tableIn, const std::string &description,
                         const std::vector<const table::TableColumn *> &cols, bool isImageView, bool isColoc,
                         const table::TableColumn *intersectingColl)
 {
@@ -168,6 +168,13 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
   std::map<uint64_t, RowInfo> trackingIdMapping;    // Key is the tracking_id and value the row where this tracking_id was first placed
   int32_t highestRow = 0;
 
+  // The row names are shared by all columns, the first column placed in a row names it
+  auto setRowName = [&tableToSet, &tableIn](uint32_t rowToPlace, uint32_t rowIn) {
+    if(tableToSet->getRowHeader(rowToPlace).empty()) {
+      tableToSet->setRowName(rowToPlace, tableIn.getRowHeader(rowIn));
+    }
+  };
+
   // We add a column with the object ID as first column
   int32_t COL_IDX_OBJECT_ID          = 0;
   const int32_t COL_IDX_INTERSECTING = 1;
@@ -199,8 +206,12 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
     }
 
     int row = 0;
-    for(const auto &[_, rowData] : colData->rows) {
-      if(isImageView && rowData->getObjectId() == 0) {
+    for(uint32_t rowIn = 0; rowIn < colData->getNrOfRows(); rowIn++) {
+      if(!colData->contains(rowIn)) {
+        continue;
+      }
+      const auto rowData = colData->at(rowIn);
+      if(isImageView && rowData.getObjectId() == 0) {
         continue;
       }
 
@@ -209,21 +220,21 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
       // =====================================
       int32_t rowToPlace = row;
       if(isColoc && isImageView) {
-        if(rowData->getTrackingId() == 0) {
+        if(rowData.getTrackingId() == 0) {
           // This should not happen, but if we continue
           continue;
         }
 
-        if(trackingIdMapping.contains(rowData->getTrackingId())) {
-          rowToPlace = trackingIdMapping.at(rowData->getTrackingId()).startingRow;
-          bgColor    = trackingIdMapping.at(rowData->getTrackingId()).bgColor;
+        if(trackingIdMapping.contains(rowData.getTrackingId())) {
+          rowToPlace = trackingIdMapping.at(rowData.getTrackingId()).startingRow;
+          bgColor    = trackingIdMapping.at(rowData.getTrackingId()).bgColor;
         } else {
           if(alternate % 2 != 0) {
             bgColor = ALTERNATE_COLOR;
           } else {
             bgColor = BASE_COLOR;
           }
-          trackingIdMapping.emplace(rowData->getTrackingId(), RowInfo{highestRow, bgColor});
+          trackingIdMapping.emplace(rowData.getTrackingId(), RowInfo{highestRow, bgColor});
           highestRow++;
           alternate++;
         }
@@ -233,9 +244,9 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
       // Alternating row color
       // =====================================
       if(!isColoc) {
-        auto key = rowData->getParentId();
+        auto key = rowData.getParentId();
         if(key == 0) {
-          key = rowData->getObjectId();
+          key = rowData.getObjectId();
         }
         if(!startOfNewParent.contains(key)) {
           if(alternate % 2 != 0) {
@@ -259,12 +270,12 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
         colKey.stats          = enums::Stats::OFF;
         tableToSet->setColHeader(COL_IDX_OBJECT_ID, colKey);
 
-        auto objectIdCell = std::make_shared<joda::table::TableCell>(rowData);
-        objectIdCell->setIsObjectIdCell(true);
+        auto objectIdCell = rowData.toCell();
+        objectIdCell.setIsObjectIdCell(true);
         if(bgColor == BASE_COLOR) {
-          objectIdCell->setBackgroundColor(LIGHT_BLUE);
+          objectIdCell.setBackgroundColor(LIGHT_BLUE);
         } else {
-          objectIdCell->setBackgroundColor(DARK_BLUE);
+          objectIdCell.setBackgroundColor(DARK_BLUE);
         }
         tableToSet->setData(rowToPlace, COL_IDX_OBJECT_ID, objectIdCell);
       }
@@ -273,8 +284,10 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
       // Add data
       // =========================================
       tableToSet->setColHeader(colTableTmp, actColumnKey);
-      tableToSet->setData(rowToPlace, colTableTmp, rowData);
-      rowData->setBackgroundColor(bgColor);
+      auto dataCell = rowData.toCell();
+      dataCell.setBackgroundColor(bgColor);
+      tableToSet->setData(rowToPlace, colTableTmp, dataCell);
+      setRowName(rowToPlace, rowIn);
 
       row++;
     }
@@ -297,15 +310,19 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
   // =========================================
 
   if(nullptr != intersectingColl && isImageView && !isColoc) {
-    for(const auto &[_, rowData] : intersectingColl->rows) {
-      if(rowData->getObjectId() == 0 || !startOfNewParent.contains(rowData->getObjectId())) {
+    for(uint32_t rowIn = 0; rowIn < intersectingColl->getNrOfRows(); rowIn++) {
+      if(!intersectingColl->contains(rowIn)) {
+        continue;
+      }
+      const auto rowData = intersectingColl->at(rowIn);
+      if(rowData.getObjectId() == 0 || !startOfNewParent.contains(rowData.getObjectId())) {
         continue;
       }
 
-      auto [row, bgColorIn] = startOfNewParent.at(rowData->getObjectId());
+      auto [row, bgColorIn] = startOfNewParent.at(rowData.getObjectId());
       // We link to the parent. So if the users clicks on this cell, he gets the information about the parent object
       // rowData.getVal() contains the number of elements we have to fill
-      for(int n = 0; n < rowData->getVal(); n++) {
+      for(int n = 0; n < rowData.getVal(); n++) {
         int32_t rowTemp = row + n;
         // Header
         auto colKey           = intersectingColl->colSettings;
@@ -314,11 +331,12 @@ void Dashboard::setData(const std::shared_ptr<joda::table::Table> &tableToSet, c
         tableToSet->setColHeader(COL_IDX_INTERSECTING, colKey);
 
         // Header is filled out above
-        auto objectIdCell = std::make_shared<joda::table::TableCell>(rowData);
-        objectIdCell->setBackgroundColor(bgColorIn);
-        objectIdCell->setIsObjectIdCell(true);    // This is special, we print the object ID of the parent which is the paren object ID from this
-                                                  // object but the object id from the referencing object
+        auto objectIdCell = rowData.toCell();
+        objectIdCell.setBackgroundColor(bgColorIn);
+        objectIdCell.setIsObjectIdCell(true);    // This is special, we print the object ID of the parent which is the paren object ID from this
+                                                 // object but the object id from the referencing object
         tableToSet->setData(static_cast<uint32_t>(rowTemp), COL_IDX_INTERSECTING, objectIdCell);
+        setRowName(static_cast<uint32_t>(rowTemp), rowIn);
       }
     }
   }
@@ -46,7 +46,7 @@ public:
 
 private:
   /////////////////////////////////////////////////////
-  static void setData(const std::shared_ptr<joda::table::Table> &tableToSet, const std::string &description,
+  static void setData(const std::shared_ptr<joda::table::Table> &tableToSet, const joda::table::Table &tableIn, const std::string &description,
                       const std::vector<const table::TableColumn *> &cols, bool isImageView, bool isColoc,
                       const table::TableColumn *intersectingColl);
 };
@@ -45,6 +45,23 @@ std::string numberToExcelColumn(uint32_t number)
 ///
 auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t cols, uint32_t colToDisplay, int32_t tStackIn,
                       const PlotPlateSettings &settings) -> joda::table::Table
+{
+  auto column = table->columns().find(colToDisplay);
+  if(column == table->columns().end()) {
+    static const joda::table::TableColumn emptyColumn;
+    return convertToHeatmap(emptyColumn, rows, cols, tStackIn, settings);
+  }
+  return convertToHeatmap(column->second, rows, cols, tStackIn, settings);
+}
+
+///
+/// \brief      Places the cells of the column at their position in the plate,
+///             well or image. The column is read in place, only the cells
+///             placed in the heatmap are copied.
+/// \author     Joachim Danmayr
+///
+auto convertToHeatmap(const joda::table::TableColumn &colData, uint32_t rows, uint32_t cols, int32_t tStackIn, const PlotPlateSettings &settings)
+    -> joda::table::Table
 {
   if(rows == 0) {
     return {};
@@ -72,26 +89,22 @@ auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t c
   }
 
   for(uint32_t y = 0; y < rows; y++) {
-    if(nullptr == data.data(y, 0)) {
-      data.setData(y, 0, std::make_shared<joda::table::TableCell>());
+    if(!data.data(y, 0).has_value()) {
+      data.setData(y, 0, joda::table::TableCell{});
     }
-    data.mutableData(y, 0)->setRowName(numberToExcelColumn(y + 1));
+    data.setRowName(y, numberToExcelColumn(y + 1));
   }
+
   std::optional<joda::table::TableCell> cellTmp;    // Needed for the density map
-  for(uint32_t tblRow = 0; tblRow < table->getNrOfRows(); tblRow++) {
-    std::shared_ptr<const table::TableCell> tmp = table->data(tblRow, colToDisplay);
-    if(tmp == nullptr) {
-      continue;
-    }
-    auto cellData = std::make_shared<joda::table::TableCell>(tmp);
-    if(cellData == nullptr) {
+  for(uint32_t tblRow = 0; tblRow < colData.getNrOfRows(); tblRow++) {
+    if(!colData.contains(tblRow)) {
       continue;
     }
-    uint32_t posX   = cellData->getPosX();
-    uint32_t posY   = cellData->getPosY();
-    uint32_t tStack = cellData->getStackT();
-    // uint64_t groupId = cellData->getGroupId();
-    cellData->setRowName(numberToExcelColumn(posY));
+    const auto cellData = colData.at(tblRow);
+    uint32_t posX       = cellData.getPosX();
+    uint32_t posY       = cellData.getPosY();
+    uint32_t tStack     = cellData.getStackT();
+    // uint64_t groupId = cellData.getGroupId();
     if(static_cast<int32_t>(tStack) == tStackIn) {
       if(posX <= 0 || posY <= 0) {
         continue;
@@ -99,9 +112,9 @@ auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t c
       posX--;    // The maps start counting at 1
       posY--;    // The maps start counting at 1
       if(densityMapSize > 0) {
-        if(!cellData->isNAN() && cellData->isValid()) {
+        if(!cellData.isNAN() && cellData.isValid()) {
           if(!cellTmp.has_value()) {
-            cellTmp.emplace(cellData);
+            cellTmp.emplace(cellData.toCell());
           }
           posX = static_cast<uint32_t>(std::round(static_cast<double>(posX) / static_cast<double>(densityMapSize)));
           posY = static_cast<uint32_t>(std::round(static_cast<double>(posY) / static_cast<double>(densityMapSize)));
@@ -111,12 +124,12 @@ auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t c
           if(posY >= rows) {
             posY = rows - 1;
           }
-          densityMapVal[{posX, posY}].val += cellData->getVal();
+          densityMapVal[{posX, posY}].val += cellData.getVal();
           densityMapVal[{posX, posY}].cnt++;
           densityMapVal[{posX, posY}].tblRow = static_cast<int32_t>(tblRow);
         }
       } else {
-        data.setData(posY, posX, cellData);
+        data.setData(posY, posX, cellData.toCell());
       }
     }
   }
@@ -127,7 +140,7 @@ auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t c
   if(densityMapSize > 0) {
     for(const auto &[pos, value] : densityMapVal) {
       double val = value.val;
-      if(table->columns().at(colToDisplay).colSettings.measureChannel != enums::Measurement::COUNT) {
+      if(colData.colSettings.measureChannel != enums::Measurement::COUNT) {
         // Only calculate an average if not counting
         val /= static_cast<double>(value.cnt);
       }
@@ -135,7 +148,6 @@ auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t c
       uint32_t posX = pos.posX;
       // int32_t tblRow = value.tblRow;
       if(cellTmp.has_value()) {
-        cellTmp->setRowName(numberToExcelColumn(posY + 1));
         cellTmp->setVal(val);
         data.setData(posY, posX, cellTmp.value());
       }
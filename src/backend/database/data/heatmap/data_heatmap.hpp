@@ -25,5 +25,7 @@ struct PlotPlateSettings
 
 auto convertToHeatmap(const joda::table::Table *table, uint32_t rows, uint32_t cols, uint32_t colToDisplay, int32_t tStackIn,
                       const PlotPlateSettings &settings) -> joda::table::Table;
+auto convertToHeatmap(const joda::table::TableColumn &column, uint32_t rows, uint32_t cols, int32_t tStackIn, const PlotPlateSettings &settings)
+    -> joda::table::Table;
 
 }    // namespace joda::db::data
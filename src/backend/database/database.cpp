@@ -13,15 +13,26 @@
 
 #include "database.hpp"
 #include <duckdb.h>
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <future>
+#include <iomanip>
+#include <locale>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <variant>
 #include "backend/artifacts/object_list/object_list.hpp"
+#include "backend/database/query/stats_aggregates.hpp"
 #include "backend/enums/enums_classes.hpp"
 #include "backend/enums/enums_grouping.hpp"
 #include "backend/enums/enums_units.hpp"
@@ -30,9 +41,11 @@
 #include "backend/helper/file_grouper/file_grouper.hpp"
 #include "backend/helper/file_grouper/file_grouper_types.hpp"
 #include "backend/helper/fnv1a.hpp"
+#include "backend/helper/helper.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/helper/reader/image_reader.hpp"
-#include "backend/helper/rle/rle.hpp"
+#include "backend/helper/rle/mask_codec.hpp"
+#include "backend/helper/threading/task_scheduler.hpp"
 #include "backend/helper/uuid.hpp"
 #include "backend/processor/initializer/pipeline_initializer.hpp"
 #include "backend/settings/analze_settings.hpp"
@@ -54,6 +67,22 @@
 
 namespace joda::db {
 
+namespace {
+
+///
+/// \brief      Appends binary data to a BLOB column, empty data is stored as NULL
+///
+void appendBlob(duckdb::Appender &appender, const std::string &data)
+{
+  if(data.empty()) {
+    appender.AppendDefault();
+  } else {
+    appender.Append<duckdb::Value>(duckdb::Value::BLOB(reinterpret_cast<duckdb::const_data_ptr_t>(data.data()), data.size()));
+  }
+}
+
+}    // namespace
+
 template <class KEY, class VALUE>
 auto duckdbMapToMap(auto &materializedResult) -> std::map<KEY, std::set<VALUE>>
 {
@@ -80,12 +109,39 @@ void Database::openDatabase(const std::filesystem::path &pathToDb)
 {
   mDbCfg = std::make_unique<duckdb::DBConfig>();
   mDbCfg->SetOption("temp_directory", pathToDb.parent_path().string());
-  mDb = std::make_unique<duckdb::DuckDB>(pathToDb.string(), mDbCfg.get());
+  {
+    std::lock_guard<std::mutex> lock(mDbLock);
+    mDb = std::make_shared<duckdb::DuckDB>(pathToDb.string(), mDbCfg.get());
+  }
   createTables();
 }
 
+///
+/// \brief      Uses the database instance of another, already opened database.
+///             DuckDB allows only one instance per file, but any number of
+///             connections to it. This way the results of a running job can be
+///             read in the same process while the job is writing them.
+///             The instance is kept open until all sharing databases are closed.
+/// \author     Joachim Danmayr
+/// \param[in]  other  Opened database, for example the one of the running job
+///
+void Database::shareDatabase(const Database &other)
+{
+  std::shared_ptr<duckdb::DuckDB> db;
+  {
+    std::lock_guard<std::mutex> lock(other.mDbLock);
+    db = other.mDb;
+  }
+  if(db == nullptr) {
+    throw std::invalid_argument("Database to share is not opened!");
+  }
+  std::lock_guard<std::mutex> lock(mDbLock);
+  mDb = std::move(db);
+}
+
 void Database::closeDatabase()
 {
+  std::lock_guard<std::mutex> lock(mDbLock);
   mDb.reset();
 }
 
@@ -114,6 +170,7 @@ void Database::createTables()
       " settings_tile_height UINTEGER,"
       " settings_image_series UINTEGER,"
       " physicalPixelSizeUnit STRING,"
+      " settings_hash UBIGINT,"
       " PRIMARY KEY (job_id),"
       " FOREIGN KEY(experiment_id) REFERENCES experiment(experiment_id)"
       ");"
@@ -136,6 +193,9 @@ void Database::createTables()
       "ALTER TABLE jobs "
       " ADD COLUMN IF NOT EXISTS physicalPixelSizeUnit STRING DEFAULT 'Px';\n"
 
+      "ALTER TABLE jobs "
+      " ADD COLUMN IF NOT EXISTS settings_hash UBIGINT DEFAULT 0;\n"
+
       "CREATE TABLE IF NOT EXISTS plates ("
       " job_id UUID,"
       " plate_id USMALLINT,"
@@ -263,7 +323,13 @@ void Database::createTables()
       " meas_origin_object_id UBIGINT,"
       " meas_parent_object_id UBIGINT,"
       " meas_parent_class_id USMALLINT DEFAULT NULL,"    // Class ID of the parent object
-      " meas_tracking_id UBIGINT"    // Elements having the same linked_object_id represent the same element (e.g used for coloc or object tracking)
+      " meas_tracking_id UBIGINT,"    // Elements having the same linked_object_id represent the same element (e.g used for coloc or object tracking)
+      " meas_mask_encoded BLOB,"       // Mask encoded with joda::rle::encodeMask
+      " meas_contour_encoded BLOB,"    // Contour encoded with joda::rle::encodeContour
+      " meas_stack_z_end UINTEGER,"    // Last z-stack of objects segmented in 3D, stack_z is the first one. NULL for 2D objects
+      " meas_voxel_count UBIGINT,"     // Only set for objects segmented in 3D
+      " meas_volume DOUBLE,"           // Only set for objects segmented in 3D
+      " meas_center_z DOUBLE"          // Centroid Z of objects segmented in 3D, meas_center_x/y are the 3D centroid too
       ");"
 
       "ALTER TABLE objects "
@@ -278,6 +344,24 @@ void Database::createTables()
       "ALTER TABLE objects "
       " ADD COLUMN IF NOT EXISTS meas_parent_class_id USMALLINT DEFAULT NULL;\n"
 
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_mask_encoded BLOB DEFAULT NULL;\n"
+
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_contour_encoded BLOB DEFAULT NULL;\n"
+
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_stack_z_end UINTEGER DEFAULT NULL;\n"
+
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_voxel_count UBIGINT DEFAULT NULL;\n"
+
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_volume DOUBLE DEFAULT NULL;\n"
+
+      "ALTER TABLE objects "
+      " ADD COLUMN IF NOT EXISTS meas_center_z DOUBLE DEFAULT NULL;\n"
+
       "CREATE TABLE IF NOT EXISTS object_measurements ("
       "	image_id UBIGINT,"
       " object_id UBIGINT,"
@@ -287,9 +371,13 @@ void Database::createTables()
       " meas_intensity_sum UBIGINT,"
       " meas_intensity_avg float,"
       " meas_intensity_min UINTEGER,"
-      " meas_intensity_max UINTEGER"
+      " meas_intensity_max UINTEGER,"
+      " meas_intensity_stddev float"
       ");"
 
+      "ALTER TABLE object_measurements "
+      " ADD COLUMN IF NOT EXISTS meas_intensity_stddev float DEFAULT NULL;\n"
+
       "CREATE TABLE IF NOT EXISTS distance_measurements ("
       "	image_id UBIGINT,"
       " object_id UBIGINT,"
@@ -306,6 +394,30 @@ void Database::createTables()
       " meas_distance_surface_to_surface_max DOUBLE"
       ");"
 
+      "CREATE TABLE IF NOT EXISTS pipeline_step_profiling ("
+      " job_id UUID,"
+      " image_id UBIGINT,"
+      " pipeline_idx INTEGER,"
+      " step_idx INTEGER,"    // -1 is the whole pipeline including image loading
+      " command TEXT,"
+      " tile_x INTEGER,"
+      " tile_y INTEGER,"
+      " stack_t INTEGER,"
+      " stack_z INTEGER,"
+      " wall_time_ns UBIGINT,"
+      " cpu_time_ns UBIGINT,"    // CPU time of the executing thread
+      " nr_of_objects UBIGINT"
+      ");"
+
+      "CREATE TABLE IF NOT EXISTS work_units ("    // Tiles whose objects have been stored completely
+      " image_id UBIGINT,"
+      " tile_x INTEGER,"
+      " tile_y INTEGER,"
+      " stack_t INTEGER,"
+      " stack_z INTEGER,"
+      " PRIMARY KEY (image_id, tile_x, tile_y, stack_t, stack_z)"
+      ");"
+
       "CREATE TABLE IF NOT EXISTS cache_analyze_settings ("
       " job_id UUID,"
       " output_classes INTEGER[],"                         // A list of output channels
@@ -321,6 +433,10 @@ void Database::createTables()
   if(resultCreate->HasError()) {
     throw std::invalid_argument(resultCreate->GetError());
   }
+  resultCreate = connection->Query(StatsAggregates::createTables());
+  if(resultCreate->HasError()) {
+    throw std::invalid_argument(resultCreate->GetError());
+  }
 
   //
   // Do some migrations
@@ -424,18 +540,128 @@ std::unique_ptr<duckdb::QueryResult> Database::select(const std::string &query,
 }
 
 ///
-/// \brief
-/// \author
-/// \param[in]
-/// \param[out]
-/// \return
+/// \brief      Executes independent select statements concurrently. Each statement
+///             runs on its own connection, small statements which do not profit
+///             from the parallelism inside of DuckDB are executed side by side.
+/// \author     Joachim Danmayr
+/// \param[in]  queries  Statements and the values of their parameters
+/// \return     Materialized results in the order of the statements
+///
+auto Database::selectAll(const std::vector<std::pair<std::string, DbArgs_t>> &queries)
+    -> std::vector<std::unique_ptr<duckdb::MaterializedQueryResult>>
+{
+  std::vector<std::unique_ptr<duckdb::MaterializedQueryResult>> results(queries.size());
+  if(queries.empty()) {
+    return results;
+  }
+  const auto nrOfThreads = std::min<size_t>(queries.size(), std::max(1U, std::thread::hardware_concurrency()));
+  BS::thread_pool<> pool(nrOfThreads);
+  std::vector<std::future<void>> futures;
+  futures.reserve(queries.size());
+  for(size_t n = 0; n < queries.size(); n++) {
+    futures.emplace_back(pool.submit_task([this, &queries, &results, n]() {
+      auto result = select(queries[n].first, queries[n].second);
+      if(result->HasError()) {
+        throw std::invalid_argument(result->GetError());
+      }
+      results[n] = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    }));
+  }
+  // The pool is destroyed before the results, running statements are finished if one failed
+  for(auto &future : futures) {
+    future.get();
+  }
+  return results;
+}
+
+///
+/// \brief      Writes the result of a select statement with DuckDBs COPY ... TO
+///             directly to a CSV or Parquet file. The rows are streamed from
+///             the query to the file, the result is never materialized.
+/// \author     Joachim Danmayr
+/// \param[in]  query       Select statement, may contain parameters $1, $2, ...
+/// \param[in]  args        Values of the parameters
+/// \param[in]  format      Output file format
+/// \param[in]  outputFile  File to write, an existing file is overwritten
+///
+void Database::copyTo(const std::string &query, const DbArgs_t &args, CopyFormat format, const std::filesystem::path &outputFile)
+{
+  std::string path = outputFile.string();
+  helper::stringReplace(path, "'", "''");
+  std::string options;
+  switch(format) {
+    case CopyFormat::CSV:
+      options = "(FORMAT CSV, HEADER)";
+      break;
+    case CopyFormat::PARQUET:
+      options = "(FORMAT PARQUET, COMPRESSION ZSTD)";
+      break;
+  }
+
+  auto connection = acquire();
+  auto result     = connection->Query("COPY (" + bindArgsAsLiterals(query, args) + ") TO '" + path + "' " + options);
+  if(result->HasError()) {
+    throw std::invalid_argument(result->GetError());
+  }
+}
+
+///
+/// \brief      COPY statements cannot be prepared, therefore the parameters
+///             $1, $2, ... are replaced by the SQL literals of the values.
+///             The query is scanned once, so a parameter value is never replaced again.
+/// \author     Joachim Danmayr
+///
+auto Database::bindArgsAsLiterals(const std::string &query, const DbArgs_t &args) -> std::string
+{
+  auto toLiteral = [](const auto &value) -> std::string {
+    using T = std::decay_t<decltype(value)>;
+    if constexpr(std::is_same_v<T, std::string>) {
+      std::string escaped = value;
+      helper::stringReplace(escaped, "'", "''");
+      return "'" + escaped + "'";
+    } else if constexpr(std::is_same_v<T, double>) {
+      std::ostringstream stream;
+      stream.imbue(std::locale::classic());
+      stream << std::setprecision(17) << value;
+      return stream.str();
+    } else {
+      return std::to_string(value);
+    }
+  };
+
+  std::string sql;
+  sql.reserve(query.size());
+  for(size_t n = 0; n < query.size(); n++) {
+    if(query[n] != '$' || n + 1 >= query.size() || std::isdigit(static_cast<unsigned char>(query[n + 1])) == 0) {
+      sql += query[n];
+      continue;
+    }
+    size_t idx = 0;
+    while(n + 1 < query.size() && std::isdigit(static_cast<unsigned char>(query[n + 1])) != 0) {
+      idx = idx * 10 + static_cast<size_t>(query[n + 1] - '0');
+      n++;
+    }
+    if(idx == 0 || idx > args.size()) {
+      throw std::invalid_argument("Query parameter $" + std::to_string(idx) + " has no value!");
+    }
+    sql += std::visit(toLiteral, args[idx - 1]);
+  }
+  return sql;
+}
+
+///
+/// \brief      Stores the objects of one work unit. The objects and the work
+///             unit are written in one transaction, if the process dies while
+///             writing nothing of the unit is stored and it is executed again
+///             when the job is resumed.
+/// \author     Joachim Danmayr
 ///
 void Database::insertObjects(const processor::PipelineInitializer &imgContext, enums::Units physicalSizeUnit,
-                             const joda::atom::ObjectList &objectsList)
+                             const joda::atom::ObjectList &objectsList, const WorkUnit &workUnit)
 {
+  auto connection = acquire();
   try {
-    auto connection = acquire();
-    // connection->BeginTransaction();
+    connection->BeginTransaction();
     auto objects               = duckdb::Appender(*connection, "objects");
     auto object_measurements   = duckdb::Appender(*connection, "object_measurements");
     auto distance_measurements = duckdb::Appender(*connection, "distance_measurements");
@@ -456,23 +682,21 @@ void Database::insertObjects(const processor::PipelineInitializer &imgContext, e
         objects.Append<double>(roi.getAreaSize(physicalSize, physicalSizeUnit));             // " meas_area_size DOUBLE,"
         objects.Append<float>(roi.getPerimeter(physicalSize, physicalSizeUnit));             // " meas_perimeter float,"
         objects.Append<float>(roi.getCircularity());                                         // " meas_circularity float,"
-        objects.Append<uint32_t>(static_cast<uint32_t>(roi.getCentroidReal().x));            // " meas_center_x UINTEGER,"
-        objects.Append<uint32_t>(static_cast<uint32_t>(roi.getCentroidReal().y));            // " meas_center_y UINTEGER,"
+        if(roi.isVolume()) {
+          objects.Append<uint32_t>(static_cast<uint32_t>(std::lround(roi.getVolume().centroid.x)));    // " meas_center_x UINTEGER,"
+          objects.Append<uint32_t>(static_cast<uint32_t>(std::lround(roi.getVolume().centroid.y)));    // " meas_center_y UINTEGER,"
+        } else {
+          objects.Append<uint32_t>(static_cast<uint32_t>(roi.getCentroidReal().x));    // " meas_center_x UINTEGER,"
+          objects.Append<uint32_t>(static_cast<uint32_t>(roi.getCentroidReal().y));    // " meas_center_y UINTEGER,"
+        }
         objects.Append<uint32_t>(static_cast<uint32_t>(roi.getBoundingBoxReal().x));         // " meas_box_x UINTEGER,"
         objects.Append<uint32_t>(static_cast<uint32_t>(roi.getBoundingBoxReal().y));         // " meas_box_y UINTEGER,"
         objects.Append<uint32_t>(static_cast<uint32_t>(roi.getBoundingBoxReal().width));     // " meas_box_width UINTEGER,"
         objects.Append<uint32_t>(static_cast<uint32_t>(roi.getBoundingBoxReal().height));    // " meas_box_height UINTEGER,"
 
-        auto mask =
-            duckdb::Value::MAP(duckdb::LogicalType(duckdb::LogicalTypeId::UINTEGER), duckdb::LogicalType(duckdb::LogicalTypeId::BOOLEAN), {}, {});
-        objects.Append<duckdb::Value>(mask);
-        /* objects.Append<duckdb::Value>(
-             joda::rle::rle_encode({roi.getMask().datastart, roi.getMask().dataend}));    // " meas_mask BOOLEAN[]"*/
-
-        duckdb::vector<duckdb::Value> flattenPoints;
-        // flatten(roi.getContour(), flattenPoints);
-        auto contour = duckdb::Value::LIST(duckdb::LogicalType(duckdb::LogicalTypeId::UINTEGER), flattenPoints);
-        objects.Append<duckdb::Value>(contour);    // " meas_contour UINTEGER[]"
+        // Replaced by meas_mask_encoded and meas_contour_encoded
+        objects.AppendDefault();    // " meas_mask MAP(UINTEGER,BOOLEAN)"
+        objects.AppendDefault();    // " meas_contour UINTEGER[]"
 
         objects.Append<uint64_t>(roi.getOriginObjectId());    // "	meas_origin_object_id UBIGINT"
         objects.Append<uint64_t>(roi.getParentObjectId());    // "	meas_parent_object_id UBIGINT"
@@ -483,6 +707,20 @@ void Database::insertObjects(const processor::PipelineInitializer &imgContext, e
           objects.AppendDefault();    // No parent
         }
         objects.Append<uint64_t>(roi.getTrackingId());    // "	meas_tracking_id UBIGINT"
+        appendBlob(objects, joda::rle::encodeMask(roi.getMask()));          // " meas_mask_encoded BLOB"
+        appendBlob(objects, joda::rle::encodeContour(roi.getContour()));    // " meas_contour_encoded BLOB"
+        if(roi.isVolume()) {
+          const auto &volume = roi.getVolume();
+          objects.Append<uint32_t>(static_cast<uint32_t>(volume.zStackEnd));            // " meas_stack_z_end UINTEGER"
+          objects.Append<uint64_t>(volume.voxelCount);                                  // " meas_voxel_count UBIGINT"
+          objects.Append<double>(roi.getVolumeSize(physicalSize, physicalSizeUnit));    // " meas_volume DOUBLE"
+          objects.Append<double>(volume.centroid.z);                                    // " meas_center_z DOUBLE"
+        } else {
+          objects.AppendDefault();    // " meas_stack_z_end UINTEGER"
+          objects.AppendDefault();    // " meas_voxel_count UBIGINT"
+          objects.AppendDefault();    // " meas_volume DOUBLE"
+          objects.AppendDefault();    // " meas_center_z DOUBLE"
+        }
 
         objects.EndRow();
 
@@ -502,6 +740,7 @@ void Database::insertObjects(const processor::PipelineInitializer &imgContext, e
           object_measurements.Append<float>(intensity.intensityAvg);                               //       " meas_intensity_avg float,"
           object_measurements.Append<uint32_t>(static_cast<uint32_t>(intensity.intensityMin));     //       " meas_intensity_min UINTEGER,"
           object_measurements.Append<uint32_t>(static_cast<uint32_t>(intensity.intensityMax));     //       " meas_intensity_max UINTEGER"
+          object_measurements.Append<float>(intensity.intensityStdDev);                            //       " meas_intensity_stddev float"
           object_measurements.EndRow();
         }
 
@@ -540,6 +779,17 @@ void Database::insertObjects(const processor::PipelineInitializer &imgContext, e
     object_measurements.Close();
     distance_measurements.Close();
 
+    auto workUnits = duckdb::Appender(*connection, "work_units");
+    workUnits.BeginRow();
+    workUnits.Append<uint64_t>(workUnit.imageId);    // " image_id UBIGINT,"
+    workUnits.Append<int32_t>(workUnit.tileX);       // " tile_x INTEGER,"
+    workUnits.Append<int32_t>(workUnit.tileY);       // " tile_y INTEGER,"
+    workUnits.Append<int32_t>(workUnit.tStack);      // " stack_t INTEGER,"
+    workUnits.Append<int32_t>(workUnit.zStack);      // " stack_z INTEGER,"
+    workUnits.EndRow();
+    workUnits.Close();
+    connection->Commit();
+
     //
     // Statistics
     //
@@ -548,26 +798,116 @@ void Database::insertObjects(const processor::PipelineInitializer &imgContext, e
     // statistics.Close();
     // statistic_measurements.Close();
   } catch(const std::exception &ex) {
-    std::cout << "Insert Obj: " << ex.what() << std::endl;
+    if(connection->HasActiveTransaction()) {
+      connection->Rollback();
+    }
+    joda::log::logError("Insert Obj: " + std::string(ex.what()));
   }
 }
 
-auto Database::prepareImages(uint8_t plateId, int32_t series, enums::GroupBy groupBy, const std::string &filenameRegex,
-                             const std::vector<std::filesystem::path> &imagePaths, const std::filesystem::path &imagesBasePath,
-                             const joda::settings::AnalyzeSettings &analyzeSettings, std::unique_ptr<BS::thread_pool<>> &threadPool)
+///
+/// \brief      Stores the resource usage of the executed pipeline steps
+/// \author     Joachim Danmayr
+/// \param[in]  jobId     Job the profiles belong to
+/// \param[in]  profiles  Measured pipeline steps
+///
+void Database::insertPipelineStepProfiles(const std::string &jobId, const std::vector<PipelineStepProfile> &profiles)
+{
+  try {
+    auto connection = acquire();
+    auto appender   = duckdb::Appender(*connection, "pipeline_step_profiling");
+    const auto job  = duckdb::Value::UUID(jobId);
+    for(const auto &profile : profiles) {
+      appender.BeginRow();
+      appender.Append<duckdb::Value>(job);                   // " job_id UUID,"
+      appender.Append<uint64_t>(profile.imageId);            // " image_id UBIGINT,"
+      appender.Append<int32_t>(profile.pipelineIndex);       // " pipeline_idx INTEGER,"
+      appender.Append<int32_t>(profile.stepIndex);           // " step_idx INTEGER,"
+      appender.Append<duckdb::string_t>(profile.command);    // " command TEXT,"
+      appender.Append<int32_t>(profile.tileX);               // " tile_x INTEGER,"
+      appender.Append<int32_t>(profile.tileY);               // " tile_y INTEGER,"
+      appender.Append<int32_t>(profile.tStack);              // " stack_t INTEGER,"
+      appender.Append<int32_t>(profile.zStack);              // " stack_z INTEGER,"
+      appender.Append<uint64_t>(profile.wallTimeNs);         // " wall_time_ns UBIGINT,"
+      appender.Append<uint64_t>(profile.cpuTimeNs);          // " cpu_time_ns UBIGINT,"
+      appender.Append<uint64_t>(profile.nrOfObjects);        // " nr_of_objects UBIGINT"
+      appender.EndRow();
+    }
+    appender.Close();
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("Could not store pipeline step profiling: " + std::string(ex.what()));
+  }
+}
+
+///
+/// \brief      Wall time and CPU time per pipeline step and command summed up
+///             over all images and tiles of a job
+/// \author     Joachim Danmayr
+/// \param[in]  jobId  Job to select the profiling for
+///
+auto Database::selectPipelineStepProfiling(const std::string &jobId) -> std::unique_ptr<duckdb::MaterializedQueryResult>
+{
+  auto result = select(
+      "SELECT pipeline_idx, step_idx, command, COUNT(*)::UBIGINT AS executions, SUM(wall_time_ns)::UBIGINT AS wall_time_ns, "
+      "SUM(cpu_time_ns)::UBIGINT AS cpu_time_ns, SUM(nr_of_objects)::UBIGINT AS nr_of_objects "
+      "FROM pipeline_step_profiling WHERE job_id = ? "
+      "GROUP BY pipeline_idx, step_idx, command "
+      "ORDER BY pipeline_idx, step_idx",
+      duckdb::Value::UUID(jobId));
+  if(result->HasError()) {
+    throw std::invalid_argument(result->GetError());
+  }
+  return result->Cast<duckdb::StreamQueryResult>().Materialize();
+}
+
+///
+/// \brief      Inserts the images and their groups into the database. The grouper is
+///             owned by the caller, images added to a running job in later calls
+///             continue the group and well numbering of the first call.
+/// \author     Joachim Danmayr
+///
+auto Database::prepareImages(uint8_t plateId, int32_t series, joda::grp::FileGrouper &grouper, const std::vector<std::filesystem::path> &imagePaths,
+                             const std::filesystem::path &imagesBasePath, const joda::settings::AnalyzeSettings &analyzeSettings,
+                             std::unique_ptr<BS::priority_thread_pool> &threadPool)
     -> std::vector<std::shared_ptr<joda::processor::PipelineInitializer>>
 {
   std::vector<std::shared_ptr<joda::processor::PipelineInitializer>> imagesToProcess;
-  joda::grp::FileGrouper grouper(groupBy, filenameRegex);
+
+  //
+  // Images and groups of a resumed job are already in the database
+  //
+  std::set<uint64_t> addedImages;
+  std::set<uint16_t> addedGroups;
+  {
+    auto result = select("SELECT image_id FROM images");
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+      addedImages.emplace(materializedResult->GetValue(0, n).GetValue<uint64_t>());
+    }
+  }
+  {
+    auto result = select("SELECT group_id FROM groups WHERE plate_id=?", static_cast<uint16_t>(plateId));
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+      addedGroups.emplace(materializedResult->GetValue(0, n).GetValue<uint16_t>());
+    }
+  }
 
   auto connection      = acquire();
   auto groups          = duckdb::Appender(*connection, "groups");
   auto images          = duckdb::Appender(*connection, "images");
   auto images_groups   = duckdb::Appender(*connection, "images_groups");
   auto images_channels = duckdb::Appender(*connection, "images_channels");
-  std::set<uint16_t> addedGroups;
 
   std::mutex insertMutex;
+  std::vector<std::future<void>> prepared;
+  prepared.reserve(imagePaths.size());
 
   //
   // Preparing -> Insert all images to database
@@ -575,8 +915,8 @@ auto Database::prepareImages(uint8_t plateId, int32_t series, enums::GroupBy gro
   for(const auto &imagePath : imagePaths) {
     //
     //
-    auto prepareImage = [&groups, &grouper, &addedGroups, &imagesToProcess, &images, &images_groups, &images_channels, &insertMutex, plateId,
-                         imagePath, &imagesBasePath, &analyzeSettings]() {
+    auto prepareImage = [&groups, &grouper, &addedGroups, &addedImages, &imagesToProcess, &images, &images_groups, &images_channels, &insertMutex,
+                         plateId, imagePath, &imagesBasePath, &analyzeSettings]() {
       const auto element = std::make_shared<joda::processor::PipelineInitializer>(analyzeSettings.imageSetup, analyzeSettings.pipelineSetup,
                                                                                   imagePath, imagesBasePath);
 
@@ -589,6 +929,9 @@ auto Database::prepareImages(uint8_t plateId, int32_t series, enums::GroupBy gro
       {
         std::lock_guard<std::mutex> lock(insertMutex);
         imagesToProcess.emplace_back(element);
+        if(addedImages.contains(element->getImageId())) {
+          return;
+        }
 
         // Group
         {
@@ -651,10 +994,13 @@ auto Database::prepareImages(uint8_t plateId, int32_t series, enums::GroupBy gro
       }
     };
 
-    (void) threadPool->submit_task(prepareImage);
+    prepared.push_back(joda::thread::TaskScheduler::submit(*threadPool, joda::thread::TaskPriority::METADATA, prepareImage));
   }
 
-  threadPool->wait();
+  // Only the own tasks are waited for, the pool may be busy with a preview
+  for(const auto &image : prepared) {
+    image.wait();
+  }
 
   groups.Close();
   images.Close();
@@ -788,6 +1134,7 @@ void Database::setImageValidity(uint64_t imageId, enums::ChannelValidity validit
   if(result->HasError()) {
     throw std::invalid_argument(result->GetError());
   }
+  refreshGroupStatsOfImage(imageId);
 }
 
 ///
@@ -803,6 +1150,7 @@ void Database::setImageProcessed(uint64_t imageId)
   if(result->HasError()) {
     throw std::invalid_argument(result->GetError());
   }
+  refreshStatsAggregates(StatsAggregates::refreshImages({imageId}));
 }
 
 ///
@@ -819,6 +1167,7 @@ void Database::unsetImageValidity(uint64_t imageId, enums::ChannelValidity valid
   if(result->HasError()) {
     throw std::invalid_argument(result->GetError());
   }
+  refreshGroupStatsOfImage(imageId);
 }
 
 ///
@@ -1066,6 +1415,71 @@ std::string Database::startJob(const joda::settings::AnalyzeSettings &exp, const
   return jobId;
 }
 
+///
+/// \brief      Continue the last job stored in the database. Only possible
+///             if the job was started with the same results relevant settings.
+/// \author     Joachim Danmayr
+/// \param[in]  exp  Settings used to continue the job
+/// \return     Job ID, stored work units and the highest object and tracking IDs
+///
+auto Database::resumeJob(const joda::settings::AnalyzeSettings &exp) -> ResumeInfo
+{
+  ResumeInfo info;
+  {
+    auto result = select("SELECT job_id, settings_hash FROM jobs ORDER BY time_started DESC LIMIT 1");
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    if(materializedResult->RowCount() <= 0) {
+      throw std::invalid_argument("The results database does not contain a job which could be resumed!");
+    }
+    info.jobId = duckdb::UUID::ToString(materializedResult->GetValue(0, 0).GetValue<duckdb::hugeint_t>());
+    if(materializedResult->GetValue(1, 0).GetValue<uint64_t>() != exp.getResultsRelevantHash()) {
+      throw std::invalid_argument("The settings have been changed since the job was started, the job cannot be resumed!");
+    }
+  }
+
+  {
+    auto result = select("SELECT image_id, tile_x, tile_y, stack_t, stack_z FROM work_units");
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+      info.finishedWorkUnits.emplace(WorkUnit{.imageId = materializedResult->GetValue(0, n).GetValue<uint64_t>(),
+                                              .tileX   = materializedResult->GetValue(1, n).GetValue<int32_t>(),
+                                              .tileY   = materializedResult->GetValue(2, n).GetValue<int32_t>(),
+                                              .tStack  = materializedResult->GetValue(3, n).GetValue<int32_t>(),
+                                              .zStack  = materializedResult->GetValue(4, n).GetValue<int32_t>()});
+    }
+  }
+
+  {
+    auto result = select("SELECT image_id FROM images WHERE processed");
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+      info.processedImages.emplace(materializedResult->GetValue(0, n).GetValue<uint64_t>());
+    }
+  }
+
+  {
+    auto result = select("SELECT COALESCE(MAX(object_id), 0)::UBIGINT, COALESCE(MAX(meas_tracking_id), 0)::UBIGINT FROM objects");
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+    info.lastObjectId       = materializedResult->GetValue(0, 0).GetValue<uint64_t>();
+    info.lastTrackingId     = materializedResult->GetValue(1, 0).GetValue<uint64_t>();
+  }
+
+  joda::log::logInfo("Resume job >" + info.jobId + "<, " + std::to_string(info.finishedWorkUnits.size()) + " work units already stored.");
+  return info;
+}
+
 ///
 /// \brief     Finish job
 /// \author    Joachim Danmayr
@@ -1082,6 +1496,171 @@ void Database::finishJob(const std::string &jobId)
   if(result->HasError()) {
     throw std::invalid_argument(result->GetError());
   }
+
+  //
+  // Images which have never been marked as processed (e.g. because of an error)
+  // still have objects which must be part of the aggregates.
+  //
+  result = select("SELECT image_id FROM images WHERE image_id NOT IN (SELECT image_id FROM stats_aggregated_images)");
+  if(result->HasError()) {
+    throw std::invalid_argument(result->GetError());
+  }
+  auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+  std::set<uint64_t> imageIds;
+  for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+    imageIds.emplace(materializedResult->GetValue(0, n).GetValue<uint64_t>());
+  }
+  if(!imageIds.empty()) {
+    refreshStatsAggregates(StatsAggregates::refreshImages(imageIds));
+  }
+}
+
+///
+/// \brief      Recalculates the groups of an already aggregated image, the
+///             group statistics depend on the validity of the images.
+/// \author     Joachim Danmayr
+///
+void Database::refreshGroupStatsOfImage(uint64_t imageId)
+{
+  auto result = select("SELECT COUNT(*) FROM stats_aggregated_images WHERE image_id = ?", imageId);
+  if(result->HasError()) {
+    throw std::invalid_argument(result->GetError());
+  }
+  if(result->Cast<duckdb::StreamQueryResult>().Materialize()->GetValue(0, 0).GetValue<int64_t>() > 0) {
+    refreshStatsAggregates(StatsAggregates::refreshGroupsOfImage(imageId));
+  }
+}
+
+///
+/// \brief      Executes the statements updating the aggregate tables in one transaction.
+///             The aggregates are only a cache, if they cannot be written the
+///             affected images stay unaggregated and the raw queries are used.
+/// \author     Joachim Danmayr
+/// \param[in]  sql  Statements generated by StatsAggregates
+///
+void Database::refreshStatsAggregates(const std::string &sql)
+{
+  std::lock_guard<std::mutex> lock(mStatsAggregatesLock);
+  auto connection = acquire();
+  connection->BeginTransaction();
+  auto result = connection->Query(sql);
+  if(result->HasError()) {
+    connection->Rollback();
+    joda::log::logWarning("Could not update the statistics aggregates. what: " + result->GetError());
+    return;
+  }
+  connection->Commit();
+}
+
+///
+/// \brief      True if all images are part of the aggregate tables, plate and
+///             well views can then be read from the aggregates.
+/// \author     Joachim Danmayr
+///
+auto Database::hasStatsAggregates() -> bool
+{
+  auto result = select("SELECT COUNT(*) FROM images WHERE image_id NOT IN (SELECT image_id FROM stats_aggregated_images)");
+  if(result->HasError()) {
+    throw std::invalid_argument(result->GetError());
+  }
+  return result->Cast<duckdb::StreamQueryResult>().Materialize()->GetValue(0, 0).GetValue<int64_t>() == 0;
+}
+
+///
+/// \brief      Combines the results databases of a sharded job into this empty database.
+///             Image, group and class IDs are the same in all shards. Object and tracking
+///             IDs are counted per shard and are shifted behind the IDs of the already
+///             merged shards. The image statistics are taken over, the group statistics
+///             are recalculated because the images of a group can be spread over shards.
+/// \author     Joachim Danmayr
+/// \param[in]  shards  Results databases of the shards (*.icdb)
+///
+void Database::mergeShards(const std::vector<std::filesystem::path> &shards)
+{
+  auto connection = acquire();
+  auto query      = [&connection](const std::string &sql) {
+    auto result = connection->Query(sql);
+    if(result->HasError()) {
+      throw std::invalid_argument(result->GetError());
+    }
+    return result;
+  };
+  auto count = [&query](const std::string &sql) { return query(sql)->GetValue(0, 0).GetValue<int64_t>(); };
+  if(count("SELECT COUNT(*) FROM images") > 0) {
+    throw std::invalid_argument("Shards can only be merged into an empty results database!");
+  }
+
+  for(size_t n = 0; n < shards.size(); n++) {
+    auto shardPath = shards[n].string();
+    helper::stringReplace(shardPath, "'", "''");
+    query("ATTACH '" + shardPath + "' AS shard (READ_ONLY);");
+    connection->BeginTransaction();
+    try {
+      if(n == 0) {
+        query(
+            "INSERT INTO experiment BY NAME SELECT * FROM shard.experiment;\n"
+            "INSERT INTO jobs BY NAME SELECT * FROM shard.jobs;\n"
+            "INSERT INTO plates BY NAME SELECT * FROM shard.plates;\n"
+            "INSERT INTO classes BY NAME SELECT * FROM shard.classes;\n"
+            "INSERT INTO cache_analyze_settings BY NAME SELECT * FROM shard.cache_analyze_settings;");
+      } else {
+        if(count("SELECT COUNT(*) FROM shard.jobs WHERE settings_hash NOT IN (SELECT settings_hash FROM jobs)") > 0) {
+          throw std::invalid_argument("Shard >" + shards[n].string() + "< has been analyzed with other settings!");
+        }
+        query(
+            "UPDATE jobs SET\n"
+            " time_started = LEAST(time_started, (SELECT MIN(time_started) FROM shard.jobs)),\n"
+            " time_finished = GREATEST(time_finished, (SELECT MAX(time_finished) FROM shard.jobs));");
+      }
+      if(count("SELECT COUNT(*) FROM shard.images WHERE image_id IN (SELECT image_id FROM images)") > 0) {
+        throw std::invalid_argument("Shard >" + shards[n].string() + "< contains images of an already merged shard!");
+      }
+
+      auto lastIds                = query("SELECT COALESCE(MAX(object_id), 0)::UBIGINT, COALESCE(MAX(meas_tracking_id), 0)::UBIGINT FROM objects");
+      const auto objectIdOffset   = std::to_string(lastIds->GetValue(0, 0).GetValue<uint64_t>());
+      const auto trackingIdOffset = std::to_string(lastIds->GetValue(1, 0).GetValue<uint64_t>());
+      // 0 means not linked to another object
+      auto shift = [](const std::string &column, const std::string &offset) {
+        return "CASE WHEN " + column + " = 0 THEN 0 ELSE " + column + " + " + offset + " END AS " + column;
+      };
+
+      query(
+          "INSERT OR IGNORE INTO groups BY NAME SELECT * FROM shard.groups;\n"
+          "INSERT INTO images BY NAME SELECT * FROM shard.images;\n"
+          "INSERT INTO images_groups BY NAME SELECT * FROM shard.images_groups;\n"
+          "INSERT INTO images_channels BY NAME SELECT * FROM shard.images_channels;\n"
+          "INSERT INTO images_planes BY NAME SELECT * FROM shard.images_planes;\n"
+          "INSERT INTO classes_planes BY NAME SELECT * FROM shard.classes_planes;\n"
+          "INSERT INTO work_units BY NAME SELECT * FROM shard.work_units;\n"
+          "INSERT INTO objects BY NAME SELECT * REPLACE (\n"
+          " object_id + " +
+          objectIdOffset + " AS object_id,\n " + shift("meas_origin_object_id", objectIdOffset) + ",\n " +
+          shift("meas_parent_object_id", objectIdOffset) + ",\n " + shift("meas_tracking_id", trackingIdOffset) +
+          ")\n"
+          "FROM shard.objects;\n"
+          "INSERT INTO object_measurements BY NAME SELECT * REPLACE (object_id + " +
+          objectIdOffset +
+          " AS object_id)\n"
+          "FROM shard.object_measurements;\n"
+          "INSERT INTO distance_measurements BY NAME SELECT * REPLACE (object_id + " +
+          objectIdOffset + " AS object_id, meas_object_id + " + objectIdOffset +
+          " AS meas_object_id)\n"
+          "FROM shard.distance_measurements;\n"
+          "INSERT INTO pipeline_step_profiling BY NAME SELECT * REPLACE ((SELECT job_id FROM jobs LIMIT 1) AS job_id)\n"
+          "FROM shard.pipeline_step_profiling;\n"
+          "INSERT INTO stats_image_objects BY NAME SELECT * FROM shard.stats_image_objects;\n"
+          "INSERT INTO stats_image_intensities BY NAME SELECT * FROM shard.stats_image_intensities;\n"
+          "INSERT INTO stats_aggregated_images BY NAME SELECT * FROM shard.stats_aggregated_images;");
+      connection->Commit();
+    } catch(...) {
+      connection->Rollback();
+      connection->Query("DETACH shard;");
+      throw;
+    }
+    query("DETACH shard;");
+    joda::log::logInfo("Shard >" + shards[n].string() + "< merged.");
+  }
+  refreshStatsAggregates(StatsAggregates::refreshAllGroups());
 }
 
 ///
@@ -1221,8 +1800,8 @@ std::string Database::insertJobAndPlates(const joda::settings::AnalyzeSettings &
     duckdb::timestamp_t nil = {};
     auto prepare            = connection->Prepare(
         "INSERT INTO jobs (experiment_id, job_id, job_name,imagec_version, time_started, time_finished, settings, settings_results_table_default, "
-                   "settings_results_table, settings_tile_width, settings_tile_height, settings_image_series, physicalPixelSizeUnit) "
-                   "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+                   "settings_results_table, settings_tile_width, settings_tile_height, settings_image_series, physicalPixelSizeUnit, settings_hash) "
+                   "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
     auto resultsTableSettings = exp.toResultsSettings();
     prepare->Execute(duckdb::Value::UUID(exp.projectSettings.experimentSettings.experimentId), jobId, jobName, Version::getVersion(),
@@ -1230,7 +1809,7 @@ std::string Database::insertJobAndPlates(const joda::settings::AnalyzeSettings &
                      helper::base64Encode(settings::Settings::toString(resultsTableSettings)),
                      helper::base64Encode(settings::Settings::toString(resultsTableSettings)), exp.imageSetup.imageTileSettings.tileWidth,
                      exp.imageSetup.imageTileSettings.tileHeight, exp.imageSetup.series,
-                     static_cast<duckdb::string_t>(physicalImageSizeUnit.get<std::string>().c_str()));
+                     static_cast<duckdb::string_t>(physicalImageSizeUnit.get<std::string>().c_str()), exp.getResultsRelevantHash());
   } catch(const std::exception &ex) {
     connection->Rollback();
     throw std::runtime_error(ex.what());
@@ -1859,8 +2438,8 @@ auto Database::selectRegionOfInterests(uint64_t imageId, uint16_t classIdIn) ->
       "SELECT "
       "object_id,class_id,stack_c,stack_z,stack_t,meas_confidence,meas_area_size,meas_perimeter,meas_circularity,meas_center_x,meas_center_y,meas_"
       "box_x,meas_box_y,"
-      "meas_box_width,meas_box_height,meas_origin_object_id,meas_parent_object_id,meas_parent_class_id,meas_tracking_id  FROM objects WHERE image_id "
-      "= ? AND class_id = ?",
+      "meas_box_width,meas_box_height,meas_origin_object_id,meas_parent_object_id,meas_parent_class_id,meas_tracking_id,meas_mask_encoded,"
+      "meas_contour_encoded FROM objects WHERE image_id = ? AND class_id = ?",
       imageId, classIdIn);
 
   if(result->HasError()) {
@@ -1891,50 +2470,108 @@ auto Database::selectRegionOfInterests(uint64_t imageId, uint16_t classIdIn) ->
     // const uint16_t parentClassId  = materializedResult->GetValue(17, 0).GetValue<uint16_t>();
     const uint64_t trackingId = materializedResult->GetValue(18, row).GetValue<uint64_t>();
 
+    // Results written by older versions have no mask and contour
+    cv::Mat mask;
+    std::vector<cv::Point> contour;
+    try {
+      const auto maskEncoded    = materializedResult->GetValue(19, row);
+      const auto contourEncoded = materializedResult->GetValue(20, row);
+      if(!maskEncoded.IsNull()) {
+        mask = joda::rle::decodeMask(duckdb::StringValue::Get(maskEncoded));
+      }
+      if(!contourEncoded.IsNull()) {
+        contour = joda::rle::decodeContour(duckdb::StringValue::Get(contourEncoded));
+      }
+    } catch(const std::exception &ex) {
+      joda::log::logWarning("Could not decode mask of object >" + std::to_string(objectId) + "<. what: " + std::string(ex.what()));
+      mask.release();
+      contour.clear();
+    }
+
     atom::ROI roi(false, objectId,
                   atom::ROI::RoiObjectId{.classId    = static_cast<joda::enums::ClassId>(classId),
                                          .imagePlane = {.tStack = stackT, .zStack = stackZ, .cStack = stackC}},
-                  confidence, {boxX, boxY, boxWidth, boxHeight}, {}, {}, areaSize, perimeter, circularity, {}, originObjectId, {centerX, centerY},
-                  parentObjectId, trackingId, {}, false, atom::ROI::Category::AUTO_SEGMENTATION);
+                  confidence, {boxX, boxY, boxWidth, boxHeight}, std::move(mask), std::move(contour), areaSize, perimeter, circularity, {},
+                  originObjectId, {centerX, centerY}, parentObjectId, trackingId, {}, false, atom::ROI::Category::AUTO_SEGMENTATION);
     retVals[stackT].emplace_back(std::move(roi));
   }
   return retVals;
 }
 
 ///
-/// \brief
-/// \author
-/// \param[in]
-/// \param[out]
-/// \return
+/// \brief      Writes the tracking IDs of the ROIs to the objects table
+/// \author     Joachim Danmayr
 ///
 void Database::setTrackingId(const std::map<int32_t, std::vector<atom::ROI>> &rois)
 {
+  std::vector<std::pair<uint64_t, uint64_t>> objectIdTrackingId;
+  for(const auto &[frameId, spots] : rois) {
+    for(const auto &roi : spots) {
+      objectIdTrackingId.emplace_back(roi.getObjectId(), roi.getTrackingId());
+    }
+  }
+  setTrackingIds(0, objectIdTrackingId);
+}
+
+///
+/// \brief      Replaces the tracking ID of the given objects.
+///             The pairs are appended to a connection local temp table and
+///             applied with one UPDATE ... FROM join. The join is limited to the
+///             image and the object ID range of the pairs, so DuckDB can skip
+///             all row groups of other images and tiles with its zone maps.
+/// \author     Joachim Danmayr
+/// \param[in]  imageId             Image the objects belong to, 0 to match the object ID only
+/// \param[in]  objectIdTrackingId  Object ID and the new tracking ID
+///
+void Database::setTrackingIds(uint64_t imageId, const std::vector<std::pair<uint64_t, uint64_t>> &objectIdTrackingId)
+{
+  if(objectIdTrackingId.empty()) {
+    return;
+  }
+  const auto [minIt, maxIt] = std::minmax_element(objectIdTrackingId.begin(), objectIdTrackingId.end(),
+                                                  [](const auto &a, const auto &b) { return a.first < b.first; });
+  const uint64_t minObjectId = minIt->first;
+  const uint64_t maxObjectId = maxIt->first;
+
   auto connection = acquire();
   connection->Query("BEGIN TRANSACTION");
-
-  connection->Query("CREATE TEMP TABLE updates(id UBIGINT, val UBIGINT)");
+  connection->Query("CREATE OR REPLACE TEMP TABLE tracking_updates(id UBIGINT, val UBIGINT)");
 
   // Use Appender for fast inserts
-  auto appender = duckdb::Appender(*connection, "updates");
-
-  for(const auto &[frameId, spots] : rois) {
-    for(const auto &roi : spots) {
+  {
+    auto appender = duckdb::Appender(*connection, "tracking_updates");
+    for(const auto &[objectId, trackingId] : objectIdTrackingId) {
       appender.BeginRow();
-      appender.Append(roi.getObjectId());
-      appender.Append(roi.getTrackingId());
+      appender.Append<uint64_t>(objectId);
+      appender.Append<uint64_t>(trackingId);
       appender.EndRow();
     }
+    appender.Close();
   }
-  appender.Close();
 
-  connection->Query(R"(
+  std::unique_ptr<duckdb::QueryResult> result;
+  if(imageId != 0) {
+    auto prepare = connection->Prepare(R"(
         UPDATE objects
-        SET objects.meas_tracking_id = updates.val
-        FROM updates
-        WHERE objects.object_id = updates.id
+        SET meas_tracking_id = tracking_updates.val
+        FROM tracking_updates
+        WHERE objects.image_id = ? AND objects.object_id BETWEEN ? AND ? AND objects.object_id = tracking_updates.id
     )");
-
+    result       = prepare->Execute(imageId, minObjectId, maxObjectId);
+  } else {
+    auto prepare = connection->Prepare(R"(
+        UPDATE objects
+        SET meas_tracking_id = tracking_updates.val
+        FROM tracking_updates
+        WHERE objects.object_id BETWEEN ? AND ? AND objects.object_id = tracking_updates.id
+    )");
+    result       = prepare->Execute(minObjectId, maxObjectId);
+  }
+  if(result->HasError()) {
+    connection->Query("ROLLBACK");
+    throw std::runtime_error(result->GetError());
+  }
+  connection->Query("DROP TABLE tracking_updates");
   connection->Query("COMMIT");
 }
 
@@ -17,6 +17,9 @@
 #include <exception>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 #include "backend/artifacts/roi/roi.hpp"
 #include "backend/enums/enum_validity.hpp"
@@ -32,6 +35,7 @@
 #include <duckdb/main/config.hpp>
 #include <duckdb/main/connection.hpp>
 #include <duckdb/main/database.hpp>
+#include <duckdb/main/materialized_query_result.hpp>
 #include <opencv2/core/types.hpp>
 #include "database_interface.hpp"
 #include <BS_thread_pool.hpp>
@@ -40,6 +44,24 @@ namespace joda::db {
 
 using DbArgs_t = std::vector<std::variant<std::string, uint16_t, uint32_t, uint64_t, double, int32_t>>;
 
+enum class CopyFormat
+{
+  CSV,
+  PARQUET
+};
+
+///
+/// \brief      State of an interrupted job read back from the database
+///
+struct ResumeInfo
+{
+  std::string jobId;
+  std::set<WorkUnit> finishedWorkUnits;
+  std::set<uint64_t> processedImages;
+  uint64_t lastObjectId   = 0;
+  uint64_t lastTrackingId = 0;
+};
+
 class Database : public DatabaseInterface
 {
 public:
@@ -48,13 +70,16 @@ public:
   }
   /////////////////////////////////////////////////////
   void openDatabase(const std::filesystem::path &pathToDb) override;
+  void shareDatabase(const Database &other);
   void closeDatabase() override;
   std::string startJob(const joda::settings::AnalyzeSettings &, const std::string &jobName) override;
+  auto resumeJob(const joda::settings::AnalyzeSettings &) -> ResumeInfo;
   void finishJob(const std::string &jobId) override;
+  void mergeShards(const std::vector<std::filesystem::path> &shards);
 
-  auto prepareImages(uint8_t plateId, int32_t series, enums::GroupBy groupBy, const std::string &filenameRegex,
-                     const std::vector<std::filesystem::path> &imagePaths, const std::filesystem::path &imagesBasePath,
-                     const joda::settings::AnalyzeSettings &analyzeSettings, std::unique_ptr<BS::thread_pool<>> &threadPool)
+  auto prepareImages(uint8_t plateId, int32_t series, joda::grp::FileGrouper &grouper, const std::vector<std::filesystem::path> &imagePaths,
+                     const std::filesystem::path &imagesBasePath, const joda::settings::AnalyzeSettings &analyzeSettings,
+                     std::unique_ptr<BS::priority_thread_pool> &threadPool)
       -> std::vector<std::shared_ptr<joda::processor::PipelineInitializer>> override;
   void setImageProcessed(uint64_t) override;
 
@@ -75,7 +100,10 @@ public:
                                const std::map<enums::ClassId, std::set<enums::ClassId>> &intersectingChannels,
                                const std::map<enums::ClassId, std::set<enums::ClassId>> &distanceChannels);
 
-  void insertObjects(const joda::processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &) override;
+  void insertObjects(const joda::processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &, const WorkUnit &) override;
+  void insertPipelineStepProfiles(const std::string &jobId, const std::vector<PipelineStepProfile> &profiles) override;
+  void setTrackingIds(uint64_t imageId, const std::vector<std::pair<uint64_t, uint64_t>> &objectIdTrackingId) override;
+  auto selectPipelineStepProfiling(const std::string &jobId) -> std::unique_ptr<duckdb::MaterializedQueryResult>;
 
   auto selectExperiment() -> AnalyzeMeta;
   auto selectPlates() -> std::map<uint16_t, joda::settings::Plate>;
@@ -105,6 +133,7 @@ public:
   auto selectResultsTableSettings(const std::string &jobId) -> std::string;
   auto selectImageIdFromImageFileName(const std::string &imageFileName) -> uint64_t;
   auto selectGroupIdFromGroupName(const std::string &groupName) -> uint16_t;
+  auto hasStatsAggregates() -> bool;
 
   template <typename... ARGS>
   std::unique_ptr<duckdb::QueryResult> select(const std::string &query, ARGS... args)
@@ -115,6 +144,8 @@ public:
   }
 
   std::unique_ptr<duckdb::QueryResult> select(const std::string &query, const DbArgs_t &args);
+  auto selectAll(const std::vector<std::pair<std::string, DbArgs_t>> &queries) -> std::vector<std::unique_ptr<duckdb::MaterializedQueryResult>>;
+  void copyTo(const std::string &query, const DbArgs_t &args, CopyFormat format, const std::filesystem::path &outputFile);
 
 private:
   /////////////////////////////////////////////////////
@@ -130,10 +161,15 @@ private:
   void insertGroup();
   void flatten(const std::vector<cv::Point> &, duckdb::vector<duckdb::Value> &);
   void createAnalyzeSettingsCache(const std::string &jobId);
+  static auto bindArgsAsLiterals(const std::string &query, const DbArgs_t &args) -> std::string;
+  void refreshStatsAggregates(const std::string &sql);
+  void refreshGroupStatsOfImage(uint64_t imageId);
 
   /////////////////////////////////////////////////////
   std::unique_ptr<duckdb::DBConfig> mDbCfg;
-  std::unique_ptr<duckdb::DuckDB> mDb;
+  std::shared_ptr<duckdb::DuckDB> mDb;    // Shared with the readers of a running job, see shareDatabase
+  mutable std::mutex mDbLock;
+  std::mutex mStatsAggregatesLock;
 };
 
 }    // namespace joda::db
@@ -13,9 +13,13 @@
 
 #pragma once
 
+#include <compare>
 #include <filesystem>
+#include <string>
+#include <utility>
 #include <vector>
 #include "backend/enums/enum_validity.hpp"
+#include "backend/helper/file_grouper/file_grouper.hpp"
 #include "backend/helper/file_grouper/file_grouper_types.hpp"
 #include "backend/helper/ome_parser/ome_info.hpp"
 #include "backend/settings/analze_settings.hpp"
@@ -76,6 +80,42 @@ struct ObjectInfo
   uint64_t imageId       = 0;
 };
 
+///
+/// \brief      Resource usage of one pipeline step executed on one tile.
+///             A step index of -1 covers the whole pipeline including image loading.
+///
+struct PipelineStepProfile
+{
+  uint64_t imageId      = 0;
+  int32_t pipelineIndex = 0;
+  int32_t stepIndex     = 0;
+  std::string command;
+  int32_t tileX         = 0;
+  int32_t tileY         = 0;
+  int32_t tStack        = 0;
+  int32_t zStack        = 0;
+  uint64_t wallTimeNs   = 0;
+  uint64_t cpuTimeNs    = 0;    // CPU time of the executing thread, threads spawned by the command are not included
+  uint64_t nrOfObjects  = 0;    // Number of objects in the object list after the step
+};
+
+///
+/// \brief      One tile of one t and z stack of an image.
+///             The objects of a work unit are written in one transaction
+///             together with the work unit itself, this way an interrupted
+///             job can be resumed at the first unit not stored yet.
+///
+struct WorkUnit
+{
+  uint64_t imageId = 0;
+  int32_t tileX    = 0;
+  int32_t tileY    = 0;
+  int32_t tStack   = 0;
+  int32_t zStack   = 0;
+
+  auto operator<=>(const WorkUnit &) const = default;
+};
+
 class DatabaseInterface
 {
 public:
@@ -86,9 +126,9 @@ public:
   virtual std::string startJob(const joda::settings::AnalyzeSettings &, const std::string &jobName) = 0;
   virtual void finishJob(const std::string &jobId)                                                  = 0;
 
-  virtual auto prepareImages(uint8_t plateId, int32_t series, enums::GroupBy groupBy, const std::string &filenameRegex,
-                             const std::vector<std::filesystem::path> &imagePaths, const std::filesystem::path &imagesBasePath,
-                             const joda::settings::AnalyzeSettings &analyzeSettings, std::unique_ptr<BS::thread_pool<>> &threadPool)
+  virtual auto prepareImages(uint8_t plateId, int32_t series, joda::grp::FileGrouper &grouper, const std::vector<std::filesystem::path> &imagePaths,
+                             const std::filesystem::path &imagesBasePath, const joda::settings::AnalyzeSettings &analyzeSettings,
+                             std::unique_ptr<BS::priority_thread_pool> &threadPool)
       -> std::vector<std::shared_ptr<joda::processor::PipelineInitializer>> = 0;
   virtual void setImageProcessed(uint64_t)                                  = 0;
 
@@ -100,7 +140,10 @@ public:
   virtual void setImagePlaneClasssClasssValidity(uint64_t imageId, const enums::PlaneId &, enums::ClassId classId,
                                                  enums::ChannelValidity validity)                               = 0;
 
-  virtual void insertObjects(const processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &) = 0;
+  virtual void insertObjects(const processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &, const WorkUnit &) = 0;
+  virtual void insertPipelineStepProfiles(const std::string &jobId, const std::vector<PipelineStepProfile> &)                       = 0;
+
+  virtual void setTrackingIds(uint64_t imageId, const std::vector<std::pair<uint64_t, uint64_t>> &objectIdTrackingId) = 0;
   [[nodiscard]] virtual auto getImageValidity() const -> enums::ChannelValidity
   {
     return {};
@@ -130,9 +173,9 @@ public:
   {
   }
 
-  auto prepareImages(uint8_t /*plateId*/, int32_t /*series*/, enums::GroupBy /*groupBy*/, const std::string & /*filenameRegex*/,
+  auto prepareImages(uint8_t /*plateId*/, int32_t /*series*/, joda::grp::FileGrouper & /*grouper*/,
                      const std::vector<std::filesystem::path> & /*imagePaths*/, const std::filesystem::path & /*imagesBasePath*/,
-                     const joda::settings::AnalyzeSettings & /*projectImageSetup*/, std::unique_ptr<BS::thread_pool<>> & /*globalThreadPool*/)
+                     const joda::settings::AnalyzeSettings & /*projectImageSetup*/, std::unique_ptr<BS::priority_thread_pool> & /*globalThreadPool*/)
       -> std::vector<std::shared_ptr<joda::processor::PipelineInitializer>> override
   {
     return {};
@@ -161,7 +204,15 @@ public:
   {
   }
 
-  void insertObjects(const processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &) override
+  void insertObjects(const processor::PipelineInitializer &, enums::Units, const joda::atom::ObjectList &, const WorkUnit &) override
+  {
+  }
+
+  void insertPipelineStepProfiles(const std::string & /*jobId*/, const std::vector<PipelineStepProfile> & /*profiles*/) override
+  {
+  }
+
+  void setTrackingIds(uint64_t /*imageId*/, const std::vector<std::pair<uint64_t, uint64_t>> & /*objectIdTrackingId*/) override
   {
   }
 
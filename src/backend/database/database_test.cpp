@@ -0,0 +1,125 @@
+///
+/// \file      database_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/database/database.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <duckdb/main/materialized_query_result.hpp>
+#include <duckdb/main/stream_query_result.hpp>
+
+namespace joda::test {
+
+namespace {
+
+struct ObjectIds
+{
+  uint64_t objectId   = 0;
+  uint64_t originId   = 0;
+  uint64_t parentId   = 0;
+  uint64_t trackingId = 0;
+
+  bool operator==(const ObjectIds &) const = default;
+};
+
+template <typename... ARGS>
+void execute(db::Database &database, const std::string &sql, ARGS... args)
+{
+  auto result = database.select(sql, args...);
+  INFO(sql);
+  REQUIRE_FALSE(result->HasError());
+}
+
+///
+/// \brief  Writes a results database with one image of group A1 and the given objects
+///
+void createShard(const std::filesystem::path &path, uint64_t imageId, const std::vector<ObjectIds> &objects)
+{
+  db::Database database;
+  database.openDatabase(path);
+  execute(database, "INSERT INTO experiment (experiment_id, name) VALUES ('7c6a9b5e-0e6b-4c1e-9d0a-2f3a4b5c6d7e', 'Shard')");
+  execute(database,
+          "INSERT INTO jobs (experiment_id, job_id, job_name, settings_hash) "
+          "SELECT experiment_id, gen_random_uuid(), 'Shard', 42 FROM experiment");
+  execute(database, "INSERT INTO groups (plate_id, group_id, name) VALUES (0, 0, 'A1')");
+  execute(database, "INSERT INTO images (image_id, file_name, processed) VALUES (?, ?, true)", imageId, "img_" + std::to_string(imageId));
+  execute(database, "INSERT INTO images_groups (plate_id, group_id, image_id, image_group_idx) VALUES (0, 0, ?, ?)", imageId,
+          static_cast<uint32_t>(imageId));
+  for(const auto &object : objects) {
+    execute(database,
+            "INSERT INTO objects (image_id, object_id, class_id, meas_origin_object_id, meas_parent_object_id, meas_tracking_id) "
+            "VALUES (?, ?, 1, ?, ?, ?)",
+            imageId, object.objectId, object.originId, object.parentId, object.trackingId);
+  }
+  database.closeDatabase();
+}
+
+auto selectObjectIds(db::Database &database) -> std::vector<ObjectIds>
+{
+  auto result = database.select(
+      "SELECT object_id, meas_origin_object_id, meas_parent_object_id, meas_tracking_id FROM objects ORDER BY object_id");
+  REQUIRE_FALSE(result->HasError());
+  auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
+  std::vector<ObjectIds> objects;
+  for(size_t n = 0; n < materializedResult->RowCount(); n++) {
+    objects.push_back({.objectId   = materializedResult->GetValue(0, n).GetValue<uint64_t>(),
+                       .originId   = materializedResult->GetValue(1, n).GetValue<uint64_t>(),
+                       .parentId   = materializedResult->GetValue(2, n).GetValue<uint64_t>(),
+                       .trackingId = materializedResult->GetValue(3, n).GetValue<uint64_t>()});
+  }
+  return objects;
+}
+
+}    // namespace
+
+///
+/// \brief  Object, parent and tracking IDs of a shard are shifted behind the ones of the
+///         shards merged before, IDs being 0 (not linked) stay 0
+/// \author Joachim Danmayr
+///
+TEST_CASE("database::merge_shards", "[database]")
+{
+  const auto folder = std::filesystem::temp_directory_path() / "imagec_merge_shards_test";
+  std::filesystem::remove_all(folder);
+  std::filesystem::create_directories(folder);
+
+  createShard(folder / "shard_0.icdb", 1, {{.objectId = 1}, {.objectId = 2, .parentId = 1, .trackingId = 1}});
+  createShard(folder / "shard_1.icdb", 2,
+              {{.objectId = 1, .trackingId = 1},
+               {.objectId = 2, .originId = 1, .trackingId = 2},
+               {.objectId = 3, .parentId = 1, .trackingId = 1}});
+
+  {
+    db::Database merged;
+    merged.openDatabase(folder / "merged.icdb");
+    merged.mergeShards({folder / "shard_0.icdb", folder / "shard_1.icdb"});
+
+    const std::vector<ObjectIds> expected = {{.objectId = 1},
+                                             {.objectId = 2, .parentId = 1, .trackingId = 1},
+                                             {.objectId = 3, .trackingId = 2},
+                                             {.objectId = 4, .originId = 3, .trackingId = 3},
+                                             {.objectId = 5, .parentId = 3, .trackingId = 2}};
+    CHECK(selectObjectIds(merged) == expected);
+    CHECK(merged.selectImages().size() == 2);
+    CHECK(merged.selectGroups().size() == 1);
+
+    // Shards can only be merged into an empty database
+    CHECK_THROWS_AS(merged.mergeShards({folder / "shard_0.icdb"}), std::invalid_argument);
+    merged.closeDatabase();
+  }
+
+  std::filesystem::remove_all(folder);
+}
+
+}    // namespace joda::test
@@ -0,0 +1,106 @@
+///
+/// \file      exporter_columnar.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "exporter_columnar.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include "backend/database/query/query_for_image.hpp"
+#include "backend/database/query/query_for_well.hpp"
+#include "backend/helper/logger/console_logger.hpp"
+
+namespace joda::exporter::columnar {
+
+///
+/// \brief      Streams the results of all classes in the filter to files
+/// \author     Joachim Danmayr
+/// \param[in]  database    Opened results database
+/// \param[in]  filterIn    Columns and filter, same as for the xlsx export
+/// \param[in]  view        Plate, well or image view
+/// \param[in]  format      CSV or Parquet
+/// \param[in]  outputFile  Output file. If more than one class is exported,
+///                         the class name is appended to the file name.
+/// \return     Written files
+///
+auto Exporter::startExport(db::Database *database, const settings::ResultsSettings &filterIn, xlsx::ExportSettings::ExportView view,
+                           db::CopyFormat format, const std::filesystem::path &outputFile) -> std::vector<std::filesystem::path>
+{
+  settings::ResultsSettings filter;
+  auto grouping = db::StatsPerGroup::Grouping::BY_PLATE;
+  switch(view) {
+    case xlsx::ExportSettings::ExportView::PLATE:
+      filter   = db::StatsPerGroup::prepareFilter(filterIn);
+      grouping = db::StatsPerGroup::Grouping::BY_PLATE;
+      break;
+    case xlsx::ExportSettings::ExportView::WELL:
+      filter   = db::StatsPerGroup::prepareFilter(filterIn);
+      grouping = db::StatsPerGroup::Grouping::BY_WELL;
+      break;
+    case xlsx::ExportSettings::ExportView::IMAGE:
+      filter   = db::StatsPerImage::prepareFilter(filterIn);
+      grouping = db::StatsPerGroup::Grouping::BY_IMAGE;
+      break;
+  }
+
+  auto classesToExport = db::ResultingTable(&filter);
+  const auto classes   = database->selectClasses();
+  const auto nrOfFiles = std::distance(classesToExport.begin(), classesToExport.end());
+
+  std::vector<std::filesystem::path> writtenFiles;
+  for(const auto &[classs, statement] : classesToExport) {
+    std::pair<std::string, db::DbArgs_t> query;
+    if(grouping == db::StatsPerGroup::Grouping::BY_IMAGE) {
+      query = db::StatsPerImage::toSqlTable(classs, filter.getFilter(), statement, "");
+    } else {
+      query = db::StatsPerGroup::toSQL(classs, filter.getFilter(), statement, grouping);
+    }
+    auto fileName = toFileName(outputFile, classs, classes, nrOfFiles == 1);
+    database->copyTo(query.first, query.second, format, fileName);
+    joda::log::logInfo("Exported >" + fileName.string() + "<.");
+    writtenFiles.emplace_back(std::move(fileName));
+  }
+  return writtenFiles;
+}
+
+///
+/// \brief      <name>_<class>[_<distance to class>][_z<z>_t<t>].<ext>
+///             Characters not allowed in file names are replaced by '_'.
+/// \author     Joachim Danmayr
+///
+auto Exporter::toFileName(const std::filesystem::path &outputFile, const db::ResultingTable::QueryKey &key,
+                          const std::map<enums::ClassId, joda::settings::Class> &classes, bool isSingleFile) -> std::filesystem::path
+{
+  if(isSingleFile) {
+    return outputFile;
+  }
+  auto className = [&classes](enums::ClassId classId) -> std::string {
+    if(classes.contains(classId)) {
+      return classes.at(classId).name;
+    }
+    return std::to_string(static_cast<uint16_t>(classId));
+  };
+
+  std::string suffix = "_" + className(key.classs);
+  if(key.distanceToClass != enums::ClassId::NONE) {
+    suffix += "_distance_to_" + className(key.distanceToClass);
+  }
+  if(key.zStack != 0 || key.tStack != 0) {
+    suffix += "_z" + std::to_string(key.zStack) + "_t" + std::to_string(key.tStack);
+  }
+  std::replace_if(
+      suffix.begin(), suffix.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '_' && c != '-'; }, '_');
+
+  auto fileName = outputFile;
+  fileName.replace_filename(outputFile.stem().string() + suffix + outputFile.extension().string());
+  return fileName;
+}
+
+}    // namespace joda::exporter::columnar
@@ -0,0 +1,45 @@
+///
+/// \file      exporter_columnar.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <vector>
+#include "backend/database/database.hpp"
+#include "backend/database/exporter/xlsx/exporter_xlsx.hpp"
+#include "backend/database/query/filter.hpp"
+#include "backend/settings/results_settings/results_settings.hpp"
+
+namespace joda::exporter::columnar {
+
+///
+/// \class      Exporter
+/// \author     Joachim Danmayr
+/// \brief      Exports the results as CSV or Parquet files. The same queries
+///             as for the xlsx export are used, but the rows are written by
+///             DuckDB directly into the files instead of building a table in
+///             memory first. One file is written per class.
+///
+class Exporter
+{
+public:
+  /////////////////////////////////////////////////////
+  static auto startExport(db::Database *database, const settings::ResultsSettings &filter, xlsx::ExportSettings::ExportView view,
+                          db::CopyFormat format, const std::filesystem::path &outputFile) -> std::vector<std::filesystem::path>;
+
+private:
+  /////////////////////////////////////////////////////
+  static auto toFileName(const std::filesystem::path &outputFile, const db::ResultingTable::QueryKey &key,
+                         const std::map<enums::ClassId, joda::settings::Class> &classes, bool isSingleFile) -> std::filesystem::path;
+};
+
+}    // namespace joda::exporter::columnar
@@ -69,8 +69,7 @@ void Exporter::startHeatmapExport(const std::vector<const Exportable *> &data, c
     auto *worksheet = workbook_add_worksheet(workbookSettings.workbook, name.data());
 
     for(const auto &col : columns.second) {
-      joda::table::Table tmpTable({*col});
-      auto dataHeatmap = joda::db::data::convertToHeatmap(&tmpTable, rows, cols, 0, filterSettings.getFilter().tStack,
+      auto dataHeatmap = joda::db::data::convertToHeatmap(*col, rows, cols, filterSettings.getFilter().tStack,
                                                           joda::db::data::PlotPlateSettings{.densityMapSize = densityMapSize});
       if(dataHeatmap.getNrOfRows() <= 0 || dataHeatmap.getNrOfCols() <= 0) {
         continue;
@@ -155,7 +154,7 @@ Exporter::Pos Exporter::paintHeatmap(const WorkBook &workbookSettings, lxw_works
   for(uint32_t row = 0; row < table.getNrOfRows(); row++) {
     for(uint16_t col = 0; col < table.getNrOfCols(); col++) {
       auto *format     = workbookSettings.numberFormatScientific;
-      const auto &cell = table.data(row, col);
+      const auto cell  = table.data(row, col);
 
       if(!cell || !cell->isValid()) {
         format = workbookSettings.numberFormatInvalidScientific;
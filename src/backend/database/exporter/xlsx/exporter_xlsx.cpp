@@ -91,8 +91,8 @@ void Exporter::writeWorkSheet(const Exporter::WorkBook &workbookSettings, const
 
   for(uint32_t row = 0; row < table.getNrOfRows(); row++) {
     for(uint16_t col = 0; col < table.getNrOfCols(); col++) {
-      const auto &item = table.data(row, col);
-      if(item == nullptr) {
+      const auto item = table.data(row, col);
+      if(!item.has_value()) {
         worksheet_write_blank(worksheet, row + 1, 1 + col, workbookSettings.numberFormatInvalid);
       } else {
         auto val = item->getValAsVariant(table.getColHeader(col).measureChannel);
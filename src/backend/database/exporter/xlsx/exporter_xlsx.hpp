@@ -31,7 +31,9 @@ struct ExportSettings
   enum class ExportFormat
   {
     XLSX,
-    R
+    R,
+    CSV,
+    PARQUET
   };
 
   enum class ExportStyle
@@ -28,6 +28,7 @@ namespace joda::db {
 ResultingTable::ResultingTable(const settings::ResultsSettings *filter) : mFilter(filter)
 {
   std::map<uint32_t, settings::ResultsSettings::ColumnKey> tableHeaders;
+  std::map<QueryKey, uint32_t> rowGroups;    // The rows of one statement are the same objects in all its columns
   for(const auto &[colIdx, colKey] : filter->getColumns()) {
     QueryKey qKey;
     if(settings::ResultsSettings::getType(colKey.measureChannel) == settings::ResultsSettings::MeasureType::DISTANCE ||
@@ -43,6 +44,7 @@ ResultingTable::ResultingTable(const settings::ResultsSettings *filter) : mFilte
     }
     mClassesAndClasses.at(qKey).addColumn(colKey);
     mTableMapping.emplace(colKey, colIdx);
+    mResultingTable.setRowGroup(colIdx.colIdx, rowGroups.emplace(qKey, static_cast<uint32_t>(rowGroups.size())).first->second);
     tableHeaders.emplace(colIdx.colIdx, colKey);
   }
 
@@ -91,11 +91,10 @@ public:
     return mColNames;
   }
 
-private:
-  /////////////////////////////////////////////////////
   static std::string getMeasurement(enums::Measurement measure, bool textual);
   static std::string getStatsString(enums::Stats stats, const std::string &offValue = "ANY_VALUE");
 
+private:
   /////////////////////////////////////////////////////
   std::map<uint32_t, settings::ResultsSettings::ColumnKey> columns;
   settings::ResultsSettings::ColumnName mColNames;
@@ -14,7 +14,9 @@
 #include "query_for_image.hpp"
 #include <exception>
 #include <string>
+#include <vector>
 #include "backend/database/database.hpp"
+#include "backend/database/query/result_chunk.hpp"
 #include "backend/enums/enum_measurements.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 
@@ -30,22 +32,7 @@ namespace joda::db {
 auto StatsPerImage::toTable(db::Database *database, const settings::ResultsSettings &filterIn, settings::ResultsSettings *resultingFilter)
     -> QueryResult
 {
-  //
-  // Remove all stats but one per channel since one image level an average e.g. for just one object does not make sense
-  //
-  settings::ResultsSettings filter;
-  std::set<settings::ResultsSettings::ColumnKey> stillMeasured;
-  uint32_t tabColIdx = 0;
-  for(const auto &[_, key] : filterIn.getColumns()) {
-    settings::ResultsSettings::ColumnKey keyTmp = key;
-    keyTmp.stats                                = enums::Stats::OFF;
-    if(!stillMeasured.contains(keyTmp)) {
-      filter.addColumn({tabColIdx}, keyTmp, key.names);
-      stillMeasured.emplace(keyTmp);
-      tabColIdx++;
-    }
-  }
-  filter.setFilter(filterIn.getFilter(), filterIn.getPlateSetup(), filterIn.getDensityMapSettings());
+  settings::ResultsSettings filter = prepareFilter(filterIn);
   if(resultingFilter != nullptr) {
     *resultingFilter = filter;
   }
@@ -56,55 +43,73 @@ auto StatsPerImage::toTable(db::Database *database, const settings::ResultsSetti
   auto classesToExport = ResultingTable(&filter);
 
   //
-  // This is used to align the objects for each class correct
+  // The statements of the classes are independent and executed concurrently
   //
+  std::vector<std::pair<std::string, DbArgs_t>> queries;
+  std::vector<std::pair<const db::ResultingTable::QueryKey *, const PreparedStatement *>> statements;
   for(const auto &[classs, statement] : classesToExport) {
-    auto [sql, params] = toSqlTable(classs, filter.getFilter(), statement, "");
-    auto result        = database->select(sql, params);
-    if(result->HasError()) {
-      throw std::invalid_argument(result->GetError());
-    }
-    auto materializedResult = result->Cast<duckdb::StreamQueryResult>().Materialize();
-    size_t columnNr         = statement.getColSize();
-    for(duckdb::idx_t rowIdx = 0; rowIdx < materializedResult->RowCount(); rowIdx++) {
+    queries.push_back(toSqlTable(classs, filter.getFilter(), statement, ""));
+    statements.emplace_back(&classs, &statement);
+  }
+  auto results = database->selectAll(queries);
+
+  //
+  // This is used to align the objects for each class correct
+  //
+  for(size_t n = 0; n < results.size(); n++) {
+    const auto &classs    = *statements[n].first;
+    const auto &statement = *statements[n].second;
+    size_t columnNr       = statement.getColSize();
+    duckdb::idx_t rowIdx  = 0;
+    for(auto &chunk : results[n]->Collection().Chunks()) {
+      const auto count = chunk.size();
+      ChunkColumn<uint32_t> centersX(chunk.data[columnNr + 0], count);
+      ChunkColumn<uint32_t> centersY(chunk.data[columnNr + 1], count);
+      ChunkColumn<uint64_t> objectIds(chunk.data[columnNr + 2], count);
+      ChunkColumn<uint64_t> objectIdsReal(chunk.data[columnNr + 3], count);
+      ChunkColumn<uint64_t> parentObjectIds(chunk.data[columnNr + 4], count);
+      ChunkColumn<uint64_t> trackingIds(chunk.data[columnNr + 5], count);
+      ChunkColumn<std::string> filenames(chunk.data[columnNr + 6], count);
+      ChunkColumn<uint32_t> tStacks(chunk.data[columnNr + 7], count);
+      ChunkColumn<uint32_t> cStacks(chunk.data[columnNr + 8], count);
+      ChunkColumn<uint32_t> zStacks(chunk.data[columnNr + 9], count);
+      ChunkColumn<uint64_t> distanceToObjectIds(chunk.data[columnNr + 10], count);
+      std::vector<ChunkColumn<double>> values;
+      values.reserve(columnNr);
       for(size_t colIdx = 0; colIdx < columnNr; colIdx++) {
-        uint32_t meas_center_x  = materializedResult->GetValue(columnNr + 0, rowIdx).GetValue<uint32_t>();
-        uint32_t meas_center_y  = materializedResult->GetValue(columnNr + 1, rowIdx).GetValue<uint32_t>();
-        uint64_t objectId       = materializedResult->GetValue(columnNr + 2, rowIdx).GetValue<uint64_t>();
-        uint64_t objectIdReal   = materializedResult->GetValue(columnNr + 3, rowIdx).GetValue<uint64_t>();
-        uint64_t parentObjectId = materializedResult->GetValue(columnNr + 4, rowIdx).GetValue<uint64_t>();
-        auto trackIdTmp         = materializedResult->GetValue(columnNr + 5, rowIdx);
-        auto filename           = materializedResult->GetValue(columnNr + 6, rowIdx).GetValue<std::string>();
-        auto tStack             = materializedResult->GetValue(columnNr + 7, rowIdx).GetValue<uint32_t>();
-        auto cStack             = materializedResult->GetValue(columnNr + 8, rowIdx).GetValue<uint32_t>();
-        auto zStack             = materializedResult->GetValue(columnNr + 9, rowIdx).GetValue<uint32_t>();
-        auto distanceToObjectId = materializedResult->GetValue(columnNr + 10, rowIdx).GetValue<uint64_t>();
-        uint64_t trackingId     = 0;
-        if(!trackIdTmp.IsNull()) {
-          trackingId = trackIdTmp.GetValue<uint64_t>();
-        }
-        /// \todo think about if 0 is always the best choice
-        double value = 0;
-        if(!materializedResult->GetValue(colIdx, rowIdx).IsNull()) {
-          value = materializedResult->GetValue(colIdx, rowIdx).GetValue<double>();
+        values.emplace_back(chunk.data[colIdx], count);
+      }
+
+      for(duckdb::idx_t row = 0; row < count; row++, rowIdx++) {
+        uint32_t meas_center_x  = centersX.get(row);
+        uint32_t meas_center_y  = centersY.get(row);
+        uint64_t objectId       = objectIds.get(row);
+        uint64_t objectIdReal   = objectIdsReal.get(row);
+        uint64_t parentObjectId = parentObjectIds.get(row);
+        uint64_t trackingId     = trackingIds.get(row);
+        auto tStack             = tStacks.get(row);
+        auto cStack             = cStacks.get(row);
+        auto zStack             = zStacks.get(row);
+        auto distanceToObjectId = distanceToObjectIds.get(row);
+        std::string fileNameTmp = filenames.get(row) + " t(" + std::to_string(tStack) + ")";
+        uint64_t groupIdx       = (static_cast<uint64_t>(meas_center_x) << 32) | meas_center_y;
+        for(size_t colIdx = 0; colIdx < columnNr; colIdx++) {
+          /// \todo think about if 0 is always the best choice
+          double value = values[colIdx].get(row, 0);
+          classesToExport.setData(classs, statement.getColNames(), static_cast<uint32_t>(rowIdx), static_cast<uint32_t>(colIdx),
+                                  table::TableCell{value,
+                                                   table::TableCell::MetaData{.objectIdGroup      = objectId,
+                                                                              .objectId           = objectIdReal,
+                                                                              .parentObjectId     = parentObjectId,
+                                                                              .trackingId         = trackingId,
+                                                                              .distanceToObjectId = distanceToObjectId,
+                                                                              .isValid            = true,
+                                                                              .tStack             = tStack,
+                                                                              .zStack             = zStack,
+                                                                              .cStack             = cStack,
+                                                                              .rowName            = fileNameTmp},
+                                                   table::TableCell::Grouping{.groupIdx = groupIdx, .posX = meas_center_x, .posY = meas_center_y}});
         }
-        std::string fileNameTmp = filename + " t(" + std::to_string(tStack) + ")";
-        classesToExport.setData(classs, statement.getColNames(), static_cast<uint32_t>(rowIdx), static_cast<uint32_t>(colIdx),
-                                table::TableCell{value,
-                                                 table::TableCell::MetaData{.objectIdGroup      = objectId,
-                                                                            .objectId           = objectIdReal,
-                                                                            .parentObjectId     = parentObjectId,
-                                                                            .trackingId         = trackingId,
-                                                                            .distanceToObjectId = distanceToObjectId,
-                                                                            .isValid            = true,
-                                                                            .tStack             = tStack,
-                                                                            .zStack             = zStack,
-                                                                            .cStack             = cStack,
-                                                                            .rowName            = fileNameTmp},
-                                                 table::TableCell::Grouping{
-                                                     .groupIdx = static_cast<uint64_t>((static_cast<uint64_t>(meas_center_x) << 32) | meas_center_y),
-                                                     .posX     = meas_center_x,
-                                                     .posY     = meas_center_y}});
       }
     }
   }
@@ -114,6 +119,31 @@ auto StatsPerImage::toTable(db::Database *database, const settings::ResultsSetti
   return classesToExport.getResult();
 }
 
+///
+/// \brief      Remove all stats but one per channel since one image level an average
+///             e.g. for just one object does not make sense
+/// \author     Joachim Danmayr
+/// \param[in]  filterIn  Filter as configured by the user
+/// \return     Filter with one column per measurement
+///
+auto StatsPerImage::prepareFilter(const settings::ResultsSettings &filterIn) -> settings::ResultsSettings
+{
+  settings::ResultsSettings filter;
+  std::set<settings::ResultsSettings::ColumnKey> stillMeasured;
+  uint32_t tabColIdx = 0;
+  for(const auto &[_, key] : filterIn.getColumns()) {
+    settings::ResultsSettings::ColumnKey keyTmp = key;
+    keyTmp.stats                                = enums::Stats::OFF;
+    if(!stillMeasured.contains(keyTmp)) {
+      filter.addColumn({tabColIdx}, keyTmp, key.names);
+      stillMeasured.emplace(keyTmp);
+      tabColIdx++;
+    }
+  }
+  filter.setFilter(filterIn.getFilter(), filterIn.getPlateSetup(), filterIn.getDensityMapSettings());
+  return filter;
+}
+
 ///
 /// \brief
 /// \author
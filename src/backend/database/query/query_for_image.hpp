@@ -15,6 +15,7 @@ class StatsPerImage
 public:
   static auto toTable(db::Database *database, const settings::ResultsSettings &filter, settings::ResultsSettings *resultingFilter = nullptr)
       -> QueryResult;
+  static auto prepareFilter(const settings::ResultsSettings &filterIn) -> settings::ResultsSettings;
   static auto toSqlTable(const db::ResultingTable::QueryKey &classsAndClass, const settings::ResultsSettings::ObjectFilter &filter,
                          const PreparedStatement &channelFilter, const std::string &offValue = "ANY_VALUE") -> std::pair<std::string, DbArgs_t>;
 
@@ -3,9 +3,13 @@
 #include "query_for_well.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include "backend/database/query/filter.hpp"
+#include "backend/database/query/result_chunk.hpp"
+#include "backend/database/query/stats_aggregates.hpp"
 #include "backend/enums/bigtypes.hpp"
 #include "backend/enums/enum_measurements.hpp"
 #include "backend/helper/table/table.hpp"
@@ -22,21 +26,7 @@ namespace joda::db {
 auto StatsPerGroup::toTable(db::Database *database, const settings::ResultsSettings &filterIn, Grouping grouping,
                             settings::ResultsSettings *resultingFilter) -> QueryResult
 {
-  //
-  // Remove object IDs, and position since they make no sense in an overview
-  //
-  settings::ResultsSettings filter;
-  uint32_t colIdxOut = 0;
-  for(const auto &[_, key] : filterIn.getColumns()) {
-    if(settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::DISTANCE_ID ||
-       settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::ID ||
-       settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::POSITION) {
-      continue;
-    }
-    filter.addColumn({colIdxOut}, key, key.names);
-    colIdxOut++;
-  }
-  filter.setFilter(filterIn.getFilter(), filterIn.getPlateSetup(), filterIn.getDensityMapSettings());
+  settings::ResultsSettings filter = prepareFilter(filterIn);
   if(resultingFilter != nullptr) {
     *resultingFilter = filter;
   }
@@ -93,24 +83,53 @@ auto StatsPerGroup::toTable(db::Database *database, const settings::ResultsSetti
   }
 
   //
-  // Iterate
+  // The statements of the classes are independent and executed concurrently
   //
+  const bool hasAggregates = database->hasStatsAggregates();
+  std::vector<std::pair<std::string, DbArgs_t>> queries;
+  std::vector<std::pair<const db::ResultingTable::QueryKey *, const PreparedStatement *>> statements;
   for(const auto &[classs, statement] : classesToExport) {
-    auto materializedResult = getData(classs, database, filter.getFilter(), statement, grouping)->Cast<duckdb::StreamQueryResult>().Materialize();
-    size_t columnNr         = statement.getColSize();
+    if(hasAggregates && StatsAggregates::canAnswer(statement, filter.getFilter(), nrOfTimeStacks)) {
+      queries.push_back(toSQLFromAggregates(classs, filter.getFilter(), statement, grouping));
+    } else {
+      queries.push_back(toSQL(classs, filter.getFilter(), statement, grouping));
+    }
+    statements.emplace_back(&classs, &statement);
+  }
+  auto results = database->selectAll(queries);
+
+  //
+  // Iterate
+  //
+  for(size_t n = 0; n < results.size(); n++) {
+    const auto &classs    = *statements[n].first;
+    const auto &statement = *statements[n].second;
+    size_t columnNr       = statement.getColSize();
+
+    for(auto &chunk : results[n]->Collection().Chunks()) {
+      const auto count = chunk.size();
+      ChunkColumn<uint16_t> groupIds(chunk.data[columnNr + 0], count);
+      ChunkColumn<uint32_t> imgGroupIdxs(chunk.data[columnNr + 1], count);
+      ChunkColumn<uint32_t> platePosXs(chunk.data[columnNr + 2], count);
+      ChunkColumn<uint32_t> platePosYs(chunk.data[columnNr + 3], count);
+      ChunkColumn<uint64_t> imageIds(chunk.data[columnNr + 6], count);
+      ChunkColumn<uint64_t> validities(chunk.data[columnNr + 7], count);
+      ChunkColumn<uint32_t> tStacks(chunk.data[columnNr + 8], count);
+      std::vector<ChunkColumn<double>> values;
+      values.reserve(columnNr);
+      for(size_t colIdx = 0; colIdx < columnNr; colIdx++) {
+        values.emplace_back(chunk.data[colIdx], count);
+      }
 
-    for(size_t row = 0; row < materializedResult->RowCount(); row++) {
-      try {
-        auto groupId     = materializedResult->GetValue(columnNr + 0, row).GetValue<uint16_t>();
-        auto imgGroupIdx = materializedResult->GetValue(columnNr + 1, row).GetValue<uint32_t>();
-        auto platePosX   = materializedResult->GetValue(columnNr + 2, row).GetValue<uint32_t>();
-        auto platePosY   = materializedResult->GetValue(columnNr + 3, row).GetValue<uint32_t>();
-        auto groupName   = materializedResult->GetValue(columnNr + 4, row).GetValue<std::string>();
-        auto filename    = materializedResult->GetValue(columnNr + 5, row).GetValue<std::string>();
-        auto imageId     = materializedResult->GetValue(columnNr + 6, row).GetValue<uint64_t>();
-        auto validity    = materializedResult->GetValue(columnNr + 7, row).GetValue<uint64_t>();
-        auto tStack      = materializedResult->GetValue(columnNr + 8, row).GetValue<uint32_t>();
-        size_t rowIdx    = row;
+      for(duckdb::idx_t row = 0; row < count; row++) {
+        auto groupId     = groupIds.get(row);
+        auto imgGroupIdx = imgGroupIdxs.get(row);
+        auto platePosX   = platePosXs.get(row);
+        auto platePosY   = platePosYs.get(row);
+        auto imageId     = imageIds.get(row);
+        auto validity    = validities.get(row);
+        auto tStack      = tStacks.get(row);
+        size_t rowIdx    = 0;
         if(grouping == Grouping::BY_WELL) {
           rowIdx = rowIndexes.at({imageId, tStack});
         } else {
@@ -118,7 +137,11 @@ auto StatsPerGroup::toTable(db::Database *database, const settings::ResultsSetti
         }
 
         for(int32_t colIdxI = 0; colIdxI < static_cast<int32_t>(columnNr); colIdxI++) {
-          double value = materializedResult->GetValue(static_cast<uint32_t>(colIdxI), row).GetValue<double>();
+          const auto &column = values[static_cast<size_t>(colIdxI)];
+          if(column.isNull(row)) {
+            continue;
+          }
+          double value = column.get(row);
           if(grouping == Grouping::BY_WELL) {
             ///
             joda::settings::ImgPositionInWell pos;
@@ -160,8 +183,6 @@ auto StatsPerGroup::toTable(db::Database *database, const settings::ResultsSetti
                                                             .posY     = platePosY}});
           }
         }
-      } catch(const duckdb::InternalException &ex) {
-        std::cout << ex.what() << std::endl;
       }
     }
   }
@@ -169,22 +190,132 @@ auto StatsPerGroup::toTable(db::Database *database, const settings::ResultsSetti
 }
 
 ///
-/// \brief
-/// \author
-/// \param[in]
-/// \param[out]
-/// \return
+/// \brief      Remove object IDs, and position since they make no sense in an overview
+/// \author     Joachim Danmayr
+/// \param[in]  filterIn  Filter as configured by the user
+/// \return     Filter with the columns which can be grouped
+///
+auto StatsPerGroup::prepareFilter(const settings::ResultsSettings &filterIn) -> settings::ResultsSettings
+{
+  settings::ResultsSettings filter;
+  uint32_t colIdxOut = 0;
+  for(const auto &[_, key] : filterIn.getColumns()) {
+    if(settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::DISTANCE_ID ||
+       settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::ID ||
+       settings::ResultsSettings::getType(key.measureChannel) == settings::ResultsSettings::MeasureType::POSITION) {
+      continue;
+    }
+    filter.addColumn({colIdxOut}, key, key.names);
+    colIdxOut++;
+  }
+  filter.setFilter(filterIn.getFilter(), filterIn.getPlateSetup(), filterIn.getDensityMapSettings());
+  return filter;
+}
+
 ///
-auto StatsPerGroup::getData(const db::ResultingTable::QueryKey &classsAndClass, db::Database *analyzer,
-                            const settings::ResultsSettings::ObjectFilter &filter, const PreparedStatement &channelFilter, Grouping grouping)
-    -> std::unique_ptr<duckdb::QueryResult>
+/// \brief      Same result as toSQL, but read from the precalculated statistics.
+///             Only valid if StatsAggregates::canAnswer is true for the statement.
+/// \author     Joachim Danmayr
+/// \param[in]  classsAndClass  Class, z- and t-stack to select
+/// \param[in]  filter          Actual filter
+/// \param[in]  channelFilter   Columns to select
+/// \param[in]  grouping        Images of a well or the wells of a plate
+/// \return     Query and its arguments
+///
+auto StatsPerGroup::toSQLFromAggregates(const db::ResultingTable::QueryKey &classsAndClass, const settings::ResultsSettings::ObjectFilter &filter,
+                                        const PreparedStatement &channelFilter, Grouping grouping) -> std::pair<std::string, DbArgs_t>
 {
-  auto [sql, params]                          = toSQL(classsAndClass, filter, channelFilter, grouping);
-  std::unique_ptr<duckdb::QueryResult> result = analyzer->select(sql, params);
-  if(result->HasError()) {
-    throw std::invalid_argument(result->GetError());
+  const bool byWell          = grouping == Grouping::BY_WELL;
+  const std::string tblStats = byWell ? "stats_image_" : "stats_group_";
+  const std::string keyCol   = byWell ? "image_id" : "group_id";
+
+  std::string columns;
+  std::string joins;
+  std::set<int32_t> joinedStacks;
+  for(const auto &[_, column] : channelFilter.getColumns()) {
+    const auto colName = StatsAggregates::columnName(column.measureChannel, column.stats);
+    if(settings::ResultsSettings::getType(column.measureChannel) == settings::ResultsSettings::MeasureType::INTENSITY) {
+      const std::string stackC    = std::to_string(column.crossChannelStacksC);
+      const std::string tableName = "sc" + stackC;
+      if(!joinedStacks.contains(column.crossChannelStacksC)) {
+        joins += "LEFT JOIN " + tblStats + "intensities " + tableName + " ON\n " + tableName + "." + keyCol + " = s." + keyCol + " AND " + tableName +
+                 ".class_id = s.class_id AND " + tableName + ".stack_z = s.stack_z AND " + tableName + ".stack_t = s.stack_t AND " + tableName +
+                 ".stack_c = " + stackC + "\n";
+        joinedStacks.emplace(column.crossChannelStacksC);
+      }
+      columns += " " + tableName + "." + colName + " as " + colName + "_" + stackC + ",\n";
+    } else {
+      columns += " s." + colName + " as " + colName + ",\n";
+    }
+  }
+
+  std::string queryGroupId = "(";
+  DbArgs_t args;
+  int i = 0;
+  if(byWell) {
+    for(auto groupId : filter.groupId) {
+      queryGroupId += (i > 0 ? ", $" + std::to_string(i + 1) : "$" + std::to_string(i + 1));
+      args.emplace_back(static_cast<uint16_t>(groupId));
+      i++;
+    }
+  }
+  queryGroupId += ")";
+
+  std::string sql;
+  if(byWell) {
+    sql = "SELECT\n" + columns +
+          " images_groups.group_id as group_id,\n"
+          " images_groups.image_group_idx as image_group_idx,\n"
+          " groups.pos_on_plate_x as pos_on_plate_x,\n"
+          " groups.pos_on_plate_y as pos_on_plate_y,\n"
+          " groups.name as group_name,\n"
+          " images.file_name as file_name,\n"
+          " images.image_id as image_id,\n"
+          " images.validity as validity,\n"
+          " s.stack_t as stack_t_real\n"
+          "FROM stats_image_objects s\n" +
+          joins +
+          "JOIN images_groups ON\n"
+          " s.image_id = images_groups.image_id\n"
+          "JOIN groups ON\n"
+          " images_groups.group_id = groups.group_id\n"
+          "JOIN images ON\n"
+          " s.image_id = images.image_id\n"
+          "WHERE\n"
+          " images_groups.group_id IN " +
+          queryGroupId + " AND ";
+  } else {
+    sql = "SELECT\n" + columns +
+          " s.group_id as group_id,\n"
+          " 0 as image_group_idx,\n"
+          " groups.pos_on_plate_x as pos_on_plate_x,\n"
+          " groups.pos_on_plate_y as pos_on_plate_y,\n"
+          " groups.name as group_name,\n"
+          " '' as file_name,\n"
+          " 0 as image_id,\n"
+          " s.validity as validity,\n"
+          " s.stack_t as stack_t_real\n"
+          "FROM stats_group_objects s\n" +
+          joins +
+          "JOIN groups ON\n"
+          " s.group_id = groups.group_id\n"
+          "WHERE\n ";
+  }
+  sql += "s.class_id=$" + std::to_string(i + 1) + " AND s.stack_z=$" + std::to_string(i + 2);
+  args.emplace_back(static_cast<uint16_t>(classsAndClass.classs));
+  args.emplace_back(static_cast<int32_t>(classsAndClass.zStack));
+
+  if(filter.tStackHandling == settings::ResultsSettings::ObjectFilter::TStackHandling::INDIVIDUAL) {
+    sql += " AND s.stack_t=$" + std::to_string(i + 3) + "\n";
+    sql += byWell ? "ORDER BY file_name" : "ORDER BY pos_on_plate_y, pos_on_plate_x\n";
+    args.emplace_back(static_cast<int32_t>(classsAndClass.tStack));
+  } else if(filter.tStackHandling == settings::ResultsSettings::ObjectFilter::TStackHandling::SLICE) {
+    sql += "\n";
+    sql += byWell ? "ORDER BY file_name,stack_t_real" : "ORDER BY pos_on_plate_y, pos_on_plate_x,stack_t_real\n";
+  } else {
+    throw std::invalid_argument("Unknow t-Stack handling");
   }
-  return result;
+  return {sql, args};
 }
 
 ///
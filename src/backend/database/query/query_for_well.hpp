@@ -19,12 +19,12 @@ public:
 
   static auto toTable(db::Database *database, const settings::ResultsSettings &filter, Grouping grouping,
                       settings::ResultsSettings *resultingFilter = nullptr) -> QueryResult;
+  static auto prepareFilter(const settings::ResultsSettings &filterIn) -> settings::ResultsSettings;
   static auto toSQL(const db::ResultingTable::QueryKey &classsAndClass, const settings::ResultsSettings::ObjectFilter &filter,
                     const PreparedStatement &channelFilter, Grouping grouping) -> std::pair<std::string, DbArgs_t>;
 
 private:
-  static auto getData(const db::ResultingTable::QueryKey &classsAndClass, db::Database *analyzer,
-                      const settings::ResultsSettings::ObjectFilter &filter, const PreparedStatement &channelFilter, Grouping grouping)
-      -> std::unique_ptr<duckdb::QueryResult>;
+  static auto toSQLFromAggregates(const db::ResultingTable::QueryKey &classsAndClass, const settings::ResultsSettings::ObjectFilter &filter,
+                                  const PreparedStatement &channelFilter, Grouping grouping) -> std::pair<std::string, DbArgs_t>;
 };
 }    // namespace joda::db
@@ -0,0 +1,102 @@
+///
+/// \file      result_chunk.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <duckdb/common/types.hpp>
+#include <duckdb/common/types/string_type.hpp>
+#include <duckdb/common/types/vector.hpp>
+#include <duckdb/common/vector_operations/vector_operations.hpp>
+
+namespace joda::db {
+
+///
+/// \class      ChunkColumn
+/// \author     Joachim Danmayr
+/// \brief      One column of a result chunk converted to T. The column is cast
+///             with one vector operation per chunk instead of boxing each cell
+///             into a duckdb::Value.
+///
+template <class T>
+class ChunkColumn
+{
+public:
+  /////////////////////////////////////////////////////
+  using Physical_t = std::conditional_t<std::is_same_v<T, std::string>, duckdb::string_t, T>;
+
+  ChunkColumn(duckdb::Vector &source, duckdb::idx_t count) : mVector(logicalType(), count)
+  {
+    duckdb::VectorOperations::DefaultCast(source, mVector, count);
+    mVector.Flatten(count);
+    mData     = duckdb::FlatVector::GetData<Physical_t>(mVector);
+    mValidity = &duckdb::FlatVector::Validity(mVector);
+  }
+
+  ///
+  /// \brief  The validity mask is part of the vector, so both pointers are taken from
+  ///         the moved vector again
+  ///
+  ChunkColumn(ChunkColumn &&other) noexcept :
+      mVector(std::move(other.mVector)), mData(duckdb::FlatVector::GetData<Physical_t>(mVector)),
+      mValidity(&duckdb::FlatVector::Validity(mVector))
+  {
+  }
+
+  ChunkColumn(const ChunkColumn &)            = delete;
+  ChunkColumn &operator=(const ChunkColumn &) = delete;
+  ChunkColumn &operator=(ChunkColumn &&)      = delete;
+
+  [[nodiscard]] bool isNull(duckdb::idx_t row) const
+  {
+    return !mValidity->RowIsValid(row);
+  }
+
+  [[nodiscard]] auto get(duckdb::idx_t row, T defaultValue = {}) const -> T
+  {
+    if(isNull(row)) {
+      return defaultValue;
+    }
+    if constexpr(std::is_same_v<T, std::string>) {
+      return mData[row].GetString();
+    } else {
+      return mData[row];
+    }
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  static auto logicalType() -> duckdb::LogicalType
+  {
+    if constexpr(std::is_same_v<T, double>) {
+      return duckdb::LogicalType::DOUBLE;
+    } else if constexpr(std::is_same_v<T, uint16_t>) {
+      return duckdb::LogicalType::USMALLINT;
+    } else if constexpr(std::is_same_v<T, uint32_t>) {
+      return duckdb::LogicalType::UINTEGER;
+    } else if constexpr(std::is_same_v<T, uint64_t>) {
+      return duckdb::LogicalType::UBIGINT;
+    } else {
+      static_assert(std::is_same_v<T, std::string>, "Unsupported column type!");
+      return duckdb::LogicalType::VARCHAR;
+    }
+  }
+
+  /////////////////////////////////////////////////////
+  duckdb::Vector mVector;
+  const Physical_t *mData               = nullptr;
+  const duckdb::ValidityMask *mValidity = nullptr;
+};
+
+}    // namespace joda::db
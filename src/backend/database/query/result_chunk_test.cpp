@@ -0,0 +1,92 @@
+///
+/// \file      result_chunk_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/database/query/result_chunk.hpp"
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <duckdb/main/connection.hpp>
+#include <duckdb/main/database.hpp>
+#include <duckdb/main/materialized_query_result.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Columns of all chunks are cast to the requested type, NULL cells are reported
+/// \author Joachim Danmayr
+///
+TEST_CASE("result_chunk::cast_columns", "[result_chunk]")
+{
+  duckdb::DuckDB database(nullptr);
+  duckdb::Connection connection(database);
+  auto result = connection.Query(
+      "SELECT range::FLOAT / 2 AS value, CASE WHEN range % 3 = 0 THEN NULL ELSE range END AS id, 'img_' || range AS name "
+      "FROM range(5000)");
+  REQUIRE_FALSE(result->HasError());
+
+  duckdb::idx_t rowIdx   = 0;
+  size_t nrOfNullCells   = 0;
+  size_t nrOfWrongValues = 0;
+  for(auto &chunk : result->Collection().Chunks()) {
+    const auto count = chunk.size();
+    db::ChunkColumn<double> values(chunk.data[0], count);
+    db::ChunkColumn<uint64_t> ids(chunk.data[1], count);
+    db::ChunkColumn<std::string> names(chunk.data[2], count);
+    for(duckdb::idx_t row = 0; row < count; row++, rowIdx++) {
+      if(ids.isNull(row)) {
+        nrOfNullCells++;
+        nrOfWrongValues += ids.get(row, 42) != 42 ? 1 : 0;
+      } else {
+        nrOfWrongValues += ids.get(row) != rowIdx ? 1 : 0;
+      }
+      nrOfWrongValues += values.get(row) != static_cast<double>(rowIdx) / 2 ? 1 : 0;
+      nrOfWrongValues += names.get(row) != "img_" + std::to_string(rowIdx) ? 1 : 0;
+    }
+  }
+  CHECK(rowIdx == 5000);
+  CHECK(nrOfNullCells == 1667);
+  CHECK(nrOfWrongValues == 0);
+}
+
+///
+/// \brief  Columns stay valid if they are moved, e.g. when a vector of columns grows
+/// \author Joachim Danmayr
+///
+TEST_CASE("result_chunk::move_column", "[result_chunk]")
+{
+  duckdb::DuckDB database(nullptr);
+  duckdb::Connection connection(database);
+  auto result = connection.Query("SELECT CASE WHEN range % 2 = 0 THEN NULL ELSE range::DOUBLE END AS value FROM range(100)");
+  REQUIRE_FALSE(result->HasError());
+
+  duckdb::idx_t nrOfRows = 0;
+  size_t nrOfWrongValues = 0;
+  for(auto &chunk : result->Collection().Chunks()) {
+    const auto count = chunk.size();
+    std::vector<db::ChunkColumn<double>> columns;
+    for(int32_t n = 0; n < 16; n++) {
+      columns.emplace_back(chunk.data[0], count);
+    }
+    for(const auto &column : columns) {
+      for(duckdb::idx_t row = 0; row < count; row++) {
+        if((nrOfRows + row) % 2 == 0) {
+          nrOfWrongValues += column.isNull(row) ? 0 : 1;
+        } else {
+          nrOfWrongValues += column.get(row) != static_cast<double>(nrOfRows + row) ? 1 : 0;
+        }
+      }
+    }
+    nrOfRows += count;
+  }
+  CHECK(nrOfRows == 100);
+  CHECK(nrOfWrongValues == 0);
+}
+
+}    // namespace joda::test
@@ -0,0 +1,307 @@
+///
+/// \file      stats_aggregates.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "stats_aggregates.hpp"
+#include <array>
+#include <string>
+#include "backend/database/query/filter.hpp"
+
+namespace joda::db {
+
+namespace {
+
+constexpr std::array OBJECT_MEASUREMENTS{enums::Measurement::COUNT,
+                                         enums::Measurement::CONFIDENCE,
+                                         enums::Measurement::AREA_SIZE,
+                                         enums::Measurement::PERIMETER,
+                                         enums::Measurement::CIRCULARITY,
+                                         enums::Measurement::BOUNDING_BOX_WIDTH,
+                                         enums::Measurement::BOUNDING_BOX_HEIGHT};
+
+constexpr std::array INTENSITY_MEASUREMENTS{enums::Measurement::INTENSITY_SUM, enums::Measurement::INTENSITY_AVG, enums::Measurement::INTENSITY_MIN,
+                                            enums::Measurement::INTENSITY_MAX};
+
+constexpr std::array STATS{enums::Stats::CNT, enums::Stats::AVG, enums::Stats::MAX, enums::Stats::MIN, enums::Stats::SUM, enums::Stats::MEDIAN,
+                           enums::Stats::STDDEV};
+
+///
+/// \brief      Calls func for each precalculated column
+///
+template <class MEASUREMENTS, class FUNC>
+void forEachColumn(const MEASUREMENTS &measurements, FUNC &&func)
+{
+  for(const auto measure : measurements) {
+    for(const auto stats : STATS) {
+      func(measure, stats);
+    }
+  }
+}
+
+///
+/// \brief      Column definitions of an aggregate table
+///
+template <class MEASUREMENTS>
+auto columnDefinitions(const MEASUREMENTS &measurements) -> std::string
+{
+  std::string columns;
+  forEachColumn(measurements, [&](enums::Measurement measure, enums::Stats stats) {
+    columns += " " + StatsAggregates::columnName(measure, stats) + " DOUBLE,";
+  });
+  columns.pop_back();
+  return columns;
+}
+
+///
+/// \brief      Comma separated column names of an aggregate table
+///
+template <class MEASUREMENTS>
+auto columnNames(const MEASUREMENTS &measurements) -> std::string
+{
+  std::string columns;
+  forEachColumn(measurements, [&](enums::Measurement measure, enums::Stats stats) { columns += StatsAggregates::columnName(measure, stats) + ","; });
+  columns.pop_back();
+  return columns;
+}
+
+///
+/// \brief      Statistics of the raw measurements of an image
+///
+template <class MEASUREMENTS>
+auto imageStats(const MEASUREMENTS &measurements, const std::string &tablePrefix) -> std::string
+{
+  std::string columns;
+  forEachColumn(measurements, [&](enums::Measurement measure, enums::Stats stats) {
+    // Same expressions as the raw image query, the count is the number of objects
+    std::string value = measure == enums::Measurement::COUNT ? "1" : tablePrefix + PreparedStatement::getMeasurement(measure, false);
+    columns += " " + PreparedStatement::getStatsString(stats) + "(" + value + "),\n";
+  });
+  columns.erase(columns.size() - 2, 1);
+  return columns;
+}
+
+///
+/// \brief      Average of the image statistics over the valid images of a group
+///
+template <class MEASUREMENTS>
+auto groupStats(const MEASUREMENTS &measurements) -> std::string
+{
+  std::string columns;
+  forEachColumn(measurements, [&](enums::Measurement measure, enums::Stats stats) {
+    columns += " AVG(CASE WHEN images.validity = 0 THEN s." + StatsAggregates::columnName(measure, stats) + " ELSE NULL END),\n";
+  });
+  columns.erase(columns.size() - 2, 1);
+  return columns;
+}
+
+}    // namespace
+
+///
+/// \brief      Statements creating the aggregate tables
+/// \author     Joachim Danmayr
+///
+auto StatsAggregates::createTables() -> std::string
+{
+  return "CREATE TABLE IF NOT EXISTS stats_image_objects ("
+         " image_id UBIGINT,"
+         " class_id USMALLINT,"
+         " stack_z UINTEGER,"
+         " stack_t UINTEGER," +
+         columnDefinitions(OBJECT_MEASUREMENTS) +
+         ");"
+
+         "CREATE TABLE IF NOT EXISTS stats_image_intensities ("
+         " image_id UBIGINT,"
+         " class_id USMALLINT,"
+         " stack_z UINTEGER,"
+         " stack_t UINTEGER,"
+         " stack_c UINTEGER," +
+         columnDefinitions(INTENSITY_MEASUREMENTS) +
+         ");"
+
+         "CREATE TABLE IF NOT EXISTS stats_group_objects ("
+         " group_id USMALLINT,"
+         " class_id USMALLINT,"
+         " stack_z UINTEGER,"
+         " stack_t UINTEGER,"
+         " validity UBIGINT,"    // Highest validity of the images in the group
+         + columnDefinitions(OBJECT_MEASUREMENTS) +
+         ");"
+
+         "CREATE TABLE IF NOT EXISTS stats_group_intensities ("
+         " group_id USMALLINT,"
+         " class_id USMALLINT,"
+         " stack_z UINTEGER,"
+         " stack_t UINTEGER,"
+         " stack_c UINTEGER," +
+         columnDefinitions(INTENSITY_MEASUREMENTS) +
+         ");"
+
+         "CREATE TABLE IF NOT EXISTS stats_aggregated_images ("    // Images whose objects are part of the aggregates
+         " image_id UBIGINT"
+         ");";
+}
+
+///
+/// \brief      Statements recalculating the statistics of the given images and
+///             of the groups they are part of
+/// \author     Joachim Danmayr
+/// \param[in]  imageIds  Images to aggregate, must not be empty
+///
+auto StatsAggregates::refreshImages(const std::set<uint64_t> &imageIds) -> std::string
+{
+  std::string ids;
+  for(const auto imageId : imageIds) {
+    ids += std::to_string(imageId) + ",";
+  }
+  ids.pop_back();
+
+  return "DELETE FROM stats_image_objects WHERE image_id IN (" + ids +
+         ");\n"
+         "DELETE FROM stats_image_intensities WHERE image_id IN (" +
+         ids +
+         ");\n"
+         "INSERT INTO stats_image_objects (image_id, class_id, stack_z, stack_t, " +
+         columnNames(OBJECT_MEASUREMENTS) +
+         ")\n"
+         "SELECT\n"
+         " o.image_id, o.class_id, o.stack_z, o.stack_t,\n" +
+         imageStats(OBJECT_MEASUREMENTS, "o.") +
+         "FROM objects o\n"
+         "WHERE o.image_id IN (" +
+         ids +
+         ")\n"
+         "GROUP BY o.image_id, o.class_id, o.stack_z, o.stack_t;\n"
+         "INSERT INTO stats_image_intensities (image_id, class_id, stack_z, stack_t, stack_c, " +
+         columnNames(INTENSITY_MEASUREMENTS) +
+         ")\n"
+         "SELECT\n"
+         " o.image_id, o.class_id, o.stack_z, o.stack_t, om.meas_stack_c,\n" +
+         imageStats(INTENSITY_MEASUREMENTS, "om.") +
+         "FROM objects o\n"
+         "JOIN object_measurements om ON\n"
+         " o.object_id = om.object_id AND o.image_id = om.image_id AND o.stack_z = om.meas_stack_z AND o.stack_t = om.meas_stack_t\n"
+         "WHERE o.image_id IN (" +
+         ids +
+         ")\n"
+         "GROUP BY o.image_id, o.class_id, o.stack_z, o.stack_t, om.meas_stack_c;\n"
+         "INSERT INTO stats_aggregated_images (image_id)\n"
+         "SELECT image_id FROM images WHERE image_id IN (" +
+         ids +
+         ") AND image_id NOT IN (SELECT image_id FROM stats_aggregated_images);\n" +
+         refreshGroups("SELECT group_id FROM images_groups WHERE image_id IN (" + ids + ")");
+}
+
+///
+/// \brief      Statements recalculating the groups an image is part of,
+///             used if the validity of an aggregated image changed.
+/// \author     Joachim Danmayr
+///
+auto StatsAggregates::refreshGroupsOfImage(uint64_t imageId) -> std::string
+{
+  return refreshGroups("SELECT group_id FROM images_groups WHERE image_id = " + std::to_string(imageId));
+}
+
+///
+/// \brief      Statements recalculating all groups, used if the images of a
+///             group have been aggregated in different databases.
+/// \author     Joachim Danmayr
+///
+auto StatsAggregates::refreshAllGroups() -> std::string
+{
+  return refreshGroups("SELECT group_id FROM images_groups");
+}
+
+///
+/// \brief      Statements recalculating the statistics of the groups
+/// \author     Joachim Danmayr
+/// \param[in]  groupIds  Query selecting the group IDs
+///
+auto StatsAggregates::refreshGroups(const std::string &groupIds) -> std::string
+{
+  return "DELETE FROM stats_group_objects WHERE group_id IN (" + groupIds +
+         ");\n"
+         "DELETE FROM stats_group_intensities WHERE group_id IN (" +
+         groupIds +
+         ");\n"
+         "INSERT INTO stats_group_objects (group_id, class_id, stack_z, stack_t, validity, " +
+         columnNames(OBJECT_MEASUREMENTS) +
+         ")\n"
+         "SELECT\n"
+         " images_groups.group_id, s.class_id, s.stack_z, s.stack_t, MAX(images.validity),\n" +
+         groupStats(OBJECT_MEASUREMENTS) +
+         "FROM stats_image_objects s\n"
+         "JOIN images_groups ON s.image_id = images_groups.image_id\n"
+         "JOIN images ON s.image_id = images.image_id\n"
+         "WHERE images_groups.group_id IN (" +
+         groupIds +
+         ")\n"
+         "GROUP BY images_groups.group_id, s.class_id, s.stack_z, s.stack_t;\n"
+         "INSERT INTO stats_group_intensities (group_id, class_id, stack_z, stack_t, stack_c, " +
+         columnNames(INTENSITY_MEASUREMENTS) +
+         ")\n"
+         "SELECT\n"
+         " images_groups.group_id, s.class_id, s.stack_z, s.stack_t, s.stack_c,\n" +
+         groupStats(INTENSITY_MEASUREMENTS) +
+         "FROM stats_image_intensities s\n"
+         "JOIN images_groups ON s.image_id = images_groups.image_id\n"
+         "JOIN images ON s.image_id = images.image_id\n"
+         "WHERE images_groups.group_id IN (" +
+         groupIds +
+         ")\n"
+         "GROUP BY images_groups.group_id, s.class_id, s.stack_z, s.stack_t, s.stack_c;\n";
+}
+
+///
+/// \brief      Name of the aggregate column holding the statistics of a measurement
+/// \author     Joachim Danmayr
+///
+auto StatsAggregates::columnName(enums::Measurement measure, enums::Stats stats) -> std::string
+{
+  return PreparedStatement::getMeasurement(measure, true) + "_" + PreparedStatement::getStatsString(stats);
+}
+
+///
+/// \brief      True if all columns of the statement can be read from the aggregates
+///             with the same result as the raw query
+/// \author     Joachim Danmayr
+/// \param[in]  statement       Columns of one class, z-stack combination
+/// \param[in]  filter          Actual filter
+/// \param[in]  nrOfTimeStacks  Number of t-stacks stored in the database
+///
+bool StatsAggregates::canAnswer(const PreparedStatement &statement, const settings::ResultsSettings::ObjectFilter &filter, uint32_t nrOfTimeStacks)
+{
+  for(const auto &[_, column] : statement.getColumns()) {
+    if(column.stats == enums::Stats::OFF) {
+      return false;    // ANY_VALUE picks a random object
+    }
+    switch(settings::ResultsSettings::getType(column.measureChannel)) {
+      case settings::ResultsSettings::MeasureType::OBJECT:
+        if(column.measureChannel == enums::Measurement::NONE) {
+          return false;
+        }
+        break;
+      case settings::ResultsSettings::MeasureType::INTENSITY:
+        if(column.crossChannelStacksC < 0) {
+          return false;
+        }
+        // The raw query joins the intensities of the filtered t-stack to the objects of all t-stacks
+        if(filter.tStackHandling == settings::ResultsSettings::ObjectFilter::TStackHandling::SLICE && (nrOfTimeStacks > 1 || filter.tStack != 0)) {
+          return false;
+        }
+        break;
+      default:
+        return false;    // Intersections and distances depend on other classes
+    }
+  }
+  return true;
+}
+
+}    // namespace joda::db
@@ -0,0 +1,51 @@
+///
+/// \file      stats_aggregates.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include "backend/enums/enum_measurements.hpp"
+#include "backend/settings/results_settings/results_settings.hpp"
+
+namespace joda::db {
+
+class PreparedStatement;
+
+///
+/// \class      StatsAggregates
+/// \author     Joachim Danmayr
+/// \brief      Materialized statistics used by the plate and well views.
+///             For each image, class, z- and t-stack all statistics of the object
+///             and intensity measurements are calculated once. The group tables
+///             hold the average over the valid images of a group, like the raw
+///             plate query does. Images are aggregated as soon as they are
+///             processed, as long as one image is missing in stats_aggregated_images
+///             the raw queries are used.
+///
+class StatsAggregates
+{
+public:
+  /////////////////////////////////////////////////////
+  static auto createTables() -> std::string;
+  static auto refreshImages(const std::set<uint64_t> &imageIds) -> std::string;
+  static auto refreshGroupsOfImage(uint64_t imageId) -> std::string;
+  static auto refreshAllGroups() -> std::string;
+  static auto columnName(enums::Measurement measure, enums::Stats stats) -> std::string;
+  static bool canAnswer(const PreparedStatement &statement, const settings::ResultsSettings::ObjectFilter &filter, uint32_t nrOfTimeStacks);
+
+private:
+  /////////////////////////////////////////////////////
+  static auto refreshGroups(const std::string &groupIds) -> std::string;
+};
+
+}    // namespace joda::db
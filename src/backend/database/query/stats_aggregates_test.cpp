@@ -0,0 +1,60 @@
+///
+/// \file      stats_aggregates_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/database/query/filter.hpp"
+#include "backend/database/query/stats_aggregates.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Only columns with the same result as the raw query are read from the aggregates
+/// \author Joachim Danmayr
+///
+TEST_CASE("stats_aggregates::can_answer", "[stats_aggregates]")
+{
+  using TStackHandling = settings::ResultsSettings::ObjectFilter::TStackHandling;
+  settings::ResultsSettings::ObjectFilter filter;
+  filter.tStackHandling = TStackHandling::INDIVIDUAL;
+
+  db::PreparedStatement statement({}, nullptr);
+  statement.addColumn({.classId = enums::ClassId::C1, .measureChannel = enums::Measurement::AREA_SIZE, .stats = enums::Stats::MEDIAN});
+  statement.addColumn({.classId = enums::ClassId::C1, .measureChannel = enums::Measurement::COUNT, .stats = enums::Stats::CNT});
+  CHECK(db::StatsAggregates::canAnswer(statement, filter, 3));
+
+  SECTION("Intensities of other t-stacks are not aggregated")
+  {
+    statement.addColumn(
+        {.classId = enums::ClassId::C1, .measureChannel = enums::Measurement::INTENSITY_AVG, .stats = enums::Stats::AVG, .crossChannelStacksC = 1});
+    CHECK(db::StatsAggregates::canAnswer(statement, filter, 3));
+    filter.tStackHandling = TStackHandling::SLICE;
+    CHECK(db::StatsAggregates::canAnswer(statement, filter, 1));
+    CHECK_FALSE(db::StatsAggregates::canAnswer(statement, filter, 3));
+  }
+
+  SECTION("Random values and measurements of other classes")
+  {
+    db::PreparedStatement anyValue({}, nullptr);
+    anyValue.addColumn({.classId = enums::ClassId::C1, .measureChannel = enums::Measurement::AREA_SIZE, .stats = enums::Stats::OFF});
+    CHECK_FALSE(db::StatsAggregates::canAnswer(anyValue, filter, 1));
+
+    statement.addColumn({.classId             = enums::ClassId::C1,
+                         .measureChannel      = enums::Measurement::INTERSECTING,
+                         .stats               = enums::Stats::SUM,
+                         .intersectingChannel = enums::ClassId::C2});
+    CHECK_FALSE(db::StatsAggregates::canAnswer(statement, filter, 1));
+  }
+
+  CHECK(db::StatsAggregates::columnName(enums::Measurement::AREA_SIZE, enums::Stats::MEDIAN) == "meas_area_size_MEDIAN");
+  CHECK(db::StatsAggregates::columnName(enums::Measurement::COUNT, enums::Stats::CNT) == "counted_COUNT");
+}
+
+}    // namespace joda::test
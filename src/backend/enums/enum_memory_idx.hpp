@@ -86,6 +86,15 @@ public:
     return stdi::uint128_t(0, other) == value;
   }
 
+  ///
+  /// \brief      True for the memory slots M0-M15 a pipeline step can store images to.
+  ///             Images loaded from the image file use the reserved range.
+  ///
+  [[nodiscard]] bool isMemorySlot() const
+  {
+    return value < stdi::uint128_t(0, static_cast<uint64_t>(RESERVED_01));
+  }
+
   explicit operator stdi::uint128_t() const
   {
     return value;
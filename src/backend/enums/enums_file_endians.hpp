@@ -23,6 +23,8 @@ static inline std::string EXT_PROJECT_TEMPLATE     = ".ictemplproj";
 static inline std::string EXT_PIPELINE_TEMPLATE    = ".ictempl";
 static inline std::string EXT_CLASS_CLASS_TEMPLATE = ".ictemplcc";
 static inline std::string EXT_ANNOTATION           = ".icroi";
+static inline std::string EXT_PIPELINE_CACHE       = ".iccache";
+static inline std::string EXT_FILE_INDEX           = ".icindex";
 static inline std::string USER_SETTINGS_PATH       = "imagec";
 
 static inline std::string RESULTS_PATH                        = "results";
@@ -30,11 +32,14 @@ static inline std::string WORKING_DIRECTORY_TEMP_PROJECT_PATH = "tmp";
 static inline std::string WORKING_DIRECTORY_PROJECT_PATH      = "imagec";
 static inline std::string WORKING_DIRECTORY_MODELS_PATH       = "models";
 static inline std::string WORKING_DIRECTORY_IMAGE_DATA_PATH   = "data";
+static inline std::string WORKING_DIRECTORY_CACHE_PATH        = "cache";
 
 static inline std::string FILE_NAME_PROJECT_DEFAULT  = "settings";
 static inline std::string FILE_NAME_RESULTS_DATABASE = "results";
 static inline std::string FILE_NAME_ANNOTATIONS      = "annotations";
 static inline std::string FILE_NAME_image_meta       = "meta";
+static inline std::string FILE_NAME_CACHE_IDS        = "ids";
+static inline std::string FILE_NAME_FILE_INDEX       = "files";
 
 static inline std::string MASCHINE_LEARNING_PYTORCH_ANN_MLP = ".icmlmlppt";
 static inline std::string MASCHINE_LEARNING_MLPACK_RTREE    = ".icmlrtreemp";
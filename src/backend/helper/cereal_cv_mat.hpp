@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "backend/enums/enum_images.hpp"
 #include "backend/enums/enums_classes.hpp"
 #include "backend/enums/types.hpp"
 #include <cereal/archives/binary.hpp>
@@ -129,6 +130,18 @@ void load(Archive &ar, joda::enums::PlaneId &in)
   ar(in.tStack, in.zStack, in.cStack);
 }
 
+template <class Archive>
+void save(Archive &ar, joda::enums::ImageId const &in)
+{
+  ar(in.zProjection, in.imagePlane, in.memoryId);
+}
+
+template <class Archive>
+void load(Archive &ar, joda::enums::ImageId &in)
+{
+  ar(in.zProjection, in.imagePlane, in.memoryId);
+}
+
 }    // namespace joda::enums
 
 namespace joda::atom {
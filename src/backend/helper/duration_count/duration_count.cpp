@@ -24,7 +24,8 @@ std::string getCurrentDateTime()
   ss << std::put_time(std::localtime(&now_time), "%Y-%m-%d_%H-%M-%S");
   return ss.str();
 }
-void DurationCount::printStats(double nrOfImages, const std::filesystem::path &outputDir)
+void DurationCount::printStats(double nrOfImages, const std::filesystem::path &outputDir,
+                               const std::map<std::string, joda::trace::Tracer::Stats> &traceStats)
 {
   std::lock_guard<std::mutex> lock(mLock);
   auto timeEnd = std::chrono::steady_clock::now();
@@ -39,6 +40,13 @@ void DurationCount::printStats(double nrOfImages, const std::filesystem::path &o
     statsJson["stats"][comment]["totalMs"] = totalMs;
     statsJson["stats"][comment]["avgMs"]   = static_cast<float>(totalMs) / static_cast<float>(stats.cnt);
   }
+  // Hot paths are recorded with the tracer
+  for(const auto &[span, stats] : traceStats) {
+    double totalMs                      = static_cast<double>(stats.totalNs) / 1e6;
+    statsJson["stats"][span]["cnt"]     = stats.cnt;
+    statsJson["stats"][span]["totalMs"] = totalMs;
+    statsJson["stats"][span]["avgMs"]   = static_cast<float>(totalMs) / static_cast<float>(stats.cnt);
+  }
 
   double totalMs = std::chrono::duration<double, std::milli>(durations).count();
 
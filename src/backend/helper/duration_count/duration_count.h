@@ -21,6 +21,7 @@
 #include <mutex>
 #include <string>
 #include "backend/helper/logger/console_logger.hpp"
+#include "backend/helper/trace/trace.hpp"
 
 class DurationCount
 {
@@ -74,7 +75,8 @@ public:
     }
   }
 
-  static void printStats(double nrOfImages, const std::filesystem::path &outputDir);
+  static void printStats(double nrOfImages, const std::filesystem::path &outputDir,
+                         const std::map<std::string, joda::trace::Tracer::Stats> &traceStats = {});
   static void resetStats();
 
 private:
@@ -0,0 +1,123 @@
+///
+/// \file      frequency_domain.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "frequency_domain.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace joda::fft {
+
+///
+/// \brief      Smallest size >= minSize which can be transformed fast (product of 2, 3 and 5)
+/// \author     Joachim Danmayr
+///
+auto FrequencyDomain::getOptimalSize(const cv::Size &minSize) -> cv::Size
+{
+  return {cv::getOptimalDFTSize(minSize.width), cv::getOptimalDFTSize(minSize.height)};
+}
+
+///
+/// \brief      Forward transform of a real image
+/// \author     Joachim Danmayr
+/// \param[in]  image  Single channel image, converted to float if necessary
+/// \return     Complex spectrum (CV_32FC2) of the same size
+///
+auto FrequencyDomain::forward(const cv::Mat &image) -> cv::Mat
+{
+  cv::Mat spectrum;
+  if(image.type() == CV_32FC1) {
+    cv::dft(image, spectrum, cv::DFT_COMPLEX_OUTPUT);
+  } else {
+    cv::Mat floatImage;
+    image.convertTo(floatImage, CV_32F);
+    cv::dft(floatImage, spectrum, cv::DFT_COMPLEX_OUTPUT);
+  }
+  return spectrum;
+}
+
+///
+/// \brief      Inverse transform of a spectrum of a real image
+/// \author     Joachim Danmayr
+/// \param[in]  spectrum  Complex spectrum (CV_32FC2)
+/// \return     Real image (CV_32FC1), already scaled by 1/N
+///
+auto FrequencyDomain::inverse(const cv::Mat &spectrum) -> cv::Mat
+{
+  cv::Mat image;
+  cv::dft(spectrum, image, cv::DFT_INVERSE | cv::DFT_REAL_OUTPUT | cv::DFT_SCALE);
+  return image;
+}
+
+///
+/// \brief      Multiplies a spectrum element wise with a mask from getMask
+/// \author     Joachim Danmayr
+///
+void FrequencyDomain::multiply(cv::Mat &spectrum, const cv::Mat &mask)
+{
+  if(spectrum.size() != mask.size() || spectrum.type() != mask.type()) {
+    throw std::invalid_argument("Spectrum and filter mask do not match.");
+  }
+  cv::multiply(spectrum, mask, spectrum);
+}
+
+///
+/// \brief      Returns the cached mask for the key or builds it.
+///             The generator gets a CV_32FC1 matrix of the given size and
+///             fills in the real filter factors for each frequency
+///             (DC at (0,0), not shifted). The mask is stored with the same
+///             factor for the real and the imaginary part, ready for multiply.
+/// \author     Joachim Danmayr
+/// \param[in]  key        Unique name of the filter including all parameters
+/// \param[in]  size       Size of the spectrum
+/// \param[in]  generator  Builds the mask if it is not cached
+///
+auto FrequencyDomain::getMask(const std::string &key, const cv::Size &size, const MaskGenerator &generator) -> std::shared_ptr<const cv::Mat>
+{
+  const auto fullKey = key + "@" + std::to_string(size.width) + "x" + std::to_string(size.height);
+  {
+    std::lock_guard<std::mutex> lock(mMaskLock);
+    auto it = mMasks.find(fullKey);
+    if(it != mMasks.end()) {
+      return it->second;
+    }
+  }
+
+  // Built without holding the lock, two threads may build the same mask once at the start
+  cv::Mat factors(size, CV_32FC1, cv::Scalar(1.0F));
+  generator(factors);
+  cv::Mat planes[] = {factors, factors};
+  auto mask        = std::make_shared<cv::Mat>();
+  cv::merge(planes, 2, *mask);
+
+  std::lock_guard<std::mutex> lock(mMaskLock);
+  auto [it, inserted] = mMasks.emplace(fullKey, mask);
+  if(inserted) {
+    mMaskOrder.push_back(fullKey);
+    while(mMaskOrder.size() > MAX_CACHED_MASKS) {
+      mMasks.erase(mMaskOrder.front());
+      mMaskOrder.pop_front();
+    }
+  }
+  return it->second;
+}
+
+///
+/// \brief      Releases all cached masks
+/// \author     Joachim Danmayr
+///
+void FrequencyDomain::clearMaskCache()
+{
+  std::lock_guard<std::mutex> lock(mMaskLock);
+  mMasks.clear();
+  mMaskOrder.clear();
+}
+
+}    // namespace joda::fft
@@ -0,0 +1,66 @@
+///
+/// \file      frequency_domain.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Fourier transform helpers shared by the frequency domain commands
+///
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <opencv2/core.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::fft {
+
+///
+/// \class      FrequencyDomain
+/// \author     Joachim Danmayr
+/// \brief      Real to complex FFT based on cv::dft and a process wide cache
+///             for filter masks. A mask depends only on the padded size and
+///             the filter parameters, so all tiles and threads with the same
+///             settings share one mask instead of building their own.
+///
+///             Usage:
+///               auto size     = FrequencyDomain::getOptimalSize(minSize);
+///               auto spectrum = FrequencyDomain::forward(padded);
+///               auto mask     = FrequencyDomain::getMask(key, size, generator);
+///               FrequencyDomain::multiply(spectrum, *mask);
+///               auto result   = FrequencyDomain::inverse(spectrum);
+///
+class FrequencyDomain
+{
+public:
+  /////////////////////////////////////////////////////
+  using MaskGenerator = std::function<void(cv::Mat &mask)>;
+
+  static auto getOptimalSize(const cv::Size &minSize) -> cv::Size;
+  static auto forward(const cv::Mat &image) -> cv::Mat;
+  static auto inverse(const cv::Mat &spectrum) -> cv::Mat;
+  static void multiply(cv::Mat &spectrum, const cv::Mat &mask);
+  static auto getMask(const std::string &key, const cv::Size &size, const MaskGenerator &generator) -> std::shared_ptr<const cv::Mat>;
+  static void clearMaskCache();
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr size_t MAX_CACHED_MASKS = 16;
+
+  /////////////////////////////////////////////////////
+  static inline std::mutex mMaskLock;
+  static inline std::map<std::string, std::shared_ptr<const cv::Mat>> mMasks;
+  static inline std::deque<std::string> mMaskOrder;    // Oldest first
+};
+
+}    // namespace joda::fft
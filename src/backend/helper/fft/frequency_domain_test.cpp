@@ -0,0 +1,67 @@
+///
+/// \file      frequency_domain_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/helper/fft/frequency_domain.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Transform round trip and mask cache
+/// \author Joachim Danmayr
+///
+TEST_CASE("fft::frequency_domain", "[fft]")
+{
+  SECTION("Optimal size is never smaller than requested")
+  {
+    auto size = joda::fft::FrequencyDomain::getOptimalSize({1537, 769});
+    CHECK(size.width >= 1537);
+    CHECK(size.height >= 769);
+  }
+
+  SECTION("Forward and inverse transform give the original image")
+  {
+    cv::Mat image(90, 120, CV_16UC1);
+    cv::randu(image, cv::Scalar(0), cv::Scalar(65535));
+    auto spectrum = joda::fft::FrequencyDomain::forward(image);
+    CHECK(spectrum.type() == CV_32FC2);
+    auto result = joda::fft::FrequencyDomain::inverse(spectrum);
+    cv::Mat original;
+    image.convertTo(original, CV_32F);
+    CHECK(cv::norm(result, original, cv::NORM_INF) < 0.5);
+  }
+
+  SECTION("Masks are built once per key and size")
+  {
+    joda::fft::FrequencyDomain::clearMaskCache();
+    int calls      = 0;
+    auto generator = [&calls](cv::Mat &mask) {
+      calls++;
+      mask.setTo(0.5F);
+    };
+    auto mask1 = joda::fft::FrequencyDomain::getMask("test", {64, 32}, generator);
+    auto mask2 = joda::fft::FrequencyDomain::getMask("test", {64, 32}, generator);
+    auto mask3 = joda::fft::FrequencyDomain::getMask("test", {32, 32}, generator);
+    CHECK(calls == 2);
+    CHECK(mask1.get() == mask2.get());
+    CHECK(mask1.get() != mask3.get());
+    CHECK(mask1->type() == CV_32FC2);
+
+    cv::Mat spectrum = joda::fft::FrequencyDomain::forward(cv::Mat(32, 64, CV_32FC1, cv::Scalar(2.0F)));
+    joda::fft::FrequencyDomain::multiply(spectrum, *mask1);
+    auto result = joda::fft::FrequencyDomain::inverse(spectrum);
+    CHECK(cv::norm(result, cv::Mat(32, 64, CV_32FC1, cv::Scalar(1.0F)), cv::NORM_INF) < 1e-4);
+    joda::fft::FrequencyDomain::clearMaskCache();
+  }
+}
+
+}    // namespace joda::test
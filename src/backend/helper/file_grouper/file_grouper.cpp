@@ -19,7 +19,9 @@
 
 namespace joda::grp {
 
-FileGrouper::FileGrouper(joda::enums::GroupBy groupBy, const std::string &fileRegex) : mGroupBy(groupBy), mFileRegex(fileRegex)
+FileGrouper::FileGrouper(joda::enums::GroupBy groupBy, const std::string &fileRegex) :
+    mGroupBy(groupBy), mFileRegex(fileRegex),
+    mFilePattern(groupBy == enums::GroupBy::FILENAME ? std::optional<std::regex>(std::regex(fileRegex)) : std::nullopt)
 {
 }
 
@@ -40,14 +42,19 @@ GroupInformation FileGrouper::getGroupForFilename(const std::filesystem::path &f
       groupInfo.imageIdx  = UINT32_MAX;
     } break;
     case enums::GroupBy::FILENAME: {
-      groupInfo = applyRegex(mFileRegex, filePath);
+      groupInfo = applyRegex(*mFilePattern, filePath);
     } break;
     case enums::GroupBy::UNKNOWN:
       break;
   }
   {
     std::lock_guard<std::mutex> lock(mWellGeneratorLock);
-    return mWellPosGenerator.getGroupId(groupInfo);
+    if(const auto it = mGroupOfFile.find(filePath); it != mGroupOfFile.end()) {
+      return it->second;
+    }
+    auto assignedGroup = mWellPosGenerator.getGroupId(groupInfo);
+    mGroupOfFile.emplace(filePath, assignedGroup);
+    return assignedGroup;
   }
   return {};
 }
@@ -58,7 +65,15 @@ GroupInformation FileGrouper::getGroupForFilename(const std::filesystem::path &f
 ///
 GroupInformation FileGrouper::applyRegex(const std::string &regex, const std::filesystem::path &imagePath)
 {
-  std::regex pattern(regex);
+  return applyRegex(std::regex(regex), imagePath);
+}
+
+///
+/// \brief      Apply a precompiled regex
+/// \author     Joachim Danmayr
+///
+GroupInformation FileGrouper::applyRegex(const std::regex &pattern, const std::filesystem::path &imagePath)
+{
   std::smatch match;
   GroupInformation result;
 
@@ -17,6 +17,8 @@
 #include <filesystem>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <regex>
 #include <string>
 #include "backend/enums/enums_grouping.hpp"
 #include "file_grouper_types.hpp"
@@ -36,14 +38,17 @@ public:
   FileGrouper(joda::enums::GroupBy groupBy, const std::string &fileRegex);
   GroupInformation getGroupForFilename(const std::filesystem::path &filePath);
   static GroupInformation applyRegex(const std::string &regex, const std::filesystem::path &imagePath);
+  static GroupInformation applyRegex(const std::regex &pattern, const std::filesystem::path &imagePath);
 
 private:
   //// SETTINGS /////////////////////////////////////////////////
   const joda::enums::GroupBy mGroupBy;
   const std::string mFileRegex;
+  const std::optional<std::regex> mFilePattern;    // Compiled once, grouping by file name is called for each image
 
   /////////////////////////////////////////////////////
   WellPosGenerator mWellPosGenerator;
+  std::map<std::filesystem::path, GroupInformation> mGroupOfFile;    // A file keeps its group and image index if it is grouped again
   mutable std::mutex mWellGeneratorLock;
 };
 
@@ -0,0 +1,42 @@
+///
+/// \file      file_grouper_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/enums/enums_grouping.hpp"
+#include "backend/helper/file_grouper/file_grouper.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  A file grouped a second time keeps its group and image index,
+///         shards rely on this to get the same IDs as the other shards.
+/// \author Joachim Danmayr
+///
+TEST_CASE("file_grouper::stable_assignment", "[file_grouper]")
+{
+  joda::grp::FileGrouper grouper(enums::GroupBy::DIRECTORY, "");
+  const auto first  = grouper.getGroupForFilename("/plate/well_b/img_1.tif");
+  const auto second = grouper.getGroupForFilename("/plate/well_a/img_1.tif");
+  const auto third  = grouper.getGroupForFilename("/plate/well_b/img_2.tif");
+
+  CHECK(first.groupId == 0);
+  CHECK(second.groupId == 1);
+  CHECK(third.groupId == 0);
+  CHECK(third.imageIdx != first.imageIdx);
+
+  const auto again = grouper.getGroupForFilename("/plate/well_b/img_1.tif");
+  CHECK(again.groupId == first.groupId);
+  CHECK(again.imageIdx == first.imageIdx);
+  CHECK(again.wellPosX == first.wellPosX);
+  CHECK(again.wellPosY == first.wellPosY);
+}
+
+}    // namespace joda::test
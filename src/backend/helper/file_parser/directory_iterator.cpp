@@ -14,8 +14,9 @@
 #include "directory_iterator.hpp"
 #include <exception>
 #include <filesystem>
-#include <iostream>
 #include <string>
+#include "backend/enums/enums_file_endians.hpp"
+#include "backend/helper/file_parser/file_index.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 
 namespace joda::filesystem {
@@ -53,20 +54,23 @@ void DirectoryWatcher::lookForImages()
 }
 
 ///
-/// \brief      Add file
+/// \brief      Uses the given files instead of looking for images in the working
+///             directory, e.g. if only a single image is analyzed.
+///             Directories and not supported files are skipped.
 /// \author     Joachim Danmayr
+/// \param[in]  files  Files to analyze
 ///
-void DirectoryWatcher::addFile(const std::filesystem::path &file)
+void DirectoryWatcher::setFilesList(const std::vector<std::filesystem::path> &files)
 {
-  try {
-    if(!is_directory(file)) {
-      auto supported = parseFile(file);
-      if(supported) {
-        mListOfImagePaths.push_back(file);
-      }
+  stop();
+  mListOfImagePaths.clear();
+  for(const auto &file : files) {
+    std::error_code ec;
+    if(std::filesystem::is_directory(file, ec) || !parseFile(file)) {
+      joda::log::logWarning("File iterator: >" + file.string() + "< is not a supported image.");
+      continue;
     }
-  } catch(const std::exception &ex) {
-    std::cout << ex.what() << std::endl;
+    mListOfImagePaths.push_back(file);
   }
 }
 
@@ -83,14 +87,24 @@ void DirectoryWatcher::lookForImagesInFolderAndSubfolder()
   }
 
   mListOfImagePaths.clear();
+  mKnownImagePaths.clear();
+  mPendingImagePaths.clear();
   if(!mWorkingDirectory.empty() && std::filesystem::exists(mWorkingDirectory)) {
     try {
-      for(recursive_directory_iterator i(mWorkingDirectory), end; i != end; ++i) {
-        addFile(i->path());
-        if(mIsStopped) {
-          break;
-        }
+      // The index is only stored in project folders, plain image folders are not touched
+      std::error_code ec;
+      const auto projectFolder = mWorkingDirectory / joda::fs::WORKING_DIRECTORY_PROJECT_PATH;
+      std::filesystem::path indexFile;
+      if(std::filesystem::is_directory(projectFolder, ec)) {
+        indexFile = projectFolder / joda::fs::WORKING_DIRECTORY_CACHE_PATH / (joda::fs::FILE_NAME_FILE_INDEX + joda::fs::EXT_FILE_INDEX);
+      }
+      FileIndex index(indexFile, mSupportedFormats);
+      mListOfImagePaths = index.scan(mWorkingDirectory, [this](const std::filesystem::path &path) { return parseFile(path); }, mIsStopped);
+      if(!mIsStopped) {
+        index.store();
       }
+      joda::log::logDebug("File iterator: " + std::to_string(mListOfImagePaths.size()) + " images found, " +
+                          std::to_string(index.getNrOfListedDirectories()) + " directories listed.");
     } catch(const std::exception &ex) {
       joda::log::logError("File iterator: " + std::string(ex.what()));
     }
@@ -103,4 +117,70 @@ void DirectoryWatcher::lookForImagesInFolderAndSubfolder()
   (void) mWorkerThread.release();
 }
 
+///
+/// \brief      Scans the working directory for images which were not found before.
+///             An image is returned as soon as its size and modification time did
+///             not change for the settle time. Files still written by the microscope
+///             are therefore returned by a later call. The imagec folder is skipped,
+///             it contains the images written by the running job.
+///             Must not be called while lookForImages is running.
+/// \author     Joachim Danmayr
+/// \param[in]  settleTime  Time a file must not change before it is returned
+/// \return     New images, they are added to the list of found files
+///
+auto DirectoryWatcher::lookForNewImages(std::chrono::milliseconds settleTime) -> std::vector<std::filesystem::path>
+{
+  if(mKnownImagePaths.size() < mListOfImagePaths.size()) {
+    mKnownImagePaths.insert(mListOfImagePaths.begin(), mListOfImagePaths.end());
+  }
+
+  std::vector<std::filesystem::path> newImages;
+  if(mWorkingDirectory.empty() || !std::filesystem::exists(mWorkingDirectory)) {
+    return newImages;
+  }
+
+  const auto now           = std::chrono::steady_clock::now();
+  const auto projectFolder = mWorkingDirectory / joda::fs::WORKING_DIRECTORY_PROJECT_PATH;
+  std::set<std::filesystem::path> stillPending;
+  try {
+    for(recursive_directory_iterator i(mWorkingDirectory, directory_options::skip_permission_denied), end; i != end; ++i) {
+      const auto &path = i->path();
+      std::error_code ec;
+      if(i->is_directory(ec)) {
+        if(path == projectFolder) {
+          i.disable_recursion_pending();
+        }
+        continue;
+      }
+      if(!parseFile(path) || mKnownImagePaths.contains(path)) {
+        continue;
+      }
+      const auto size          = std::filesystem::file_size(path, ec);
+      const auto lastWriteTime = std::filesystem::last_write_time(path, ec);
+      if(ec) {
+        continue;
+      }
+      stillPending.emplace(path);
+      auto pending = mPendingImagePaths.find(path);
+      if(pending == mPendingImagePaths.end() || pending->second.size != size || pending->second.lastWriteTime != lastWriteTime) {
+        mPendingImagePaths[path] = {.size = size, .lastWriteTime = lastWriteTime, .unchangedSince = now};
+      } else if(now - pending->second.unchangedSince >= settleTime) {
+        newImages.push_back(path);
+      }
+    }
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("File iterator: " + std::string(ex.what()));
+  }
+
+  // Files deleted before they settled are forgotten
+  std::erase_if(mPendingImagePaths, [&stillPending](const auto &entry) { return !stillPending.contains(entry.first); });
+  std::sort(newImages.begin(), newImages.end());
+  for(const auto &image : newImages) {
+    mPendingImagePaths.erase(image);
+    mKnownImagePaths.emplace(image);
+    mListOfImagePaths.push_back(image);
+  }
+  return newImages;
+}
+
 }    // namespace joda::filesystem
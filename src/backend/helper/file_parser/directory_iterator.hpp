@@ -14,6 +14,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <functional>
@@ -50,7 +53,8 @@ public:
 
   void setWorkingDirectory(const std::filesystem::path &inputFolder);
   void lookForImages();
-  void addFile(const std::filesystem::path &file);
+  auto lookForNewImages(std::chrono::milliseconds settleTime) -> std::vector<std::filesystem::path>;
+  void setFilesList(const std::vector<std::filesystem::path> &files);
   inline std::string getWorkingDirectory()
   {
     return mWorkingDirectory.generic_string();
@@ -60,6 +64,8 @@ public:
   {
     mWorkingDirectory.clear();
     mListOfImagePaths.clear();
+    mKnownImagePaths.clear();
+    mPendingImagePaths.clear();
   }
 
   ///
@@ -151,6 +157,14 @@ public:
   }
 
 private:
+  /////////////////////////////////////////////////////
+  struct PendingFile
+  {
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type lastWriteTime;
+    std::chrono::steady_clock::time_point unchangedSince;
+  };
+
   /////////////////////////////////////////////////////
   void lookForImagesInFolderAndSubfolder();
   bool parseFile(const std::filesystem::path &path)
@@ -164,8 +178,10 @@ private:
   std::set<std::string> mSupportedFormats;
   std::filesystem::path mWorkingDirectory;
   std::vector<std::filesystem::path> mListOfImagePaths;
-  bool mIsStopped = false;
-  bool mIsRunning = false;
+  std::set<std::filesystem::path> mKnownImagePaths;                   // Files already returned, used by lookForNewImages
+  std::map<std::filesystem::path, PendingFile> mPendingImagePaths;    // New files which may still be written
+  std::atomic<bool> mIsStopped = false;
+  bool mIsRunning               = false;
   std::unique_ptr<std::thread> mWorkerThread;
 };
 
@@ -0,0 +1,60 @@
+///
+/// \file      directory_iterator_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "backend/enums/enums_file_endians.hpp"
+#include "backend/helper/file_parser/directory_iterator.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  New images are returned once they stopped changing
+/// \author Joachim Danmayr
+///
+TEST_CASE("directory_iterator::new_images", "[directory_iterator]")
+{
+  const auto folder = std::filesystem::temp_directory_path() / "imagec_directory_iterator_test";
+  std::filesystem::remove_all(folder);
+  std::filesystem::create_directories(folder / joda::fs::WORKING_DIRECTORY_PROJECT_PATH);
+  std::ofstream(folder / "a.tif") << "a";
+
+  joda::filesystem::DirectoryWatcher watcher;
+  watcher.setWorkingDirectory(folder);
+  watcher.lookForImages();
+  watcher.waitForFinished();
+  REQUIRE(watcher.getNrOfFiles() == 1);
+
+  std::ofstream(folder / "b.tif") << "b";
+  std::ofstream(folder / "c.txt") << "c";
+  std::ofstream(folder / joda::fs::WORKING_DIRECTORY_PROJECT_PATH / "d.tif") << "d";
+
+  // The first scan only remembers the file, it could still be written
+  CHECK(watcher.lookForNewImages(std::chrono::milliseconds(0)).empty());
+  const auto newImages = watcher.lookForNewImages(std::chrono::milliseconds(0));
+  REQUIRE(newImages.size() == 1);
+  CHECK(newImages.front() == folder / "b.tif");
+  CHECK(watcher.getNrOfFiles() == 2);
+  CHECK(watcher.lookForNewImages(std::chrono::milliseconds(0)).empty());
+
+  // A file which is still growing is not returned
+  std::ofstream(folder / "e.tif") << "e";
+  CHECK(watcher.lookForNewImages(std::chrono::milliseconds(0)).empty());
+  std::ofstream(folder / "e.tif", std::ios::app) << "more data";
+  CHECK(watcher.lookForNewImages(std::chrono::milliseconds(0)).empty());
+  CHECK(watcher.lookForNewImages(std::chrono::milliseconds(0)).size() == 1);
+
+  std::filesystem::remove_all(folder);
+}
+
+}    // namespace joda::test
@@ -0,0 +1,220 @@
+///
+/// \file      file_index.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "file_index.hpp"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <utility>
+#include "backend/helper/logger/console_logger.hpp"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/map.hpp>
+#include <cereal/types/set.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+namespace joda::filesystem {
+
+///
+/// \brief      Pool the directories are listed in, nullptr lists them on the calling thread
+/// \author     Joachim Danmayr
+///
+void FileIndex::setThreadPool(BS::priority_thread_pool *pool)
+{
+  mThreadPool.store(pool);
+}
+
+///
+/// \brief      Opens the index, a missing or outdated index file starts an empty index
+/// \author     Joachim Danmayr
+/// \param[in]  indexFile         File the index is stored in
+/// \param[in]  supportedFormats  File extensions stored in the index
+///
+FileIndex::FileIndex(std::filesystem::path indexFile, std::set<std::string> supportedFormats) :
+    mIndexFile(std::move(indexFile)), mSupportedFormats(std::move(supportedFormats))
+{
+  load();
+}
+
+///
+/// \brief      Scans the root folder and its subfolders. Waits for the tasks of this
+///             scan only, therefore it must not be called by a worker of the pool.
+/// \author     Joachim Danmayr
+/// \param[in]  root         Folder to scan
+/// \param[in]  isSupported  Returns true if a file should be part of the index
+/// \param[in]  stop         The scan is canceled as soon as this is set
+/// \return     Sorted list of the found files
+///
+auto FileIndex::scan(const std::filesystem::path &root, const Filter_t &isSupported, const std::atomic<bool> &stop)
+    -> std::vector<std::filesystem::path>
+{
+  mScanned.clear();
+  mNrOfListedDirectories = 0;
+  {
+    joda::thread::TaskGroup tasks;
+    scanDirectory(mThreadPool.load(), tasks, root, isSupported, stop);
+    tasks.wait();
+  }
+
+  std::vector<std::filesystem::path> files;
+  for(const auto &[directory, entry] : mScanned) {
+    for(const auto &file : entry.files) {
+      files.emplace_back(std::filesystem::path(directory) / file.name);
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  // Deleted directories are dropped, a canceled scan keeps the old index
+  if(!stop) {
+    mDirectories = std::move(mScanned);
+  }
+  mScanned.clear();
+  return files;
+}
+
+///
+/// \brief      Visits one directory and submits its subdirectories to the pool.
+///             Listing directories is metadata work, it is started before the work
+///             units of a job but after the previews.
+/// \author     Joachim Danmayr
+///
+void FileIndex::scanDirectory(BS::priority_thread_pool *pool, joda::thread::TaskGroup &tasks, const std::filesystem::path &directory,
+                              const Filter_t &isSupported, const std::atomic<bool> &stop)
+{
+  if(stop) {
+    return;
+  }
+  try {
+    std::error_code ec;
+    const auto lastWriteTime = static_cast<int64_t>(std::filesystem::last_write_time(directory, ec).time_since_epoch().count());
+    if(ec) {
+      return;
+    }
+    const auto key = directory.generic_string();
+
+    Directory entry;
+    auto indexed = mDirectories.find(key);    // Not modified while scanning
+    if(indexed != mDirectories.end() && indexed->second.lastWriteTime == lastWriteTime) {
+      entry = indexed->second;
+    } else {
+      entry = listDirectory(directory, lastWriteTime, isSupported);
+      mNrOfListedDirectories++;
+    }
+
+    const auto subDirectories = entry.subDirectories;
+    {
+      std::lock_guard<std::mutex> lock(mScannedLock);
+      mScanned.emplace(key, std::move(entry));
+    }
+    for(const auto &subDirectory : subDirectories) {
+      if(pool == nullptr) {
+        scanDirectory(pool, tasks, directory / subDirectory, isSupported, stop);
+        continue;
+      }
+      tasks.detach(*pool, joda::thread::TaskPriority::METADATA, [this, pool, &tasks, subPath = directory / subDirectory, &isSupported, &stop]() {
+        scanDirectory(pool, tasks, subPath, isSupported, stop);
+      });
+    }
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("File iterator: " + std::string(ex.what()));
+  }
+}
+
+///
+/// \brief      Lists the subdirectories and supported files of a directory.
+///             Directory symlinks are not followed, like the recursive iterator.
+/// \author     Joachim Danmayr
+///
+auto FileIndex::listDirectory(const std::filesystem::path &directory, int64_t lastWriteTime, const Filter_t &isSupported) -> Directory
+{
+  Directory entry{.lastWriteTime = lastWriteTime, .subDirectories = {}, .files = {}};
+  std::error_code ec;
+  for(std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec), end; !ec && it != end;
+      it.increment(ec)) {
+    std::error_code entryEc;
+    if(it->is_directory(entryEc) && !it->is_symlink(entryEc)) {
+      entry.subDirectories.emplace_back(it->path().filename().string());
+      continue;
+    }
+    if(entryEc || !isSupported(it->path())) {
+      continue;
+    }
+    const auto size          = it->file_size(entryEc);
+    const auto fileWriteTime = it->last_write_time(entryEc);
+    entry.files.push_back({.name          = it->path().filename().string(),
+                           .size          = entryEc ? 0 : static_cast<uint64_t>(size),
+                           .lastWriteTime = entryEc ? 0 : static_cast<int64_t>(fileWriteTime.time_since_epoch().count())});
+  }
+  if(ec) {
+    joda::log::logWarning("File iterator: Could not list >" + directory.string() + "<. What: " + ec.message());
+  }
+  return entry;
+}
+
+///
+/// \brief      Reads the index file
+/// \author     Joachim Danmayr
+///
+void FileIndex::load()
+{
+  std::error_code ec;
+  if(mIndexFile.empty() || !std::filesystem::exists(mIndexFile, ec)) {
+    return;
+  }
+  try {
+    std::ifstream is(mIndexFile.string(), std::ios::binary);
+    cereal::BinaryInputArchive archive(is);
+    uint32_t version = 0;
+    std::set<std::string> supportedFormats;
+    archive(version);
+    if(version != INDEX_FORMAT_VERSION) {
+      return;
+    }
+    archive(supportedFormats);
+    if(supportedFormats != mSupportedFormats) {
+      return;
+    }
+    archive(mDirectories);
+  } catch(const std::exception &ex) {
+    mDirectories.clear();
+    joda::log::logWarning("Could not read file index >" + mIndexFile.string() + "<. what: " + std::string(ex.what()));
+  }
+}
+
+///
+/// \brief      Writes the index. The file is written under a temporary name first,
+///             an interrupted write never leaves a partial index behind.
+/// \author     Joachim Danmayr
+///
+void FileIndex::store() const
+{
+  if(mIndexFile.empty()) {
+    return;
+  }
+  auto tmpIndexFile = mIndexFile;
+  tmpIndexFile += ".tmp";
+  try {
+    std::filesystem::create_directories(mIndexFile.parent_path());
+    {
+      std::ofstream os(tmpIndexFile.string(), std::ios::binary);
+      cereal::BinaryOutputArchive archive(os);
+      archive(INDEX_FORMAT_VERSION, mSupportedFormats, mDirectories);
+    }
+    std::filesystem::rename(tmpIndexFile, mIndexFile);
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("Could not write file index >" + mIndexFile.string() + "<. what: " + std::string(ex.what()));
+    std::error_code ec;
+    std::filesystem::remove(tmpIndexFile, ec);
+  }
+}
+
+}    // namespace joda::filesystem
@@ -0,0 +1,104 @@
+///
+/// \file      file_index.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "backend/helper/threading/task_scheduler.hpp"
+#include <BS_thread_pool.hpp>
+
+namespace joda::filesystem {
+
+///
+/// \class      FileIndex
+/// \author     Joachim Danmayr
+/// \brief      Parallel directory scanner with a persisted index. Each directory
+///             is listed in its own metadata task of the global thread pool,
+///             subdirectories are fanned out as soon as they are found. Without
+///             a pool the directories are listed by the calling thread. For every
+///             directory the modification time, its subdirectories and the
+///             supported files (name, size, modification time) are remembered. A
+///             directory whose modification time did not change since the last
+///             scan is not listed again, only its subdirectories are visited.
+///
+class FileIndex
+{
+public:
+  /////////////////////////////////////////////////////
+  using Filter_t = std::function<bool(const std::filesystem::path &)>;
+
+  static void setThreadPool(BS::priority_thread_pool *pool);
+
+  FileIndex(std::filesystem::path indexFile, std::set<std::string> supportedFormats);
+  auto scan(const std::filesystem::path &root, const Filter_t &isSupported, const std::atomic<bool> &stop) -> std::vector<std::filesystem::path>;
+  void store() const;
+
+  [[nodiscard]] auto getNrOfListedDirectories() const -> size_t
+  {
+    return mNrOfListedDirectories;
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr uint32_t INDEX_FORMAT_VERSION = 1;
+
+  struct File
+  {
+    std::string name;
+    uint64_t size         = 0;
+    int64_t lastWriteTime = 0;
+
+    template <class Archive>
+    void serialize(Archive &archive)
+    {
+      archive(name, size, lastWriteTime);
+    }
+  };
+
+  struct Directory
+  {
+    int64_t lastWriteTime = 0;
+    std::vector<std::string> subDirectories;
+    std::vector<File> files;
+
+    template <class Archive>
+    void serialize(Archive &archive)
+    {
+      archive(lastWriteTime, subDirectories, files);
+    }
+  };
+
+  /////////////////////////////////////////////////////
+  void load();
+  void scanDirectory(BS::priority_thread_pool *pool, joda::thread::TaskGroup &tasks, const std::filesystem::path &directory,
+                     const Filter_t &isSupported, const std::atomic<bool> &stop);
+  static auto listDirectory(const std::filesystem::path &directory, int64_t lastWriteTime, const Filter_t &isSupported) -> Directory;
+
+  /////////////////////////////////////////////////////
+  static inline std::atomic<BS::priority_thread_pool *> mThreadPool = nullptr;
+
+  std::filesystem::path mIndexFile;
+  std::set<std::string> mSupportedFormats;           // The index is only valid for the formats it was created with
+  std::map<std::string, Directory> mDirectories;     // Key is the generic path of the directory
+  std::map<std::string, Directory> mScanned;         // Directories found by the running scan
+  std::mutex mScannedLock;
+  std::atomic<size_t> mNrOfListedDirectories = 0;    // Directories listed by the last scan, the others were taken from the index
+};
+
+}    // namespace joda::filesystem
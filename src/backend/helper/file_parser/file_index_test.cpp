@@ -0,0 +1,114 @@
+///
+/// \file      file_index_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include "backend/helper/file_parser/file_index.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <BS_thread_pool.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Only directories modified since the last scan are listed again
+/// \author Joachim Danmayr
+///
+TEST_CASE("file_index::rescan_changed_directories", "[file_index]")
+{
+  const auto folder    = std::filesystem::temp_directory_path() / "imagec_file_index_test";
+  const auto images    = folder / "images";
+  const auto indexFile = folder / "files.icindex";
+  std::filesystem::remove_all(folder);
+  for(const auto *well : {"well_a", "well_b", "well_c"}) {
+    std::filesystem::create_directories(images / well / "sub");
+    std::ofstream(images / well / "img_1.tif") << "a";
+    std::ofstream(images / well / "sub" / "img_2.tif") << "b";
+    std::ofstream(images / well / "notes.txt") << "c";
+  }
+
+  const std::set<std::string> formats{".tif"};
+  const auto isSupported = [&formats](const std::filesystem::path &path) { return formats.contains(path.extension().string()); };
+  const std::atomic<bool> stop{false};
+
+  {
+    filesystem::FileIndex index(indexFile, formats);
+    const auto files = index.scan(images, isSupported, stop);
+    REQUIRE(files.size() == 6);
+    CHECK(files.front() == images / "well_a" / "img_1.tif");
+    CHECK(index.getNrOfListedDirectories() == 7);
+    index.store();
+  }
+
+  {
+    filesystem::FileIndex index(indexFile, formats);
+    CHECK(index.scan(images, isSupported, stop).size() == 6);
+    CHECK(index.getNrOfListedDirectories() == 0);
+  }
+
+  // A new file changes the modification time of its directory
+  std::ofstream(images / "well_b" / "img_3.tif") << "d";
+  std::filesystem::last_write_time(images / "well_b", std::filesystem::last_write_time(images / "well_b") + std::chrono::seconds(2));
+  {
+    filesystem::FileIndex index(indexFile, formats);
+    CHECK(index.scan(images, isSupported, stop).size() == 7);
+    CHECK(index.getNrOfListedDirectories() == 1);
+  }
+
+  // The index of other file formats is not used
+  {
+    filesystem::FileIndex index(indexFile, {".tif", ".txt"});
+    CHECK(index.scan(images, [](const std::filesystem::path &) { return true; }, stop).size() == 10);
+    CHECK(index.getNrOfListedDirectories() == 7);
+  }
+
+  std::filesystem::remove_all(folder);
+}
+
+///
+/// \brief  Listing the directories in the thread pool finds the same files as the calling thread
+/// \author Joachim Danmayr
+///
+TEST_CASE("file_index::thread_pool", "[file_index]")
+{
+  const auto folder = std::filesystem::temp_directory_path() / "imagec_file_index_pool_test";
+  std::filesystem::remove_all(folder);
+  for(int32_t well = 0; well < 8; well++) {
+    for(int32_t sub = 0; sub < 4; sub++) {
+      const auto directory = folder / ("well_" + std::to_string(well)) / ("sub_" + std::to_string(sub));
+      std::filesystem::create_directories(directory);
+      std::ofstream(directory / "img.tif") << "a";
+    }
+  }
+
+  const std::set<std::string> formats{".tif"};
+  const auto isSupported = [&formats](const std::filesystem::path &path) { return formats.contains(path.extension().string()); };
+  const std::atomic<bool> stop{false};
+
+  const auto files = filesystem::FileIndex({}, formats).scan(folder, isSupported, stop);
+  CHECK(files.size() == 32);
+  {
+    BS::priority_thread_pool pool(4);
+    filesystem::FileIndex::setThreadPool(&pool);
+    filesystem::FileIndex index({}, formats);
+    CHECK(index.scan(folder, isSupported, stop) == files);
+    CHECK(index.getNrOfListedDirectories() == 41);
+    filesystem::FileIndex::setThreadPool(nullptr);
+  }
+
+  std::filesystem::remove_all(folder);
+}
+
+}    // namespace joda::test
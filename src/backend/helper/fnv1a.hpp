@@ -34,6 +34,19 @@ inline uint64_t calcFnv1a(const std::string &str)
   return hash;
 }
 
+///
+/// \brief      Continues the hash with the bytes of the given value.
+///             Used to chain hashes of consecutive processing steps.
+///
+inline uint64_t combineFnv1a(uint64_t hash, uint64_t value)
+{
+  for(int byte = 0; byte < 8; byte++) {
+    hash ^= (value >> (byte * 8)) & 0xFF;
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
 inline uint64_t generateImageIdFromPath(const std::filesystem::path &imageFilePath, const std::filesystem::path &workingDirectory)
 {
   auto relativePath = std::filesystem::relative(imageFilePath, workingDirectory);
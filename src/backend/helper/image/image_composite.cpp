@@ -0,0 +1,301 @@
+///
+/// \file      image_composite.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "image_composite.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "backend/commands/image_functions/resize/resize.hpp"
+#include "backend/helper/logger/console_logger.hpp"
+#include <opencv2/core.hpp>
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/matx.hpp>
+
+namespace joda::image {
+
+///
+/// \brief      Returns true if the given channel of the image identified
+///             by key is already loaded and must not be read again.
+/// \author     Joachim Danmayr
+/// \param[in]  key      Image, plane and tile the channel belongs to
+/// \param[in]  channel  Channel index
+/// \return
+///
+bool CompositeImage::isResident(const Key &key, int32_t channel) const
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  return mKey == key && mChannels.contains(channel);
+}
+
+///
+/// \brief      Sets the image, plane and tile the composite is built from.
+///             If the key changed all resident channels are dropped.
+/// \author     Joachim Danmayr
+/// \param[in]  key  Image, plane and tile identifier
+///
+void CompositeImage::setKey(const Key &key)
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  if(mKey == key) {
+    return;
+  }
+  mKey = key;
+  mChannels.clear();
+  mAccumulated = cv::Mat{};
+}
+
+///
+/// \brief      Adds or replaces a channel plane. The display range of an
+///             already resident channel is kept. RGB planes are blended
+///             with their own colors instead of the pseudo color.
+/// \author     Joachim Danmayr
+/// \param[in]  channel      Channel index
+/// \param[in]  plane        8 or 16 bit gray scale or 8 bit RGB image plane
+/// \param[in]  pseudoColor  BGR color the channel is blended with
+/// \param[in]  rescale      Max. preview size
+///
+void CompositeImage::setChannel(int32_t channel, const cv::Mat &plane, const cv::Vec3f &pseudoColor, int32_t rescale)
+{
+  if(plane.empty()) {
+    return;
+  }
+  if(plane.type() != CV_16UC1 && plane.type() != CV_8UC1 && plane.type() != CV_8UC3) {
+    joda::log::logWarning("Composite: Pixel type of channel >" + std::to_string(channel) + "< is not supported, channel is not shown.");
+    return;
+  }
+  cv::Mat scaled;
+  if(rescale > 0) {
+    scaled = joda::image::func::Resizer::resizeWithAspectRatio(plane, std::min(plane.cols, rescale), std::min(plane.rows, rescale));
+  } else {
+    scaled = plane.clone();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mLockMutex);
+    if(!mAccumulated.empty() && mAccumulated.size() != scaled.size()) {
+      // Planes of a composite must have the same size, start from scratch
+      mChannels.clear();
+      mAccumulated = cv::Mat{};
+    }
+    if(mAccumulated.empty()) {
+      mAccumulated = cv::Mat::zeros(scaled.size(), CV_32FC3);
+    }
+    const bool isNew = !mChannels.contains(channel);
+    replaceContribution(mChannels[channel], [&plane, &scaled, &pseudoColor, isNew](Channel &ch) {
+      ch.original    = plane;
+      ch.plane       = scaled;
+      ch.pseudoColor = pseudoColor;
+      if(isNew && plane.depth() == CV_8U) {
+        ch.upperValue = UINT8_MAX;
+      }
+    });
+  }
+  refreshImageToPaint();
+}
+
+///
+/// \brief      Show or hide a resident channel without dropping its data
+/// \author     Joachim Danmayr
+///
+void CompositeImage::setChannelEnabled(int32_t channel, bool enabled)
+{
+  {
+    std::lock_guard<std::mutex> lock(mLockMutex);
+    auto it = mChannels.find(channel);
+    if(it == mChannels.end() || it->second.enabled == enabled) {
+      return;
+    }
+    replaceContribution(it->second, [enabled](Channel &ch) { ch.enabled = enabled; });
+  }
+  refreshImageToPaint();
+}
+
+///
+/// \brief      Change the LUT of one channel. Only the contribution of this
+///             channel is recalculated.
+/// \author     Joachim Danmayr
+///
+void CompositeImage::setBrightnessRange(int32_t channel, int32_t lowerValue, int32_t upperValue)
+{
+  lowerValue = std::clamp(lowerValue, 0, static_cast<int32_t>(UINT16_MAX));
+  upperValue = std::clamp(upperValue, 0, static_cast<int32_t>(UINT16_MAX));
+  if(lowerValue > upperValue) {
+    lowerValue = upperValue;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mLockMutex);
+    auto it = mChannels.find(channel);
+    if(it == mChannels.end()) {
+      return;
+    }
+    if(it->second.lowerValue == lowerValue && it->second.upperValue == upperValue) {
+      return;
+    }
+    replaceContribution(it->second, [lowerValue, upperValue](Channel &ch) {
+      ch.lowerValue = static_cast<uint16_t>(lowerValue);
+      ch.upperValue = static_cast<uint16_t>(upperValue);
+    });
+  }
+  refreshImageToPaint();
+}
+
+///
+/// \brief      Change the pseudo color of one channel
+/// \author     Joachim Danmayr
+///
+void CompositeImage::setPseudoColor(int32_t channel, const cv::Vec3f &pseudoColor)
+{
+  {
+    std::lock_guard<std::mutex> lock(mLockMutex);
+    auto it = mChannels.find(channel);
+    if(it == mChannels.end()) {
+      return;
+    }
+    replaceContribution(it->second, [&pseudoColor](Channel &ch) { ch.pseudoColor = pseudoColor; });
+  }
+  refreshImageToPaint();
+}
+
+///
+/// \brief      Drop all resident channels
+/// \author     Joachim Danmayr
+///
+void CompositeImage::clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(mLockMutex);
+    mKey         = {};
+    mAccumulated = cv::Mat{};
+    mChannels.clear();
+  }
+  refreshImageToPaint();
+}
+
+///
+/// \brief      Channels which are currently loaded
+/// \author     Joachim Danmayr
+///
+auto CompositeImage::getResidentChannels() const -> std::set<int32_t>
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  std::set<int32_t> channels;
+  for(const auto &[idx, _] : mChannels) {
+    channels.emplace(idx);
+  }
+  return channels;
+}
+
+///
+/// \brief      Size of the blended preview image
+/// \author     Joachim Danmayr
+///
+auto CompositeImage::getPreviewImageSize() const -> QSize
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  return {mAccumulated.cols, mAccumulated.rows};
+}
+
+///
+/// \brief      Plane of a resident channel as it was loaded, empty if the
+///             channel is not resident for the given key.
+/// \author     Joachim Danmayr
+///
+auto CompositeImage::getChannelPlane(const Key &key, int32_t channel) const -> cv::Mat
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  if(!(mKey == key)) {
+    return {};
+  }
+  auto it = mChannels.find(channel);
+  if(it == mChannels.end()) {
+    return {};
+  }
+  return it->second.original;
+}
+
+///
+/// \brief      Copy of the blended image. The image is recalculated by the
+///             loading thread, so the painter must not keep a pointer to it.
+/// \author     Joachim Danmayr
+///
+auto CompositeImage::getImageToPaint() const -> QImage
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  return mQImage;
+}
+
+///
+/// \brief      Removes the old contribution of the channel from the
+///             accumulator, applies the modification, recalculates the
+///             contribution and adds it again.
+///             Must be called with mLockMutex held.
+/// \author     Joachim Danmayr
+///
+void CompositeImage::replaceContribution(Channel &channel, const std::function<void(Channel &)> &modify)
+{
+  if(channel.enabled && !channel.contribution.empty()) {
+    cv::subtract(mAccumulated, channel.contribution, mAccumulated);
+  }
+  modify(channel);
+  calcContribution(channel);
+  if(channel.enabled && !channel.contribution.empty()) {
+    cv::add(mAccumulated, channel.contribution, mAccumulated);
+  }
+}
+
+///
+/// \brief      Applies the linear display LUT and the pseudo color in one
+///             vectorized pass. The result is in the range [0, 255].
+/// \author     Joachim Danmayr
+///
+void CompositeImage::calcContribution(Channel &channel)
+{
+  if(channel.plane.empty()) {
+    channel.contribution = cv::Mat{};
+    return;
+  }
+  // Linear LUT: (val - lower) * 255 / (upper - lower), clamped to [0, 255]
+  const double range = std::max(1.0, static_cast<double>(channel.upperValue) - static_cast<double>(channel.lowerValue));
+  const double alpha = 255.0 / range;
+  const double beta  = -static_cast<double>(channel.lowerValue) * alpha;
+  cv::Mat gray;
+  channel.plane.convertTo(gray, CV_32F, alpha, beta);
+  cv::max(gray, cv::Scalar::all(0.0), gray);
+  cv::min(gray, cv::Scalar::all(255.0), gray);
+  if(gray.channels() == 3) {
+    // RGB planes keep their own colors
+    channel.contribution = gray;
+    return;
+  }
+
+  // Pseudo color: 1 channel -> 3 channel matrix multiplication
+  const cv::Matx31f color(channel.pseudoColor[0], channel.pseudoColor[1], channel.pseudoColor[2]);
+  cv::transform(gray, channel.contribution, color);
+}
+
+///
+/// \brief      Converts the accumulated channels to the QImage to paint
+/// \author     Joachim Danmayr
+///
+void CompositeImage::refreshImageToPaint()
+{
+  std::lock_guard<std::mutex> lock(mLockMutex);
+  if(mAccumulated.empty()) {
+    mQImage = QImage{};
+    return;
+  }
+  cv::Mat color8U;
+  mAccumulated.convertTo(color8U, CV_8UC3);    // Saturating
+  mQImage = QImage(color8U.data, color8U.cols, color8U.rows, static_cast<int>(color8U.step), QImage::Format_BGR888).copy();
+}
+
+}    // namespace joda::image
@@ -0,0 +1,97 @@
+///
+/// \file      image_composite.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <qimage.h>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include "backend/enums/types.hpp"
+#include "backend/helper/ome_parser/ome_info.hpp"
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/matx.hpp>
+
+namespace joda::image {
+
+///
+/// \class      CompositeImage
+/// \author     Joachim Danmayr
+/// \brief      Keeps several channel planes of the same image resident and
+///             blends them additively, each with its own pseudo color LUT.
+///             Changing the display range of one channel only recalculates
+///             the contribution of this channel.
+///
+class CompositeImage
+{
+public:
+  /////////////////////////////////////////////////////
+  struct Key
+  {
+    std::filesystem::path imagePath;
+    int32_t series = -1;
+    int32_t tStack = -1;
+    int32_t zStack = -1;
+    joda::ome::TileToLoad tile;
+    enums::ZProjection zProjection = enums::ZProjection::UNDEFINED;
+
+    bool operator==(const Key &other) const
+    {
+      return imagePath == other.imagePath && series == other.series && tStack == other.tStack && zStack == other.zStack && tile == other.tile &&
+             zProjection == other.zProjection;
+    }
+  };
+
+  /////////////////////////////////////////////////////
+  CompositeImage() = default;
+  bool isResident(const Key &key, int32_t channel) const;
+  void setKey(const Key &key);
+  void setChannel(int32_t channel, const cv::Mat &plane, const cv::Vec3f &pseudoColor, int32_t rescale = 2048);
+  void setChannelEnabled(int32_t channel, bool enabled);
+  void setBrightnessRange(int32_t channel, int32_t lowerValue, int32_t upperValue);
+  void setPseudoColor(int32_t channel, const cv::Vec3f &pseudoColor);
+  void clear();
+
+  [[nodiscard]] auto getResidentChannels() const -> std::set<int32_t>;
+  [[nodiscard]] auto getPreviewImageSize() const -> QSize;
+  [[nodiscard]] auto getChannelPlane(const Key &key, int32_t channel) const -> cv::Mat;
+  [[nodiscard]] auto getImageToPaint() const -> QImage;
+
+private:
+  /////////////////////////////////////////////////////
+  struct Channel
+  {
+    cv::Mat original;        // Plane as loaded from the image file
+    cv::Mat plane;           // CV_16UC1, CV_8UC1 or CV_8UC3, scaled to the preview size
+    cv::Mat contribution;    // CV_32FC3, plane after applying LUT and pseudo color
+    cv::Vec3f pseudoColor = {1.0, 1.0, 1.0};
+    uint16_t lowerValue   = 0;
+    uint16_t upperValue   = UINT16_MAX;
+    bool enabled          = true;
+  };
+
+  /////////////////////////////////////////////////////
+  static void calcContribution(Channel &channel);
+  void replaceContribution(Channel &channel, const std::function<void(Channel &)> &modify);
+  void refreshImageToPaint();
+
+  /////////////////////////////////////////////////////
+  Key mKey;
+  std::map<int32_t, Channel> mChannels;
+  cv::Mat mAccumulated;    // CV_32FC3, sum of all enabled channel contributions
+  QImage mQImage;    // Written by the loading thread, only hand out copies
+  mutable std::mutex mLockMutex;
+};
+
+}    // namespace joda::image
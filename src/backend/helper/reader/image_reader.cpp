@@ -24,6 +24,7 @@
 #include <tuple>
 #include "backend/commands/image_functions/resize/resize.hpp"
 #include "backend/helper/duration_count/duration_count.h"
+#include "backend/helper/trace/trace.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include <nlohmann/json.hpp>
 #include <opencv2/core/mat.hpp>
@@ -640,7 +641,8 @@ cv::Mat ImageReader::loadImageTile(joda::enums::PlaneId imagePlane, uint16_t ser
       tile.tileY = tilesY;
     }
 
-    DurationCount durationCount("Load from filesystem");
+    static const auto SPAN_LOAD_FROM_FILESYSTEM = joda::trace::Tracer::registerSpan("Load from filesystem");
+    joda::trace::Span span(SPAN_LOAD_FROM_FILESYSTEM);
 
     // 2. Allocate the memory block in native C++ heap
     // This is *your* memory to manage.
@@ -0,0 +1,234 @@
+///
+/// \file      mask_codec.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "mask_codec.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace joda::rle {
+
+namespace {
+
+constexpr uint8_t MASK_FORMAT_VERSION    = 1;
+constexpr uint8_t CONTOUR_FORMAT_VERSION = 1;
+constexpr uint8_t CONTOUR_ESCAPE         = 0xFF;    // Followed by dx and dy of a step which is not to a neighbour
+
+void writeVarint(std::string &out, uint64_t value)
+{
+  while(value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void writeSignedVarint(std::string &out, int64_t value)
+{
+  writeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+///
+/// \brief      Reads the encoded data, throws if the data ends too early
+///
+class Reader
+{
+public:
+  explicit Reader(std::string_view data) : mData(data)
+  {
+  }
+
+  [[nodiscard]] bool atEnd() const
+  {
+    return mPos >= mData.size();
+  }
+
+  uint8_t readByte()
+  {
+    if(atEnd()) {
+      throw std::invalid_argument("Encoded mask or contour is truncated.");
+    }
+    return static_cast<uint8_t>(mData[mPos++]);
+  }
+
+  uint64_t readVarint()
+  {
+    uint64_t value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+      const auto byte = readByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw std::invalid_argument("Encoded mask or contour contains an invalid number.");
+  }
+
+  int64_t readSignedVarint()
+  {
+    const auto value = readVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+private:
+  std::string_view mData;
+  size_t mPos = 0;
+};
+
+}    // namespace
+
+///
+/// \brief      Run length encodes a binary mask, every pixel > 0 is foreground
+/// \author     Joachim Danmayr
+/// \param[in]  mask  CV_8UC1 mask
+/// \return     Encoded mask, empty if the mask is empty
+///
+auto encodeMask(const cv::Mat &mask) -> std::string
+{
+  std::string out;
+  if(mask.empty()) {
+    return out;
+  }
+  CV_Assert(mask.type() == CV_8UC1);
+  out.reserve(16);
+  out.push_back(static_cast<char>(MASK_FORMAT_VERSION));
+  writeVarint(out, static_cast<uint64_t>(mask.cols));
+  writeVarint(out, static_cast<uint64_t>(mask.rows));
+
+  bool foreground = false;
+  uint64_t run    = 0;
+  for(int y = 0; y < mask.rows; y++) {
+    const auto *row = mask.ptr<uint8_t>(y);
+    for(int x = 0; x < mask.cols; x++) {
+      if((row[x] > 0) != foreground) {
+        writeVarint(out, run);
+        foreground = !foreground;
+        run        = 0;
+      }
+      run++;
+    }
+  }
+  writeVarint(out, run);
+  return out;
+}
+
+///
+/// \brief      Decodes a mask encoded with encodeMask
+/// \author     Joachim Danmayr
+/// \param[in]  data  Encoded mask
+/// \return     CV_8UC1 mask with 255 for foreground pixels, empty for empty data
+///
+auto decodeMask(std::string_view data) -> cv::Mat
+{
+  if(data.empty()) {
+    return {};
+  }
+  Reader reader(data);
+  if(reader.readByte() != MASK_FORMAT_VERSION) {
+    throw std::invalid_argument("Unknown mask encoding.");
+  }
+  const auto cols = reader.readVarint();
+  const auto rows = reader.readVarint();
+  if(cols > INT32_MAX || rows > INT32_MAX) {
+    throw std::invalid_argument("Encoded mask is too big.");
+  }
+  cv::Mat mask        = cv::Mat::zeros(static_cast<int>(rows), static_cast<int>(cols), CV_8UC1);
+  const uint64_t size = cols * rows;
+  auto *pixels        = mask.ptr<uint8_t>();
+
+  uint64_t pos    = 0;
+  bool foreground = false;
+  while(!reader.atEnd()) {
+    const auto run = reader.readVarint();
+    if(run > size - pos) {
+      throw std::invalid_argument("Encoded mask is bigger than its size.");
+    }
+    if(foreground) {
+      std::memset(pixels + pos, 255, run);
+    }
+    pos += run;
+    foreground = !foreground;
+  }
+  return mask;
+}
+
+///
+/// \brief      Encodes a contour. Contours found with CHAIN_APPROX_NONE only
+///             contain steps to neighbours and need one byte per point.
+/// \author     Joachim Danmayr
+/// \param[in]  contour  Contour points
+/// \return     Encoded contour, empty if the contour is empty
+///
+auto encodeContour(const std::vector<cv::Point> &contour) -> std::string
+{
+  std::string out;
+  if(contour.empty()) {
+    return out;
+  }
+  out.reserve(contour.size() + 8);
+  out.push_back(static_cast<char>(CONTOUR_FORMAT_VERSION));
+  writeVarint(out, contour.size());
+  writeSignedVarint(out, contour.front().x);
+  writeSignedVarint(out, contour.front().y);
+  for(size_t n = 1; n < contour.size(); n++) {
+    const int dx = contour[n].x - contour[n - 1].x;
+    const int dy = contour[n].y - contour[n - 1].y;
+    if(dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1) {
+      out.push_back(static_cast<char>((dx + 1) * 3 + (dy + 1)));
+    } else {
+      out.push_back(static_cast<char>(CONTOUR_ESCAPE));
+      writeSignedVarint(out, dx);
+      writeSignedVarint(out, dy);
+    }
+  }
+  return out;
+}
+
+///
+/// \brief      Decodes a contour encoded with encodeContour
+/// \author     Joachim Danmayr
+/// \param[in]  data  Encoded contour
+/// \return     Contour points
+///
+auto decodeContour(std::string_view data) -> std::vector<cv::Point>
+{
+  std::vector<cv::Point> contour;
+  if(data.empty()) {
+    return contour;
+  }
+  Reader reader(data);
+  if(reader.readByte() != CONTOUR_FORMAT_VERSION) {
+    throw std::invalid_argument("Unknown contour encoding.");
+  }
+  const auto nrOfPoints = reader.readVarint();
+  if(nrOfPoints > data.size()) {
+    throw std::invalid_argument("Encoded contour is truncated.");
+  }
+  contour.reserve(nrOfPoints);
+  cv::Point point{static_cast<int>(reader.readSignedVarint()), static_cast<int>(reader.readSignedVarint())};
+  contour.push_back(point);
+  for(uint64_t n = 1; n < nrOfPoints; n++) {
+    const auto step = reader.readByte();
+    if(step == CONTOUR_ESCAPE) {
+      point.x += static_cast<int>(reader.readSignedVarint());
+      point.y += static_cast<int>(reader.readSignedVarint());
+    } else if(step < 9) {
+      point.x += step / 3 - 1;
+      point.y += step % 3 - 1;
+    } else {
+      throw std::invalid_argument("Encoded contour contains an invalid step.");
+    }
+    contour.push_back(point);
+  }
+  return contour;
+}
+
+}    // namespace joda::rle
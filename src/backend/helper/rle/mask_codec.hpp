@@ -0,0 +1,41 @@
+///
+/// \file      mask_codec.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/types.hpp>
+
+namespace joda::rle {
+
+///
+/// \brief      Compact binary encoding of object masks and contours, stored as
+///             BLOB in the results database.
+///
+///             Mask:    [version][cols][rows][run 0][run 1]...
+///                      Run lengths of alternating background and foreground
+///                      pixels in row major order, starting with background.
+///             Contour: [version][nr. of points][x0][y0][step 1][step 2]...
+///                      A step to one of the 8 neighbours is stored in one byte,
+///                      other steps as escape byte followed by dx and dy.
+///
+///             Numbers are LEB128 varints, signed ones zig-zag encoded.
+/// \author     Joachim Danmayr
+///
+auto encodeMask(const cv::Mat &mask) -> std::string;
+auto decodeMask(std::string_view data) -> cv::Mat;
+auto encodeContour(const std::vector<cv::Point> &contour) -> std::string;
+auto decodeContour(std::string_view data) -> std::vector<cv::Point>;
+
+}    // namespace joda::rle
@@ -0,0 +1,68 @@
+///
+/// \file      mask_codec_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <stdexcept>
+#include <vector>
+#include "backend/helper/rle/mask_codec.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Masks and contours are restored unchanged
+/// \author Joachim Danmayr
+///
+TEST_CASE("mask_codec::round_trip", "[mask_codec]")
+{
+  SECTION("Mask")
+  {
+    cv::Mat mask = cv::Mat::zeros(40, 300, CV_8UC1);
+    cv::circle(mask, {150, 20}, 15, cv::Scalar(255), cv::FILLED);
+    mask.at<uint8_t>(0, 0)    = 1;    // Every value > 0 is foreground
+    mask.at<uint8_t>(39, 299) = 255;
+
+    const auto encoded = rle::encodeMask(mask);
+    const auto decoded = rle::decodeMask(encoded);
+    REQUIRE(decoded.size() == mask.size());
+    CHECK(cv::countNonZero(decoded != (mask > 0)) == 0);
+    CHECK(encoded.size() < 200);
+
+    // Sub matrices are not continuous
+    const auto roi = mask(cv::Rect(130, 5, 40, 30));
+    CHECK(cv::countNonZero(rle::decodeMask(rle::encodeMask(roi)) != (roi > 0)) == 0);
+
+    CHECK(rle::encodeMask({}).empty());
+    CHECK(rle::decodeMask({}).empty());
+    CHECK(cv::countNonZero(rle::decodeMask(rle::encodeMask(cv::Mat::zeros(3, 3, CV_8UC1)))) == 0);
+  }
+
+  SECTION("Contour")
+  {
+    const std::vector<cv::Point> contour{{10, 10}, {11, 10}, {12, 11}, {12, 12}, {11, 12}, {10, 11}, {-5, 400}, {10, 10}};
+    const auto encoded = rle::encodeContour(contour);
+    CHECK(rle::decodeContour(encoded) == contour);
+    CHECK(rle::decodeContour({}).empty());
+  }
+
+  SECTION("Corrupt data")
+  {
+    auto encoded   = rle::encodeMask(cv::Mat::ones(10, 10, CV_8UC1));
+    encoded.back() = static_cast<char>(101);
+    CHECK_THROWS_AS(rle::decodeMask(encoded), std::invalid_argument);
+    auto contour = rle::encodeContour({{1, 1}, {2, 2}});
+    contour.pop_back();
+    CHECK_THROWS_AS(rle::decodeContour(contour), std::invalid_argument);
+  }
+}
+
+}    // namespace joda::test
@@ -0,0 +1,69 @@
+///
+/// \file      process_usage.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     CPU time of the running process
+///
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <ctime>
+
+#endif
+
+namespace joda::system {
+
+#ifdef _WIN32
+
+///
+/// \brief      CPU time (user + kernel) the calling thread consumed in nanoseconds
+///
+inline uint64_t getThreadCpuTimeNs()
+{
+  FILETIME creationTime;
+  FILETIME exitTime;
+  FILETIME kernelTime;
+  FILETIME userTime;
+  if(GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime) == 0) {
+    return 0;
+  }
+  auto toNs = [](const FILETIME &ft) -> uint64_t {
+    ULARGE_INTEGER val;
+    val.LowPart  = ft.dwLowDateTime;
+    val.HighPart = ft.dwHighDateTime;
+    return static_cast<uint64_t>(val.QuadPart) * 100;    // 100 ns ticks
+  };
+  return toNs(kernelTime) + toNs(userTime);
+}
+
+#else
+
+///
+/// \brief      CPU time (user + kernel) the calling thread consumed in nanoseconds
+///
+inline uint64_t getThreadCpuTimeNs()
+{
+  struct timespec ts;
+  if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+#endif
+
+}    // namespace joda::system
@@ -18,6 +18,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 namespace joda::table {
 
@@ -28,6 +31,7 @@ Table::Table(const std::vector<TableColumn> &input)
   for(size_t n = 0; n < input.size(); n++) {
     mDataColOrganized.emplace(n, input.at(n));
   }
+  detachRowMetaData();
 }
 
 void Table::setColHeader(const std::map<uint32_t, settings::ResultsSettings::ColumnKey> &data)
@@ -66,42 +70,70 @@ void Table::clear()
 {
   std::lock_guard<std::mutex> lock(mAccessMutex);
   mDataColOrganized.clear();
+  mRowMetaData.clear();
+  mRowNames.clear();
 }
 
 ///
-/// \brief
-/// \author
-/// \param[in]
-/// \param[out]
-/// \return
+/// \brief      Columns of the same row group describe the same object in each
+///             row and share the row meta data (ids, validity, position).
+///             Columns without a row group keep their own meta data. Must be
+///             set before the first cell of the column is stored.
+/// \author     Joachim Danmayr
 ///
-[[nodiscard]] std::shared_ptr<const TableCell> Table::data(uint32_t row, uint32_t col) const
+void Table::setRowGroup(uint32_t col, uint32_t rowGroup)
 {
-  std::lock_guard<std::mutex> lock(mAccessMutex);
-  if(mDataColOrganized.contains(col)) {
-    if(mDataColOrganized.at(col).rows.contains(row)) {
-      return mDataColOrganized.at(col).rows.at(row);
+  auto &meta = mRowMetaData[rowGroup];
+  if(meta == nullptr) {
+    meta = std::make_shared<TableRowMetaData>();
+  }
+  auto &column = mDataColOrganized[col];
+  if(!column.empty()) {
+    throw std::invalid_argument("Row group of column >" + std::to_string(col) + "< must be set before the data.");
+  }
+  column.mRowMeta = meta;
+}
+
+///
+/// \brief      Copies the row meta data, afterwards the columns of this table
+///             do not share their meta data with the table it was copied from
+/// \author     Joachim Danmayr
+///
+void Table::detachRowMetaData()
+{
+  std::map<const TableRowMetaData *, std::shared_ptr<TableRowMetaData>> copies;
+  auto copyOf = [&copies](const std::shared_ptr<TableRowMetaData> &meta) -> std::shared_ptr<TableRowMetaData> {
+    if(meta == nullptr) {
+      return nullptr;
+    }
+    auto &copy = copies[meta.get()];
+    if(copy == nullptr) {
+      copy = std::make_shared<TableRowMetaData>(*meta);
     }
+    return copy;
+  };
+  for(auto &[_, column] : mDataColOrganized) {
+    column.mRowMeta = copyOf(column.mRowMeta);
+  }
+  for(auto &[_, meta] : mRowMetaData) {
+    meta = copyOf(meta);
   }
-  return nullptr;
 }
 
 ///
-/// \brief
-/// \author
-/// \param[in]
-/// \param[out]
-/// \return
+/// \brief      Copy of the cell or nothing if there is no cell at this position.
+///             The copy is taken under the lock and stays valid if the table
+///             is changed afterwards.
+/// \author     Joachim Danmayr
 ///
-[[nodiscard]] std::shared_ptr<TableCell> Table::mutableData(uint32_t row, uint32_t col)
+[[nodiscard]] std::optional<TableCell> Table::data(uint32_t row, uint32_t col) const
 {
   std::lock_guard<std::mutex> lock(mAccessMutex);
-  if(mDataColOrganized.contains(col)) {
-    if(mDataColOrganized.at(col).rows.contains(row)) {
-      return mDataColOrganized.at(col).rows.at(row);
-    }
+  auto it = mDataColOrganized.find(col);
+  if(it == mDataColOrganized.end() || !it->second.contains(row)) {
+    return std::nullopt;
   }
-  return nullptr;
+  return TableCellRef{&it->second, row, row < mRowNames.size() ? &mRowNames[row] : nullptr}.toCell();
 }
 
 ///
@@ -113,39 +145,153 @@ void Table::clear()
 ///
 std::pair<double, double> Table::getMinMax(uint32_t column) const
 {
-  double min      = std::numeric_limits<double>::max();
-  double max      = std::numeric_limits<double>::min();
-  const auto &col = mDataColOrganized.at(column);
-  for(const auto &[_, row] : col.rows) {
-    if(!row->isNAN() && row->isValid()) {
-      if(row->getVal() < min) {
-        min = row->getVal();
-      }
-      if(row->getVal() > max) {
-        max = row->getVal();
-      }
-    }
+  return mDataColOrganized.at(column).getMinMax();
+}
+
+std::pair<double, double> Table::getMinMax() const
+{
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::min();
+  for(const auto &[_, col] : mDataColOrganized) {
+    auto [colMin, colMax] = col.getMinMax();
+    min                   = std::min(min, colMin);
+    max                   = std::max(max, colMax);
   }
   return {min, max};
 }
 
-std::pair<double, double> Table::getMinMax() const
+///
+/// \brief      Stores the cell in the row. The value and the formatting are
+///             stored in the column, the other fields in the row meta data.
+/// \author     Joachim Danmayr
+///
+void TableColumn::set(uint32_t row, const TableCell &cell)
+{
+  resize(row);
+  const auto &formatting = cell.getFormatting();
+  mValues[row]           = cell.getVal();
+
+  auto &meta                   = *mRowMeta;
+  meta.objectIdGroup[row]      = cell.getId();
+  meta.objectId[row]           = cell.getObjectId();
+  meta.parentObjectId[row]     = cell.getParentId();
+  meta.trackingId[row]         = cell.getTrackingId();
+  meta.distanceToObjectId[row] = cell.getDistanceToObjectId();
+  meta.groupIdx[row]           = cell.getGroupId();
+  meta.tStack[row]             = cell.getStackT();
+  meta.zStack[row]             = cell.getStackZ();
+  meta.cStack[row]             = cell.getStackC();
+  meta.posX[row]               = cell.getPosX();
+  meta.posY[row]               = cell.getPosY();
+  meta.isValid[row]            = cell.isValid() ? 1 : 0;
+
+  uint8_t flags = CELL_SET;
+  flags |= formatting.isObjectId ? IS_OBJECT_ID : 0;
+  flags |= formatting.isParentObjectId ? IS_PARENT_OBJECT_ID : 0;
+  flags |= formatting.isTrackingId ? IS_TRACKING_ID : 0;
+  flags |= static_cast<uint8_t>((static_cast<uint8_t>(formatting.bgColor) << BG_COLOR_SHIFT) & BG_COLOR_MASK);
+  mFlags[row] = flags;
+}
+
+///
+/// \brief      Sets the object id group of the cell. An empty cell is
+///             created if there is no cell in this row.
+/// \author     Joachim Danmayr
+///
+void TableColumn::setId(uint32_t row, uint64_t id)
+{
+  if(!contains(row)) {
+    set(row, TableCell{});
+  }
+  mRowMeta->objectIdGroup[row] = id;
+}
+
+///
+/// \brief      Min and max of the valid values, NaN and inf are ignored
+/// \author     Joachim Danmayr
+///
+std::pair<double, double> TableColumn::getMinMax() const
 {
   double min = std::numeric_limits<double>::max();
   double max = std::numeric_limits<double>::min();
-  for(const auto &[_1, col] : mDataColOrganized) {
-    for(const auto &[_2, rowIn] : col.rows) {
-      if(!rowIn->isNAN() && rowIn->isValid()) {
-        if(rowIn->getVal() < min) {
-          min = rowIn->getVal();
-        }
-        if(rowIn->getVal() > max) {
-          max = rowIn->getVal();
-        }
-      }
+  for(size_t row = 0; row < mValues.size(); row++) {
+    const double val = mValues[row];
+    if((mFlags[row] & CELL_SET) == 0 || mRowMeta->isValid[row] == 0 || std::isnan(val) || std::isinf(val)) {
+      continue;
     }
+    min = std::min(min, val);
+    max = std::max(max, val);
   }
   return {min, max};
 }
 
+///
+/// \brief      Grows the vectors and the row meta data so that row fits in.
+///             New rows have no cell.
+/// \author     Joachim Danmayr
+///
+void TableColumn::resize(uint32_t row)
+{
+  if(mRowMeta == nullptr) {
+    mRowMeta = std::make_shared<TableRowMetaData>();
+  }
+  mRowMeta->resize(row);
+  if(row < mFlags.size()) {
+    return;
+  }
+  const size_t size = static_cast<size_t>(row) + 1;
+  mValues.resize(size, std::numeric_limits<double>::quiet_NaN());
+  mFlags.resize(size, 0);
+}
+
+///
+/// \brief      Grows all vectors so that row fits in
+/// \author     Joachim Danmayr
+///
+void TableRowMetaData::resize(uint32_t row)
+{
+  if(row < isValid.size()) {
+    return;
+  }
+  const size_t size = static_cast<size_t>(row) + 1;
+  objectIdGroup.resize(size, 0);
+  objectId.resize(size, 0);
+  parentObjectId.resize(size, 0);
+  trackingId.resize(size, 0);
+  distanceToObjectId.resize(size, 0);
+  groupIdx.resize(size, 0);
+  tStack.resize(size, 0);
+  zStack.resize(size, 0);
+  cStack.resize(size, 0);
+  posX.resize(size, 0);
+  posY.resize(size, 0);
+  isValid.resize(size, 0);
+}
+
+///
+/// \brief      Copy of the cell, e.g. to keep it after the table was changed
+/// \author     Joachim Danmayr
+///
+auto TableCellRef::toCell() const -> TableCell
+{
+  TableCell cell{getVal(),
+                 TableCell::MetaData{.objectIdGroup      = getId(),
+                                     .objectId           = getObjectId(),
+                                     .parentObjectId     = getParentId(),
+                                     .trackingId         = getTrackingId(),
+                                     .distanceToObjectId = getDistanceToObjectId(),
+                                     .isValid            = isValid(),
+                                     .tStack             = getStackT(),
+                                     .zStack             = getStackZ(),
+                                     .cStack             = getStackC(),
+                                     .rowName            = getRowName()},
+                 TableCell::Grouping{.groupIdx = getGroupId(), .posX = getPosX(), .posY = getPosY()}};
+  const auto formatting = getFormatting();
+  cell.setBackgroundColor(formatting.bgColor);
+  cell.setIsObjectIdCell(formatting.isObjectId);
+  cell.setIsParentObjectIdCell(formatting.isParentObjectId);
+  cell.setIsTrackinIdCell(formatting.isTrackingId);
+  return cell;
+}
+
 }    // namespace joda::table
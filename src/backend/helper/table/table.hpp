@@ -17,6 +17,8 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <variant>
@@ -82,14 +84,6 @@ public:
     mFormatting = other.mFormatting;
   }
 
-  explicit TableCell(const std::shared_ptr<const TableCell> &other)
-  {
-    value       = other->value;
-    mMetaData   = other->mMetaData;
-    mGrouping   = other->mGrouping;
-    mFormatting = other->mFormatting;
-  }
-
   TableCell(double val, MetaData meta, const Grouping &grouping) : value(val), mMetaData(std::move(meta)), mGrouping(grouping)
   {
   }
@@ -180,6 +174,16 @@ public:
     return mMetaData.tStack;
   }
 
+  [[nodiscard]] uint32_t getStackZ() const
+  {
+    return mMetaData.zStack;
+  }
+
+  [[nodiscard]] uint32_t getStackC() const
+  {
+    return mMetaData.cStack;
+  }
+
   [[nodiscard]] const std::string &getRowName() const
   {
     return mMetaData.rowName;
@@ -223,15 +227,233 @@ private:
   Formating mFormatting;
 };
 
-using colRows_t = std::map<uint32_t, std::shared_ptr<TableCell>>;    // This is a column with its rows
+class TableCellRef;
 
-struct TableColumn
+///
+/// \struct     TableRowMetaData
+/// \author     Joachim Danmayr
+/// \brief      Ids, validity and position of the object in each row. Columns
+///             describing the same objects (e.g. all measurements of one class)
+///             share one instance, so these fields are stored once per row and
+///             not once per cell.
+///
+struct TableRowMetaData
 {
-  colRows_t rows;
+  void resize(uint32_t row);
+
+  std::vector<uint64_t> objectIdGroup;
+  std::vector<uint64_t> objectId;
+  std::vector<uint64_t> parentObjectId;
+  std::vector<uint64_t> trackingId;
+  std::vector<uint64_t> distanceToObjectId;
+  std::vector<uint64_t> groupIdx;
+  std::vector<uint32_t> tStack;
+  std::vector<uint32_t> zStack;
+  std::vector<uint32_t> cStack;
+  std::vector<uint32_t> posX;
+  std::vector<uint32_t> posY;
+  std::vector<uint8_t> isValid;
+};
+
+///
+/// \class      TableColumn
+/// \author     Joachim Danmayr
+/// \brief      Values of one column stored in a typed vector indexed by the
+///             row, rows without a cell are marked in the flags. Reading all
+///             values (e.g. for a heatmap) only touches this vector. The row
+///             meta data is shared with the columns of the same row group,
+///             row names are shared by all columns and stored in the table.
+///
+class TableColumn
+{
+public:
+  /////////////////////////////////////////////////////
+  void set(uint32_t row, const TableCell &cell);
+  void setId(uint32_t row, uint64_t id);
+
+  [[nodiscard]] bool contains(uint32_t row) const
+  {
+    return row < mFlags.size() && (mFlags[row] & CELL_SET) != 0;
+  }
+
+  [[nodiscard]] auto at(uint32_t row) const -> TableCellRef;
+
+  ///
+  /// \brief      Highest row with a cell + 1
+  ///
+  [[nodiscard]] uint32_t getNrOfRows() const
+  {
+    return static_cast<uint32_t>(mFlags.size());
+  }
+
+  [[nodiscard]] bool empty() const
+  {
+    return mFlags.empty();
+  }
+
+  [[nodiscard]] std::pair<double, double> getMinMax() const;
+
+  /////////////////////////////////////////////////////
   settings::ResultsSettings::ColumnKey colSettings;
   std::string title;
+
+private:
+  /////////////////////////////////////////////////////
+  friend class TableCellRef;
+  friend class Table;
+
+  static constexpr uint8_t CELL_SET            = 0x01;
+  static constexpr uint8_t IS_OBJECT_ID        = 0x02;
+  static constexpr uint8_t IS_PARENT_OBJECT_ID = 0x04;
+  static constexpr uint8_t IS_TRACKING_ID      = 0x08;
+  static constexpr uint8_t BG_COLOR_SHIFT      = 4;
+  static constexpr uint8_t BG_COLOR_MASK       = 0x30;
+
+  /////////////////////////////////////////////////////
+  void resize(uint32_t row);
+
+  /////////////////////////////////////////////////////
+  std::vector<double> mValues;
+  std::vector<uint8_t> mFlags;                   // CELL_SET, formatting and background color
+  std::shared_ptr<TableRowMetaData> mRowMeta;    // Shared with the columns of the same row group
 };
 
+///
+/// \class      TableCellRef
+/// \author     Joachim Danmayr
+/// \brief      Read only view to one cell of a TableColumn with the same
+///             getters as TableCell. The view is not synchronized with the
+///             table and only valid as long as the table is not changed, use
+///             toCell to keep a copy.
+///
+class TableCellRef
+{
+public:
+  /////////////////////////////////////////////////////
+  TableCellRef(const TableColumn *column, uint32_t row, const std::string *rowName = nullptr) :
+      mColumn(column), mRow(row), mRowName(rowName)
+  {
+  }
+
+  [[nodiscard]] double getVal() const
+  {
+    return mColumn->mValues[mRow];
+  }
+
+  [[nodiscard]] std::variant<std::string, double> getValAsVariant(enums::Measurement meas) const
+  {
+    if(meas == enums::Measurement::OBJECT_ID) {
+      return helper::toBase32(getObjectId());
+    }
+    if(meas == enums::Measurement::PARENT_OBJECT_ID) {
+      return helper::toBase32(getParentId());
+    }
+    if(meas == enums::Measurement::TRACKING_ID) {
+      return helper::toBase32(getTrackingId());
+    }
+    if(meas == enums::Measurement::DISTANCE_TO_OBJECT_ID) {
+      return helper::toBase32(getDistanceToObjectId());
+    }
+    return getVal();
+  }
+
+  [[nodiscard]] uint64_t getId() const
+  {
+    return mColumn->mRowMeta->objectIdGroup[mRow];
+  }
+
+  [[nodiscard]] uint64_t getObjectId() const
+  {
+    return mColumn->mRowMeta->objectId[mRow];
+  }
+
+  [[nodiscard]] uint64_t getParentId() const
+  {
+    return mColumn->mRowMeta->parentObjectId[mRow];
+  }
+
+  [[nodiscard]] uint64_t getTrackingId() const
+  {
+    return mColumn->mRowMeta->trackingId[mRow];
+  }
+
+  [[nodiscard]] uint64_t getDistanceToObjectId() const
+  {
+    return mColumn->mRowMeta->distanceToObjectId[mRow];
+  }
+
+  [[nodiscard]] bool isValid() const
+  {
+    return mColumn->mRowMeta->isValid[mRow] != 0;
+  }
+
+  [[nodiscard]] bool isNAN() const
+  {
+    return std::isnan(getVal()) || std::isinf(getVal());
+  }
+
+  [[nodiscard]] uint32_t getPosX() const
+  {
+    return mColumn->mRowMeta->posX[mRow];
+  }
+
+  [[nodiscard]] uint32_t getPosY() const
+  {
+    return mColumn->mRowMeta->posY[mRow];
+  }
+
+  [[nodiscard]] uint64_t getGroupId() const
+  {
+    return mColumn->mRowMeta->groupIdx[mRow];
+  }
+
+  [[nodiscard]] uint32_t getStackT() const
+  {
+    return mColumn->mRowMeta->tStack[mRow];
+  }
+
+  [[nodiscard]] uint32_t getStackZ() const
+  {
+    return mColumn->mRowMeta->zStack[mRow];
+  }
+
+  [[nodiscard]] uint32_t getStackC() const
+  {
+    return mColumn->mRowMeta->cStack[mRow];
+  }
+
+  [[nodiscard]] const std::string &getRowName() const
+  {
+    static const std::string empty;
+    return mRowName != nullptr ? *mRowName : empty;
+  }
+
+  [[nodiscard]] auto getFormatting() const -> TableCell::Formating
+  {
+    const auto flags = mColumn->mFlags[mRow];
+    return {.bgColor          = static_cast<TableCell::Formating::Color>((flags & TableColumn::BG_COLOR_MASK) >> TableColumn::BG_COLOR_SHIFT),
+            .isObjectId       = (flags & TableColumn::IS_OBJECT_ID) != 0,
+            .isParentObjectId = (flags & TableColumn::IS_PARENT_OBJECT_ID) != 0,
+            .isTrackingId     = (flags & TableColumn::IS_TRACKING_ID) != 0};
+  }
+
+  [[nodiscard]] auto toCell() const -> TableCell;
+
+private:
+  /////////////////////////////////////////////////////
+  const TableColumn *mColumn;
+  uint32_t mRow;
+  const std::string *mRowName;
+};
+
+inline auto TableColumn::at(uint32_t row) const -> TableCellRef
+{
+  if(!contains(row)) {
+    throw std::out_of_range("Table column has no cell in row >" + std::to_string(row) + "<.");
+  }
+  return {this, row};
+}
+
 using entry_t = std::map<uint32_t, TableColumn>;    // These are the different columns
 
 ///
@@ -250,7 +472,10 @@ public:
   Table(const Table &other)
   {
     mDataColOrganized = other.mDataColOrganized;
+    mRowMetaData      = other.mRowMetaData;
+    mRowNames         = other.mRowNames;
     mTitle            = other.mTitle;
+    detachRowMetaData();
   }
 
   Table &operator=(const Table &other)
@@ -259,7 +484,10 @@ public:
       return *this;
     }
     mDataColOrganized = other.mDataColOrganized;
+    mRowMetaData      = other.mRowMetaData;
+    mRowNames         = other.mRowNames;
     mTitle            = other.mTitle;
+    detachRowMetaData();
     return *this;
   }
 
@@ -277,52 +505,41 @@ public:
     return mDataColOrganized;
   }
 
-  [[nodiscard]] std::shared_ptr<const TableCell> data(uint32_t row, uint32_t col) const;
-  [[nodiscard]] std::shared_ptr<TableCell> mutableData(uint32_t row, uint32_t col);
+  [[nodiscard]] std::optional<TableCell> data(uint32_t row, uint32_t col) const;
+  void setRowGroup(uint32_t col, uint32_t rowGroup);
 
-  void setData(uint32_t row, uint32_t col, const std::shared_ptr<TableCell> &data)
+  void setData(uint32_t row, uint32_t col, const TableCell &data)
   {
-    mDataColOrganized[col].rows[row] = data;
+    mDataColOrganized[col].set(row, data);
+    if(!data.getRowName().empty()) {
+      setRowName(row, data.getRowName());
+    }
   }
 
-  void setData(uint32_t row, uint32_t col, const TableCell &data)
+  void setDataId(uint32_t row, uint32_t col, uint64_t id, const std::string &rowName)
   {
-    if(data.getRowName().empty()) {
-      if(mDataColOrganized[col].rows[row] != nullptr) {
-        const auto rowName               = mDataColOrganized[col].rows[row]->getRowName();
-        mDataColOrganized[col].rows[row] = std::make_shared<TableCell>(data);
-        mDataColOrganized[col].rows[row]->setRowName(rowName);
-      } else {
-        mDataColOrganized[col].rows[row] = std::make_shared<TableCell>(data);
-      }
-    } else {
-      mDataColOrganized[col].rows[row] = std::make_shared<TableCell>(data);
+    auto &column = mDataColOrganized[col];
+    if(!column.contains(row)) {
+      setRowName(row, rowName);
     }
+    column.setId(row, id);
   }
 
-  void setDataId(uint32_t row, uint32_t col, uint64_t id, const std::string &rowName)
+  void setRowName(uint32_t row, const std::string &rowName)
   {
-    if(mDataColOrganized[col].rows[row] == nullptr) {
-      mDataColOrganized[col].rows[row] = std::make_shared<TableCell>();
-      mDataColOrganized[col].rows[row]->setRowName(rowName);
+    if(row >= mRowNames.size()) {
+      mRowNames.resize(row + 1);
     }
-    mDataColOrganized[col].rows[row]->setId(id);
+    mRowNames[row] = rowName;
   }
+
   [[nodiscard]] uint32_t getNrOfRows() const
   {
-    if(mDataColOrganized.empty()) {
-      return 0;
-    }
     uint32_t nr = 0;
     for(const auto &col : mDataColOrganized) {
-      if(!col.second.rows.empty()) {
-        auto tmp = std::prev(col.second.rows.end())->first + 1;
-        if(tmp > nr) {
-          nr = tmp;
-        }
-      }
+      nr = std::max(nr, col.second.getNrOfRows());
     }
-    return static_cast<uint32_t>(nr);
+    return nr;
   }
 
   [[nodiscard]] uint16_t getNrOfCols() const
@@ -354,17 +571,10 @@ public:
   [[nodiscard]] const std::string &getRowHeader(uint32_t row) const
   {
     static std::string ret;
-    if(mDataColOrganized.empty()) {
+    if(row >= mRowNames.size()) {
       return ret;
     }
-    for(const auto &col : mDataColOrganized) {
-      if(col.second.rows.contains(row)) {
-        if(!col.second.rows.at(row)->getRowName().empty()) {
-          return col.second.rows.at(row)->getRowName();
-        }
-      }
-    }
-    return ret;
+    return mRowNames[row];
   }
 
   [[nodiscard]] const std::string &getTitle() const override
@@ -384,7 +594,12 @@ public:
 
 private:
   /////////////////////////////////////////////////////
-  entry_t mDataColOrganized;    // <ROW, <COL, DATA>>
+  void detachRowMetaData();
+
+  /////////////////////////////////////////////////////
+  entry_t mDataColOrganized;                                             // <COL, DATA>
+  std::map<uint32_t, std::shared_ptr<TableRowMetaData>> mRowMetaData;    // <ROW GROUP, META>
+  std::vector<std::string> mRowNames;                                    // Shared by all columns
   std::string mTitle;
   mutable std::mutex mAccessMutex;
 };
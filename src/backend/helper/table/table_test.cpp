@@ -0,0 +1,158 @@
+///
+/// \file      table_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <limits>
+#include <stdexcept>
+#include "backend/helper/table/table.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  Cells written to the columnar table are read back unchanged
+/// \author Joachim Danmayr
+///
+TEST_CASE("table::columnar", "[table]")
+{
+  joda::table::Table table;
+  joda::table::TableCell cell{4.5,
+                              {.objectIdGroup      = 1,
+                               .objectId           = 2,
+                               .parentObjectId     = 3,
+                               .trackingId         = 4,
+                               .distanceToObjectId = 5,
+                               .isValid            = true,
+                               .tStack             = 6,
+                               .zStack             = 7,
+                               .cStack             = 8,
+                               .rowName            = "image.tif"},
+                              {.groupIdx = 9, .posX = 10, .posY = 11}};
+  cell.setBackgroundColor(joda::table::TableCell::Formating::Color::ALTERNATE_1);
+  cell.setIsParentObjectIdCell(true);
+  table.setData(3, 2, cell);
+  table.setData(1, 0, joda::table::TableCell{-1.0, {.isValid = true}, {}});
+
+  SECTION("Size and empty cells")
+  {
+    CHECK(table.getNrOfRows() == 4);
+    CHECK(table.getNrOfCols() == 3);
+    CHECK_FALSE(table.data(0, 2).has_value());
+    CHECK_FALSE(table.data(3, 1).has_value());
+    CHECK_FALSE(table.data(7, 2).has_value());
+  }
+
+  SECTION("All fields are stored")
+  {
+    auto stored = table.data(3, 2);
+    REQUIRE(stored.has_value());
+    CHECK(stored->getVal() == 4.5);
+    CHECK(stored->getId() == 1);
+    CHECK(stored->getObjectId() == 2);
+    CHECK(stored->getParentId() == 3);
+    CHECK(stored->getTrackingId() == 4);
+    CHECK(stored->getDistanceToObjectId() == 5);
+    CHECK(stored->isValid());
+    CHECK(stored->getStackT() == 6);
+    CHECK(stored->getStackZ() == 7);
+    CHECK(stored->getStackC() == 8);
+    CHECK(stored->getGroupId() == 9);
+    CHECK(stored->getPosX() == 10);
+    CHECK(stored->getPosY() == 11);
+    CHECK(stored->getRowName() == "image.tif");
+    CHECK(stored->getFormatting().bgColor == joda::table::TableCell::Formating::Color::ALTERNATE_1);
+    CHECK(stored->getFormatting().isParentObjectId);
+    CHECK_FALSE(stored->getFormatting().isObjectId);
+
+    auto view = table.columns().at(2).at(3);
+    CHECK(view.getVal() == 4.5);
+    CHECK(view.getStackZ() == 7);
+    CHECK(view.toCell().getFormatting().isParentObjectId);
+  }
+
+  SECTION("Row names are shared by the columns")
+  {
+    table.setDataId(3, 2, 42, "other.tif");
+    CHECK(table.getRowHeader(3) == "image.tif");
+    CHECK(table.data(3, 2)->getId() == 42);
+    CHECK(table.data(3, 2)->getVal() == 4.5);
+    CHECK(table.data(1, 0)->getRowName().empty());
+    table.setDataId(5, 1, 43, "other.tif");
+    CHECK(table.getRowHeader(5) == "other.tif");
+    CHECK(table.data(5, 1)->isNAN());
+    CHECK(table.getRowHeader(4).empty());
+  }
+
+  SECTION("Min and max skip invalid and NaN cells")
+  {
+    table.setData(2, 2, joda::table::TableCell{100.0, {.isValid = false}, {}});
+    table.setData(0, 2, joda::table::TableCell{std::numeric_limits<double>::quiet_NaN(), {.isValid = true}, {}});
+    auto [min, max] = table.getMinMax(2);
+    CHECK(min == 4.5);
+    CHECK(max == 4.5);
+    CHECK(table.getMinMax().first == -1.0);
+  }
+
+  SECTION("Copies are independent")
+  {
+    joda::table::Table copy = table;
+    copy.setData(3, 2, joda::table::TableCell{1.0, {.objectId = 99, .isValid = true}, {}});
+    CHECK(table.data(3, 2)->getVal() == 4.5);
+    CHECK(table.data(3, 2)->getObjectId() == 2);
+    CHECK(copy.data(3, 2)->getVal() == 1.0);
+    CHECK(copy.data(3, 2)->getObjectId() == 99);
+    CHECK(copy.getRowHeader(3) == "image.tif");
+  }
+
+  SECTION("A cell copy stays valid if the table changes")
+  {
+    auto stored = table.data(3, 2);
+    table.clear();
+    REQUIRE(stored.has_value());
+    CHECK(stored->getVal() == 4.5);
+    CHECK(stored->getRowName() == "image.tif");
+  }
+}
+
+///
+/// \brief  Columns of one row group store the row meta data once
+/// \author Joachim Danmayr
+///
+TEST_CASE("table::row_group", "[table]")
+{
+  joda::table::Table table;
+  table.setRowGroup(0, 0);
+  table.setRowGroup(1, 0);
+  table.setRowGroup(2, 1);
+  table.setData(0, 0, joda::table::TableCell{1.0, {.objectId = 7, .trackingId = 3, .isValid = true}, {.posX = 4}});
+  table.setData(0, 1, joda::table::TableCell{2.0, {.objectId = 7, .trackingId = 3, .isValid = true}, {.posX = 4}});
+  table.setData(0, 2, joda::table::TableCell{3.0, {.objectId = 8, .isValid = false}, {}});
+
+  CHECK(table.data(0, 0)->getVal() == 1.0);
+  CHECK(table.data(0, 1)->getVal() == 2.0);
+  CHECK(table.data(0, 1)->getObjectId() == 7);
+  CHECK(table.data(0, 1)->getTrackingId() == 3);
+  CHECK(table.data(0, 1)->getPosX() == 4);
+  CHECK(table.data(0, 2)->getObjectId() == 8);
+  CHECK_FALSE(table.data(0, 2)->isValid());
+
+  table.setDataId(0, 1, 42, "");
+  CHECK(table.data(0, 0)->getId() == 42);
+  CHECK(table.data(0, 2)->getId() == 0);
+
+  joda::table::Table copy = table;
+  copy.setDataId(0, 0, 43, "");
+  CHECK(copy.data(0, 1)->getId() == 43);
+  CHECK(table.data(0, 1)->getId() == 42);
+
+  CHECK_THROWS_AS(table.setRowGroup(2, 0), std::invalid_argument);
+}
+
+}    // namespace joda::test
@@ -0,0 +1,145 @@
+///
+/// \file      stripe_parallel.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "stripe_parallel.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include "backend/helper/threading/task_scheduler.hpp"
+
+namespace joda::thread {
+
+namespace {
+
+///
+/// \brief      State shared between the caller and the helper tasks.
+///             Helpers which start after all stripes are claimed only touch
+///             this object, never the function of the caller.
+///
+struct SharedState
+{
+  const std::function<void(int32_t, int32_t)> *func = nullptr;
+  std::atomic<int32_t> nextStripe                   = 0;
+  int32_t nrOfStripes                               = 0;
+  int32_t stripeLength                              = 0;
+  int32_t length                                    = 0;
+
+  std::mutex lock;
+  std::condition_variable finished;
+  int32_t doneStripes = 0;
+  std::exception_ptr error;
+
+  void work()
+  {
+    int32_t stripe = 0;
+    while((stripe = nextStripe.fetch_add(1)) < nrOfStripes) {
+      const int32_t start = stripe * stripeLength;
+      const int32_t end   = std::min(length, start + stripeLength);
+      std::exception_ptr actError;
+      try {
+        (*func)(start, end);
+      } catch(...) {
+        actError = std::current_exception();
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      if(actError && !error) {
+        error = actError;
+      }
+      doneStripes++;
+      if(doneStripes == nrOfStripes) {
+        finished.notify_all();
+      }
+    }
+  }
+};
+
+}    // namespace
+
+///
+/// \brief      Thread pool helper tasks are submitted to.
+///             Without a thread pool all stripes are processed by the caller.
+/// \author     Joachim Danmayr
+///
+void StripeParallel::setThreadPool(BS::priority_thread_pool *pool)
+{
+  mThreadPool.store(pool);
+}
+
+///
+/// \brief      Number of pool workers which are neither running nor waiting for a task
+/// \author     Joachim Danmayr
+///
+auto StripeParallel::getIdleThreads() -> int32_t
+{
+  auto *pool = mThreadPool.load();
+  if(pool == nullptr) {
+    return 0;
+  }
+  const auto busy = static_cast<int64_t>(pool->get_tasks_running()) + static_cast<int64_t>(pool->get_tasks_queued());
+  return static_cast<int32_t>(std::max<int64_t>(0, static_cast<int64_t>(pool->get_thread_count()) - busy));
+}
+
+///
+/// \brief      Calls func for consecutive stripes of [0, length). Each stripe
+///             is processed exactly once, the call returns after all stripes
+///             are finished. The first exception thrown by func is rethrown.
+/// \author     Joachim Danmayr
+/// \param[in]  length           Number of lines to process
+/// \param[in]  minStripeLength  Min. number of lines of one stripe
+/// \param[in]  func             Function processing the lines [start, end)
+/// \param[in]  threadBudget     Max. threads (including the calling one) for this call,
+///                              0 = budget of the calling task, see ScopedThreadBudget
+///
+void StripeParallel::forEach(int32_t length, int32_t minStripeLength, const std::function<void(int32_t start, int32_t end)> &func,
+                             int32_t threadBudget)
+{
+  if(length <= 0) {
+    return;
+  }
+  minStripeLength = std::max(1, minStripeLength);
+  if(threadBudget <= 0) {
+    threadBudget = mThreadBudget;
+  }
+  int32_t nrOfThreads = getIdleThreads() + 1;
+  if(threadBudget > 0) {
+    nrOfThreads = std::min(nrOfThreads, threadBudget);
+  }
+  nrOfThreads = std::min(nrOfThreads, length / minStripeLength);
+  if(nrOfThreads <= 1) {
+    func(0, length);
+    return;
+  }
+
+  // More stripes than threads, so a thread which started late does not delay the end
+  const int32_t nrOfStripes = std::min(nrOfThreads * 4, length / minStripeLength);
+  auto state                = std::make_shared<SharedState>();
+  state->stripeLength       = (length + nrOfStripes - 1) / nrOfStripes;
+  state->nrOfStripes        = (length + state->stripeLength - 1) / state->stripeLength;
+  state->length             = length;
+  state->func               = &func;
+
+  auto *pool = mThreadPool.load();
+  for(int32_t n = 1; n < nrOfThreads; n++) {
+    // Helpers inherit the priority of the caller, a batch tile cannot delay a preview
+    TaskScheduler::detach(*pool, TaskScheduler::currentPriority(), [state]() { state->work(); });
+  }
+  state->work();
+
+  std::unique_lock<std::mutex> guard(state->lock);
+  state->finished.wait(guard, [&state]() { return state->doneStripes == state->nrOfStripes; });
+  if(state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+}    // namespace joda::thread
@@ -0,0 +1,73 @@
+///
+/// \file      stripe_parallel.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <BS_thread_pool.hpp>
+
+namespace joda::thread {
+
+///
+/// \class      StripeParallel
+/// \author     Joachim Danmayr
+/// \brief      Splits a range of lines (rows, columns, ...) into stripes and
+///             processes them in parallel with the idle workers of the global
+///             thread pool. The calling thread always takes part, so there is
+///             no deadlock if all workers are busy with other tiles. In this
+///             case the stripes are simply processed one after the other.
+///
+class StripeParallel
+{
+public:
+  ///
+  /// \class      ScopedThreadBudget
+  /// \author     Joachim Danmayr
+  /// \brief      Limits the threads of all forEach calls of the calling thread
+  ///             as long as the object lives, the previous budget is restored
+  ///             on destruction. Tasks running in parallel are not affected.
+  ///
+  class ScopedThreadBudget
+  {
+  public:
+    explicit ScopedThreadBudget(int32_t threads) : mPrevious(mThreadBudget)
+    {
+      mThreadBudget = std::max(0, threads);
+    }
+    ~ScopedThreadBudget()
+    {
+      mThreadBudget = mPrevious;
+    }
+    ScopedThreadBudget(const ScopedThreadBudget &)            = delete;
+    ScopedThreadBudget &operator=(const ScopedThreadBudget &) = delete;
+
+  private:
+    int32_t mPrevious;
+  };
+
+  /////////////////////////////////////////////////////
+  static void setThreadPool(BS::priority_thread_pool *pool);
+  static void forEach(int32_t length, int32_t minStripeLength, const std::function<void(int32_t start, int32_t end)> &func,
+                      int32_t threadBudget = 0);
+
+private:
+  /////////////////////////////////////////////////////
+  static auto getIdleThreads() -> int32_t;
+
+  /////////////////////////////////////////////////////
+  static inline std::atomic<BS::priority_thread_pool *> mThreadPool = nullptr;
+  static inline thread_local int32_t mThreadBudget                  = 0;    // Max. threads of the calling task, 0 = no limit
+};
+
+}    // namespace joda::thread
@@ -0,0 +1,181 @@
+///
+/// \file      stripe_parallel_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+/// \brief     Compares single and multi threaded execution of the
+///            stripe parallel filters. The results must be bit exact.
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "backend/commands/image_functions/blur/blur.hpp"
+#include "backend/commands/image_functions/rank_filter/rank_filter.hpp"
+#include "backend/commands/image_functions/rolling_ball/rolling_ball.hpp"
+#include "backend/commands/image_functions/watershed/watershed.hpp"
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <BS_thread_pool.hpp>
+
+namespace joda::test {
+
+namespace {
+
+///
+/// \brief  Noisy background with some bright spots
+///
+cv::Mat createTestImage()
+{
+  cv::Mat image(1024, 1024, CV_16UC1);
+  cv::RNG rng(42);
+  rng.fill(image, cv::RNG::NORMAL, 1000, 200);
+  for(int n = 0; n < 100; n++) {
+    cv::circle(image, {rng.uniform(0, image.cols), rng.uniform(0, image.rows)}, rng.uniform(2, 15), cv::Scalar(rng.uniform(3000, 60000)), -1);
+  }
+  return image;
+}
+
+bool isEqual(const cv::Mat &a, const cv::Mat &b)
+{
+  if(a.size() != b.size() || a.type() != b.type()) {
+    return false;
+  }
+  cv::Mat diff;
+  cv::compare(a, b, diff, cv::CMP_NE);
+  return cv::countNonZero(diff) == 0;
+}
+
+///
+/// \brief  Executes the filter once with one thread and once with all threads of the pool
+///
+void checkBitExact(const std::function<void(cv::Mat &)> &filter)
+{
+  const cv::Mat original = createTestImage();
+
+  cv::Mat singleThreaded = original.clone();
+  {
+    joda::thread::StripeParallel::ScopedThreadBudget budget(1);
+    filter(singleThreaded);
+  }
+
+  cv::Mat multiThreaded = original.clone();
+  filter(multiThreaded);
+
+  CHECK(isEqual(singleThreaded, multiThreaded));
+}
+
+///
+/// \brief  Helpers are submitted to the pool as long as the object lives
+///
+class ScopedThreadPool
+{
+public:
+  ScopedThreadPool() : mPool(std::max(1U, std::thread::hardware_concurrency() - 1))
+  {
+    joda::thread::StripeParallel::setThreadPool(&mPool);
+  }
+  ~ScopedThreadPool()
+  {
+    joda::thread::StripeParallel::setThreadPool(nullptr);
+  }
+
+private:
+  BS::priority_thread_pool mPool;
+};
+
+}    // namespace
+
+///
+/// \brief  Single and multi threaded filters must produce the same output
+/// \author Joachim Danmayr
+///
+TEST_CASE("threading::stripe_parallel", "[stripe_parallel]")
+{
+  ScopedThreadPool pool;
+
+  SECTION("All stripes are processed exactly once")
+  {
+    std::vector<int32_t> visited(10007, 0);
+    joda::thread::StripeParallel::forEach(static_cast<int32_t>(visited.size()), 7, [&visited](int32_t start, int32_t end) {
+      for(int32_t n = start; n < end; n++) {
+        visited[static_cast<size_t>(n)]++;
+      }
+    });
+    for(const auto cnt : visited) {
+      CHECK(cnt == 1);
+    }
+  }
+
+  SECTION("A thread budget of one processes all stripes in the calling thread")
+  {
+    joda::thread::StripeParallel::ScopedThreadBudget budget(1);
+    std::vector<std::thread::id> threads;
+    joda::thread::StripeParallel::forEach(10007, 7, [&threads](int32_t /*start*/, int32_t /*end*/) {
+      threads.push_back(std::this_thread::get_id());
+    });
+    REQUIRE(threads.size() == 1);
+    CHECK(threads[0] == std::this_thread::get_id());
+  }
+
+  SECTION("Rank filter median")
+  {
+    joda::settings::RankFilterSettings settings;
+    settings.mode   = joda::settings::RankFilterSettings::Mode::MEDIAN;
+    settings.radius = 5;
+    checkBitExact([&settings](cv::Mat &img) { joda::cmd::RankFilter(settings).execute(img); });
+  }
+
+  SECTION("Rank filter variance")
+  {
+    joda::settings::RankFilterSettings settings;
+    settings.mode   = joda::settings::RankFilterSettings::Mode::VARIANCE;
+    settings.radius = 3;
+    checkBitExact([&settings](cv::Mat &img) { joda::cmd::RankFilter(settings).execute(img); });
+  }
+
+  SECTION("Rolling ball")
+  {
+    joda::settings::RollingBallSettings settings;
+    settings.ballType = joda::settings::RollingBallSettings::BallType::BALL;
+    settings.ballSize = 50;
+    checkBitExact([&settings](cv::Mat &img) { joda::cmd::RollingBall(settings).execute(img); });
+  }
+
+  SECTION("Sliding paraboloid")
+  {
+    joda::settings::RollingBallSettings settings;
+    settings.ballType = joda::settings::RollingBallSettings::BallType::PARABOLOID;
+    settings.ballSize = 50;
+    checkBitExact([&settings](cv::Mat &img) { joda::cmd::RollingBall(settings).execute(img); });
+  }
+
+  SECTION("Blur more")
+  {
+    joda::settings::BlurSettings settings;
+    settings.mode       = joda::settings::BlurSettings::Mode::BLUR_MORE;
+    settings.kernelSize = 3;
+    checkBitExact([&settings](cv::Mat &img) { joda::cmd::Blur(settings).execute(img); });
+  }
+
+  SECTION("Watershed")
+  {
+    joda::settings::WatershedSettings settings;
+    settings.maximumFinderTolerance = 0.5F;
+    checkBitExact([&settings](cv::Mat &img) {
+      img.setTo(0, img < 2000);    // Only the spots are foreground
+      joda::cmd::Watershed(settings).execute(img);
+    });
+  }
+}
+
+}    // namespace joda::test
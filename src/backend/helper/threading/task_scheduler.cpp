@@ -0,0 +1,161 @@
+///
+/// \file      task_scheduler.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "task_scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <string>
+#include "backend/helper/logger/console_logger.hpp"
+
+namespace joda::thread {
+
+///
+/// \brief      Share of the workers (0..1] batch jobs may use while the user is editing
+/// \author     Joachim Danmayr
+///
+void TaskScheduler::setBatchShareWhileEditing(float share)
+{
+  mBatchShareWhileEditing.store(std::clamp(share, 0.0F, 1.0F));
+}
+
+///
+/// \brief      Called for each preview request of the pipeline editor
+/// \author     Joachim Danmayr
+///
+void TaskScheduler::userIsEditing()
+{
+  mLastEditTime.store(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+///
+/// \brief      Batch jobs may use all workers again, e.g. if the pipeline editor is closed
+/// \author     Joachim Danmayr
+///
+void TaskScheduler::userStoppedEditing()
+{
+  mLastEditTime.store(0);
+}
+
+///
+/// \brief      True if the last preview request is younger than the editing timeout
+/// \author     Joachim Danmayr
+///
+bool TaskScheduler::isUserEditing()
+{
+  const auto lastEditTime = mLastEditTime.load();
+  if(lastEditTime == 0) {
+    return false;
+  }
+  const auto lastEdit = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(lastEditTime));
+  return std::chrono::steady_clock::now() - lastEdit < EDITING_TIMEOUT;
+}
+
+///
+/// \brief      Number of work units a job may run in parallel
+/// \author     Joachim Danmayr
+/// \param[in]  nrOfThreads  Number of workers of the pool
+///
+auto TaskScheduler::getMaxBatchTasks(size_t nrOfThreads) -> size_t
+{
+  nrOfThreads = std::max<size_t>(1, nrOfThreads);
+  if(!isUserEditing()) {
+    return nrOfThreads;
+  }
+  const auto share = static_cast<size_t>(std::floor(static_cast<float>(nrOfThreads) * mBatchShareWhileEditing.load()));
+  return std::clamp<size_t>(share, 1, nrOfThreads);
+}
+
+///
+/// \brief
+/// \author     Joachim Danmayr
+/// \param[in]  pool  Pool the work units are executed in
+///
+BatchQueue::BatchQueue(BS::priority_thread_pool &pool) : mPool(pool)
+{
+}
+
+///
+/// \brief      Adds a work unit, it is started as soon as the batch share allows
+/// \author     Joachim Danmayr
+///
+void BatchQueue::push(std::function<void()> task)
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  mQueued.push_back(std::move(task));
+  dispatchLocked();
+}
+
+///
+/// \brief      Blocks until all work units are finished
+/// \author     Joachim Danmayr
+///
+void BatchQueue::wait()
+{
+  std::unique_lock<std::mutex> lock(mLock);
+  mFinished.wait(lock, [this]() { return mQueued.empty() && mRunning == 0; });
+}
+
+///
+/// \brief      Hands work units to the pool until the batch share is reached.
+///             A finished unit dispatches and notifies while holding the lock,
+///             so the queue is not touched anymore once wait returned.
+/// \author     Joachim Danmayr
+///
+void BatchQueue::dispatchLocked()
+{
+  const auto maxRunning = TaskScheduler::getMaxBatchTasks(mPool.get_thread_count());
+  while(mRunning < maxRunning && !mQueued.empty()) {
+    auto task = std::move(mQueued.front());
+    mQueued.pop_front();
+    mRunning++;
+    TaskScheduler::detach(mPool, TaskPriority::BATCH, [this, task = std::move(task)]() {
+      try {
+        task();
+      } catch(const std::exception &ex) {
+        joda::log::logWarning("Work unit failed. What: " + std::string(ex.what()));
+      }
+      std::lock_guard<std::mutex> lock(mLock);
+      mRunning--;
+      dispatchLocked();
+      mFinished.notify_all();
+    });
+  }
+}
+
+///
+/// \brief      Blocks until all tasks detached by this group are finished
+/// \author     Joachim Danmayr
+///
+void TaskGroup::wait()
+{
+  std::unique_lock<std::mutex> lock(mLock);
+  mFinished.wait(lock, [this]() { return mRunning == 0; });
+}
+
+void TaskGroup::taskFailed(const std::exception &ex)
+{
+  joda::log::logWarning("Background task failed. What: " + std::string(ex.what()));
+}
+
+///
+/// \brief      Notifies while holding the lock, so the group is not touched
+///             anymore once wait returned.
+/// \author     Joachim Danmayr
+///
+void TaskGroup::taskFinished()
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  mRunning--;
+  mFinished.notify_all();
+}
+
+}    // namespace joda::thread
@@ -0,0 +1,169 @@
+///
+/// \file      task_scheduler.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <BS_thread_pool.hpp>
+
+namespace joda::thread {
+
+///
+/// \brief      Priority classes of the tasks executed in the global thread pool.
+///             Queued tasks with a higher priority are started first, running
+///             tasks are never interrupted.
+/// \author     Joachim Danmayr
+///
+enum class TaskPriority : BS::priority_t
+{
+  BACKGROUND  = BS::pr::lowest,     // Database maintenance, e.g. statistics aggregates
+  BATCH       = BS::pr::low,        // Work units of a running job
+  METADATA    = BS::pr::high,       // Reading image meta data and thumbnails
+  INTERACTIVE = BS::pr::highest,    // Preview of the pipeline editor
+};
+
+///
+/// \class      TaskScheduler
+/// \author     Joachim Danmayr
+/// \brief      Submits tasks with a priority class to a thread pool. The priority
+///             of the task a worker executes is remembered, tasks it submits
+///             itself (e.g. StripeParallel helpers) inherit it. While the user
+///             is editing the pipeline, a BatchQueue only keeps the configured
+///             share of the workers busy, the others stay free for the preview.
+///
+class TaskScheduler
+{
+public:
+  /////////////////////////////////////////////////////
+  static void setBatchShareWhileEditing(float share);
+  static void userIsEditing();
+  static void userStoppedEditing();
+  [[nodiscard]] static bool isUserEditing();
+  [[nodiscard]] static auto getMaxBatchTasks(size_t nrOfThreads) -> size_t;
+
+  ///
+  /// \brief      Priority of the task the calling thread executes, threads
+  ///             outside the pool are interactive
+  ///
+  [[nodiscard]] static auto currentPriority() -> TaskPriority
+  {
+    return mCurrentPriority;
+  }
+
+  template <class FUNC>
+  static void detach(BS::priority_thread_pool &pool, TaskPriority priority, FUNC &&task)
+  {
+    pool.detach_task(withPriority(priority, std::forward<FUNC>(task)), static_cast<BS::priority_t>(priority));
+  }
+
+  template <class FUNC>
+  static auto submit(BS::priority_thread_pool &pool, TaskPriority priority, FUNC &&task)
+  {
+    return pool.submit_task(withPriority(priority, std::forward<FUNC>(task)), static_cast<BS::priority_t>(priority));
+  }
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr std::chrono::seconds EDITING_TIMEOUT{30};    // The user is editing as long as the last preview is younger
+
+  template <class FUNC>
+  static auto withPriority(TaskPriority priority, FUNC &&task)
+  {
+    return [priority, task = std::forward<FUNC>(task)]() mutable {
+      mCurrentPriority = priority;
+      return task();
+    };
+  }
+
+  /////////////////////////////////////////////////////
+  static inline thread_local TaskPriority mCurrentPriority = TaskPriority::INTERACTIVE;
+  static inline std::atomic<float> mBatchShareWhileEditing = 0.5F;
+  static inline std::atomic<int64_t> mLastEditTime         = 0;    // steady_clock ticks of the last preview, 0 = never
+};
+
+///
+/// \class      BatchQueue
+/// \author     Joachim Danmayr
+/// \brief      Work units of a job. Only as many units are handed to the pool as
+///             TaskScheduler::getMaxBatchTasks allows, each finished unit hands
+///             over the next one. Interactive tasks submitted meanwhile therefore
+///             find a free worker or start at the next task boundary.
+///
+class BatchQueue
+{
+public:
+  /////////////////////////////////////////////////////
+  explicit BatchQueue(BS::priority_thread_pool &pool);
+  void push(std::function<void()> task);
+  void wait();
+
+private:
+  /////////////////////////////////////////////////////
+  void dispatchLocked();
+
+  /////////////////////////////////////////////////////
+  BS::priority_thread_pool &mPool;
+  std::mutex mLock;
+  std::condition_variable mFinished;
+  std::deque<std::function<void()>> mQueued;
+  size_t mRunning = 0;    // Units handed to the pool and not finished yet
+};
+
+///
+/// \class      TaskGroup
+/// \author     Joachim Danmayr
+/// \brief      Tasks a job detaches to the pool which access the job, e.g. the
+///             statistics of a finished image. The job waits for its own tasks
+///             before it is finished, not for all tasks of the shared pool.
+///
+class TaskGroup
+{
+public:
+  /////////////////////////////////////////////////////
+  template <class FUNC>
+  void detach(BS::priority_thread_pool &pool, TaskPriority priority, FUNC &&task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mLock);
+      mRunning++;
+    }
+    TaskScheduler::detach(pool, priority, [this, task = std::forward<FUNC>(task)]() mutable {
+      try {
+        task();
+      } catch(const std::exception &ex) {
+        taskFailed(ex);
+      }
+      taskFinished();
+    });
+  }
+  void wait();
+
+private:
+  /////////////////////////////////////////////////////
+  static void taskFailed(const std::exception &ex);
+  void taskFinished();
+
+  /////////////////////////////////////////////////////
+  std::mutex mLock;
+  std::condition_variable mFinished;
+  size_t mRunning = 0;    // Detached tasks not finished yet
+};
+
+}    // namespace joda::thread
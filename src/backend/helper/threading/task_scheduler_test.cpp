@@ -0,0 +1,143 @@
+///
+/// \file      task_scheduler_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include "backend/helper/threading/task_scheduler.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <BS_thread_pool.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  While the user is editing, a job only uses its share of the workers
+/// \author Joachim Danmayr
+///
+TEST_CASE("task_scheduler::batch_share", "[task_scheduler]")
+{
+  using namespace std::chrono_literals;
+  BS::priority_thread_pool pool(8);
+  thread::TaskScheduler::setBatchShareWhileEditing(0.25F);
+  thread::TaskScheduler::userIsEditing();
+  CHECK(thread::TaskScheduler::getMaxBatchTasks(8) == 2);
+  CHECK(thread::TaskScheduler::getMaxBatchTasks(1) == 1);
+
+  std::atomic<int32_t> running    = 0;
+  std::atomic<int32_t> maxRunning = 0;
+  std::atomic<int32_t> finished   = 0;
+  std::atomic<bool> inheritedPriority{true};
+  {
+    thread::BatchQueue queue(pool);
+    for(int n = 0; n < 32; n++) {
+      queue.push([&]() {
+        const auto actRunning = ++running;
+        int32_t expected      = maxRunning.load();
+        while(actRunning > expected && !maxRunning.compare_exchange_weak(expected, actRunning)) {
+        }
+        if(thread::TaskScheduler::currentPriority() != thread::TaskPriority::BATCH) {
+          inheritedPriority = false;
+        }
+        std::this_thread::sleep_for(2ms);
+        --running;
+        ++finished;
+      });
+    }
+    queue.wait();
+  }
+  CHECK(finished == 32);
+  CHECK(maxRunning <= 2);
+  CHECK(inheritedPriority);
+
+  auto preview = thread::TaskScheduler::submit(pool, thread::TaskPriority::INTERACTIVE, []() { return thread::TaskScheduler::currentPriority(); });
+  CHECK(preview.get() == thread::TaskPriority::INTERACTIVE);
+
+  // Editing state is shared by the whole process
+  thread::TaskScheduler::userStoppedEditing();
+  thread::TaskScheduler::setBatchShareWhileEditing(0.5F);
+  CHECK_FALSE(thread::TaskScheduler::isUserEditing());
+  CHECK(thread::TaskScheduler::getMaxBatchTasks(8) == 8);
+}
+
+///
+/// \brief  Interactive work is started before batch work which was queued earlier
+/// \author Joachim Danmayr
+///
+TEST_CASE("task_scheduler::interactive_first", "[task_scheduler]")
+{
+  BS::priority_thread_pool pool(2);
+  std::promise<void> releaseFirst;
+  std::promise<void> releaseSecond;
+  std::atomic<int32_t> nrOfBlockedWorkers = 0;
+  auto block = [&nrOfBlockedWorkers](std::shared_future<void> release) {
+    return [&nrOfBlockedWorkers, release]() {
+      ++nrOfBlockedWorkers;
+      release.wait();
+    };
+  };
+  thread::TaskScheduler::detach(pool, thread::TaskPriority::BATCH, block(releaseFirst.get_future().share()));
+  thread::TaskScheduler::detach(pool, thread::TaskPriority::BATCH, block(releaseSecond.get_future().share()));
+  while(nrOfBlockedWorkers < 2) {
+    std::this_thread::yield();
+  }
+
+  std::atomic<int32_t> nrOfStartedBatchTasks = 0;
+  thread::BatchQueue queue(pool);
+  for(int n = 0; n < 8; n++) {
+    queue.push([&nrOfStartedBatchTasks]() { ++nrOfStartedBatchTasks; });
+  }
+  auto preview = thread::TaskScheduler::submit(pool, thread::TaskPriority::INTERACTIVE, [&nrOfStartedBatchTasks]() {
+    return nrOfStartedBatchTasks.load();
+  });
+
+  // Only one worker gets free, it must pick the preview although the batch work is older
+  releaseFirst.set_value();
+  CHECK(preview.get() == 0);
+  releaseSecond.set_value();
+  queue.wait();
+  pool.wait();
+  CHECK(nrOfStartedBatchTasks == 8);
+}
+
+///
+/// \brief  A task group waits for its own tasks only
+/// \author Joachim Danmayr
+///
+TEST_CASE("task_scheduler::task_group", "[task_scheduler]")
+{
+  using namespace std::chrono_literals;
+  BS::priority_thread_pool pool(4);
+  std::promise<void> release;
+  thread::TaskScheduler::detach(pool, thread::TaskPriority::BACKGROUND, [blocker = release.get_future().share()]() { blocker.wait(); });
+
+  std::atomic<int32_t> finished = 0;
+  {
+    thread::TaskGroup group;
+    for(int n = 0; n < 16; n++) {
+      group.detach(pool, thread::TaskPriority::BACKGROUND, [&finished, n]() {
+        std::this_thread::sleep_for(1ms);
+        if(n == 0) {
+          throw std::runtime_error("Failing tasks are finished too");
+        }
+        ++finished;
+      });
+    }
+    group.wait();
+    CHECK(finished == 15);
+  }
+  release.set_value();
+  pool.wait();
+}
+
+}    // namespace joda::test
@@ -0,0 +1,296 @@
+///
+/// \file      trace.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "trace.hpp"
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include "backend/helper/logger/console_logger.hpp"
+#include <nlohmann/json.hpp>
+
+namespace joda::trace {
+
+namespace {
+
+std::mutex &registryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Index 0 is reserved for "no span"
+std::vector<std::string> &spanNames()
+{
+  static std::vector<std::string> names{""};
+  return names;
+}
+
+std::unordered_map<std::string, SpanId> &spanIds()
+{
+  static std::unordered_map<std::string, SpanId> ids;
+  return ids;
+}
+
+thread_local Attributes actualAttributes;
+
+}    // namespace
+
+///
+/// \brief      Interns a span name. Call once and keep the id in a static.
+/// \author     Joachim Danmayr
+/// \param[in]  name  Name of the span
+/// \return     Id of the span
+///
+SpanId Tracer::registerSpan(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto it = spanIds().find(name);
+  if(it != spanIds().end()) {
+    return it->second;
+  }
+  auto id = static_cast<SpanId>(spanNames().size());
+  spanNames().emplace_back(name);
+  spanIds().emplace(name, id);
+  return id;
+}
+
+///
+/// \brief      Interns the name of a type. A per thread cache is used, so the
+///             registry lock is only taken the first time a thread sees a type.
+/// \author     Joachim Danmayr
+/// \param[in]  type  Type to register
+/// \return     Id of the span
+///
+SpanId Tracer::registerType(const std::type_info &type)
+{
+  thread_local std::unordered_map<std::type_index, SpanId> cache;
+  auto it = cache.find(std::type_index(type));
+  if(it != cache.end()) {
+    return it->second;
+  }
+  auto id = registerSpan(type.name());
+  cache.emplace(std::type_index(type), id);
+  return id;
+}
+
+///
+/// \brief      Starts recording. Events of a previous recording are discarded.
+/// \author     Joachim Danmayr
+///
+void Tracer::start()
+{
+  mStartTime = std::chrono::steady_clock::now();
+  mEpoch.fetch_add(1);
+  mEnabled.store(true);
+}
+
+///
+/// \brief      Stops recording and waits for threads still recording a span.
+///             The events are moved out of the thread buffers, the buffers
+///             do not keep any memory afterwards.
+/// \author     Joachim Danmayr
+/// \return     Events of the recording
+///
+auto Tracer::stop() -> Recording
+{
+  mEnabled.store(false);
+  while(mActiveRecords.load() > 0) {
+    std::this_thread::yield();
+  }
+
+  Recording recording;
+  const auto epoch = mEpoch.load();
+  std::lock_guard<std::mutex> lock(mBuffersMutex);
+  for(const auto &buffer : mBuffers) {
+    if(buffer->epoch.load() == epoch && buffer->size.load() > 0) {
+      recording.threads.push_back(
+          {.threadIdx = buffer->threadIdx, .size = buffer->size.load(), .dropped = buffer->dropped.load(), .chunks = std::move(buffer->chunks)});
+    }
+    buffer->chunks.clear();
+    buffer->chunks.shrink_to_fit();
+    buffer->size.store(0);
+    buffer->dropped.store(0);
+  }
+  return recording;
+}
+
+///
+/// \brief      Nanoseconds since start
+/// \author     Joachim Danmayr
+///
+uint64_t Tracer::now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStartTime).count());
+}
+
+///
+/// \brief      Buffer of the calling thread. Each thread registers its buffer
+///             once in the global list, afterwards no lock is needed.
+/// \author     Joachim Danmayr
+///
+Tracer::ThreadBuffer &Tracer::threadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto newBuffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(mBuffersMutex);
+    newBuffer->threadIdx = static_cast<uint32_t>(mBuffers.size());
+    mBuffers.emplace_back(newBuffer);
+    return newBuffer;
+  }();
+  return *buffer;
+}
+
+///
+/// \brief      Appends a finished span to the buffer of the calling thread
+/// \author     Joachim Danmayr
+///
+void Tracer::record(SpanId span, SpanId command, uint64_t startNs, uint64_t endNs)
+{
+  // stop() waits until no thread is within this function anymore
+  mActiveRecords.fetch_add(1);
+  if(!mEnabled.load()) {
+    mActiveRecords.fetch_sub(1);
+    return;
+  }
+
+  auto &buffer     = threadBuffer();
+  const auto epoch = mEpoch.load(std::memory_order_relaxed);
+  if(buffer.epoch.load(std::memory_order_relaxed) != epoch) {
+    buffer.epoch.store(epoch, std::memory_order_relaxed);
+    buffer.size.store(0, std::memory_order_relaxed);
+    buffer.dropped.store(0, std::memory_order_relaxed);
+  }
+  const size_t idx = buffer.size.load(std::memory_order_relaxed);
+  if(idx >= MAX_EVENTS_PER_THREAD) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    const size_t chunk = idx / CHUNK_SIZE;
+    if(chunk >= buffer.chunks.size()) {
+      buffer.chunks.emplace_back(std::make_unique<Event[]>(CHUNK_SIZE));
+    }
+    buffer.chunks[chunk][idx % CHUNK_SIZE] =
+        Event{.span = span, .command = command, .startNs = startNs, .durationNs = endNs - startNs, .attributes = actualAttributes};
+    buffer.size.store(idx + 1, std::memory_order_release);
+  }
+  mActiveRecords.fetch_sub(1);
+}
+
+///
+/// \brief      Name of an interned span
+/// \author     Joachim Danmayr
+///
+auto Tracer::spanName(SpanId span) -> std::string
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  if(span < spanNames().size()) {
+    return spanNames()[span];
+  }
+  return "";
+}
+
+///
+/// \brief      Count and total duration per span name of a recording
+/// \author     Joachim Danmayr
+///
+auto Tracer::aggregate(const Recording &recording) -> std::map<std::string, Stats>
+{
+  std::map<SpanId, Stats> perSpan;
+  for(const auto &thread : recording.threads) {
+    for(size_t idx = 0; idx < thread.size; idx++) {
+      const auto &event = thread.chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE];
+      auto &stats       = perSpan[event.span];
+      stats.cnt++;
+      stats.totalNs += event.durationNs;
+    }
+  }
+  std::map<std::string, Stats> result;
+  for(const auto &[span, stats] : perSpan) {
+    result[spanName(span)] = stats;
+  }
+  return result;
+}
+
+///
+/// \brief      Writes the recorded spans as Chrome trace event JSON which can be
+///             opened with Perfetto (ui.perfetto.dev) or chrome://tracing.
+/// \author     Joachim Danmayr
+/// \param[in]  recording   Events returned by stop()
+/// \param[in]  outputFile  Path of the JSON file to write
+///
+void Tracer::exportChromeTrace(const Recording &recording, const std::filesystem::path &outputFile)
+{
+  std::ofstream out(outputFile);
+  if(!out.is_open()) {
+    joda::log::logWarning("Could not write trace to >" + outputFile.string() + "<.");
+    return;
+  }
+
+  std::unordered_map<SpanId, std::string> names;
+  auto nameOf = [&names](SpanId span) -> const std::string & {
+    auto it = names.find(span);
+    if(it == names.end()) {
+      it = names.emplace(span, nlohmann::json(spanName(span)).dump()).first;    // Quoted and escaped
+    }
+    return it->second;
+  };
+
+  bool first = true;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for(const auto &thread : recording.threads) {
+    if(!first) {
+      out << ",\n";
+    }
+    first = false;
+    out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread.threadIdx << R"(,"args":{"name":"worker )" << thread.threadIdx
+        << "\"}}";
+
+    for(size_t idx = 0; idx < thread.size; idx++) {
+      const auto &event = thread.chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE];
+      const auto &attr  = event.attributes;
+      out << ",\n{\"name\":" << nameOf(event.span) << R"(,"cat":"imagec","ph":"X","pid":1,"tid":)" << thread.threadIdx
+          << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0 << ",\"dur\":" << static_cast<double>(event.durationNs) / 1000.0
+          << ",\"args\":{\"image\":" << attr.imageId << ",\"tileX\":" << attr.tileX << ",\"tileY\":" << attr.tileY << ",\"t\":" << attr.tStack
+          << ",\"z\":" << attr.zStack << ",\"pipeline\":" << attr.pipelineIndex;
+      if(event.command != 0) {
+        out << ",\"command\":" << nameOf(event.command);
+      }
+      out << "}}";
+    }
+    if(thread.dropped > 0) {
+      joda::log::logWarning("Trace buffer of thread " + std::to_string(thread.threadIdx) + " full, dropped " +
+                            std::to_string(thread.dropped) + " events.");
+    }
+  }
+  out << "\n]}\n";
+}
+
+///
+/// \brief      Sets the thread attributes and remembers the previous ones
+/// \author     Joachim Danmayr
+///
+ScopedAttributes::ScopedAttributes(const Attributes &attributes) : mPrevious(actualAttributes)
+{
+  actualAttributes = attributes;
+}
+
+ScopedAttributes::~ScopedAttributes()
+{
+  actualAttributes = mPrevious;
+}
+
+auto ScopedAttributes::actual() -> const Attributes &
+{
+  return actualAttributes;
+}
+
+}    // namespace joda::trace
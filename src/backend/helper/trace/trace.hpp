@@ -0,0 +1,184 @@
+///
+/// \file      trace.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace joda::trace {
+
+using SpanId = uint32_t;
+
+///
+/// \brief      Attributes attached to each span recorded on the actual thread.
+///             Set by the processor with ScopedAttributes.
+///
+struct Attributes
+{
+  uint64_t imageId      = 0;
+  int32_t tileX         = -1;
+  int32_t tileY         = -1;
+  int32_t tStack        = -1;
+  int32_t zStack        = -1;
+  int32_t pipelineIndex = -1;
+};
+
+///
+/// \brief      One recorded span
+///
+struct Event
+{
+  SpanId span         = 0;
+  SpanId command      = 0;    // Interned command type, 0 if not executed within a command
+  uint64_t startNs    = 0;    // Nanoseconds since Tracer::start
+  uint64_t durationNs = 0;
+  Attributes attributes;
+};
+
+///
+/// \class      Tracer
+/// \author     Joachim Danmayr
+/// \brief      Low overhead tracing. Span names are interned once, each thread
+///             writes to its own buffer without locking. stop() waits for spans
+///             being recorded and moves the events out of the thread buffers,
+///             so no memory is kept between two recordings.
+///
+class Tracer
+{
+public:
+  /////////////////////////////////////////////////////
+  struct Stats
+  {
+    int64_t cnt      = 0;
+    uint64_t totalNs = 0;
+  };
+
+  struct Recording
+  {
+    struct Thread
+    {
+      uint32_t threadIdx = 0;
+      size_t size        = 0;
+      size_t dropped     = 0;
+      std::vector<std::unique_ptr<Event[]>> chunks;
+    };
+    std::vector<Thread> threads;
+  };
+
+  /////////////////////////////////////////////////////
+  static SpanId registerSpan(const std::string &name);
+  static SpanId registerType(const std::type_info &type);
+  static void start();
+  static auto stop() -> Recording;
+  static bool isEnabled()
+  {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+  static uint64_t now();
+  static void record(SpanId span, SpanId command, uint64_t startNs, uint64_t endNs);
+  static auto aggregate(const Recording &recording) -> std::map<std::string, Stats>;
+  static void exportChromeTrace(const Recording &recording, const std::filesystem::path &outputFile);
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr size_t CHUNK_SIZE            = 4096;
+  static constexpr size_t MAX_EVENTS_PER_THREAD = 1U << 20U;
+
+  struct ThreadBuffer
+  {
+    uint32_t threadIdx          = 0;
+    std::atomic<uint32_t> epoch = 0;
+    std::vector<std::unique_ptr<Event[]>> chunks;
+    std::atomic<size_t> size    = 0;
+    std::atomic<size_t> dropped = 0;
+  };
+
+  /////////////////////////////////////////////////////
+  static ThreadBuffer &threadBuffer();
+  static auto spanName(SpanId span) -> std::string;
+
+  static inline std::mutex mBuffersMutex;
+  static inline std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+  static inline std::atomic<bool> mEnabled          = false;
+  static inline std::atomic<uint32_t> mEpoch        = 0;
+  static inline std::atomic<int32_t> mActiveRecords = 0;    // Threads within record()
+  static inline std::chrono::steady_clock::time_point mStartTime;
+};
+
+///
+/// \class      ScopedAttributes
+/// \author     Joachim Danmayr
+/// \brief      Sets the attributes of all spans recorded on this thread for
+///             the lifetime of the object.
+///
+class ScopedAttributes
+{
+public:
+  explicit ScopedAttributes(const Attributes &attributes);
+  ~ScopedAttributes();
+  ScopedAttributes(const ScopedAttributes &)            = delete;
+  ScopedAttributes &operator=(const ScopedAttributes &) = delete;
+
+  static auto actual() -> const Attributes &;
+
+private:
+  Attributes mPrevious;
+};
+
+///
+/// \class      Span
+/// \author     Joachim Danmayr
+/// \brief      Records the duration between construction and destruction.
+///             Does nothing but one atomic load if tracing is disabled.
+///
+class Span
+{
+public:
+  explicit Span(SpanId span, SpanId command = 0) : mSpan(span), mCommand(command), mActive(Tracer::isEnabled())
+  {
+    if(mActive) {
+      mStartNs = Tracer::now();
+    }
+  }
+
+  ~Span()
+  {
+    stop();
+  }
+
+  Span(const Span &)            = delete;
+  Span &operator=(const Span &) = delete;
+
+  void stop()
+  {
+    if(mActive) {
+      mActive = false;
+      Tracer::record(mSpan, mCommand, mStartNs, Tracer::now());
+    }
+  }
+
+private:
+  SpanId mSpan;
+  SpanId mCommand;
+  uint64_t mStartNs = 0;
+  bool mActive;
+};
+
+}    // namespace joda::trace
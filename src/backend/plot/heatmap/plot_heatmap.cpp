@@ -69,10 +69,10 @@ auto Heatmap::plot(const Size &size) -> cv::Mat
   // =========================================
   for(uint32_t col = 0; col < nrCols; col++) {
     for(uint32_t row = 0; row < nrRows; row++) {
-      const auto &tmpData = mData.data(row, col);
-      double val          = std::numeric_limits<double>::quiet_NaN();
-      bool isValid        = false;
-      if(tmpData != nullptr) {
+      const auto tmpData = mData.data(row, col);
+      double val         = std::numeric_limits<double>::quiet_NaN();
+      bool isValid       = false;
+      if(tmpData.has_value()) {
         val     = tmpData->getVal();
         isValid = tmpData->isValid();
       }
@@ -331,8 +331,8 @@ auto Heatmap::getCellFromCoordinates(double x, double y) const -> std::optional<
   auto col        = static_cast<int32_t>(x / mRectWidth);
   if(row >= 0 && row < static_cast<int32_t>(nrRows) && col >= 0 && col < static_cast<int32_t>(nrCols)) {
     auto data = mData.data(static_cast<uint32_t>(row), static_cast<uint32_t>(col));
-    if(data != nullptr) {
-      return std::tuple<Cell, joda::table::TableCell>{Cell{col, row}, *mData.data(static_cast<uint32_t>(row), static_cast<uint32_t>(col))};
+    if(data.has_value()) {
+      return std::tuple<Cell, joda::table::TableCell>{Cell{col, row}, *data};
     } else {
       return std::tuple<Cell, joda::table::TableCell>{Cell{col, row}, {}};
     }
@@ -0,0 +1,434 @@
+///
+/// \file      pipeline_cache.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "pipeline_cache.hpp"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <utility>
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/enums/enums_file_endians.hpp"
+#include "backend/helper/cereal_cv_mat.hpp"
+#include "backend/helper/fnv1a.hpp"
+#include "backend/helper/logger/console_logger.hpp"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/map.hpp>
+#include <cereal/types/tuple.hpp>
+#include <nlohmann/json.hpp>
+#include "version.h"
+
+namespace joda::processor {
+
+namespace {
+
+///
+/// \brief      Size and modification time of a file, 0 if the file does not exist
+///
+uint64_t calcFileStamp(const std::filesystem::path &file)
+{
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(file, ec);
+  if(ec) {
+    return 0;
+  }
+  const auto modified = std::filesystem::last_write_time(file, ec);
+  if(ec) {
+    return 0;
+  }
+  return helper::combineFnv1a(helper::combineFnv1a(helper::FNV_OFFSET_BASIS, size), static_cast<uint64_t>(modified.time_since_epoch().count()));
+}
+
+///
+/// \brief      Model file of a step, empty if the step does not load a model
+///
+std::filesystem::path getModelPath(const settings::PipelineStep &step)
+{
+  if(step.$aiClassify.has_value()) {
+    return step.$aiClassify->modelPath;
+  }
+  if(step.$pixelClassify.has_value()) {
+    return step.$pixelClassify->modelPath;
+  }
+  return {};
+}
+
+struct Checkpoint
+{
+  std::filesystem::path path;
+  std::filesystem::file_time_type modified;
+  uint64_t size = 0;
+};
+
+///
+/// \brief      True for checkpoint files and for the temporary files they are written to.
+///             The file with the IDs is not a checkpoint.
+///
+bool isCheckpointFile(const std::filesystem::path &file, bool includeTemporary)
+{
+  if(file.filename() == joda::fs::FILE_NAME_CACHE_IDS + joda::fs::EXT_PIPELINE_CACHE) {
+    return false;
+  }
+  if(file.extension() == joda::fs::EXT_PIPELINE_CACHE) {
+    return true;
+  }
+  return includeTemporary && file.extension() == ".tmp" && file.stem().extension() == joda::fs::EXT_PIPELINE_CACHE;
+}
+
+///
+/// \brief      All checkpoints stored in the cache folder
+///
+auto listCheckpoints(const std::filesystem::path &cacheFolder) -> std::vector<Checkpoint>
+{
+  std::vector<Checkpoint> checkpoints;
+  std::error_code ec;
+  for(const auto &entry : std::filesystem::directory_iterator(cacheFolder, ec)) {
+    std::error_code entryEc;
+    if(!entry.is_regular_file(entryEc) || !isCheckpointFile(entry.path(), false)) {
+      continue;
+    }
+    const auto size     = entry.file_size(entryEc);
+    const auto modified = entry.last_write_time(entryEc);
+    if(!entryEc) {
+      checkpoints.push_back({.path = entry.path(), .modified = modified, .size = size});
+    }
+  }
+  return checkpoints;
+}
+
+}    // namespace
+
+///
+/// \brief      Opens the cache in the given folder. New object and tracking IDs are
+///             generated after the ones stored in the cache, so restored objects
+///             never collide with newly created ones.
+/// \author     Joachim Danmayr
+/// \param[in]  cacheFolder  Folder the checkpoints are stored in
+/// \param[in]  maxSize      Maximum size of all checkpoints in bytes
+///
+PipelineCache::PipelineCache(const std::filesystem::path &cacheFolder, uint64_t maxSize) : mCacheFolder(cacheFolder), mMaxSize(maxSize)
+{
+  std::filesystem::create_directories(mCacheFolder);
+  const auto idsFile = mCacheFolder / (joda::fs::FILE_NAME_CACHE_IDS + joda::fs::EXT_PIPELINE_CACHE);
+  if(std::filesystem::exists(idsFile)) {
+    try {
+      std::ifstream is(idsFile.string(), std::ios::binary);
+      cereal::BinaryInputArchive archive(is);
+      archive(mLastObjectId, mLastTrackingId);
+    } catch(const std::exception &ex) {
+      // Without the IDs, restored objects could get the same IDs as new ones
+      joda::log::logWarning("Could not read pipeline cache IDs, cache is cleared. what: " + std::string(ex.what()));
+      std::filesystem::remove_all(mCacheFolder);
+      std::filesystem::create_directories(mCacheFolder);
+      mLastObjectId   = 0;
+      mLastTrackingId = 0;
+    }
+  }
+  joda::atom::ROI::continueIdsAfter(mLastObjectId, mLastTrackingId);
+
+  std::lock_guard<std::mutex> lock(mSizeLock);
+  for(const auto &checkpoint : listCheckpoints(mCacheFolder)) {
+    mSize += checkpoint.size;
+  }
+  if(mSize > mMaxSize) {
+    evict(mMaxSize / 4 * 3);
+  }
+}
+
+///
+/// \brief      Folder the checkpoints of the images in the given folder are stored in
+/// \author     Joachim Danmayr
+///
+auto PipelineCache::getCacheFolder(const std::filesystem::path &imageFolder) -> std::filesystem::path
+{
+  return imageFolder / joda::fs::WORKING_DIRECTORY_PROJECT_PATH / joda::fs::WORKING_DIRECTORY_CACHE_PATH;
+}
+
+///
+/// \brief      Removes all checkpoints from the cache folder. The highest stored IDs are
+///             kept, other files in the cache folder are not touched.
+/// \author     Joachim Danmayr
+/// \param[in]  cacheFolder  Folder the checkpoints are stored in
+///
+void PipelineCache::clear(const std::filesystem::path &cacheFolder)
+{
+  std::error_code ec;
+  for(const auto &entry : std::filesystem::directory_iterator(cacheFolder, ec)) {
+    if(isCheckpointFile(entry.path(), true)) {
+      std::error_code removeEc;
+      std::filesystem::remove(entry.path(), removeEc);
+    }
+  }
+}
+
+///
+/// \brief      Key of a tile before the first pipeline was executed
+/// \author     Joachim Danmayr
+/// \param[in]  settings        Analyze settings
+/// \param[in]  imagePath       Image the tile is part of
+/// \param[in]  annotationPath  Manual annotations of the image, they are part of the object list
+/// \return     Start of the key chain
+///
+auto PipelineCache::calcTileKey(const settings::AnalyzeSettings &settings, const std::filesystem::path &imagePath,
+                                const std::filesystem::path &annotationPath, const enums::tile_t &tile, int32_t tStack, int32_t zStack) -> uint64_t
+{
+  nlohmann::json json;
+  json["imageSetup"]    = settings.imageSetup;
+  json["realSizesUnit"] = settings.pipelineSetup.realSizesUnit;
+  json["image"]         = imagePath.string();
+  json["version"]       = Version::getVersion();
+
+  auto key = helper::calcFnv1a(json.dump());
+  key      = helper::combineFnv1a(key, CACHE_FORMAT_VERSION);
+  key      = helper::combineFnv1a(key, calcFileStamp(imagePath));
+  key      = helper::combineFnv1a(key, calcFileStamp(annotationPath));
+  key      = helper::combineFnv1a(key, static_cast<uint32_t>(std::get<0>(tile)));
+  key      = helper::combineFnv1a(key, static_cast<uint32_t>(std::get<1>(tile)));
+  key      = helper::combineFnv1a(key, static_cast<uint32_t>(tStack));
+  key      = helper::combineFnv1a(key, static_cast<uint32_t>(zStack));
+  return key;
+}
+
+///
+/// \brief      Keys of the states of a pipeline. The first key is the state after the
+///             pipeline was initialized, key i + 1 is the state after step i.
+/// \author     Joachim Danmayr
+/// \param[in]  pipeline          Pipeline to calculate the keys for
+/// \param[in]  previousKey       Last key of the pipeline executed before or the tile key
+/// \param[in]  workingDirectory  Model paths of the steps are relative to this folder
+/// \return     Number of steps + 1 keys
+///
+auto PipelineCache::calcStepKeys(const settings::Pipeline &pipeline, uint64_t previousKey, const std::filesystem::path &workingDirectory)
+    -> std::vector<uint64_t>
+{
+  const nlohmann::json setup = pipeline.pipelineSetup;
+  auto key                   = helper::combineFnv1a(previousKey, helper::calcFnv1a(setup.dump()));
+  key                        = helper::combineFnv1a(key, static_cast<uint32_t>(pipeline.index));
+
+  std::vector<uint64_t> keys;
+  keys.reserve(pipeline.pipelineSteps.size() + 1);
+  keys.push_back(key);
+  for(const auto &step : pipeline.pipelineSteps) {
+    nlohmann::json json = step;
+    json.erase("locked");    // Only used by the editor
+    key = helper::combineFnv1a(key, helper::calcFnv1a(json.dump()));
+    // A retrained model is stored under the same path
+    if(const auto modelPath = getModelPath(step); !modelPath.empty()) {
+      key = helper::combineFnv1a(key, calcFileStamp(workingDirectory / modelPath));
+    }
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+///
+/// \brief      Steps before the first step with side effects. Only those can be skipped,
+///             all following steps are always executed.
+/// \author     Joachim Danmayr
+///
+auto PipelineCache::getNrOfCacheableSteps(const settings::Pipeline &pipeline) -> size_t
+{
+  const auto &steps         = pipeline.pipelineSteps;
+  auto firstWithSideEffects = std::find_if(steps.begin(), steps.end(), [](const settings::PipelineStep &step) { return step.hasSideEffects(); });
+  return static_cast<size_t>(std::distance(steps.begin(), firstWithSideEffects));
+}
+
+///
+/// \brief      True if a checkpoint for the key exists
+/// \author     Joachim Danmayr
+///
+bool PipelineCache::contains(uint64_t key) const
+{
+  std::error_code ec;
+  return std::filesystem::exists(getFilePath(key), ec);
+}
+
+///
+/// \brief      Restores the image and the objects of a checkpoint. Nothing is changed
+///             if the checkpoint could not be read. The modification time of a restored
+///             checkpoint is updated, so it is evicted last.
+/// \author     Joachim Danmayr
+/// \param[in]  key      Key of the checkpoint
+/// \param[out] image    Actual image of the pipeline
+/// \param[out] objects  Objects of the tile
+/// \return     True if the checkpoint was restored
+///
+bool PipelineCache::load(uint64_t key, joda::atom::ImagePlane &image, joda::atom::ObjectList &objects) const
+{
+  const auto filePath = getFilePath(key);
+  try {
+    std::ifstream is(filePath.string(), std::ios::binary);
+    if(!is.is_open()) {
+      return false;
+    }
+    cereal::BinaryInputArchive archive(is);
+    uint64_t storedKey = 0;
+    archive(storedKey);
+    if(storedKey != key) {
+      return false;
+    }
+
+    joda::atom::ImagePlane loadedImage;
+    archive(loadedImage.tile, loadedImage.series, loadedImage.image, loadedImage.appliedMinThreshold, loadedImage.appliedMaxThreshold,
+            loadedImage.mId, loadedImage.imageType);
+
+    size_t nrOfClasses = 0;
+    archive(nrOfClasses);
+    std::vector<std::pair<enums::ClassId, std::vector<joda::atom::ROI>>> loadedObjects(nrOfClasses);
+    for(auto &[classId, rois] : loadedObjects) {
+      size_t nrOfRois = 0;
+      archive(classId, nrOfRois);
+      rois.reserve(nrOfRois);
+      for(size_t n = 0; n < nrOfRois; n++) {
+        rois.emplace_back().loadWithMeasurements(archive);
+      }
+    }
+    is.close();
+    std::error_code ec;
+    std::filesystem::last_write_time(filePath, std::filesystem::file_time_type::clock::now(), ec);
+
+    objects.clearAll();
+    for(const auto &[classId, rois] : loadedObjects) {
+      objects[classId];    // Classes without objects are part of the state too
+      for(const auto &roi : rois) {
+        objects.push_back(roi);
+      }
+    }
+    image = std::move(loadedImage);
+    return true;
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("Could not read pipeline cache >" + std::to_string(key) + "<. what: " + std::string(ex.what()));
+  }
+  return false;
+}
+
+///
+/// \brief      Writes a checkpoint. The file is written under a temporary name first,
+///             an interrupted run never leaves a partial checkpoint behind.
+///             If the cache exceeds its maximum size afterwards, the least recently
+///             used checkpoints are removed until a quarter of the size is free again.
+/// \author     Joachim Danmayr
+/// \param[in]  key      Key of the checkpoint
+/// \param[in]  image    Actual image of the pipeline
+/// \param[in]  objects  Objects of the tile
+///
+void PipelineCache::store(uint64_t key, const joda::atom::ImagePlane &image, const joda::atom::ObjectList &objects)
+{
+  const auto filePath = getFilePath(key);
+  auto tmpFilePath    = filePath;
+  tmpFilePath += ".tmp";
+  try {
+    uint64_t lastObjectId   = 0;
+    uint64_t lastTrackingId = 0;
+    {
+      std::ofstream os(tmpFilePath.string(), std::ios::binary);
+      cereal::BinaryOutputArchive archive(os);
+      archive(key);
+      archive(image.tile, image.series, image.image, image.appliedMinThreshold, image.appliedMaxThreshold, image.mId, image.imageType);
+      archive(static_cast<size_t>(objects.size()));
+      for(const auto &[classId, rois] : objects) {
+        archive(classId, static_cast<size_t>(std::distance(rois->begin(), rois->end())));
+        for(const auto &roi : *rois) {
+          roi.saveWithMeasurements(archive);
+          lastObjectId   = std::max(lastObjectId, static_cast<uint64_t>(roi.getObjectId()));
+          lastTrackingId = std::max(lastTrackingId, roi.getTrackingId());
+        }
+      }
+    }
+    // The IDs must be known before the checkpoint can be found
+    storeIds(lastObjectId, lastTrackingId);
+    std::filesystem::rename(tmpFilePath, filePath);
+
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(filePath, ec);
+    std::lock_guard<std::mutex> lock(mSizeLock);
+    mSize += ec ? 0 : size;
+    if(mSize > mMaxSize) {
+      evict(mMaxSize / 4 * 3);
+    }
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("Could not write pipeline cache >" + std::to_string(key) + "<. what: " + std::string(ex.what()));
+    std::error_code ec;
+    std::filesystem::remove(tmpFilePath, ec);
+  }
+}
+
+///
+/// \brief      Size of all checkpoints in bytes
+/// \author     Joachim Danmayr
+///
+uint64_t PipelineCache::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mSizeLock);
+  return mSize;
+}
+
+///
+/// \brief      Removes the checkpoints with the oldest modification time until the cache
+///             is not larger than the target size. The size is taken from the files on
+///             disk again, so concurrent stores of the same key can not distort it.
+///             mSizeLock must be held.
+/// \author     Joachim Danmayr
+///
+void PipelineCache::evict(uint64_t targetSize)
+{
+  auto checkpoints = listCheckpoints(mCacheFolder);
+  std::sort(checkpoints.begin(), checkpoints.end(), [](const Checkpoint &a, const Checkpoint &b) { return a.modified < b.modified; });
+  uint64_t size = 0;
+  for(const auto &checkpoint : checkpoints) {
+    size += checkpoint.size;
+  }
+  for(const auto &checkpoint : checkpoints) {
+    if(size <= targetSize) {
+      break;
+    }
+    std::error_code ec;
+    if(std::filesystem::remove(checkpoint.path, ec)) {
+      size -= checkpoint.size;
+    }
+  }
+  mSize = size;
+}
+
+///
+/// \brief      Remembers the highest IDs stored in the cache
+/// \author     Joachim Danmayr
+///
+void PipelineCache::storeIds(uint64_t lastObjectId, uint64_t lastTrackingId)
+{
+  std::lock_guard<std::mutex> lock(mIdsLock);
+  if(lastObjectId <= mLastObjectId && lastTrackingId <= mLastTrackingId) {
+    return;
+  }
+  mLastObjectId   = std::max(mLastObjectId, lastObjectId);
+  mLastTrackingId = std::max(mLastTrackingId, lastTrackingId);
+
+  const auto idsFile = mCacheFolder / (joda::fs::FILE_NAME_CACHE_IDS + joda::fs::EXT_PIPELINE_CACHE);
+  auto tmpIdsFile    = idsFile;
+  tmpIdsFile += ".tmp";
+  {
+    std::ofstream os(tmpIdsFile.string(), std::ios::binary);
+    cereal::BinaryOutputArchive archive(os);
+    archive(mLastObjectId, mLastTrackingId);
+  }
+  std::filesystem::rename(tmpIdsFile, idsFile);
+}
+
+///
+/// \brief      File of the checkpoint with the given key
+/// \author     Joachim Danmayr
+///
+auto PipelineCache::getFilePath(uint64_t key) const -> std::filesystem::path
+{
+  return mCacheFolder / (std::to_string(key) + joda::fs::EXT_PIPELINE_CACHE);
+}
+
+}    // namespace joda::processor
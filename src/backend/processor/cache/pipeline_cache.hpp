@@ -0,0 +1,79 @@
+///
+/// \file      pipeline_cache.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+#include "backend/artifacts/image/image.hpp"
+#include "backend/artifacts/object_list/object_list.hpp"
+#include "backend/enums/types.hpp"
+#include "backend/settings/analze_settings.hpp"
+#include "backend/settings/pipeline/pipeline.hpp"
+
+namespace joda::processor {
+
+///
+/// \class      PipelineCache
+/// \author     Joachim Danmayr
+/// \brief      Content addressed on disk cache of intermediate pipeline results.
+///             A checkpoint stores the actual image and the object list of a tile
+///             after a pipeline step. Its key is a hash chain over the image file,
+///             the image setup and the settings of all steps executed before, in
+///             execution order. A changed step therefore invalidates its own and
+///             all following checkpoints, while a re-run can continue from the
+///             last checkpoint before the change.
+///             The checkpoints are limited to a maximum size on disk. If the limit is
+///             exceeded, the least recently used checkpoints are removed. A restored
+///             checkpoint counts as used, its modification time is updated on load.
+///
+class PipelineCache
+{
+public:
+  /////////////////////////////////////////////////////
+  static constexpr uint64_t DEFAULT_MAX_SIZE = 8ULL * 1024 * 1024 * 1024;
+
+  explicit PipelineCache(const std::filesystem::path &cacheFolder, uint64_t maxSize = DEFAULT_MAX_SIZE);
+
+  static auto getCacheFolder(const std::filesystem::path &imageFolder) -> std::filesystem::path;
+  static void clear(const std::filesystem::path &cacheFolder);
+  static auto calcTileKey(const settings::AnalyzeSettings &settings, const std::filesystem::path &imagePath,
+                          const std::filesystem::path &annotationPath, const enums::tile_t &tile, int32_t tStack, int32_t zStack) -> uint64_t;
+  static auto calcStepKeys(const settings::Pipeline &pipeline, uint64_t previousKey, const std::filesystem::path &workingDirectory)
+      -> std::vector<uint64_t>;
+  static auto getNrOfCacheableSteps(const settings::Pipeline &pipeline) -> size_t;
+
+  [[nodiscard]] bool contains(uint64_t key) const;
+  [[nodiscard]] bool load(uint64_t key, joda::atom::ImagePlane &image, joda::atom::ObjectList &objects) const;
+  void store(uint64_t key, const joda::atom::ImagePlane &image, const joda::atom::ObjectList &objects);
+  [[nodiscard]] uint64_t getSize() const;
+
+private:
+  /////////////////////////////////////////////////////
+  static constexpr uint32_t CACHE_FORMAT_VERSION = 2;
+
+  [[nodiscard]] auto getFilePath(uint64_t key) const -> std::filesystem::path;
+  void storeIds(uint64_t lastObjectId, uint64_t lastTrackingId);
+  void evict(uint64_t targetSize);
+
+  /////////////////////////////////////////////////////
+  std::filesystem::path mCacheFolder;
+  uint64_t mMaxSize;
+  mutable std::mutex mSizeLock;
+  uint64_t mSize = 0;    // Size of all checkpoints on disk
+  std::mutex mIdsLock;
+  uint64_t mLastObjectId   = 0;    // Highest object ID stored in any checkpoint
+  uint64_t mLastTrackingId = 0;    // Highest tracking ID stored in any checkpoint
+};
+
+}    // namespace joda::processor
@@ -0,0 +1,198 @@
+///
+/// \file      pipeline_cache_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/enums/enums_file_endians.hpp"
+#include "backend/processor/cache/pipeline_cache.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::test {
+
+namespace {
+
+auto createRoi(enums::ClassId classId, int x) -> atom::ROI
+{
+  atom::ROI::RoiObjectId index{.classId = classId, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 1}};
+  cv::Mat mask = cv::Mat::ones({10, 10}, CV_8UC1) * 255;
+  return {index, 0.9F, atom::Boxes(x, 5, 10, 10), mask, {{0, 0}, {9, 0}, {9, 9}, {0, 9}}, {}};
+}
+
+auto createImage(uint16_t value) -> atom::ImagePlane
+{
+  atom::ImagePlane image;
+  image.image = cv::Mat(64, 64, CV_16UC1, cv::Scalar(value));
+  return image;
+}
+
+}    // namespace
+
+///
+/// \brief  A changed step changes its own and all following keys
+/// \author Joachim Danmayr
+///
+TEST_CASE("pipeline_cache::keys", "[pipeline_cache]")
+{
+  settings::Pipeline pipeline;
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$blur = settings::BlurSettings{}});
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$rollingBall = settings::RollingBallSettings{}});
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$saveImage = settings::ImageSaverSettings{}});
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$blur = settings::BlurSettings{}});
+
+  const auto keys = processor::PipelineCache::calcStepKeys(pipeline, 42, {});
+  REQUIRE(keys.size() == 5);
+  CHECK(processor::PipelineCache::calcStepKeys(pipeline, 42, {}) == keys);
+  CHECK(processor::PipelineCache::calcStepKeys(pipeline, 43, {}).front() != keys.front());
+  CHECK(processor::PipelineCache::getNrOfCacheableSteps(pipeline) == 2);
+
+  std::next(pipeline.pipelineSteps.begin())->$rollingBall->ballSize++;
+  const auto changed = processor::PipelineCache::calcStepKeys(pipeline, 42, {});
+  CHECK(changed[0] == keys[0]);
+  CHECK(changed[1] == keys[1]);
+  for(size_t n = 2; n < keys.size(); n++) {
+    CHECK(changed[n] != keys[n]);
+  }
+
+  pipeline.pipelineSteps.front().locked = true;
+  CHECK(processor::PipelineCache::calcStepKeys(pipeline, 42, {})[1] == changed[1]);
+}
+
+///
+/// \brief  A model file changed under the same path changes the key of its step
+/// \author Joachim Danmayr
+///
+TEST_CASE("pipeline_cache::model_keys", "[pipeline_cache]")
+{
+  const auto workingDirectory = std::filesystem::temp_directory_path() / "imagec_pipeline_cache_model_test";
+  std::filesystem::remove_all(workingDirectory);
+  std::filesystem::create_directories(workingDirectory);
+  std::ofstream(workingDirectory / "model.onnx") << "model";
+
+  settings::Pipeline pipeline;
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$blur = settings::BlurSettings{}});
+  pipeline.pipelineSteps.push_back(settings::PipelineStep{.$aiClassify = settings::AiClassifierSettings{}});
+  std::next(pipeline.pipelineSteps.begin())->$aiClassify->modelPath = "model.onnx";
+
+  const auto keys = processor::PipelineCache::calcStepKeys(pipeline, 42, workingDirectory);
+  std::ofstream(workingDirectory / "model.onnx") << "retrained model";
+  const auto changed = processor::PipelineCache::calcStepKeys(pipeline, 42, workingDirectory);
+  CHECK(changed[1] == keys[1]);
+  CHECK(changed[2] != keys[2]);
+
+  std::filesystem::remove_all(workingDirectory);
+}
+
+///
+/// \brief  A stored checkpoint is restored unchanged
+/// \author Joachim Danmayr
+///
+TEST_CASE("pipeline_cache::checkpoint", "[pipeline_cache]")
+{
+  const auto cacheFolder = std::filesystem::temp_directory_path() / "imagec_pipeline_cache_test";
+  std::filesystem::remove_all(cacheFolder);
+
+  atom::ImagePlane image;
+  image.tile                = {2, 3};
+  image.image               = cv::Mat(16, 8, CV_16UC1, cv::Scalar(1234));
+  image.appliedMinThreshold = 10;
+  image.appliedMaxThreshold = 20;
+  image.setToBinary();
+
+  atom::ObjectList objects;
+  auto first  = createRoi(enums::ClassId::C1, 0);
+  auto second = createRoi(enums::ClassId::C1, 50);
+  first.measureDistanceAndAdd(second);
+  objects.push_back(first);
+  objects.push_back(second);
+  objects[enums::ClassId::C2];
+
+  uint64_t lastObjectId = 0;
+  {
+    processor::PipelineCache cache(cacheFolder);
+    CHECK_FALSE(cache.contains(1));
+    cache.store(1, image, objects);
+    CHECK(cache.contains(1));
+    lastObjectId = second.getObjectId();
+  }
+
+  processor::PipelineCache cache(cacheFolder);
+  CHECK(createRoi(enums::ClassId::C1, 0).getObjectId() > lastObjectId);
+
+  atom::ImagePlane loadedImage;
+  atom::ObjectList loadedObjects;
+  CHECK_FALSE(cache.load(2, loadedImage, loadedObjects));
+  REQUIRE(cache.load(1, loadedImage, loadedObjects));
+
+  CHECK(loadedImage.tile == image.tile);
+  CHECK(loadedImage.isBinary());
+  CHECK(loadedImage.appliedMaxThreshold == 20);
+  CHECK(cv::countNonZero(loadedImage.image != image.image) == 0);
+
+  CHECK(loadedObjects.sizeList() == 2);
+  CHECK(loadedObjects.contains(enums::ClassId::C2));
+  const auto *restored = loadedObjects.getObjectById(first.getObjectId());
+  REQUIRE(restored != nullptr);
+  CHECK(restored->getBoundingBoxReal() == first.getBoundingBoxReal());
+  CHECK(restored->getDistances({}, enums::Units::Pixels).contains(second.getObjectId()));
+
+  std::filesystem::remove_all(cacheFolder);
+}
+
+///
+/// \brief  The least recently used checkpoints are removed if the cache gets too large
+/// \author Joachim Danmayr
+///
+TEST_CASE("pipeline_cache::eviction", "[pipeline_cache]")
+{
+  const auto cacheFolder = std::filesystem::temp_directory_path() / "imagec_pipeline_cache_eviction_test";
+  std::filesystem::remove_all(cacheFolder);
+
+  atom::ObjectList objects;
+  uint64_t checkpointSize = 0;
+  {
+    processor::PipelineCache cache(cacheFolder);
+    cache.store(1, createImage(1), objects);
+    checkpointSize = cache.getSize();
+  }
+  REQUIRE(checkpointSize > 0);
+
+  // Room for three checkpoints
+  processor::PipelineCache cache(cacheFolder, checkpointSize * 3 + checkpointSize / 2);
+  CHECK(cache.getSize() == checkpointSize);
+  const auto now = std::filesystem::file_time_type::clock::now();
+  for(uint64_t key = 2; key <= 3; key++) {
+    cache.store(key, createImage(static_cast<uint16_t>(key)), objects);
+  }
+  for(uint64_t key = 1; key <= 3; key++) {
+    std::filesystem::last_write_time(cacheFolder / (std::to_string(key) + fs::EXT_PIPELINE_CACHE), now - std::chrono::hours(4 - key));
+  }
+
+  // Checkpoint 1 is the oldest one but it was used last
+  atom::ImagePlane loadedImage;
+  REQUIRE(cache.load(1, loadedImage, objects));
+  cache.store(4, createImage(4), objects);
+  CHECK(cache.getSize() <= checkpointSize * 3);
+  CHECK(cache.contains(1));
+  CHECK_FALSE(cache.contains(2));
+  CHECK(cache.contains(4));
+
+  processor::PipelineCache::clear(cacheFolder);
+  for(uint64_t key = 1; key <= 4; key++) {
+    CHECK_FALSE(cache.contains(key));
+  }
+
+  std::filesystem::remove_all(cacheFolder);
+}
+
+}    // namespace joda::test
@@ -0,0 +1,184 @@
+///
+/// \file      preview_cache.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "preview_cache.hpp"
+
+namespace joda::processor {
+
+///
+/// \brief
+/// \author     Joachim Danmayr
+/// \param[in]  maxSizeBytes  Memory the stored states may use
+///
+PreviewCache::PreviewCache(size_t maxSizeBytes) : mMaxSizeBytes(maxSizeBytes)
+{
+}
+
+///
+/// \brief      Restores a state. The cache keeps its own copy, the restored image
+///             and objects can be changed by the following steps.
+/// \author     Joachim Danmayr
+/// \param[in]  key       Key of the state
+/// \param[out] image     Actual image of the pipeline, only restored for the state after a step
+/// \param[out] objects   Objects of the tile
+/// \param[out] validity  Image validity set by the steps executed before
+/// \return     True if the state was restored
+///
+bool PreviewCache::load(uint64_t key, joda::atom::ImagePlane *image, joda::atom::ObjectList &objects, enums::ChannelValidity &validity)
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  auto found = mEntries.find(key);
+  if(found == mEntries.end()) {
+    return false;
+  }
+  auto &entry = found->second;
+  if(image != nullptr) {
+    if(!entry.image.has_value()) {
+      return false;
+    }
+    *image = entry.image->clone(entry.image->image);
+  }
+
+  objects.clearAll();
+  for(const auto &[classId, rois] : entry.objects) {
+    objects[classId];    // Classes without objects are part of the state too
+    for(const auto &roi : rois) {
+      objects.push_back(roi);
+    }
+  }
+  validity = entry.validity;
+  mUsage.splice(mUsage.begin(), mUsage, entry.usage);
+  return true;
+}
+
+///
+/// \brief      Stores a copy of the state. Existing states are not replaced, their key
+///             already describes the same content.
+/// \author     Joachim Danmayr
+/// \param[in]  key       Key of the state
+/// \param[in]  image     Actual image of the pipeline, nullptr for the state after a level
+/// \param[in]  objects   Objects of the tile
+/// \param[in]  validity  Image validity set by the steps executed so far
+///
+void PreviewCache::store(uint64_t key, const joda::atom::ImagePlane *image, const joda::atom::ObjectList &objects,
+                         const enums::ChannelValidity &validity)
+{
+  {
+    std::lock_guard<std::mutex> lock(mLock);
+    if(mEntries.contains(key)) {
+      return;
+    }
+  }
+
+  // Copying is done outside of the lock, parallel previews are not blocked
+  Entry entry;
+  if(image != nullptr) {
+    entry.image = image->clone(image->image);
+  }
+  entry.objects.reserve(objects.size());
+  for(const auto &[classId, rois] : objects) {
+    auto &storedRois = entry.objects.emplace_back(classId, std::vector<joda::atom::ROI>{}).second;
+    for(const auto &roi : *rois) {
+      storedRois.push_back(roi.clone());
+    }
+  }
+  entry.validity    = validity;
+  entry.sizeInBytes = estimateSize(entry);
+
+  std::lock_guard<std::mutex> lock(mLock);
+  if(entry.sizeInBytes > mMaxSizeBytes || mEntries.contains(key)) {
+    return;
+  }
+  mUsage.push_front(key);
+  entry.usage = mUsage.begin();
+  mSizeInBytes += entry.sizeInBytes;
+  mEntries.emplace(key, std::move(entry));
+  evictLocked();
+}
+
+///
+/// \brief      Changes the memory limit, states exceeding it are removed
+/// \author     Joachim Danmayr
+///
+void PreviewCache::setMaxSize(size_t maxSizeBytes)
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  mMaxSizeBytes = maxSizeBytes;
+  evictLocked();
+}
+
+///
+/// \brief      Removes all states
+/// \author     Joachim Danmayr
+///
+void PreviewCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  mEntries.clear();
+  mUsage.clear();
+  mSizeInBytes = 0;
+}
+
+///
+/// \brief      Memory used by the stored states
+/// \author     Joachim Danmayr
+///
+auto PreviewCache::getSizeInBytes() const -> size_t
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  return mSizeInBytes;
+}
+
+///
+/// \brief      Number of stored states
+/// \author     Joachim Danmayr
+///
+auto PreviewCache::getNrOfEntries() const -> size_t
+{
+  std::lock_guard<std::mutex> lock(mLock);
+  return mEntries.size();
+}
+
+///
+/// \brief      Approximated memory of a state, dominated by the image and the masks
+/// \author     Joachim Danmayr
+///
+auto PreviewCache::estimateSize(const Entry &entry) -> size_t
+{
+  size_t size = sizeof(Entry);
+  if(entry.image.has_value()) {
+    size += entry.image->image.total() * entry.image->image.elemSize();
+  }
+  for(const auto &[_, rois] : entry.objects) {
+    for(const auto &roi : rois) {
+      size += sizeof(joda::atom::ROI);
+      size += roi.getMask().total() * roi.getMask().elemSize();
+      size += roi.getContour().size() * sizeof(cv::Point);
+    }
+  }
+  return size;
+}
+
+///
+/// \brief      Removes the least recently used states until the limit is kept
+/// \author     Joachim Danmayr
+///
+void PreviewCache::evictLocked()
+{
+  while(mSizeInBytes > mMaxSizeBytes && !mUsage.empty()) {
+    auto found = mEntries.find(mUsage.back());
+    mSizeInBytes -= found->second.sizeInBytes;
+    mEntries.erase(found);
+    mUsage.pop_back();
+  }
+}
+
+}    // namespace joda::processor
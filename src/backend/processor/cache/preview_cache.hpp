@@ -0,0 +1,80 @@
+///
+/// \file      preview_cache.hpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "backend/artifacts/image/image.hpp"
+#include "backend/artifacts/object_list/object_list.hpp"
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/enums/enum_validity.hpp"
+#include "backend/enums/enums_classes.hpp"
+
+namespace joda::processor {
+
+///
+/// \class      PreviewCache
+/// \author     Joachim Danmayr
+/// \brief      In memory cache of intermediate preview results. It uses the keys of
+///             the PipelineCache: A state stored after a level of the dependency
+///             graph holds the objects of all upstream pipelines, a state stored
+///             after a step of the edited pipeline holds its actual image too.
+///             If only a later step of the edited pipeline changed, the preview
+///             continues from the state before this step. The least recently used
+///             states are removed as soon as the memory limit is reached.
+///
+class PreviewCache
+{
+public:
+  /////////////////////////////////////////////////////
+  static constexpr size_t DEFAULT_MAX_SIZE_BYTES = 512 * 1024 * 1024;
+
+  explicit PreviewCache(size_t maxSizeBytes = DEFAULT_MAX_SIZE_BYTES);
+
+  [[nodiscard]] bool load(uint64_t key, joda::atom::ImagePlane *image, joda::atom::ObjectList &objects, enums::ChannelValidity &validity);
+  void store(uint64_t key, const joda::atom::ImagePlane *image, const joda::atom::ObjectList &objects, const enums::ChannelValidity &validity);
+  void setMaxSize(size_t maxSizeBytes);
+  void clear();
+
+  [[nodiscard]] auto getSizeInBytes() const -> size_t;
+  [[nodiscard]] auto getNrOfEntries() const -> size_t;
+
+private:
+  /////////////////////////////////////////////////////
+  struct Entry
+  {
+    std::optional<joda::atom::ImagePlane> image;    // Not set for the state after a level
+    std::vector<std::pair<enums::ClassId, std::vector<joda::atom::ROI>>> objects;
+    enums::ChannelValidity validity;
+    size_t sizeInBytes = 0;
+    std::list<uint64_t>::iterator usage;
+  };
+
+  /////////////////////////////////////////////////////
+  static auto estimateSize(const Entry &entry) -> size_t;
+  void evictLocked();
+
+  /////////////////////////////////////////////////////
+  mutable std::mutex mLock;
+  std::unordered_map<uint64_t, Entry> mEntries;
+  std::list<uint64_t> mUsage;    // Most recently used key first
+  size_t mSizeInBytes  = 0;
+  size_t mMaxSizeBytes = 0;
+};
+
+}    // namespace joda::processor
@@ -0,0 +1,105 @@
+///
+/// \file      preview_cache_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/artifacts/roi/roi.hpp"
+#include "backend/processor/cache/preview_cache.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core/mat.hpp>
+
+namespace joda::test {
+
+namespace {
+
+auto createRoi(enums::ClassId classId, int x) -> atom::ROI
+{
+  atom::ROI::RoiObjectId index{.classId = classId, .imagePlane = {.tStack = 0, .zStack = 0, .cStack = 1}};
+  cv::Mat mask = cv::Mat::ones({10, 10}, CV_8UC1) * 255;
+  return {index, 0.9F, atom::Boxes(x, 5, 10, 10), mask, {{0, 0}, {9, 0}, {9, 9}, {0, 9}}, {}};
+}
+
+}    // namespace
+
+///
+/// \brief  A restored state is a copy, changing it does not change the cache
+/// \author Joachim Danmayr
+///
+TEST_CASE("preview_cache::restore", "[preview_cache]")
+{
+  atom::ImagePlane image;
+  image.tile  = {1, 2};
+  image.image = cv::Mat(16, 8, CV_16UC1, cv::Scalar(1234));
+  image.setToBinary();
+
+  atom::ObjectList objects;
+  const auto first = createRoi(enums::ClassId::C1, 0);
+  objects.push_back(first);
+  objects[enums::ClassId::C2];
+  enums::ChannelValidity validity;
+  validity.set(enums::ChannelValidityEnum::POSSIBLE_NOISE);
+
+  processor::PreviewCache cache;
+  cache.store(1, &image, objects, validity);
+  cache.store(2, nullptr, objects, {});
+  CHECK(cache.getNrOfEntries() == 2);
+
+  atom::ImagePlane loadedImage;
+  atom::ObjectList loadedObjects;
+  enums::ChannelValidity loadedValidity;
+  CHECK_FALSE(cache.load(3, &loadedImage, loadedObjects, loadedValidity));
+  CHECK_FALSE(cache.load(2, &loadedImage, loadedObjects, loadedValidity));    // The state after a level has no image
+  REQUIRE(cache.load(1, &loadedImage, loadedObjects, loadedValidity));
+
+  CHECK(loadedImage.tile == image.tile);
+  CHECK(loadedImage.isBinary());
+  CHECK(loadedValidity.test(enums::ChannelValidityEnum::POSSIBLE_NOISE));
+  CHECK(loadedObjects.sizeList() == 1);
+  CHECK(loadedObjects.contains(enums::ClassId::C2));
+  CHECK(loadedObjects.getObjectById(first.getObjectId()) != nullptr);
+
+  loadedImage.image.setTo(cv::Scalar(0));
+  loadedObjects.clearAll();
+  REQUIRE(cache.load(1, &loadedImage, loadedObjects, loadedValidity));
+  CHECK(cv::countNonZero(loadedImage.image != image.image) == 0);
+  CHECK(loadedObjects.sizeList() == 1);
+}
+
+///
+/// \brief  The least recently used states are removed if the memory limit is reached
+/// \author Joachim Danmayr
+///
+TEST_CASE("preview_cache::lru", "[preview_cache]")
+{
+  atom::ImagePlane image;
+  image.image = cv::Mat(100, 100, CV_16UC1, cv::Scalar(1));
+  atom::ObjectList objects;
+
+  // Room for two states
+  processor::PreviewCache cache(static_cast<size_t>(2.5 * 100 * 100 * 2));
+  cache.store(1, &image, objects, {});
+  cache.store(2, &image, objects, {});
+
+  atom::ImagePlane loadedImage;
+  enums::ChannelValidity validity;
+  REQUIRE(cache.load(1, &loadedImage, objects, validity));    // 2 is now the least recently used one
+  cache.store(3, &image, objects, {});
+
+  CHECK(cache.getNrOfEntries() == 2);
+  CHECK(cache.getSizeInBytes() <= static_cast<size_t>(2.5 * 100 * 100 * 2));
+  CHECK(cache.load(1, &loadedImage, objects, validity));
+  CHECK_FALSE(cache.load(2, &loadedImage, objects, validity));
+  CHECK(cache.load(3, &loadedImage, objects, validity));
+
+  cache.setMaxSize(0);
+  CHECK(cache.getNrOfEntries() == 0);
+  CHECK(cache.getSizeInBytes() == 0);
+}
+
+}    // namespace joda::test
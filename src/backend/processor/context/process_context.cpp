@@ -66,6 +66,11 @@ ProcessContext::ProcessContext(const GlobalContext &globalContextIn, const Pipel
   return imageContext.getImagePath();
 }
 
+[[nodiscard]] uint64_t ProcessContext::getActImageId() const
+{
+  return imageContext.getImageId();
+}
+
 void ProcessContext::setImageValidity(enums::ChannelValidityEnum validityIn)
 {
   enums::ChannelValidity validity;
@@ -102,4 +107,19 @@ ome::PhyiscalSize ProcessContext::getPhysicalPixelSIzeOfImage() const
   return imageContext.getPhysicalPixelSIzeOfImage();
 }
 
+[[nodiscard]] int32_t ProcessContext::getNrOfZStacks() const
+{
+  return imageContext.getNrOfZStack();
+}
+
+///
+/// \brief      Loads the plane of the actual tile directly from the image file.
+///             The plane is not stored to the cache.
+/// \author     Joachim Danmayr
+///
+[[nodiscard]] cv::Mat ProcessContext::loadImagePlane(const enums::PlaneId &plane) const
+{
+  return imageContext.loadImagePlane(plane, getActTile());
+}
+
 }    // namespace joda::processor
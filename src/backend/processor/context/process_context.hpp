@@ -14,15 +14,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include "backend/artifacts/image/image.hpp"
 #include "backend/artifacts/object_list/object_list.hpp"
 #include "backend/artifacts/roi/roi.hpp"
+#include "backend/data_analysis/object_tracker/tracking_manager.hpp"
 #include "backend/database/database_interface.hpp"
 #include "backend/enums/enum_images.hpp"
 #include "backend/enums/enum_memory_idx.hpp"
@@ -43,6 +46,8 @@ namespace joda::processor {
 
 using objectCache_t = std::map<enums::ObjectStoreId, std::unique_ptr<joda::atom::ObjectList>>;
 
+class PipelineCache;
+
 struct GlobalContext
 {
   friend class ProcessContext;
@@ -51,10 +56,15 @@ struct GlobalContext
   std::filesystem::path resultsOutputFolder;
   std::filesystem::path resultsDatabaseFilePath;
   std::unique_ptr<db::DatabaseInterface> database;
+  std::unique_ptr<data_analyze::object_tracker::TrackingManager> objectTracking;    // Only set if results are written to a database
+  std::shared_ptr<PipelineCache> pipelineCache;                                      // Only set if intermediate results should be cached
   std::map<enums::ClassId, joda::settings::Class> classes;
+  std::set<db::WorkUnit> finishedWorkUnits;    // Work units stored by an interrupted run of a resumed job
+  std::set<uint64_t> processedImages;          // Images finished by an interrupted run of a resumed job
   std::string jobId;
   std::string jobName;
   std::chrono::system_clock::time_point timestampStarted;
+  bool profiling = false;
 
 private:
   objectCache_t objectCache;
@@ -105,6 +115,12 @@ public:
     return pipelineContext.actImagePlane.getId().imagePlane;
   }
   [[nodiscard]] const std::filesystem::path &getActImagePath() const;
+  [[nodiscard]] uint64_t getActImageId() const;
+
+  [[nodiscard]] data_analyze::object_tracker::TrackingManager *getObjectTracking() const
+  {
+    return globalContext.objectTracking.get();
+  }
 
   [[nodiscard]] const std::filesystem::path &getWorkingDirectory() const
   {
@@ -128,6 +144,8 @@ public:
 
   [[nodiscard]] cv::Size getTileSize() const;
   ome::PhyiscalSize getPhysicalPixelSIzeOfImage() const;
+  [[nodiscard]] int32_t getNrOfZStacks() const;
+  [[nodiscard]] cv::Mat loadImagePlane(const enums::PlaneId &plane) const;
 
   void setActImage(const joda::atom::ImagePlane *image)
   {
@@ -177,6 +195,17 @@ public:
     }
   }
 
+  ///
+  /// \brief      True if a pipeline step stored an image to one of the memory slots
+  /// \author     Joachim Danmayr
+  ///
+  [[nodiscard]] bool hasImagesInMemorySlots() const
+  {
+    auto isMemorySlot = [](const auto &entry) { return entry.first.isMemorySlot(); };
+    return std::any_of(iterationContext.imageCache.begin(), iterationContext.imageCache.end(), isMemorySlot) ||
+           std::any_of(pipelineContext.imageCache.begin(), pipelineContext.imageCache.end(), isMemorySlot);
+  }
+
   [[nodiscard]] joda::atom::ObjectList *loadObjectsFromCache(joda::enums::ObjectStoreId cacheId = {}) const
   {
     if(cacheId.storeIdx == enums::MemoryIdx::M0) {
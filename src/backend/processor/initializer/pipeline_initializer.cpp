@@ -20,7 +20,7 @@
 #include "backend/enums/enum_images.hpp"
 #include "backend/enums/enum_memory_idx.hpp"
 #include "backend/enums/types.hpp"
-#include "backend/helper/duration_count/duration_count.h"
+#include "backend/helper/trace/trace.hpp"
 #include "backend/helper/fnv1a.hpp"
 #include "backend/helper/reader/image_reader.hpp"
 #include "backend/processor/context/process_context.hpp"
@@ -74,6 +74,7 @@ PipelineInitializer::PipelineInitializer(const settings::ProjectImageSetup &sett
 
   switch(mSettings.zStackHandling) {
     case settings::ProjectImageSetup::ZStackHandling::EXACT_ONE:
+    case settings::ProjectImageSetup::ZStackHandling::VOLUME:
       mZStackToLoad = 1;
       break;
     case settings::ProjectImageSetup::ZStackHandling::EACH_ONE:
@@ -131,6 +132,7 @@ void PipelineInitializer::initPipeline(const joda::settings::PipelineSettings &p
 
   switch(mSettings.zStackHandling) {
     case settings::ProjectImageSetup::ZStackHandling::EXACT_ONE:
+    case settings::ProjectImageSetup::ZStackHandling::VOLUME:
       z = pipelineSetup.zStackIndex;
       break;
     case settings::ProjectImageSetup::ZStackHandling::EACH_ONE:
@@ -208,8 +210,6 @@ enums::ImageId PipelineInitializer::loadImageAndStoreToCache(enums::MemoryScope
                                                              enums::ZProjection zProjection, const enums::tile_t &tile,
                                                              joda::processor::ProcessContext &processContext) const
 {
-  static std::mutex mLoadMutex;
-
   std::lock_guard<std::mutex> locked(mLoadMutex);
   joda::atom::ImagePlane imagePlaneOut;
   imagePlaneOut.tile = tile;
@@ -236,24 +236,12 @@ enums::ImageId PipelineInitializer::loadImageAndStoreToCache(enums::MemoryScope
   //
   // Load from image file
   //
-  auto loadEntireImage = [this, series = mSelectedSeries](int32_t zIn, int32_t cIn, int32_t tIn) {
-    return mImageRead.loadEntireImage(joda::enums::PlaneId{.tStack = tIn, .zStack = zIn, .cStack = cIn}, static_cast<uint16_t>(series), 0,
-                                      mImageMeta);
+  auto loadImage = [this, &tile](int32_t zIn, int32_t cIn, int32_t tIn) {
+    return loadPlane(joda::enums::PlaneId{.tStack = tIn, .zStack = zIn, .cStack = cIn}, tile);
   };
 
-  auto loadImageTile = [this, &tile, series = mSelectedSeries](int32_t zIn, int32_t cIn, int32_t tIn) {
-    return mImageRead.loadImageTile(
-        joda::enums::PlaneId{.tStack = tIn, .zStack = zIn, .cStack = cIn}, static_cast<uint16_t>(series), 0,
-        joda::ome::TileToLoad{.tileX = std::get<0>(tile), .tileY = std::get<1>(tile), .tileWidth = tileSize.width, .tileHeight = tileSize.height},
-        mImageMeta);
-  };
-
-  std::function<cv::Mat(int32_t, int32_t, int32_t)> loadImage = loadEntireImage;
-  if(loadImageInTiles) {
-    loadImage = loadImageTile;
-  }
-
-  DurationCount durationCount("Load image");
+  static const auto SPAN_LOAD_IMAGE = joda::trace::Tracer::registerSpan("Load image");
+  joda::trace::Span span(SPAN_LOAD_IMAGE);
 
   auto &image = imagePlaneOut.image;
   image       = loadImage(z, c, t);
@@ -309,6 +297,35 @@ enums::ImageId PipelineInitializer::loadImageAndStoreToCache(enums::MemoryScope
   return imagePlaneOut.getId();
 }
 
+///
+/// \brief      Loads one plane of the given tile without z-projection and without
+///             storing it to the cache. Used to stream through the z-stacks of a tile.
+/// \author     Joachim Danmayr
+/// \param[in]  planeToLoad  Plane to load
+/// \param[in]  tile         Tile to load
+/// \return     The loaded plane
+///
+cv::Mat PipelineInitializer::loadImagePlane(const enums::PlaneId &planeToLoad, const enums::tile_t &tile) const
+{
+  std::lock_guard<std::mutex> locked(mLoadMutex);
+  return loadPlane(planeToLoad, tile);
+}
+
+///
+/// \brief      Reads the plane from the image file, the caller must hold the load mutex
+/// \author     Joachim Danmayr
+///
+cv::Mat PipelineInitializer::loadPlane(const enums::PlaneId &planeToLoad, const enums::tile_t &tile) const
+{
+  if(loadImageInTiles) {
+    return mImageRead.loadImageTile(
+        planeToLoad, static_cast<uint16_t>(mSelectedSeries), 0,
+        joda::ome::TileToLoad{.tileX = std::get<0>(tile), .tileY = std::get<1>(tile), .tileWidth = tileSize.width, .tileHeight = tileSize.height},
+        mImageMeta);
+  }
+  return mImageRead.loadEntireImage(planeToLoad, static_cast<uint16_t>(mSelectedSeries), 0, mImageMeta);
+}
+
 ///
 /// \brief
 /// \author
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <filesystem>
+#include <mutex>
 #include <tuple>
 #include "backend/enums/enum_images.hpp"
 #include "backend/enums/types.hpp"
@@ -60,6 +61,7 @@ public:
 
   void initPipeline(const joda::settings::PipelineSettings &settings, const enums::tile_t &tile, const joda::enums::PlaneId &imagePartToLoad,
                     ProcessContext &processStepOu, int32_t pipelineIndex) const;
+  [[nodiscard]] cv::Mat loadImagePlane(const enums::PlaneId &planeToLoad, const enums::tile_t &tile) const;
 
   auto &getImagePath() const
   {
@@ -134,6 +136,7 @@ public:
 private:
   /////////////////////////////////////////////////////
   static int32_t limitChannel(int32_t wantedIndex, int32_t maxIndex);
+  [[nodiscard]] cv::Mat loadPlane(const enums::PlaneId &planeToLoad, const enums::tile_t &tile) const;
 
   /////////////////////////////////////////////////////
   std::tuple<int32_t, int32_t> mNrOfTiles = {1, 1};
@@ -155,6 +158,8 @@ private:
   cv::Size tileSize     = {};
   bool loadImageInTiles = false;
   uint64_t mImageId;
+
+  static inline std::mutex mLoadMutex;    // The image reader is not used concurrently
 };
 
 }    // namespace joda::processor
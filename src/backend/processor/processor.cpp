@@ -10,10 +10,16 @@
 ///
 
 #include "processor.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <filesystem>
+#include <future>
+#include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -35,7 +41,12 @@
 #include "backend/helper/helper.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/helper/reader/image_reader.hpp"
+#include "backend/helper/system/process_usage.hpp"
 #include "backend/helper/system/system_resources.hpp"
+#include "backend/helper/threading/task_scheduler.hpp"
+#include "backend/helper/trace/trace.hpp"
+#include "backend/processor/cache/pipeline_cache.hpp"
+#include "backend/processor/cache/preview_cache.hpp"
 #include "backend/processor/context/process_context.hpp"
 #include "backend/processor/dependency_graph.hpp"
 #include "backend/processor/initializer/pipeline_initializer.hpp"
@@ -65,6 +76,15 @@ void Processor::stop()
   mCancelAll.store(true);
 }
 
+///
+/// \brief      Live mode: No more images are added, the images found so far are finished
+/// \author     Joachim Danmayr
+///
+void Processor::stopWatching()
+{
+  mStopWatching.store(true);
+}
+
 ///
 /// \brief
 /// \author
@@ -86,29 +106,101 @@ public:
   {
   }
 
-  void execute(BS::thread_pool<> *threadPool = nullptr, const settings::Pipeline *previewPipeline = nullptr)
+  ///
+  /// \brief      Start of the pipeline cache key chain of this tile
+  ///
+  void setPipelineCacheKey(uint64_t tileKey)
+  {
+    mCacheKey = tileKey;
+  }
+
+  ///
+  /// \brief      Intermediate preview results are taken from and stored to the given cache
+  ///
+  void setPreviewCache(PreviewCache *previewCache, uint64_t tileKey)
+  {
+    mPreviewCache = previewCache;
+    mCacheKey     = tileKey;
+  }
+
+  void execute(BS::priority_thread_pool *threadPool = nullptr, const settings::Pipeline *previewPipeline = nullptr)
   {
     mPreviewPipeline = previewPipeline;
-    for(const auto &[order, pipelines] : *pipelineOrder) {
+    auto firstLevel  = pipelineOrder->begin();
+    std::map<int, uint64_t> levelKeys;
+    if constexpr(PREVIEW_TASK) {
+      if(mPreviewCache != nullptr) {
+        // Continue after the last level with cached objects, the level of the edited pipeline is always executed
+        levelKeys = calcLevelKeys();
+        for(auto level = std::prev(pipelineOrder->end()); level != pipelineOrder->begin();) {
+          --level;
+          if(restorePreviewState(levelKeys.at(level->first), nullptr, iterationContext.getObjects())) {
+            firstLevel = std::next(level);
+            break;
+          }
+        }
+      }
+    }
+
+    for(auto level = firstLevel; level != pipelineOrder->end(); ++level) {
+      const auto &[order, pipelines] = *level;
+      if constexpr(PREVIEW_TASK) {
+        // Pipelines of one level run in parallel, only the state of a single pipeline is deterministic
+        mPreviewStepCaching = mPreviewCache != nullptr && pipelines.size() == 1;
+        if(mPreviewStepCaching) {
+          mPreviewLevelKey = level == pipelineOrder->begin() ? mCacheKey : levelKeys.at(std::prev(level)->first);
+        }
+      }
+      std::vector<std::future<void>> previewPipelines;
       for(const auto &pipelineToExecute : pipelines) {
         if constexpr(PREVIEW_TASK) {
-          // In preview task we parallelize the pipeline execution
-          (void) threadPool->submit_task([this, pipelineToExecute]() { processPipeline(pipelineToExecute); });
+          // In preview task we parallelize the pipeline execution, queued work units of a running job are started later
+          previewPipelines.push_back(joda::thread::TaskScheduler::submit(*threadPool, joda::thread::TaskPriority::INTERACTIVE,
+                                                                         [this, pipelineToExecute]() { processPipeline(pipelineToExecute); }));
         } else {
           processPipeline(pipelineToExecute);
         }
       }
+      // Only the own pipelines are waited for, the pool may be busy with a running job
+      for(const auto &pipeline : previewPipelines) {
+        pipeline.wait();
+      }
       if constexpr(PREVIEW_TASK) {
-        threadPool->wait();
+        if(mPreviewCache != nullptr && std::next(level) != pipelineOrder->end()) {
+          ProcessContext context{*globalContext, *imageContext, iterationContext};
+          storePreviewState(levelKeys.at(order), context, false);
+        }
       }
     }
 
-    globalContext->database->insertObjects(*imageContext, imageContext->getPixelSizeUnit(), iterationContext.getObjects());
+    globalContext->database->insertObjects(
+        *imageContext, imageContext->getPixelSizeUnit(), iterationContext.getObjects(),
+        {.imageId = imageContext->getImageId(), .tileX = mtileX, .tileY = mtileY, .tStack = mtStack, .zStack = mzStack});
+    if(!mStepProfiles.empty()) {
+      globalContext->database->insertPipelineStepProfiles(globalContext->jobId, mStepProfiles);
+    }
+    if(globalContext->objectTracking != nullptr) {
+      // Objects of this tile are in the database, the tracking IDs can be written
+      globalContext->objectTracking->tileFinished(imageContext->getImageId(), mtStack, mzStack);
+    }
   }
 
   void processPipeline(const joda::settings::Pipeline *pipelineToExecute)
   {
-    DurationCount durationImagePipelineProcess("Process pipeline");
+    static const auto SPAN_PROCESS_PIPELINE       = joda::trace::Tracer::registerSpan("Process pipeline");
+    static const auto SPAN_DB_INSERT_IMAGE_PLANE  = joda::trace::Tracer::registerSpan("DB insert image plane");
+    static const auto SPAN_PROCESS_PIPELINE_STEPS = joda::trace::Tracer::registerSpan("Process pipeline steps");
+
+    joda::trace::ScopedAttributes traceAttributes({.imageId       = imageContext->getImageId(),
+                                                   .tileX         = mtileX,
+                                                   .tileY         = mtileY,
+                                                   .tStack        = mtStack,
+                                                   .zStack        = mzStack,
+                                                   .pipelineIndex = pipelineToExecute->index});
+    joda::trace::Span spanPipeline(SPAN_PROCESS_PIPELINE);
+    const bool profiling      = !PREVIEW_TASK && globalContext->profiling;
+    const bool caching        = !PREVIEW_TASK && globalContext->pipelineCache != nullptr;
+    const auto pipelineSample = profiling ? takeSample() : Sample{};
     ProcessContext context{*globalContext, *imageContext, iterationContext};
     imageContext->initPipeline(pipelineToExecute->pipelineSetup, {mtileX, mtileY},
                                {.tStack = mtStack, .zStack = mzStack, .cStack = pipelineToExecute->pipelineSetup.cStackIndex}, context,
@@ -117,7 +209,7 @@ public:
     const auto planeId    = context.getActImage().getId().imagePlane;
     const auto nrChannels = imageContext->getNrOfChannels();
     if(pipelineToExecute->pipelineSetup.cStackIndex >= 0 && pipelineToExecute->pipelineSetup.cStackIndex < nrChannels) {
-      DurationCount waitCounter("DB insert image plane");
+      joda::trace::Span spanInsert(SPAN_DB_INSERT_IMAGE_PLANE);
       globalContext->database->insertImagePlane(imageContext->getImageId(), planeId,
                                                 imageContext->getChannelInfos()
                                                     .at(static_cast<uint32_t>(pipelineToExecute->pipelineSetup.cStackIndex))
@@ -125,22 +217,77 @@ public:
                                                     .at(planeId.zStack));
     }
 
+    // Continue from the last checkpoint stored for this pipeline
+    std::vector<uint64_t> cacheKeys;
+    size_t nrOfCacheableSteps = 0;
+    size_t firstStepToExecute = 0;
+    if(caching) {
+      cacheKeys          = PipelineCache::calcStepKeys(*pipelineToExecute, mCacheKey, globalContext->workingDirectory);
+      nrOfCacheableSteps = PipelineCache::getNrOfCacheableSteps(*pipelineToExecute);
+      for(size_t n = nrOfCacheableSteps; n > 0; n--) {
+        if(globalContext->pipelineCache->load(cacheKeys[n], context.getActImage(), context.getActObjects())) {
+          firstStepToExecute = n;
+          break;
+        }
+      }
+      mCacheKey = cacheKeys.back();
+    }
+    const bool previewCaching = PREVIEW_TASK && mPreviewStepCaching && mPreviewPipeline == pipelineToExecute;
+    if(previewCaching) {
+      cacheKeys          = PipelineCache::calcStepKeys(*pipelineToExecute, mPreviewLevelKey, globalContext->workingDirectory);
+      nrOfCacheableSteps = PipelineCache::getNrOfCacheableSteps(*pipelineToExecute);
+      // The image at the breakpoint is taken while the steps are executed
+      const auto &steps     = pipelineToExecute->pipelineSteps;
+      const auto breakPoint = std::find_if(steps.begin(), steps.end(), [](const settings::PipelineStep &step) { return step.breakPoint; });
+      const auto maxRestore = std::min(nrOfCacheableSteps, static_cast<size_t>(std::distance(steps.begin(), breakPoint)));
+      for(size_t n = maxRestore; n > 0; n--) {
+        if(restorePreviewState(cacheKeys[n], &context.getActImage(), context.getActObjects())) {
+          firstStepToExecute = n;
+          break;
+        }
+      }
+    }
+
     // Execute the pipeline
-    DurationCount durationCountPipelineSteps("Process pipeline steps");
+    joda::trace::Span spanPipelineSteps(SPAN_PROCESS_PIPELINE_STEPS);
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+    int32_t stepIndex   = 0;
     for(const auto &step : pipelineToExecute->pipelineSteps) {
+      if(static_cast<size_t>(stepIndex) < firstStepToExecute) {
+        // Result restored from the pipeline cache
+        mProgress->incProcessedPipelineSteps();
+        stepIndex++;
+        continue;
+      }
       if constexpr(PREVIEW_TASK) {
         if(mPreviewPipeline == pipelineToExecute && step.breakPoint) {
           // Breakpoints only allowed in the pipeline for which the preview should be generated for
           editedImageAtBreakpoint = context.getActImage().image.clone();
         }
       }
-      step(context, context.getActImage().image, context.getActObjects());
+      if(profiling) {
+        const auto stepSample = takeSample();
+        step(context, context.getActImage().image, context.getActObjects());
+        addStepProfile(stepSample, pipelineToExecute->index, stepIndex, step.getCommandName(), context);
+      } else {
+        step(context, context.getActImage().image, context.getActObjects());
+      }
       mProgress->incProcessedPipelineSteps();
+      stepIndex++;
+      if(caching && static_cast<size_t>(stepIndex) <= nrOfCacheableSteps) {
+        storeCheckpoint(context, cacheKeys[stepIndex], static_cast<size_t>(stepIndex) == nrOfCacheableSteps, lastCheckpoint);
+      }
+      if(previewCaching && static_cast<size_t>(stepIndex) <= nrOfCacheableSteps) {
+        storePreviewState(cacheKeys[stepIndex], context, true);
+      }
     }
 
     // Pipeline finished
-    durationCountPipelineSteps.stop();
+    spanPipelineSteps.stop();
     iterationContext.removeTemporaryObjects(&context);
+    if(profiling) {
+      addStepProfile(pipelineSample, pipelineToExecute->index, -1, "pipeline", context);
+    }
 
     if constexpr(PREVIEW_TASK) {
       if(mPreviewPipeline == pipelineToExecute && editedImageAtBreakpoint.empty()) {
@@ -161,6 +308,117 @@ public:
   }
 
 private:
+  /////////////////////////////////////////////////////
+  struct Sample
+  {
+    std::chrono::steady_clock::time_point wallTime;
+    uint64_t cpuTimeNs = 0;
+  };
+
+  static auto takeSample() -> Sample
+  {
+    return {.wallTime = std::chrono::steady_clock::now(), .cpuTimeNs = joda::system::getThreadCpuTimeNs()};
+  }
+
+  ///
+  /// \brief      Stores the state after a step to the pipeline cache. The output of cheap
+  ///             steps is only stored if it is the last one which can be cached. Images in
+  ///             memory slots and linked objects are not part of a checkpoint, a state
+  ///             containing them can not be restored. The minimum duration between two
+  ///             checkpoints only limits how often one is written, the disk usage is bounded
+  ///             by the maximum size of the pipeline cache.
+  ///
+  void storeCheckpoint(ProcessContext &context, uint64_t key, bool isLastCacheableStep, std::chrono::steady_clock::time_point &lastCheckpoint)
+  {
+    static constexpr auto MIN_DURATION_BETWEEN_CHECKPOINTS = std::chrono::milliseconds(250);
+    if(!isLastCacheableStep && std::chrono::steady_clock::now() - lastCheckpoint < MIN_DURATION_BETWEEN_CHECKPOINTS) {
+      return;
+    }
+    if(context.hasImagesInMemorySlots() || hasLinkedObjects(context.getActObjects()) || globalContext->pipelineCache->contains(key)) {
+      return;
+    }
+    globalContext->pipelineCache->store(key, context.getActImage(), context.getActObjects());
+    lastCheckpoint = std::chrono::steady_clock::now();
+  }
+
+  ///
+  /// \brief      Preview cache keys of the states after each level of the dependency graph.
+  ///             Pipelines of a level are chained in the order of their index.
+  ///
+  auto calcLevelKeys() const -> std::map<int, uint64_t>
+  {
+    std::map<int, uint64_t> levelKeys;
+    auto key = mCacheKey;
+    for(const auto &[order, pipelines] : *pipelineOrder) {
+      std::vector<const settings::Pipeline *> sorted(pipelines.begin(), pipelines.end());
+      std::sort(sorted.begin(), sorted.end(), [](const settings::Pipeline *a, const settings::Pipeline *b) { return a->index < b->index; });
+      for(const auto *pipeline : sorted) {
+        key = PipelineCache::calcStepKeys(*pipeline, key, globalContext->workingDirectory).back();
+      }
+      levelKeys.emplace(order, key);
+    }
+    return levelKeys;
+  }
+
+  ///
+  /// \brief      Restores a state of the preview cache, the image validity set by the
+  ///             skipped steps is restored too
+  ///
+  bool restorePreviewState(uint64_t key, joda::atom::ImagePlane *image, joda::atom::ObjectList &objects)
+  {
+    enums::ChannelValidity validity;
+    if(!mPreviewCache->load(key, image, objects, validity)) {
+      return false;
+    }
+    if(validity.any()) {
+      globalContext->database->setImageValidity(imageContext->getImageId(), validity);
+    }
+    return true;
+  }
+
+  ///
+  /// \brief      Stores the state after a level or a step of the edited pipeline to the
+  ///             preview cache. Like checkpoints, states with images in memory slots or
+  ///             linked objects can not be restored.
+  ///
+  void storePreviewState(uint64_t key, ProcessContext &context, bool withImage)
+  {
+    if(context.hasImagesInMemorySlots() || hasLinkedObjects(context.getActObjects())) {
+      return;
+    }
+    mPreviewCache->store(key, withImage ? &context.getActImage() : nullptr, context.getActObjects(),
+                         globalContext->database->getImageValidity());
+  }
+
+  static bool hasLinkedObjects(const joda::atom::ObjectList &objects)
+  {
+    for(const auto &[_, rois] : objects) {
+      for(const auto &roi : *rois) {
+        if(!roi.getLinkedRois().empty()) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void addStepProfile(const Sample &start, int32_t pipelineIndex, int32_t stepIndex, const std::string &command, ProcessContext &context)
+  {
+    const auto end = takeSample();
+    mStepProfiles.push_back(
+        {.imageId       = imageContext->getImageId(),
+         .pipelineIndex = pipelineIndex,
+         .stepIndex     = stepIndex,
+         .command       = command,
+         .tileX         = mtileX,
+         .tileY         = mtileY,
+         .tStack        = mtStack,
+         .zStack        = mzStack,
+         .wallTimeNs    = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end.wallTime - start.wallTime).count()),
+         .cpuTimeNs     = end.cpuTimeNs - start.cpuTimeNs,
+         .nrOfObjects   = context.getActObjects().sizeList()});
+  }
+
   /////////////////////////////////////////////////////
   ProcessProgress *mProgress;
   const GlobalContext *globalContext;
@@ -174,6 +432,11 @@ private:
   IterationContext iterationContext;
   cv::Mat editedImageAtBreakpoint;
   const settings::Pipeline *mPreviewPipeline = nullptr;
+  std::vector<db::PipelineStepProfile> mStepProfiles;
+  uint64_t mCacheKey          = 0;          // Pipeline cache key of the state after the last executed pipeline
+  PreviewCache *mPreviewCache = nullptr;    // Only set for a preview
+  uint64_t mPreviewLevelKey   = 0;          // Preview cache key of the state before the actual level
+  bool mPreviewStepCaching    = false;      // The steps of the edited pipeline are cached
 };
 
 ///
@@ -183,97 +446,226 @@ private:
 /// \param[out]
 /// \return
 ///
-void Processor::execute(std::unique_ptr<BS::thread_pool<>> &threadPool, const joda::settings::AnalyzeSettings &program, const std::string &jobName,
-                        const std::unique_ptr<imagesList_t> &imagesToAnalyze)
+void Processor::execute(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program,
+                        const std::string &jobName, const std::unique_ptr<imagesList_t> &imagesToAnalyze,
+                        const std::optional<std::filesystem::path> &resumeDatabase, const std::optional<LiveModeSettings> &liveMode,
+                        const std::optional<ShardSettings> &shard)
 {
+  const bool tracing = program.pipelineSetup.profiling;
   try {
     mCancelAll.store(false);
+    mStopWatching.store(false);
     mProgress.setRunningPreparingPipeline();
 
     DurationCount::resetStats();
+    if(tracing) {
+      joda::trace::Tracer::start();
+    }
     // Resolve dependencies
     auto pipelineOrder = joda::processor::DependencyGraph::calcGraph(program);
-    mGlobalContext     = initializeGlobalContext<db::Database>(program, jobName);
+    mGlobalContext     = initializeGlobalContext<db::Database>(program, jobName, resumeDatabase, shard);
     prepareOutputFolder(program, mGlobalContext);
 
-    const auto &plate          = program.projectSettings.plate;
-    const auto &images         = imagesToAnalyze->getFilesListAt();
-    const auto imagesToProcess = mGlobalContext->database->prepareImages(plate.plateId, program.imageSetup.series, plate.groupBy, plate.filenameRegex,
-                                                                         images, imagesToAnalyze->getDirectoryAt(), program, threadPool);
-
-    //
-    // Prepare the tasks to execute
-    //
-    int32_t nrOfTiles = 0;
-    // std::vector<std::unique_ptr<Task<false>>> tasks;
-    for(const auto &actImage : imagesToProcess) {
-      const auto [tilesX, tilesY] = actImage->getNrOfTilesToProcess();
-      const auto nrtStack         = actImage->getNrOfTStacksToProcess();
-      const auto nrzSTack         = actImage->getNrOfZStacksToProcess();
-      const int32_t lastTileX     = tilesX - 1;
-      const int32_t lastTileY     = tilesY - 1;
-
-      for(int32_t tileX = 0; tileX < tilesX; tileX++) {
-        for(int32_t tileY = 0; tileY < tilesY; tileY++) {
-          // Start of the image specific function
-          int32_t tStackStart = 0;
-          auto tStackEnd      = static_cast<int32_t>(nrtStack);
-          if(program.imageSetup.tStackSettings.startFrame > static_cast<int32_t>(nrtStack)) {
-            tStackStart = static_cast<int32_t>(nrtStack);
-          } else {
-            tStackStart = program.imageSetup.tStackSettings.startFrame;
-          }
-          if(program.imageSetup.tStackSettings.endFrame >= 0 && program.imageSetup.tStackSettings.endFrame <= static_cast<int32_t>(nrtStack)) {
-            tStackEnd = program.imageSetup.tStackSettings.endFrame;
-          }
-          const int32_t lastTStack = tStackEnd - 1;
-
-          for(int32_t tStack = tStackStart; tStack < tStackEnd; tStack++) {
-            const int32_t lastZStack = static_cast<int32_t>(nrzSTack) - 1;
-
-            for(int32_t zStack = 0; zStack < static_cast<int32_t>(nrzSTack); zStack++) {
-              const bool lastTileOfImage = (tStack == lastTStack) && (zStack == lastZStack) && (tileX == lastTileX) && (tileY == lastTileY);
-
-              (void) threadPool->submit_task([this, &program, &pipelineOrder, actImage, tileX, tileY, tStack, zStack, lastTileOfImage]() {
-                if(mCancelAll.load(std::memory_order_relaxed)) {
-                  return;
-                }
-                // Execute task
-                std::unique_ptr<Task<false>> taskToExecute = std::make_unique<Task<false>>(
-                    &mProgress, mGlobalContext.get(), actImage.get(), program.getProjectPath(), &pipelineOrder, tileX, tileY, tStack, zStack);
-                taskToExecute->execute();
-                mProgress.incProcessedTiles();
-
-                // Image finished
-                if(lastTileOfImage) {
-                  mGlobalContext->database->setImageProcessed(actImage->getImageId());
-                  mProgress.incProcessedImages();
-                }
-              });
-              nrOfTiles++;
-            }
-          }
-        }
-      }
-    }
-    mProgress.setTotalNrOfImages(static_cast<uint32_t>(imagesToProcess.size()));
+    // Images found later in live mode must continue the group numbering
+    const auto &plate = program.projectSettings.plate;
+    joda::grp::FileGrouper grouper(plate.groupBy, plate.filenameRegex);
+    const auto images          = shard.has_value() ? selectShard(imagesToAnalyze->getFilesListAt(), grouper, *shard)
+                                                   : imagesToAnalyze->getFilesListAt();
+    const auto imagesToProcess = mGlobalContext->database->prepareImages(plate.plateId, program.imageSetup.series, grouper, images,
+                                                                         imagesToAnalyze->getDirectoryAt(), program, threadPool);
+
+    mBatchQueue     = std::make_unique<joda::thread::BatchQueue>(*threadPool);
+    auto nrOfImages = static_cast<uint32_t>(imagesToProcess.size());
+    auto nrOfTiles  = enqueueImages(threadPool, program, pipelineOrder, imagesToProcess);
+    mProgress.setTotalNrOfImages(nrOfImages);
     mProgress.setTotalNrOfTiles(static_cast<uint32_t>(nrOfTiles));
     mProgress.setStateRunning();
 
-    threadPool->wait();
+    if(liveMode.has_value()) {
+      watchForNewImages(threadPool, program, pipelineOrder, *imagesToAnalyze, grouper, *liveMode, nrOfImages, nrOfTiles);
+    }
+
+    mBatchQueue->wait();
+    mBackgroundTasks.wait();    // Detached by the work units, so all of them are known once the queue is done
 
     //
     // Done
     //
     mGlobalContext->database->finishJob(mGlobalContext->jobId);
     mGlobalContext->database->closeDatabase();
+    const auto trace = tracing ? joda::trace::Tracer::stop() : joda::trace::Tracer::Recording{};
     mProgress.setStateFinished();
-    DurationCount::printStats(static_cast<int32_t>(imagesToAnalyze->getNrOfFiles()), mGlobalContext->resultsOutputFolder);
+    DurationCount::printStats(static_cast<int32_t>(imagesToAnalyze->getNrOfFiles()), mGlobalContext->resultsOutputFolder,
+                              joda::trace::Tracer::aggregate(trace));
+    if(tracing) {
+      joda::trace::Tracer::exportChromeTrace(trace, mGlobalContext->resultsOutputFolder / "profiling_trace.json");
+    }
   } catch(const std::exception &ex) {
+    // Submitted work units and their background tasks still access the processor
+    if(mBatchQueue != nullptr) {
+      mBatchQueue->wait();
+    }
+    mBackgroundTasks.wait();
+    if(tracing) {
+      joda::trace::Tracer::stop();
+    }
+    mProgress.setWatchingForImages(false);
     mProgress.setStateError(ex.what());
   }
 }
 
+///
+/// \brief      Submits the work units of the images to the batch queue of the job
+/// \author     Joachim Danmayr
+/// \param[in]  threadPool       Pool the work units are executed in
+/// \param[in]  program          Analyze settings, must live until the pool finished
+/// \param[in]  pipelineOrder    Pipeline execution order, must live until the pool finished
+/// \param[in]  imagesToProcess  Prepared images
+/// \return     Number of submitted work units
+///
+auto Processor::enqueueImages(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program,
+                              const PipelineOrder_t &pipelineOrder, const std::vector<std::shared_ptr<PipelineInitializer>> &imagesToProcess)
+    -> int32_t
+{
+  int32_t nrOfTiles = 0;
+  for(const auto &actImage : imagesToProcess) {
+    if(mGlobalContext->processedImages.contains(actImage->getImageId())) {
+      mProgress.incProcessedImages();
+      continue;
+    }
+    const auto [tilesX, tilesY] = actImage->getNrOfTilesToProcess();
+    const auto nrtStack         = actImage->getNrOfTStacksToProcess();
+    const auto nrzSTack         = actImage->getNrOfZStacksToProcess();
+
+    int32_t tStackStart = 0;
+    auto tStackEnd      = static_cast<int32_t>(nrtStack);
+    if(program.imageSetup.tStackSettings.startFrame > static_cast<int32_t>(nrtStack)) {
+      tStackStart = static_cast<int32_t>(nrtStack);
+    } else {
+      tStackStart = program.imageSetup.tStackSettings.startFrame;
+    }
+    if(program.imageSetup.tStackSettings.endFrame >= 0 && program.imageSetup.tStackSettings.endFrame <= static_cast<int32_t>(nrtStack)) {
+      tStackEnd = program.imageSetup.tStackSettings.endFrame;
+    }
+
+    if(mGlobalContext->objectTracking != nullptr) {
+      mGlobalContext->objectTracking->registerImage(actImage->getImageId(), tStackStart, tStackEnd, static_cast<int32_t>(nrzSTack),
+                                                    tilesX * tilesY);
+    }
+
+    //
+    // Work units already stored by an interrupted run of this job are skipped
+    //
+    std::vector<db::WorkUnit> workUnits;
+    for(int32_t tileX = 0; tileX < tilesX; tileX++) {
+      for(int32_t tileY = 0; tileY < tilesY; tileY++) {
+        for(int32_t tStack = tStackStart; tStack < tStackEnd; tStack++) {
+          for(int32_t zStack = 0; zStack < static_cast<int32_t>(nrzSTack); zStack++) {
+            db::WorkUnit unit{.imageId = actImage->getImageId(), .tileX = tileX, .tileY = tileY, .tStack = tStack, .zStack = zStack};
+            if(mGlobalContext->finishedWorkUnits.contains(unit)) {
+              if(mGlobalContext->objectTracking != nullptr) {
+                mGlobalContext->objectTracking->tileFinished(unit.imageId, tStack, zStack);
+              }
+            } else {
+              workUnits.push_back(unit);
+            }
+          }
+        }
+      }
+    }
+    if(workUnits.empty()) {
+      mGlobalContext->database->setImageProcessed(actImage->getImageId());
+      mProgress.incProcessedImages();
+      continue;
+    }
+
+    // Manual annotations are part of the object list and therefore of the pipeline cache key
+    const auto annotationPath = joda::helper::generateImageMetaDataStoragePathFromImagePath(
+        actImage->getImagePath(), program.getProjectPath(), joda::fs::FILE_NAME_ANNOTATIONS + joda::fs::EXT_ANNOTATION);
+
+    // The image is finished as soon as the last of its open work units is finished
+    auto openWorkUnits = std::make_shared<std::atomic<size_t>>(workUnits.size());
+    for(const auto &unit : workUnits) {
+      mBatchQueue->push([this, pool = threadPool.get(), &program, &pipelineOrder, actImage, unit, openWorkUnits, annotationPath]() {
+        if(mCancelAll.load(std::memory_order_relaxed)) {
+          return;
+        }
+        // Execute task
+        std::unique_ptr<Task<false>> taskToExecute = std::make_unique<Task<false>>(
+            &mProgress, mGlobalContext.get(), actImage.get(), program.getProjectPath(), &pipelineOrder, unit.tileX, unit.tileY, unit.tStack,
+            unit.zStack);
+        if(mGlobalContext->pipelineCache != nullptr) {
+          taskToExecute->setPipelineCacheKey(PipelineCache::calcTileKey(program, actImage->getImagePath(), annotationPath,
+                                                                        {unit.tileX, unit.tileY}, unit.tStack, unit.zStack));
+        }
+        taskToExecute->execute();
+        mProgress.incProcessedTiles();
+
+        // Image finished, the statistics are updated without blocking a worker of the job
+        if(openWorkUnits->fetch_sub(1) == 1) {
+          mBackgroundTasks.detach(*pool, joda::thread::TaskPriority::BACKGROUND, [this, actImage]() {
+            mGlobalContext->database->setImageProcessed(actImage->getImageId());
+            mProgress.incProcessedImages();
+          });
+        }
+      });
+      nrOfTiles++;
+    }
+  }
+  return nrOfTiles;
+}
+
+///
+/// \brief      Live mode: Polls the input folder for new images and adds them to the
+///             running job until the job is stopped, watching is stopped or no new
+///             image arrived for the idle timeout. The results of the new images are
+///             appended to the database of the job.
+/// \author     Joachim Danmayr
+/// \param[in]  threadPool       Pool the work units are executed in
+/// \param[in]  program          Analyze settings
+/// \param[in]  pipelineOrder    Pipeline execution order
+/// \param[in]  imagesToAnalyze  Images of the job, new images are added
+/// \param[in]  grouper          Grouper used for the images of the job
+/// \param[in]  liveMode         Live mode settings
+/// \param[out] nrOfImages       Total number of images of the job
+/// \param[out] nrOfTiles        Total number of work units of the job
+///
+void Processor::watchForNewImages(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program,
+                                  const PipelineOrder_t &pipelineOrder, imagesList_t &imagesToAnalyze, joda::grp::FileGrouper &grouper,
+                                  const LiveModeSettings &liveMode, uint32_t &nrOfImages, int32_t &nrOfTiles)
+{
+  static constexpr auto POLL_INTERVAL = std::chrono::seconds(1);
+
+  // The processing pool is busy with the images found before, new images are prepared in an own pool
+  auto preparePool  = std::make_unique<BS::priority_thread_pool>(2);
+  const auto &plate = program.projectSettings.plate;
+  auto lastNewImage = std::chrono::steady_clock::now();
+  mProgress.setWatchingForImages(true);
+  joda::log::logInfo("Live mode: Watching >" + imagesToAnalyze.getDirectoryAt().string() + "< for new images.");
+
+  while(!mCancelAll.load() && !mStopWatching.load()) {
+    std::this_thread::sleep_for(POLL_INTERVAL);
+    const auto now = std::chrono::steady_clock::now();
+    if(liveMode.idleTimeout.count() > 0 && now - lastNewImage >= liveMode.idleTimeout) {
+      joda::log::logInfo("Live mode: No new images arrived, stop watching.");
+      break;
+    }
+    const auto newImages = imagesToAnalyze.lookForNewImages(liveMode.settleTime);
+    if(newImages.empty() || mCancelAll.load()) {
+      continue;
+    }
+    lastNewImage               = now;
+    const auto imagesToProcess = mGlobalContext->database->prepareImages(plate.plateId, program.imageSetup.series, grouper, newImages,
+                                                                         imagesToAnalyze.getDirectoryAt(), program, preparePool);
+    nrOfTiles += enqueueImages(threadPool, program, pipelineOrder, imagesToProcess);
+    nrOfImages += static_cast<uint32_t>(imagesToProcess.size());
+    mProgress.setTotalNrOfImages(nrOfImages);
+    mProgress.setTotalNrOfTiles(static_cast<uint32_t>(nrOfTiles));
+    joda::log::logInfo("Live mode: Added >" + std::to_string(imagesToProcess.size()) + "< new images.");
+  }
+  mProgress.setWatchingForImages(false);
+}
+
 ///
 /// \brief
 /// \author
@@ -281,10 +673,10 @@ void Processor::execute(std::unique_ptr<BS::thread_pool<>> &threadPool, const jo
 /// \param[out]
 /// \return
 ///
-auto Processor::generatePreview(std::unique_ptr<BS::thread_pool<>> &threadPool, const PreviewSettings & /*previewSettings*/,
+auto Processor::generatePreview(std::unique_ptr<BS::priority_thread_pool> &threadPool, const PreviewSettings & /*previewSettings*/,
                                 const settings::ProjectImageSetup &imageSetup, const settings::AnalyzeSettings &program,
                                 const settings::Pipeline &pipelineStart, const std::filesystem::path &imagePath, int32_t tStack, int32_t zStack,
-                                int32_t tileX, int32_t tileY, const ome::OmeInfo &ome, Preview &previewOut) -> void
+                                int32_t tileX, int32_t tileY, const ome::OmeInfo &ome, Preview &previewOut, PreviewCache *previewCache) -> void
 {
   DurationCount durationCount("Generate preview.");
 
@@ -305,6 +697,11 @@ auto Processor::generatePreview(std::unique_ptr<BS::thread_pool<>> &threadPool,
   //
   std::unique_ptr<Task<true>> task = std::make_unique<Task<true>>(&mProgress, globalContext.get(), &imageLoader, program.getProjectPath(),
                                                                   &pipelineOrder, tileX, tileY, tStack, zStack);
+  if(previewCache != nullptr) {
+    const auto annotationPath = joda::helper::generateImageMetaDataStoragePathFromImagePath(
+        imagePath, program.getProjectPath(), joda::fs::FILE_NAME_ANNOTATIONS + joda::fs::EXT_ANNOTATION);
+    task->setPreviewCache(previewCache, PipelineCache::calcTileKey(program, imagePath, annotationPath, {tileX, tileY}, tStack, zStack));
+  }
 
   task->execute(threadPool.get(), &pipelineStart);
 
@@ -330,7 +727,9 @@ auto Processor::generatePreview(std::unique_ptr<BS::thread_pool<>> &threadPool,
 /// \return
 ///
 template <class DATABASE_TYPE>
-std::unique_ptr<GlobalContext> Processor::initializeGlobalContext(const joda::settings::AnalyzeSettings &program, const std::string &jobName)
+std::unique_ptr<GlobalContext> Processor::initializeGlobalContext(const joda::settings::AnalyzeSettings &program, const std::string &jobName,
+                                                                  const std::optional<std::filesystem::path> &resumeDatabase,
+                                                                  const std::optional<ShardSettings> &shard)
 {
   std::unique_ptr<GlobalContext> globalContext = std::make_unique<GlobalContext>();
 
@@ -343,25 +742,97 @@ std::unique_ptr<GlobalContext> Processor::initializeGlobalContext(const joda::se
   globalContext->workingDirectory = program.getProjectPath();
 
   if constexpr(std::is_base_of_v<db::Database, DATABASE_TYPE>) {
-    globalContext->resultsOutputFolder = std::filesystem::path(program.projectSettings.plate.imageFolder) / joda::fs::WORKING_DIRECTORY_PROJECT_PATH /
-                                         joda::fs::RESULTS_PATH / (joda::helper::timepointToIsoString(now) + "_" + jobName);
+    if(resumeDatabase.has_value()) {
+      globalContext->resultsOutputFolder = resumeDatabase->parent_path();
+    } else {
+      globalContext->resultsOutputFolder = std::filesystem::path(program.projectSettings.plate.imageFolder) /
+                                           joda::fs::WORKING_DIRECTORY_PROJECT_PATH / joda::fs::RESULTS_PATH /
+                                           (joda::helper::timepointToIsoString(now) + "_" + jobName);
+      if(shard.has_value()) {
+        globalContext->resultsOutputFolder += "_shard_" + std::to_string(shard->index) + "_of_" + std::to_string(shard->count);
+      }
+    }
   } else if constexpr(std::is_base_of_v<db::PreviewDatabase, DATABASE_TYPE>) {
     globalContext->resultsOutputFolder = program.getProjectPath() / joda::fs::RESULTS_PATH / jobName;
   }
 
   std::filesystem::create_directories(globalContext->resultsOutputFolder);
 
-  globalContext->resultsDatabaseFilePath = globalContext->resultsOutputFolder / (joda::fs::FILE_NAME_RESULTS_DATABASE + joda::fs::EXT_DATABASE);
+  globalContext->resultsDatabaseFilePath =
+      resumeDatabase.value_or(globalContext->resultsOutputFolder / (joda::fs::FILE_NAME_RESULTS_DATABASE + joda::fs::EXT_DATABASE));
 
-  globalContext->database = std::make_unique<DATABASE_TYPE>();
-  globalContext->database->openDatabase(globalContext->resultsOutputFolder / (joda::fs::FILE_NAME_RESULTS_DATABASE + joda::fs::EXT_DATABASE));
-  globalContext->jobId            = globalContext->database->startJob(program, jobName);
+  auto database = std::make_unique<DATABASE_TYPE>();
+  database->openDatabase(globalContext->resultsDatabaseFilePath);
+  if constexpr(std::is_base_of_v<db::Database, DATABASE_TYPE>) {
+    if(resumeDatabase.has_value()) {
+      auto resumeInfo                  = database->resumeJob(program);
+      globalContext->jobId             = resumeInfo.jobId;
+      globalContext->finishedWorkUnits = std::move(resumeInfo.finishedWorkUnits);
+      globalContext->processedImages   = std::move(resumeInfo.processedImages);
+      // Objects of the new work units must not reuse the IDs of the stored ones
+      joda::atom::ROI::continueIdsAfter(resumeInfo.lastObjectId, resumeInfo.lastTrackingId);
+    } else {
+      globalContext->jobId = database->startJob(program, jobName);
+    }
+  } else {
+    globalContext->jobId = database->startJob(program, jobName);
+  }
+  globalContext->database         = std::move(database);
   globalContext->jobName          = jobName;
   globalContext->timestampStarted = now;
+  globalContext->profiling        = program.pipelineSetup.profiling;
+  if constexpr(std::is_base_of_v<db::Database, DATABASE_TYPE>) {
+    globalContext->objectTracking = std::make_unique<data_analyze::object_tracker::TrackingManager>(globalContext->database.get());
+    if(program.pipelineSetup.cacheIntermediateResults) {
+      globalContext->pipelineCache =
+          std::make_shared<PipelineCache>(PipelineCache::getCacheFolder(std::filesystem::path(program.projectSettings.plate.imageFolder)));
+    }
+  }
 
   return globalContext;
 }
 
+///
+/// \brief      Selects the images of one shard. All images are assigned to their group in
+///             sorted order first, this way the group IDs and image indexes are the same
+///             in every shard. The groups are distributed round robin over the shards,
+///             if there are fewer groups than shards the images are distributed instead.
+/// \author     Joachim Danmayr
+/// \param[in]  images   All images of the job
+/// \param[in]  grouper  Grouper used to prepare the images of this shard
+/// \param[in]  shard    Shard to select
+/// \return     Images of the shard in sorted order
+///
+auto Processor::selectShard(const std::vector<std::filesystem::path> &images, joda::grp::FileGrouper &grouper, const ShardSettings &shard)
+    -> std::vector<std::filesystem::path>
+{
+  if(shard.count == 0 || shard.index >= shard.count) {
+    throw std::invalid_argument("Shard index must be lower than the number of shards!");
+  }
+  auto sortedImages = images;
+  std::sort(sortedImages.begin(), sortedImages.end());
+
+  std::vector<uint16_t> groupOfImage;
+  std::set<uint16_t> groups;
+  groupOfImage.reserve(sortedImages.size());
+  for(const auto &imagePath : sortedImages) {
+    groupOfImage.push_back(grouper.getGroupForFilename(imagePath).groupId);
+    groups.emplace(groupOfImage.back());
+  }
+
+  const bool distributeGroups = groups.size() >= shard.count;
+  std::vector<std::filesystem::path> shardImages;
+  for(size_t n = 0; n < sortedImages.size(); n++) {
+    const size_t slot = distributeGroups ? groupOfImage[n] : n;
+    if(slot % shard.count == shard.index) {
+      shardImages.push_back(sortedImages[n]);
+    }
+  }
+  joda::log::logInfo("Shard " + std::to_string(shard.index) + "/" + std::to_string(shard.count) + " analyzes " +
+                     std::to_string(shardImages.size()) + " of " + std::to_string(sortedImages.size()) + " images.");
+  return shardImages;
+}
+
 ///
 /// \brief
 /// \author     Joachim Danmayr
@@ -13,15 +13,19 @@
 ///
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include "backend/enums/enum_images.hpp"
 #include "backend/enums/types.hpp"
 #include "backend/global_enums.hpp"
 #include "backend/helper/file_grouper/file_grouper.hpp"
 #include "backend/helper/file_parser/directory_iterator.hpp"
 #include "backend/helper/image/image.hpp"
+#include "backend/helper/threading/task_scheduler.hpp"
+#include "backend/processor/cache/preview_cache.hpp"
 #include "backend/processor/context/process_context.hpp"
 #include "backend/processor/dependency_graph.hpp"
 #include "backend/settings/analze_settings.hpp"
@@ -37,6 +41,29 @@ struct PreviewSettings
 {
 };
 
+///
+/// \brief      Live mode settings. In live mode the input folder is watched while the
+///             job is running and new images are added to the job.
+/// \author     Joachim Danmayr
+///
+struct LiveModeSettings
+{
+  std::chrono::seconds settleTime  = std::chrono::seconds(5);    // An image is added if it did not change for this time
+  std::chrono::seconds idleTimeout = std::chrono::seconds(0);    // The job is finished if no new image arrived for this time, 0 = never
+};
+
+///
+/// \brief      Sharded execution. The sorted image list is split by group into count
+///             deterministic slices, only the slice with the given index is analyzed.
+///             The shard databases can be combined with Database::mergeShards.
+/// \author     Joachim Danmayr
+///
+struct ShardSettings
+{
+  uint32_t index = 0;    // Slice to analyze, 0 <= index < count
+  uint32_t count = 1;    // Total number of shards
+};
+
 struct DisplayImages
 {
   joda::image::Image thumbnail;
@@ -83,6 +110,7 @@ public:
     totalNrOfTiles         = 0;
     processedNrOfTiles     = 0;
     processedPipelineSteps = 0;
+    watchingForImages      = false;
     mWhat.clear();
   }
 
@@ -130,6 +158,11 @@ public:
     mWhat = errorMsg;
   }
 
+  void setWatchingForImages(bool watching)
+  {
+    watchingForImages = watching;
+  }
+
   void setTotalNrOfImages(uint32_t images)
   {
     totalNrOfImages = images;
@@ -180,6 +213,11 @@ public:
     return state == ProcessState::FINISHED;
   }
 
+  bool isWatchingForImages() const
+  {
+    return watchingForImages;
+  }
+
   auto &what() const
   {
     return mWhat;
@@ -192,6 +230,7 @@ private:
   std::atomic<uint32_t> totalNrOfTiles         = 0;
   std::atomic<uint32_t> processedNrOfTiles     = 0;
   std::atomic<uint32_t> processedPipelineSteps = 0;
+  std::atomic<bool> watchingForImages          = false;
 
   std::string mWhat;
 };
@@ -202,14 +241,18 @@ public:
   /////////////////////////////////////////////////////
   Processor();
   void stop();
+  void stopWatching();
 
-  void execute(std::unique_ptr<BS::thread_pool<>> &threadPool, const joda::settings::AnalyzeSettings &program, const std::string &jobName,
-               const std::unique_ptr<imagesList_t> &imagesToAnalyze);
+  void execute(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program, const std::string &jobName,
+               const std::unique_ptr<imagesList_t> &imagesToAnalyze, const std::optional<std::filesystem::path> &resumeDatabase = std::nullopt,
+               const std::optional<LiveModeSettings> &liveMode = std::nullopt, const std::optional<ShardSettings> &shard = std::nullopt);
 
-  auto generatePreview(std::unique_ptr<BS::thread_pool<>> &threadPool, const PreviewSettings &previewSettings,
+  auto generatePreview(std::unique_ptr<BS::priority_thread_pool> &threadPool, const PreviewSettings &previewSettings,
                        const settings::ProjectImageSetup &imageSetup, const settings::AnalyzeSettings &settings, const settings::Pipeline &pipeline,
                        const std::filesystem::path &imagePath, int32_t tStack, int32_t zStack, int32_t tileX, int32_t tileY, const ome::OmeInfo &ome,
-                       Preview &previewOut) -> void;
+                       Preview &previewOut, PreviewCache *previewCache = nullptr) -> void;
+  static auto selectShard(const std::vector<std::filesystem::path> &images, joda::grp::FileGrouper &grouper, const ShardSettings &shard)
+      -> std::vector<std::filesystem::path>;
 
   const ProcessProgress &getProgress() const
   {
@@ -232,12 +275,22 @@ public:
 private:
   /////////////////////////////////////////////////////
   template <class DATABASE_TYPE>
-  std::unique_ptr<GlobalContext> initializeGlobalContext(const joda::settings::AnalyzeSettings &program, const std::string &jobName);
+  std::unique_ptr<GlobalContext> initializeGlobalContext(const joda::settings::AnalyzeSettings &program, const std::string &jobName,
+                                                         const std::optional<std::filesystem::path> &resumeDatabase = std::nullopt,
+                                                         const std::optional<ShardSettings> &shard                  = std::nullopt);
   void prepareOutputFolder(const joda::settings::AnalyzeSettings &program, const std::unique_ptr<GlobalContext> &globalContext) const;
+  auto enqueueImages(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program,
+                     const PipelineOrder_t &pipelineOrder, const std::vector<std::shared_ptr<PipelineInitializer>> &imagesToProcess) -> int32_t;
+  void watchForNewImages(std::unique_ptr<BS::priority_thread_pool> &threadPool, const joda::settings::AnalyzeSettings &program,
+                         const PipelineOrder_t &pipelineOrder, imagesList_t &imagesToAnalyze, joda::grp::FileGrouper &grouper,
+                         const LiveModeSettings &liveMode, uint32_t &nrOfImages, int32_t &nrOfTiles);
 
   /////////////////////////////////////////////////////
   ProcessProgress mProgress = {};
   std::unique_ptr<GlobalContext> mGlobalContext;
+  std::unique_ptr<joda::thread::BatchQueue> mBatchQueue;    // Work units of the running job
+  joda::thread::TaskGroup mBackgroundTasks;                 // Tasks of the running job, e.g. the statistics of finished images
   std::atomic<bool> mCancelAll{false};
+  std::atomic<bool> mStopWatching{false};
 };
 }    // namespace joda::processor
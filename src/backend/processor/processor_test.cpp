@@ -0,0 +1,76 @@
+///
+/// \file      processor_test.cpp
+/// \author    Joachim Danmayr
+/// \date      2026-10-18
+///
+/// \copyright Copyright 2019 Joachim Danmayr
+///            This software is licensed for **non-commercial** use only.
+///            Educational, research, and personal use are permitted.
+///            For **Commercial** please contact the copyright owner.
+///
+
+#include "backend/processor/processor.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "backend/enums/enums_grouping.hpp"
+#include "backend/helper/file_grouper/file_grouper.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+namespace joda::test {
+
+///
+/// \brief  All shards together contain each image exactly once and every shard assigns
+///         the same group ID and image index to an image as a grouper over all images
+/// \author Joachim Danmayr
+///
+TEST_CASE("processor::select_shard", "[processor]")
+{
+  // Five wells with four images each, not in sorted order
+  std::vector<std::filesystem::path> images;
+  for(int32_t img = 3; img >= 0; img--) {
+    for(const std::string well : {"C2", "A1", "B1", "A2", "C1"}) {
+      images.emplace_back("/plate/" + well + "/img_" + std::to_string(img) + ".tif");
+    }
+  }
+  auto sortedImages = images;
+  std::sort(sortedImages.begin(), sortedImages.end());
+
+  // OFF has one group only, this way the images are distributed instead of the groups
+  for(const auto groupBy : {enums::GroupBy::DIRECTORY, enums::GroupBy::OFF}) {
+    grp::FileGrouper reference(groupBy, "");
+    std::map<std::filesystem::path, grp::GroupInformation> expected;
+    for(const auto &image : sortedImages) {
+      expected.emplace(image, reference.getGroupForFilename(image));
+    }
+
+    for(const uint32_t count : {1U, 2U, 3U, 5U, 7U}) {
+      std::map<std::filesystem::path, int32_t> nrOfOccurrences;
+      size_t nrOfWrongGroups = 0;
+      for(uint32_t index = 0; index < count; index++) {
+        grp::FileGrouper grouper(groupBy, "");
+        for(const auto &image : processor::Processor::selectShard(images, grouper, {.index = index, .count = count})) {
+          nrOfOccurrences[image]++;
+          const auto group = grouper.getGroupForFilename(image);
+          nrOfWrongGroups += group.groupId != expected.at(image).groupId || group.imageIdx != expected.at(image).imageIdx ? 1 : 0;
+        }
+      }
+      INFO("Shards: " + std::to_string(count));
+      CHECK(nrOfWrongGroups == 0);
+      CHECK(nrOfOccurrences.size() == images.size());
+      for(const auto &[image, occurrences] : nrOfOccurrences) {
+        CHECK(occurrences == 1);
+      }
+    }
+  }
+
+  grp::FileGrouper grouper(enums::GroupBy::DIRECTORY, "");
+  CHECK_THROWS_AS(processor::Processor::selectShard(images, grouper, {.index = 2, .count = 2}), std::invalid_argument);
+  CHECK_THROWS_AS(processor::Processor::selectShard(images, grouper, {.index = 0, .count = 0}), std::invalid_argument);
+}
+
+}    // namespace joda::test
@@ -1,5 +1,6 @@
 #include "analze_settings.hpp"
 #include "backend/enums/enums_classes.hpp"
+#include "backend/helper/fnv1a.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/processor/dependency_graph.hpp"
 #include "backend/settings/settings.hpp"
@@ -38,11 +39,20 @@ void AnalyzeSettings::check() const
     }
   }
 
-  if(imageSetup.zStackHandling == ProjectImageSetup::ZStackHandling::EXACT_ONE) {
+  if(imageSetup.zStackHandling == ProjectImageSetup::ZStackHandling::EXACT_ONE ||
+     imageSetup.zStackHandling == ProjectImageSetup::ZStackHandling::VOLUME) {
     for(const auto &pip : pipelines) {
       CHECK_ERROR(pip.pipelineSetup.zStackIndex >= 0, "When processing exact one z stack image, define which one!");
     }
   }
+
+  if(imageSetup.zStackHandling != ProjectImageSetup::ZStackHandling::VOLUME) {
+    for(const auto &pip : pipelines) {
+      for(const auto &step : pip.pipelineSteps) {
+        CHECK_ERROR(!step.$volumeSegmentation.has_value() || step.disabled, "Volume segmentation needs the z-stack handling volume!");
+      }
+    }
+  }
   CHECK_INFO(true, "Okay");
 }
 
@@ -270,4 +280,29 @@ auto AnalyzeSettings::toResultsSettings() const -> ResultsSettings
                                     .distanceFromClasses = getPossibleDistanceClasses()});
 }
 
+///
+/// \brief      Hash over all settings which have an influence on the results.
+///             Used to check whether an interrupted job can be resumed with
+///             these settings. The image folder, experiment meta data and the
+///             profiling flag are not part of the hash.
+/// \author     Joachim Danmayr
+/// \return     FNV-1a hash of the JSON representation
+///
+auto AnalyzeSettings::getResultsRelevantHash() const -> uint64_t
+{
+  auto setup                     = pipelineSetup;
+  setup.profiling                = false;
+  setup.cacheIntermediateResults = false;
+
+  nlohmann::json json;
+  json["imageSetup"]     = imageSetup;
+  json["pipelineSetup"]  = setup;
+  json["pipelines"]      = pipelines;
+  json["classification"] = projectSettings.classification;
+  json["plateId"]        = projectSettings.plate.plateId;
+  json["groupBy"]        = projectSettings.plate.groupBy;
+  json["filenameRegex"]  = projectSettings.plate.filenameRegex;
+  return helper::calcFnv1a(json.dump());
+}
+
 }    // namespace joda::settings
@@ -56,6 +56,7 @@ public:
 
   auto checkForErrors() const -> std::vector<std::pair<std::string, SettingParserLog_t>>;
   auto toResultsSettings() const -> ResultsSettings;
+  auto getResultsRelevantHash() const -> uint64_t;
 
   auto getProjectPath() const -> std::filesystem::path;
   auto getProjectPathWithFileName() const -> std::filesystem::path
@@ -27,6 +27,8 @@
 #include "backend/commands/classification/reclassify/reclassify.hpp"
 #include "backend/commands/classification/reclassify/reclassify_settings.hpp"
 #include "backend/commands/classification/reclassify/reclassify_settings_ui.hpp"
+#include "backend/commands/classification/volume_segmentation/volume_segmentation.hpp"
+#include "backend/commands/classification/volume_segmentation/volume_segmentation_settings_ui.hpp"
 #include "backend/commands/command.hpp"
 #include "backend/commands/factory.hpp"
 #include "backend/commands/image_functions/blur/blur.hpp"
@@ -87,6 +89,8 @@
 #include "backend/commands/object_functions/measure_distance/measure_distance_settings_ui.hpp"
 #include "backend/commands/object_functions/measure_intensity/measure_intensity.hpp"
 #include "backend/commands/object_functions/measure_intensity/measure_intensity_settings_ui.hpp"
+#include "backend/commands/object_functions/object_tracking/object_tracking.hpp"
+#include "backend/commands/object_functions/object_tracking/object_tracking_settings_ui.hpp"
 #include "backend/commands/object_functions/object_transform/object_transform.hpp"
 #include "backend/commands/object_functions/object_transform/object_transform_settings_ui.hpp"
 #include "backend/commands/object_functions/objects_to_image/objects_to_image.hpp"
@@ -165,6 +169,7 @@ private:
     REGISTER_COMMAND(colocalization, Colocalization);
     REGISTER_COMMAND(measureIntensity, MeasureIntensity);
     REGISTER_COMMAND(measureDistance, MeasureDistance);
+    REGISTER_COMMAND(objectTracking, ObjectTracking);
     REGISTER_COMMAND(reclassify, Reclassify);
     REGISTER_COMMAND(voronoi, VoronoiGrid);
     REGISTER_COMMAND(thresholdValidator, ThresholdValidator);
@@ -183,6 +188,7 @@ private:
     REGISTER_COMMAND(morphologicalTransform, MorphologicalTransform);
     REGISTER_COMMAND(fillHoles, FillHoles);
     REGISTER_COMMAND(houghTransform, HoughTransform);
+    REGISTER_COMMAND(volumeSegmentation, VolumeSegmentation);
     REGISTER_COMMAND(enhanceContrast, EnhanceContrast);
     REGISTER_COMMAND(rank, RankFilter);
     REGISTER_COMMAND(skeletonize, Skeletonize);
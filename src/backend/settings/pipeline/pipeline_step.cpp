@@ -12,6 +12,7 @@
 #include <memory>
 #include "backend/commands/command.hpp"
 #include "backend/helper/logger/console_logger.hpp"
+#include "backend/helper/trace/trace.hpp"
 #include "pipeline_factory.hpp"
 
 namespace joda::settings {
@@ -21,9 +22,10 @@ void PipelineStep::operator()(processor::ProcessContext &context, cv::Mat &image
   if(disabled) {
     return;
   }
-  auto ret = PipelineFactory<joda::cmd::Command>::generate(*this);
-  DurationCount durationCountExec("Execute command");
+  static const auto SPAN_EXECUTE_COMMAND = joda::trace::Tracer::registerSpan("Execute command");
+  auto ret                               = PipelineFactory<joda::cmd::Command>::generate(*this);
   if(ret != nullptr) {
+    joda::trace::Span span(SPAN_EXECUTE_COMMAND, joda::trace::Tracer::registerType(typeid(*ret)));
     ret->execute(context, image, result);
   } else {
     joda::log::logWarning("Command is null!");
@@ -43,6 +45,35 @@ void PipelineStep::operator()(cv::Mat &image) const
   }
 }
 
+///
+/// \brief      Settings key of the command this step executes (e.g. rollingBall)
+/// \author     Joachim Danmayr
+///
+auto PipelineStep::getCommandName() const -> std::string
+{
+  const nlohmann::json json = *this;
+  for(const auto &[key, value] : json.items()) {
+    if(key.starts_with('$') && !value.is_null()) {
+      return key.substr(1);
+    }
+  }
+  return "";
+}
+
+///
+/// \brief      True if the step changes something outside of the processed image and
+///             objects (writes files, stores validities or tracking IDs). Such a step
+///             must be executed, even if its output is already known.
+/// \author     Joachim Danmayr
+///
+bool PipelineStep::hasSideEffects() const
+{
+  if(disabled) {
+    return false;
+  }
+  return $saveImage.has_value() || $thresholdValidator.has_value() || $noiseValidator.has_value() || $objectTracking.has_value();
+}
+
 void PipelineStep::check() const
 {
 }
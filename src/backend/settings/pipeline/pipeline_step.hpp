@@ -13,11 +13,13 @@
 
 #include <memory>
 #include <optional>
+#include <string>
 #include "backend/commands/classification/ai_classifier/ai_classifier_settings.hpp"
 #include "backend/commands/classification/classifier/classifier_settings.hpp"
 #include "backend/commands/classification/hough_transform/hough_transform_settings.hpp"
 #include "backend/commands/classification/pixel_classifier/pixel_classifier_settings.hpp"
 #include "backend/commands/classification/reclassify/reclassify_settings.hpp"
+#include "backend/commands/classification/volume_segmentation/volume_segmentation_settings.hpp"
 #include "backend/commands/image_functions/blur/blur_settings.hpp"
 #include "backend/commands/image_functions/color_filter/color_filter_settings.hpp"
 #include "backend/commands/image_functions/edge_detection_canny/edge_detection_canny_settings.hpp"
@@ -45,6 +47,7 @@
 #include "backend/commands/object_functions/colocalization/colocalization_settings.hpp"
 #include "backend/commands/object_functions/measure_distance/measure_distance_settings.hpp"
 #include "backend/commands/object_functions/measure_intensity/measure_intensity_settings.hpp"
+#include "backend/commands/object_functions/object_tracking/object_tracking_settings.hpp"
 #include "backend/commands/object_functions/object_transform/object_transform_settings.hpp"
 #include "backend/commands/object_functions/objects_to_image/objects_to_image_settings.hpp"
 #include "backend/commands/object_functions/validator_noise/validator_noise_settings.hpp"
@@ -117,10 +120,12 @@ public:
   std::optional<ClassifierSettings> $classify                   = std::nullopt;
   std::optional<AiClassifierSettings> $aiClassify               = std::nullopt;
   std::optional<PixelClassifierSettings> $pixelClassify         = std::nullopt;
+  std::optional<VolumeSegmentationSettings> $volumeSegmentation = std::nullopt;
   std::optional<ColocalizationSettings> $colocalization         = std::nullopt;
   std::optional<ReclassifySettings> $reclassify                 = std::nullopt;
   std::optional<MeasureIntensitySettings> $measureIntensity     = std::nullopt;
   std::optional<MeasureDistanceSettings> $measureDistance       = std::nullopt;
+  std::optional<ObjectTrackingSettings> $objectTracking         = std::nullopt;
   std::optional<ThresholdAdaptiveSettings> $thresholdAdaptive   = std::nullopt;
   std::optional<ThresholdSettings> $threshold                   = std::nullopt;
   std::optional<ImageSaverSettings> $saveImage                  = std::nullopt;
@@ -128,6 +133,8 @@ public:
   /////////////////////////////////////////////////////
   void operator()(processor::ProcessContext &context, cv::Mat &image, joda::atom::ObjectList &result) const;
   void operator()(cv::Mat &image) const;
+  [[nodiscard]] auto getCommandName() const -> std::string;
+  [[nodiscard]] bool hasSideEffects() const;
 
   void check() const;
 
@@ -137,7 +144,7 @@ public:
                                                        $intensityTransform, $colorFilter, $objectsToImage, $imageMath, $objectTransform,
                                                        $imageToCache, $morphologicalTransform, $fillHoles, $houghTransform, $enhanceContrast, $rank,
                                                        $skeletonize, $pixelClassify, $laplacian, $gaussianWeightedDev, $structureTensor, $hessian,
-                                                       $nop, disabled, locked);
+                                                       $nop, $objectTracking, $volumeSegmentation, disabled, locked);
 };
 
 }    // namespace joda::settings
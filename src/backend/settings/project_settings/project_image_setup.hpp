@@ -16,7 +16,8 @@ struct ProjectImageSetup
   enum class ZStackHandling
   {
     EXACT_ONE,
-    EACH_ONE
+    EACH_ONE,
+    VOLUME    // Like EXACT_ONE, volume segmentation steps load all z-stacks of the tile
   };
 
   enum class TStackHandling
@@ -130,8 +131,9 @@ struct ProjectImageSetup
   }
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ProjectImageSetup::ZStackHandling,
-                             {{ProjectImageSetup::ZStackHandling::EXACT_ONE, "ExactOne"}, {ProjectImageSetup::ZStackHandling::EACH_ONE, "EachOne"}});
+NLOHMANN_JSON_SERIALIZE_ENUM(ProjectImageSetup::ZStackHandling, {{ProjectImageSetup::ZStackHandling::EXACT_ONE, "ExactOne"},
+                                                                 {ProjectImageSetup::ZStackHandling::EACH_ONE, "EachOne"},
+                                                                 {ProjectImageSetup::ZStackHandling::VOLUME, "Volume"}});
 
 NLOHMANN_JSON_SERIALIZE_ENUM(ProjectImageSetup::TStackHandling, {
                                                                     {ProjectImageSetup::TStackHandling::EXACT_ONE, "ExactOne"},
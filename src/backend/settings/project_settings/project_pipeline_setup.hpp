@@ -19,10 +19,22 @@ struct ProjectPipelineSetup
   //
   enums::Units realSizesUnit = enums::Units::um;
 
+  //
+  // If enabled, wall time, CPU time, peak memory increase and number of objects
+  // of each executed pipeline step are stored in the results database.
+  //
+  bool profiling = false;
+
+  //
+  // If enabled, intermediate results of the pipeline steps are stored in the project folder.
+  // A re-run only executes the pipeline steps following the first changed one.
+  //
+  bool cacheIntermediateResults = false;
+
   void check() const
   {
   }
 
-  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT_EXTENDED(ProjectPipelineSetup, realSizesUnit);
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT_EXTENDED(ProjectPipelineSetup, realSizesUnit, profiling, cacheIntermediateResults);
 };
 }    // namespace joda::settings
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -120,6 +121,34 @@ public:
     return mUser;
   }
 
+  ///
+  /// \brief      Share of the CPU cores (0..1] a running job may use while the pipeline is edited
+  ///
+  [[nodiscard]] static auto getBatchShareWhileEditing() -> float
+  {
+    return batchShareWhileEditing;
+  }
+
+  static void setBatchShareWhileEditing(float share)
+  {
+    batchShareWhileEditing = share;
+    save();
+  }
+
+  ///
+  /// \brief      Memory in MB the intermediate results of the pipeline preview may use
+  ///
+  [[nodiscard]] static auto getPreviewCacheSizeMb() -> uint32_t
+  {
+    return previewCacheSizeMb;
+  }
+
+  static void setPreviewCacheSizeMb(uint32_t sizeMb)
+  {
+    previewCacheSizeMb = sizeMb;
+    save();
+  }
+
 private:
   static void addToVector(std::vector<Entry> &vec, const Entry &entry)
   {
@@ -135,8 +164,11 @@ private:
   static inline std::vector<Entry> lastOpenedResults;
   static inline bool showNewProjectDialogOnStartup = true;
   static inline DefaultJobMetaData mUser;
+  static inline float batchShareWhileEditing = 0.5F;
+  static inline uint32_t previewCacheSizeMb  = 512;
 
-  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(UserSettings, lastOpenedProjects, lastOpenedResults, showNewProjectDialogOnStartup, mUser);
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(UserSettings, lastOpenedProjects, lastOpenedResults, showNewProjectDialogOnStartup, mUser,
+                                              batchShareWhileEditing, previewCacheSizeMb);
 };
 
 }    // namespace joda::user_settings
@@ -22,6 +22,7 @@
 #include <utility>
 #include "backend/database/data/dashboard/data_dashboard.hpp"
 #include "backend/database/database.hpp"
+#include "backend/database/exporter/columnar/exporter_columnar.hpp"
 #include "backend/database/exporter/r/exporter_r.hpp"
 #include "backend/database/exporter/xlsx/exporter_xlsx.hpp"
 #include "backend/database/query/filter.hpp"
@@ -30,10 +31,13 @@
 #include "backend/enums/enum_measurements.hpp"
 #include "backend/enums/enums_classes.hpp"
 #include "backend/enums/types.hpp"
+#include "backend/helper/file_parser/file_index.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/helper/ome_parser/ome_info.hpp"
 #include "backend/helper/reader/image_reader.hpp"
 #include "backend/helper/system/system_resources.hpp"
+#include "backend/helper/threading/stripe_parallel.hpp"
+#include "backend/helper/threading/task_scheduler.hpp"
 #include "backend/helper/table/table.hpp"
 #include "backend/processor/context/process_context.hpp"
 #include "backend/processor/initializer/pipeline_initializer.hpp"
@@ -41,6 +45,7 @@
 #include "backend/settings/project_settings/project_class.hpp"
 #include "backend/settings/results_settings/results_settings.hpp"
 #include "backend/settings/settings.hpp"
+#include "backend/user_settings/user_settings.hpp"
 #include "ui/gui/helper/template_parser/template_parser.hpp"
 #include <nlohmann/json_fwd.hpp>
 #include <opencv2/core/mat.hpp>
@@ -112,7 +117,15 @@ void Controller::initApplication()
   // Init thread pool
   // ======================================
   const int32_t threads = std::max(1, (joda::system::getNrOfCPUs() - 1));
-  mGlobThreadPool       = std::make_unique<BS::thread_pool<>>(threads);
+  mGlobThreadPool       = std::make_unique<BS::priority_thread_pool>(threads);
+  joda::thread::StripeParallel::setThreadPool(mGlobThreadPool.get());
+  joda::filesystem::FileIndex::setThreadPool(mGlobThreadPool.get());
+  joda::thread::TaskScheduler::setBatchShareWhileEditing(user_settings::UserSettings::getBatchShareWhileEditing());
+
+  // ======================================
+  // Init preview cache
+  // ======================================
+  mPreviewCache = std::make_unique<processor::PreviewCache>(static_cast<size_t>(user_settings::UserSettings::getPreviewCacheSizeMb()) * 1024 * 1024);
 }
 
 ///
@@ -199,8 +212,11 @@ void Controller::preview(const settings::ProjectImageSetup &imageSetup, const pr
                          const settings::AnalyzeSettings &settings, const settings::Pipeline &pipeline, const std::filesystem::path &imagePath,
                          int32_t tileX, int32_t tileY, int32_t tStack, processor::Preview &previewOut, const joda::ome::OmeInfo &ome)
 {
+  // A running job leaves workers free for the previews of the next seconds
+  joda::thread::TaskScheduler::userIsEditing();
   processor::Processor process;
-  process.generatePreview(mGlobThreadPool, previewSettings, imageSetup, settings, pipeline, imagePath, tStack, 0, tileX, tileY, ome, previewOut);
+  process.generatePreview(mGlobThreadPool, previewSettings, imageSetup, settings, pipeline, imagePath, tStack, 0, tileX, tileY, ome, previewOut,
+                          mPreviewCache.get());
 }
 
 ///
@@ -213,24 +229,35 @@ auto Controller::loadImage(const std::filesystem::path &imagePath, uint16_t seri
                            const joda::settings::ProjectImageSetup::PhysicalSizeSettings &defaultPhysicalSizeSettings,
                            processor::DisplayImages &previewOut, joda::ome::OmeInfo &omeOut, enums::ZProjection zProjection) -> void
 {
-  {
-    std::lock_guard<std::mutex> lock(mReadMutex);
-    bool loadOme = false;
-    if(mLastImageReader == nullptr || mLastImageReader->getImagePath() != imagePath) {
-      mLastImageReader = std::make_unique<image::reader::ImageReader>(imagePath);
-      loadOme          = true;
-    }
+  loadOmeInformation(imagePath, defaultPhysicalSizeSettings, omeOut);
+  loadImage(imagePath, series, imagePlane, tileLoad, previewOut, &omeOut, zProjection);
+}
 
-    if(loadOme || omeOut.getNrOfSeries() == 0) {
-      ome::PhyiscalSize phys = {};
-      if(defaultPhysicalSizeSettings.mode == enums::PhysicalSizeMode::Manual) {
-        phys = joda::ome::PhyiscalSize{static_cast<double>(defaultPhysicalSizeSettings.pixelWidth),
-                                       static_cast<double>(defaultPhysicalSizeSettings.pixelHeight), 0, defaultPhysicalSizeSettings.pixelSizeUnit};
-      }
-      omeOut = mLastImageReader->getOmeInformation(phys);
+///
+/// \brief      Reads the OME information if another image than the last one
+///             is opened or the given information is empty
+/// \author
+/// \return
+///
+auto Controller::loadOmeInformation(const std::filesystem::path &imagePath,
+                                    const joda::settings::ProjectImageSetup::PhysicalSizeSettings &defaultPhysicalSizeSettings,
+                                    joda::ome::OmeInfo &omeOut) -> void
+{
+  std::lock_guard<std::mutex> lock(mReadMutex);
+  bool loadOme = false;
+  if(mLastImageReader == nullptr || mLastImageReader->getImagePath() != imagePath) {
+    mLastImageReader = std::make_unique<image::reader::ImageReader>(imagePath);
+    loadOme          = true;
+  }
+
+  if(loadOme || omeOut.getNrOfSeries() == 0) {
+    ome::PhyiscalSize phys = {};
+    if(defaultPhysicalSizeSettings.mode == enums::PhysicalSizeMode::Manual) {
+      phys = joda::ome::PhyiscalSize{static_cast<double>(defaultPhysicalSizeSettings.pixelWidth),
+                                     static_cast<double>(defaultPhysicalSizeSettings.pixelHeight), 0, defaultPhysicalSizeSettings.pixelSizeUnit};
     }
+    omeOut = mLastImageReader->getOmeInformation(phys);
   }
-  loadImage(imagePath, series, imagePlane, tileLoad, previewOut, &omeOut, zProjection);
 }
 
 ///
@@ -270,60 +297,8 @@ auto Controller::loadImage(const std::filesystem::path &imagePath, uint16_t seri
   }
 
   if(refreshImage) {
-    auto loadImageTile = [&tileLoad, series, &omeIn](int32_t z, int32_t c, int32_t t) {
-      return mLastImageReader->loadImageTile(joda::enums::PlaneId{.tStack = t, .zStack = z, .cStack = c}, series, 0, tileLoad, *omeIn);
-    };
-
-    //
-    // Do z -projection if activated
-    //
-    int32_t c  = imagePlane.cStack;
-    int32_t z  = imagePlane.zStack;
-    int32_t t  = imagePlane.tStack;
-    auto image = loadImageTile(z, c, t);
-
-    if(zProjection != enums::ZProjection::NONE && zProjection != enums::ZProjection::TAKE_MIDDLE) {
-      auto max = [&loadImageTile, &image, c, t](int zIdx) { image = cv::max(image, loadImageTile(zIdx, c, t)); };
-      auto min = [&loadImageTile, &image, c, t](int zIdx) { image = cv::min(image, loadImageTile(zIdx, c, t)); };
-      auto avg = [&loadImageTile, &image, c, t](int zIdx) {
-        auto tmp = loadImageTile(zIdx, c, t);
-        tmp.convertTo(tmp, CV_32SC1);
-        image = image + tmp;
-      };
-
-      std::function<void(int)> func = nullptr;
-      auto imageType                = image.type();
-
-      switch(zProjection) {
-        case enums::ZProjection::MAX_INTENSITY:
-          func = max;
-          break;
-        case enums::ZProjection::MIN_INTENSITY:
-          func = min;
-          break;
-        case enums::ZProjection::AVG_INTENSITY:
-          image.convertTo(image, CV_32SC1);    // Need to scale up because we are adding a lot of images to avoid overflow
-          func = avg;
-          break;
-        case enums::ZProjection::NONE:
-        case enums::ZProjection::$:
-        case enums::ZProjection::UNDEFINED:
-        case enums::ZProjection::TAKE_MIDDLE:
-          break;
-      }
-      if(func != nullptr) {
-        for(uint32_t zIdx = 1; zIdx < static_cast<uint32_t>(omeIn->getNrOfZStack(series)); zIdx++) {
-          func(static_cast<int32_t>(zIdx));
-        }
-      }
-      // Avg intensity projection
-      if(enums::ZProjection::AVG_INTENSITY == zProjection) {
-        image = image / omeIn->getNrOfZStack(series);
-        image.convertTo(image, imageType);    // no scaling
-      }
-    }
-
-    previewOut.originalImage.setImage(image, omeIn->getPseudoColorForChannel(series, c));
+    auto image = loadPlane(series, imagePlane, tileLoad, *omeIn, zProjection);
+    previewOut.originalImage.setImage(image, omeIn->getPseudoColorForChannel(series, imagePlane.cStack));
   }
 
   if(generateThumb) {
@@ -334,6 +309,116 @@ auto Controller::loadImage(const std::filesystem::path &imagePath, uint16_t seri
   previewOut.tStacks = omeIn->getNrOfTStack(series);
 }
 
+///
+/// \brief      Loads the given channels of one plane into the composite.
+///             Channels which are already resident for the same image, plane
+///             and tile are not loaded again. The single channel image of the
+///             actual channel is taken from the composite, only the thumbnail is read.
+/// \author
+/// \return
+///
+auto Controller::loadCompositeImage(const std::filesystem::path &imagePath, uint16_t series, const joda::enums::PlaneId &imagePlane,
+                                    const std::set<int32_t> &channels, const joda::ome::TileToLoad &tileLoad, const joda::ome::OmeInfo *omeIn,
+                                    enums::ZProjection zProjection, joda::image::CompositeImage &compositeOut,
+                                    processor::DisplayImages &previewOut) -> void
+{
+  if(nullptr == omeIn) {
+    return;
+  }
+  const int32_t tStack = imagePlane.tStack;
+  const int32_t zStack = imagePlane.zStack;
+  const joda::image::CompositeImage::Key key{
+      .imagePath = imagePath, .series = series, .tStack = tStack, .zStack = zStack, .tile = tileLoad, .zProjection = zProjection};
+  compositeOut.setKey(key);
+
+  std::lock_guard<std::mutex> lock(mReadMutex);
+  if(mLastImageReader == nullptr || mLastImageReader->getImagePath() != imagePath) {
+    mLastImageReader = std::make_unique<image::reader::ImageReader>(imagePath);
+  }
+
+  for(const int32_t channel : channels) {
+    if(compositeOut.isResident(key, channel)) {
+      continue;
+    }
+    auto image = loadPlane(series, joda::enums::PlaneId{.tStack = tStack, .zStack = zStack, .cStack = channel}, tileLoad, *omeIn, zProjection);
+    compositeOut.setChannel(channel, image, omeIn->getPseudoColorForChannel(series, channel));
+  }
+
+  const auto pseudoColor = omeIn->getPseudoColorForChannel(series, imagePlane.cStack);
+  auto image             = compositeOut.getChannelPlane(key, imagePlane.cStack);
+  if(image.empty()) {
+    // Channel is not part of the composite
+    image = loadPlane(series, imagePlane, tileLoad, *omeIn, zProjection);
+  }
+  previewOut.originalImage.setImage(image, pseudoColor);
+  previewOut.thumbnail.setImage(mLastImageReader->loadThumbnail(imagePlane, series, *omeIn), pseudoColor);
+  previewOut.tStacks = omeIn->getNrOfTStack(series);
+}
+
+///
+/// \brief      Loads one plane of the actual image and applies the z-projection.
+///             mReadMutex must be locked and mLastImageReader must be opened.
+/// \author
+/// \return
+///
+auto Controller::loadPlane(uint16_t series, const joda::enums::PlaneId &imagePlane, const joda::ome::TileToLoad &tileLoad,
+                           const joda::ome::OmeInfo &omeIn, enums::ZProjection zProjection) -> cv::Mat
+{
+  auto loadImageTile = [&tileLoad, series, &omeIn](int32_t z, int32_t c, int32_t t) {
+    return mLastImageReader->loadImageTile(joda::enums::PlaneId{.tStack = t, .zStack = z, .cStack = c}, series, 0, tileLoad, omeIn);
+  };
+
+  //
+  // Do z -projection if activated
+  //
+  int32_t c  = imagePlane.cStack;
+  int32_t z  = imagePlane.zStack;
+  int32_t t  = imagePlane.tStack;
+  auto image = loadImageTile(z, c, t);
+
+  if(zProjection != enums::ZProjection::NONE && zProjection != enums::ZProjection::TAKE_MIDDLE) {
+    auto max = [&loadImageTile, &image, c, t](int zIdx) { image = cv::max(image, loadImageTile(zIdx, c, t)); };
+    auto min = [&loadImageTile, &image, c, t](int zIdx) { image = cv::min(image, loadImageTile(zIdx, c, t)); };
+    auto avg = [&loadImageTile, &image, c, t](int zIdx) {
+      auto tmp = loadImageTile(zIdx, c, t);
+      tmp.convertTo(tmp, CV_32SC1);
+      image = image + tmp;
+    };
+
+    std::function<void(int)> func = nullptr;
+    auto imageType                = image.type();
+
+    switch(zProjection) {
+      case enums::ZProjection::MAX_INTENSITY:
+        func = max;
+        break;
+      case enums::ZProjection::MIN_INTENSITY:
+        func = min;
+        break;
+      case enums::ZProjection::AVG_INTENSITY:
+        image.convertTo(image, CV_32SC1);    // Need to scale up because we are adding a lot of images to avoid overflow
+        func = avg;
+        break;
+      case enums::ZProjection::NONE:
+      case enums::ZProjection::$:
+      case enums::ZProjection::UNDEFINED:
+      case enums::ZProjection::TAKE_MIDDLE:
+        break;
+    }
+    if(func != nullptr) {
+      for(uint32_t zIdx = 1; zIdx < static_cast<uint32_t>(omeIn.getNrOfZStack(series)); zIdx++) {
+        func(static_cast<int32_t>(zIdx));
+      }
+    }
+    // Avg intensity projection
+    if(enums::ZProjection::AVG_INTENSITY == zProjection) {
+      image = image / omeIn.getNrOfZStack(series);
+      image.convertTo(image, imageType);    // no scaling
+    }
+  }
+  return image;
+}
+
 ///
 /// \brief
 /// \author
@@ -361,7 +446,8 @@ auto Controller::getImageProperties(const std::filesystem::path &imagePath,
 /// \return
 ///
 void Controller::start(const settings::AnalyzeSettings &settings, const std::string &jobName,
-                       const std::optional<std::filesystem::path> &fileToAnalyze)
+                       const std::optional<std::filesystem::path> &fileToAnalyze, const std::optional<std::filesystem::path> &resumeDatabase,
+                       const std::optional<processor::LiveModeSettings> &liveMode, const std::optional<processor::ShardSettings> &shard)
 {
   if(mActThread.joinable()) {
     mActThread.join();
@@ -369,13 +455,13 @@ void Controller::start(const settings::AnalyzeSettings &settings, const std::str
 
   mActProcessor.reset();
   mActProcessor = std::make_unique<processor::Processor>();
-  mActThread    = std::thread([this, settings, jobName, fileToAnalyze] {
+  mActThread    = std::thread([this, settings, jobName, fileToAnalyze, resumeDatabase, liveMode, shard] {
     auto imageList = std::make_unique<processor::imagesList_t>();
     mActProcessor->mutableProgress().setStateLookingForImages();
     imageList->setWorkingDirectory(settings.projectSettings.plate.imageFolder);
 
     if(fileToAnalyze.has_value()) {
-      imageList->addFile(fileToAnalyze.value());
+      imageList->setFilesList({fileToAnalyze.value()});
     } else {
       imageList->lookForImages();
     }
@@ -383,7 +469,9 @@ void Controller::start(const settings::AnalyzeSettings &settings, const std::str
     imageList->waitForFinished();
     mActProcessor->mutableProgress().setRunningPreparingPipeline();
 
-    mActProcessor->execute(mGlobThreadPool, settings, jobName, imageList);
+    // Watching the folder makes no sense if only a single file is analyzed
+    mActProcessor->execute(mGlobThreadPool, settings, jobName, imageList, resumeDatabase, fileToAnalyze.has_value() ? std::nullopt : liveMode,
+                           shard);
   });
 }
 
@@ -400,6 +488,19 @@ void Controller::stop()
   throw std::runtime_error("No job running!");
 }
 
+///
+/// \brief      Live mode: Stops watching the input folder, the job finishes
+///             the images found so far
+/// \author     Joachim Danmayr
+///
+void Controller::stopWatching()
+{
+  if(mActProcessor) {
+    return mActProcessor->stopWatching();
+  }
+  throw std::runtime_error("No job running!");
+}
+
 ///
 /// \brief
 /// \author
@@ -527,6 +628,15 @@ void Controller::exportData(const std::filesystem::path &pathToDbFile, const jod
   filter.setFilter(static_cast<uint8_t>(settings.filter.plateId), {static_cast<uint16_t>(groupId)}, settings.filter.tStack, {imageId});
 
   joda::log::logInfo("Export started!");
+  if(settings.format == exporter::xlsx::ExportSettings::ExportFormat::CSV ||
+     settings.format == exporter::xlsx::ExportSettings::ExportFormat::PARQUET) {
+    // Streamed by the database, the table is never built in memory
+    auto format = settings.format == exporter::xlsx::ExportSettings::ExportFormat::CSV ? db::CopyFormat::CSV : db::CopyFormat::PARQUET;
+    joda::exporter::columnar::Exporter::startExport(analyzer.get(), filter, settings.view, format, outputFilePath);
+    joda::log::logInfo("Export finished!");
+    return;
+  }
+
   auto grouping = db::StatsPerGroup::Grouping::BY_IMAGE;
   joda::table::Table dataToExport;
   int32_t imgWidth  = 0;
@@ -14,12 +14,14 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <set>
 #include <vector>
 #include "backend/database/exporter/xlsx/exporter_xlsx.hpp"
 #include "backend/enums/enums_classes.hpp"
 #include "backend/enums/types.hpp"
 #include "backend/helper/file_parser/directory_iterator.hpp"
 #include "backend/helper/image/image.hpp"
+#include "backend/helper/image/image_composite.hpp"
 #include "backend/helper/ome_parser/ome_info.hpp"
 #include "backend/helper/reader/image_reader.hpp"
 #include "backend/helper/system/system_resources.hpp"
@@ -79,9 +81,22 @@ public:
                         const joda::ome::TileToLoad &tileLoad, processor::DisplayImages &previewOut, const joda::ome::OmeInfo *omeIn,
                         enums::ZProjection zProjection) -> void;
 
+  static auto loadOmeInformation(const std::filesystem::path &imagePath,
+                                 const joda::settings::ProjectImageSetup::PhysicalSizeSettings &defaultPhysicalSizeSettings,
+                                 joda::ome::OmeInfo &omeOut) -> void;
+
+  static auto loadCompositeImage(const std::filesystem::path &imagePath, uint16_t series, const joda::enums::PlaneId &imagePlane,
+                                 const std::set<int32_t> &channels, const joda::ome::TileToLoad &tileLoad, const joda::ome::OmeInfo *omeIn,
+                                 enums::ZProjection zProjection, joda::image::CompositeImage &compositeOut,
+                                 processor::DisplayImages &previewOut) -> void;
+
   // FLOW CONTROL ///////////////////////////////////////////////////
-  void start(const settings::AnalyzeSettings &settings, const std::string &jobName, const std::optional<std::filesystem::path> &fileToAnalyze);
+  void start(const settings::AnalyzeSettings &settings, const std::string &jobName, const std::optional<std::filesystem::path> &fileToAnalyze,
+             const std::optional<std::filesystem::path> &resumeDatabase = std::nullopt,
+             const std::optional<processor::LiveModeSettings> &liveMode = std::nullopt,
+             const std::optional<processor::ShardSettings> &shard       = std::nullopt);
   void stop();
+  void stopWatching();
   [[nodiscard]] auto getState() const -> const joda::processor::ProcessProgress &;
   [[nodiscard]] auto getJobInformation() const -> const std::unique_ptr<processor::GlobalContext> &;
 
@@ -91,6 +106,10 @@ public:
                   const std::filesystem::path &outputFilePath, const std::optional<std::list<joda::settings::Class>> &classesList);
 
 private:
+  /////////////////////////////////////////////////////
+  static auto loadPlane(uint16_t series, const joda::enums::PlaneId &imagePlane, const joda::ome::TileToLoad &tileLoad,
+                        const joda::ome::OmeInfo &omeIn, enums::ZProjection zProjection) -> cv::Mat;
+
   /////////////////////////////////////////////////////
   processor::imagesList_t mWorkingDirectory;
   std::unique_ptr<processor::Processor> mActProcessor;
@@ -98,7 +117,8 @@ private:
 
   static inline std::mutex mReadMutex;
   static inline std::unique_ptr<image::reader::ImageReader> mLastImageReader;
-  static inline std::unique_ptr<BS::thread_pool<>> mGlobThreadPool;
+  static inline std::unique_ptr<BS::priority_thread_pool> mGlobThreadPool;
+  static inline std::unique_ptr<processor::PreviewCache> mPreviewCache;    // Intermediate results of the previews
 };
 
 }    // namespace joda::ctrl
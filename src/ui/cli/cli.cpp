@@ -12,17 +12,20 @@
 ///
 
 #include "cli.hpp"
+#include <chrono>
 #include <exception>
 #include <memory>
 #include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 #include "CLI/CLI.hpp"
 #include "backend/database/database.hpp"
 #include "backend/database/query/filter.hpp"
 #include "backend/helper/helper.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/helper/random_name_generator.hpp"
+#include "backend/processor/cache/pipeline_cache.hpp"
 #include "backend/settings/settings.hpp"
 #include "controller/controller.hpp"
 #include "ui/gui/helper/template_parser/template_parser.hpp"
@@ -175,6 +178,15 @@ int Cli::startCommandLineController(int argc, char *argv[])
   std::string projectFilePath;
   std::string workingDirectory;
   std::string jobName;
+  std::string resumeDatabase;
+  bool profiling                = false;
+  bool cacheIntermediateResults = false;
+  bool clearCache               = false;
+  bool liveMode                 = false;
+  int32_t settleTime            = 5;
+  int32_t idleTimeout           = 0;
+  uint32_t shardIndex           = 0;
+  uint32_t shardCount           = 0;
   auto *run = app.add_subcommand("run", "Run an analyzes");
   run->add_option("-p,--project", projectFilePath, "ImageC project settings file (*.icproj)")
       ->check(FileExistsValidator())
@@ -182,6 +194,38 @@ int Cli::startCommandLineController(int argc, char *argv[])
       ->required();
   run->add_option("-i,--input-folder", workingDirectory, "Images folder")->check(DirectoryExistsValidator())->required();
   run->add_option("-n,--job-name", jobName, "Job name (optional)");
+  run->add_flag("--profile", profiling,
+                "Store wall time, CPU time and number of objects of each pipeline step in the results database, view them with "
+                "'database view profiling'");
+  run->add_flag("--cache", cacheIntermediateResults,
+                "Store intermediate pipeline results in the project folder, a re-run only executes the changed pipeline steps");
+  run->add_flag("--clear-cache", clearCache, "Remove all intermediate pipeline results stored in the project folder before the job is started");
+  run->add_option("--resume", resumeDatabase, "Continue the interrupted job stored in this results database (*.icdb)")
+      ->check(FileExistsValidator())
+      ->check(FileValidator(".icdb"));
+  auto *liveFlag = run->add_flag("--live", liveMode, "Watch the input folder and add new images to the running job");
+  run->add_option("--settle-time", settleTime, "Live mode: Seconds a new image must not change before it is analyzed [5]")
+      ->check(CLI::NonNegativeNumber);
+  run->add_option("--idle-timeout", idleTimeout, "Live mode: Finish the job if no new image arrived for this seconds, 0 = never [0]")
+      ->check(CLI::NonNegativeNumber);
+  auto *shardCountOpt = run->add_option("--shard-count", shardCount, "Split the job into this number of shards, each stored in its own database")
+                            ->check(CLI::PositiveNumber)
+                            ->excludes(liveFlag);
+  run->add_option("--shard-index", shardIndex, "Shard to analyze (0, 1,..., shard-count - 1), combine the shards with 'merge'")
+      ->check(CLI::NonNegativeNumber)
+      ->needs(shardCountOpt);
+
+  // =====================================
+  // Merge subcommand
+  // =====================================
+  std::vector<std::string> shardDatabases;
+  std::string mergedDatabase;
+  auto *mergeCmd = app.add_subcommand("merge", "Merge the results databases of a sharded job");
+  mergeCmd->add_option("-o,--outfile", mergedDatabase, "Output database file (*.icdb)")->check(FileValidator(".icdb"))->required();
+  mergeCmd->add_option("shards", shardDatabases, "Results databases of the shards (*.icdb)")
+      ->check(FileExistsValidator())
+      ->check(FileValidator(".icdb"))
+      ->required();
 
   // =====================================
   // Export subcommand
@@ -198,7 +242,9 @@ int Cli::startCommandLineController(int argc, char *argv[])
       ->check(FileValidator(".icdb"))
       ->required();
   export_cmd->add_option("-o,--outpath", outfile, "Output folder");
-  export_cmd->add_option("-f,--format", format, "Output format (xlsx, r) [xlsx].")->check(CLI::IsMember({"xlsx", "r"}))->default_val("xlsx");
+  export_cmd->add_option("-f,--format", format, "Output format (xlsx, r, csv, parquet) [xlsx].")
+      ->check(CLI::IsMember({"xlsx", "r", "csv", "parquet"}))
+      ->default_val("xlsx");
   export_cmd->add_option("-s,--style", style, "Output style (table, heatmap) [table].")
       ->check(CLI::IsMember({"table", "heatmap"}))
       ->default_val("table");
@@ -226,7 +272,9 @@ int Cli::startCommandLineController(int argc, char *argv[])
       ->check(FileValidator(".icdb"))
       ->required();
   auto *dbView = databaseCmd->add_subcommand("view", "View some content of the database");
-  dbView->add_option("target", target, "Must be either 'wells' or 'images'")->required()->check(CLI::IsMember({"wells", "images"}));
+  dbView->add_option("target", target, "Must be either 'wells', 'images' or 'profiling'")
+      ->required()
+      ->check(CLI::IsMember({"wells", "images", "profiling"}));
 
   CLI11_PARSE(app, argc, argv);
 
@@ -243,7 +291,30 @@ int Cli::startCommandLineController(int argc, char *argv[])
 
   if(run->parsed()) {
     // Run logic
-    startAnalyze(std::filesystem::path(projectFilePath), workingDirectory, jobName);
+    std::optional<std::filesystem::path> resume;
+    if(!resumeDatabase.empty()) {
+      resume = std::filesystem::path(resumeDatabase);
+    }
+    std::optional<processor::LiveModeSettings> live;
+    if(liveMode) {
+      live = processor::LiveModeSettings{.settleTime = std::chrono::seconds(settleTime), .idleTimeout = std::chrono::seconds(idleTimeout)};
+    }
+    std::optional<processor::ShardSettings> shard;
+    if(shardCount > 0) {
+      if(shardIndex >= shardCount) {
+        joda::log::logError("The shard index must be lower than the shard count!");
+        ctrl::Controller::cleanShutdownApplication();
+        std::exit(1);
+      }
+      shard = processor::ShardSettings{.index = shardIndex, .count = shardCount};
+    }
+    if(clearCache) {
+      processor::PipelineCache::clear(processor::PipelineCache::getCacheFolder(std::filesystem::path(workingDirectory)));
+    }
+    startAnalyze(std::filesystem::path(projectFilePath), workingDirectory, jobName, profiling, cacheIntermediateResults, resume, live, shard);
+  } else if(mergeCmd->parsed()) {
+    std::vector<std::filesystem::path> shards(shardDatabases.begin(), shardDatabases.end());
+    mergeShards(shards, std::filesystem::path(mergedDatabase));
   } else if(export_cmd->parsed()) {
     // Export logic
     exporter::xlsx::ExportSettings::ExportView toExport;
@@ -273,7 +344,9 @@ int Cli::startCommandLineController(int argc, char *argv[])
 /// \param[out]
 /// \return
 ///
-void Cli::startAnalyze(const std::filesystem::path &pathToSettingsFile, const std::optional<std::string> &imagedInputFolder, std::string jobName)
+void Cli::startAnalyze(const std::filesystem::path &pathToSettingsFile, const std::optional<std::string> &imagedInputFolder, std::string jobName,
+                       bool profiling, bool cacheIntermediateResults, const std::optional<std::filesystem::path> &resumeDatabase,
+                       const std::optional<processor::LiveModeSettings> &liveMode, const std::optional<processor::ShardSettings> &shard)
 {
   joda::settings::AnalyzeSettings analyzeSettings;
 
@@ -310,6 +383,12 @@ void Cli::startAnalyze(const std::filesystem::path &pathToSettingsFile, const st
   if(imagedInputFolder.has_value()) {
     analyzeSettings.projectSettings.plate.imageFolder = imagedInputFolder.value();
   }
+  if(profiling) {
+    analyzeSettings.pipelineSetup.profiling = true;
+  }
+  if(cacheIntermediateResults) {
+    analyzeSettings.pipelineSetup.cacheIntermediateResults = true;
+  }
 
   // ==========================
   // Start job
@@ -317,8 +396,12 @@ void Cli::startAnalyze(const std::filesystem::path &pathToSettingsFile, const st
   if(jobName.empty()) {
     jobName = joda::helper::RandomNameGenerator::GetRandomName();
   }
-  mController->start(analyzeSettings, jobName, std::nullopt);
-  joda::log::logInfo("Job >" + jobName + "< started!");
+  mController->start(analyzeSettings, jobName, std::nullopt, resumeDatabase, liveMode, shard);
+  if(resumeDatabase.has_value()) {
+    joda::log::logInfo("Job >" + resumeDatabase->string() + "< resumed!");
+  } else {
+    joda::log::logInfo("Job >" + jobName + "< started!");
+  }
 
   // ==========================
   // Running
@@ -333,10 +416,17 @@ void Cli::startAnalyze(const std::filesystem::path &pathToSettingsFile, const st
       if(jobState.isFinished()) {
         break;
       }
+      if(jobState.getState() == processor::ProcessState::FINISHED_WITH_ERROR) {
+        joda::log::logError("Job >" + jobName + "< failed: " + jobState.what());
+        ctrl::Controller::cleanShutdownApplication();
+        std::exit(1);
+      }
 
       finishedTiles = static_cast<float>(jobState.finishedTiles());
       totalTiles    = static_cast<float>(jobState.totalTiles());
-      if(totalTiles > 0) {
+      if(jobState.isWatchingForImages() && finishedTiles >= totalTiles) {
+        joda::log::logProgress(1, "Waiting for new images");
+      } else if(totalTiles > 0) {
         joda::log::logProgress(finishedTiles / totalTiles, "Analyze running");
       } else {
         joda::log::logProgress(0, "Progress");
@@ -388,6 +478,12 @@ void Cli::exportData(const std::filesystem::path &pathToDatabasefile, std::files
     if(format == exporter::xlsx::ExportSettings::ExportSettings::ExportFormat::R) {
       fileName += fileNameSuffix + ".R";
     }
+    if(format == exporter::xlsx::ExportSettings::ExportSettings::ExportFormat::CSV) {
+      fileName += fileNameSuffix + ".csv";
+    }
+    if(format == exporter::xlsx::ExportSettings::ExportSettings::ExportFormat::PARQUET) {
+      fileName += fileNameSuffix + ".parquet";
+    }
 
     outputPath = pathToDatabasefile.parent_path() / fileName;
   }
@@ -418,6 +514,35 @@ void Cli::exportData(const std::filesystem::path &pathToDatabasefile, std::files
   std::exit(0);
 }
 
+///
+/// \brief      Combines the results databases of the shards of a job into one database
+/// \author     Joachim Danmayr
+/// \param[in]  shards      Results databases of the shards
+/// \param[in]  outputPath  Database to create, must not exist
+///
+void Cli::mergeShards(const std::vector<std::filesystem::path> &shards, const std::filesystem::path &outputPath)
+{
+  if(std::filesystem::exists(outputPath)) {
+    joda::log::logError("Output database >" + outputPath.string() + "< already exists!");
+    ctrl::Controller::cleanShutdownApplication();
+    std::exit(1);
+  }
+  try {
+    auto database = std::make_unique<joda::db::Database>();
+    database->openDatabase(outputPath);
+    database->mergeShards(shards);
+    database->closeDatabase();
+  } catch(const std::exception &ex) {
+    joda::log::logError("Could not merge shards. What: " + std::string(ex.what()));
+    std::filesystem::remove(outputPath);
+    ctrl::Controller::cleanShutdownApplication();
+    std::exit(1);
+  }
+  joda::log::logInfo("Shards merged to >" + outputPath.string() + "<!");
+  ctrl::Controller::cleanShutdownApplication();
+  std::exit(0);
+}
+
 ///
 /// \brief      Init logger
 ///             allowed inputs are: [off, error, warning, info, debug, trace]
@@ -480,6 +605,24 @@ void Cli::viewData(const std::filesystem::path &pathToDatabasefile, const std::s
       std::cout << std::left << std::setw(30) << std::to_string(image.imageId) << std::setw(40) << image.filename << "\n";
     }
   }
+
+  if(target == "profiling") {
+    auto profiling = analyzer->selectPipelineStepProfiling(analyzer->selectExperiment().jobId);
+    // Header
+    std::cout << std::left << std::setw(10) << "Pipeline" << std::setw(6) << "Step" << std::setw(30) << "Command" << std::setw(12) << "Executions"
+              << std::setw(14) << "Wall [ms]" << std::setw(14) << "CPU [ms]" << std::setw(12) << "Objects"
+              << "\n";
+    std::cout << std::string(98, '-') << "\n";
+    auto toMs = [](uint64_t ns) { return std::to_string(ns / 1000000); };
+    for(size_t n = 0; n < profiling->RowCount(); n++) {
+      const auto stepIdx = profiling->GetValue(1, n).GetValue<int32_t>();
+      std::cout << std::left << std::setw(10) << profiling->GetValue(0, n).GetValue<int32_t>() << std::setw(6)
+                << (stepIdx < 0 ? "all" : std::to_string(stepIdx)) << std::setw(30) << profiling->GetValue(2, n).ToString()
+                << std::setw(12) << profiling->GetValue(3, n).GetValue<uint64_t>() << std::setw(14)
+                << toMs(profiling->GetValue(4, n).GetValue<uint64_t>()) << std::setw(14) << toMs(profiling->GetValue(5, n).GetValue<uint64_t>())
+                << std::setw(12) << profiling->GetValue(6, n).GetValue<uint64_t>() << "\n";
+    }
+  }
 }
 
 auto toFormatEnum(const std::string &type) -> exporter::xlsx::ExportSettings::ExportSettings::ExportFormat
@@ -489,6 +632,10 @@ auto toFormatEnum(const std::string &type) -> exporter::xlsx::ExportSettings::Ex
     typeEnum = exporter::xlsx::ExportSettings::ExportSettings::ExportFormat::XLSX;
   } else if(type == "r") {
     typeEnum = exporter::xlsx::ExportSettings::ExportFormat::R;
+  } else if(type == "csv") {
+    typeEnum = exporter::xlsx::ExportSettings::ExportFormat::CSV;
+  } else if(type == "parquet") {
+    typeEnum = exporter::xlsx::ExportSettings::ExportFormat::PARQUET;
   } else {
     joda::log::logError("Invalid export type!");
     ctrl::Controller::cleanShutdownApplication();
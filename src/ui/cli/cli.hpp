@@ -16,7 +16,9 @@
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <vector>
 #include "backend/database/exporter/xlsx/exporter_xlsx.hpp"
+#include "backend/processor/processor.hpp"
 
 namespace joda::ctrl {
 class Controller;
@@ -30,7 +32,10 @@ public:
   /////////////////////////////////////////////////////
   Cli();
   int startCommandLineController(int argc, char *argv[]);
-  void startAnalyze(const std::filesystem::path &pathToSettingsFile, const std::optional<std::string> &imagedInputFolder, std::string jobName);
+  void startAnalyze(const std::filesystem::path &pathToSettingsFile, const std::optional<std::string> &imagedInputFolder, std::string jobName,
+                    bool profiling, bool cacheIntermediateResults, const std::optional<std::filesystem::path> &resumeDatabase,
+                    const std::optional<processor::LiveModeSettings> &liveMode, const std::optional<processor::ShardSettings> &shard);
+  void mergeShards(const std::vector<std::filesystem::path> &shards, const std::filesystem::path &outputPath);
 
   void exportData(const std::filesystem::path &pathToDatabasefile, std::filesystem::path outputPath,
                   exporter::xlsx::ExportSettings::ExportSettings::ExportFormat type, exporter::xlsx::ExportSettings::ExportStyle formatEnum,
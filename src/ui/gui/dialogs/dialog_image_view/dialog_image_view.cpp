@@ -241,6 +241,13 @@ DialogImageViewer::DialogImageViewer(QWidget *parent, const std::shared_ptr<atom
     connect(showThumbnail, &QAction::triggered, this, &DialogImageViewer::onShowThumbnailChanged);
     toolbarTop->addAction(showThumbnail);
 
+    auto *showComposite = new QAction(generateSvgIcon<Style::REGULAR, Color::BLACK>("circles-three"), "Composite");
+    showComposite->setStatusTip("Show all channels blended together");
+    showComposite->setCheckable(true);
+    showComposite->setChecked(false);
+    connect(showComposite, &QAction::triggered, this, &DialogImageViewer::onShowCompositeChanged);
+    toolbarTop->addAction(showComposite);
+
     toolbarTop->addSeparator();
 
     if(toolbarParent == nullptr) {
@@ -564,6 +571,18 @@ void DialogImageViewer::onShowThumbnailChanged(bool checked)
   mImagePanel->setShowThumbnail(checked);
 }
 
+///
+/// \brief
+/// \author
+/// \param[in]
+/// \param[out]
+/// \return
+///
+void DialogImageViewer::onShowCompositeChanged(bool checked)
+{
+  mImagePanel->setCompositeMode(checked);
+}
+
 ///
 /// \brief
 /// \author
@@ -139,6 +139,7 @@ private slots:
   void onZoomOutClicked();
   void onZoomInClicked();
   void onShowThumbnailChanged(bool checked);
+  void onShowCompositeChanged(bool checked);
   void onShowCrossHandCursor(bool checked);
   void onSettingsChanged();
 };
@@ -196,23 +196,32 @@ void PanelImageView::loadImageThread(std::filesystem::path imagePath, const ome:
       mTile.tileX = 0;
       mTile.tileY = 0;
     }
-
-    try {
-      joda::ctrl::Controller::loadImage(imagePath, static_cast<uint16_t>(mSeries), mPlane, mTile, *previewImage, &mOmeInfo, mZprojection);
-    } catch(const std::exception &ex) {
-      joda::log::logWarning("Could not open image: " + std::string(ex.what()));
-    }
-
   } else {
     if(mPlane.tStack >= mOmeInfo.getNrOfTStack(mSeries)) {
       mPlane.tStack = mOmeInfo.getNrOfTStack(mSeries) - 1;
     }
-    try {
+  }
+
+  try {
+    if(mCompositeMode) {
+      // Only channels which are not resident yet are read, the actual channel is taken from the composite
+      if(!loadOme) {
+        joda::ctrl::Controller::loadOmeInformation(imagePath, mDefaultPhysicalSize, mOmeInfo);
+      }
+      std::set<int32_t> channels;
+      for(int32_t c = 0; c < mOmeInfo.getNrOfChannels(mSeries); c++) {
+        channels.emplace(c);
+      }
+      joda::ctrl::Controller::loadCompositeImage(imagePath, static_cast<uint16_t>(mSeries), mPlane, channels, mTile, &mOmeInfo, mZprojection,
+                                                 mCompositeImage, *previewImage);
+    } else if(loadOme) {
+      joda::ctrl::Controller::loadImage(imagePath, static_cast<uint16_t>(mSeries), mPlane, mTile, *previewImage, &mOmeInfo, mZprojection);
+    } else {
       joda::ctrl::Controller::loadImage(imagePath, static_cast<uint16_t>(mSeries), mPlane, mTile, mDefaultPhysicalSize, *previewImage, mOmeInfo,
                                         mZprojection);
-    } catch(const std::exception &ex) {
-      joda::log::logWarning("Could not open image: " + std::string(ex.what()));
     }
+  } catch(const std::exception &ex) {
+    joda::log::logWarning("Could not open image: " + std::string(ex.what()));
   }
 
   emit emitOpenImageFinished(imagePath, previewImage);
@@ -232,7 +241,12 @@ void PanelImageView::openImageFinished(std::filesystem::path imagePath, processo
     setLoadingImage(false);
     return;
   }
-  mOriginalImage->setImageToPaint(newLoadedImages->originalImage.mutableImage());
+  if(mCompositeMode) {
+    mCompositeImageToPaint = mCompositeImage.getImageToPaint();
+    mOriginalImage->setImageToPaint(&mCompositeImageToPaint);
+  } else {
+    mOriginalImage->setImageToPaint(newLoadedImages->originalImage.mutableImage());
+  }
   mThumbnail->setImageToPaint(newLoadedImages->thumbnail.mutableImage(), {imgInfo.at(0).imageWidth, imgInfo.at(0).imageHeight});
 
   if(!mShowEditedImage) {
@@ -552,6 +566,11 @@ void PanelImageView::setBrightnessRange(int32_t lowerValue, int32_t upperValue,
   }
   mImageToShow->setBrightnessRange(lowerValue, upperValue, displayAreaLower, displayAreaUpper);
   mPreviewImages->thumbnail.setBrightnessRange(lowerValue, upperValue, displayAreaLower, displayAreaUpper);
+  if(mCompositeMode) {
+    // Only the contribution of the actual channel is recalculated
+    mCompositeImage.setBrightnessRange(mPlane.cStack, lowerValue, upperValue);
+    mCompositeImageToPaint = mCompositeImage.getImageToPaint();
+  }
   scheduleUpdate();
 }
 
@@ -572,6 +591,27 @@ void PanelImageView::setPseudoColorEnabled(bool pseudoColor)
   scheduleUpdate();
 }
 
+///
+/// \brief      Show all channels of the actual plane blended together.
+///             The channel planes are kept resident, switching channels or
+///             changing the brightness of one channel does not reload the image.
+/// \author
+/// \param[in]
+/// \param[out]
+/// \return
+///
+void PanelImageView::setCompositeMode(bool enabled)
+{
+  {
+    std::lock_guard<std::mutex> locked(mImageResetMutex);
+    mCompositeMode = enabled;
+    if(!enabled) {
+      mCompositeImage.clear();
+    }
+  }
+  reloadImage();
+}
+
 ///
 /// \brief
 /// \author
@@ -27,6 +27,7 @@
 #include "backend/enums/enums_units.hpp"
 #include "backend/enums/types.hpp"
 #include "backend/helper/image/image.hpp"
+#include "backend/helper/image/image_composite.hpp"
 #include "backend/settings/project_settings/project_classification.hpp"
 #include "controller/controller.hpp"
 #include "ui/gui/dialogs/dialog_image_view/customer_painter/graphics_contour_overlay.hpp"
@@ -153,6 +154,7 @@ public:
   void autoAdjustBrightnessRange();
   void setBrightnessRange(int32_t lowerValue, int32_t upperValue, int32_t displayAreaLower, int32_t displayAreaUpper);
   void setPseudoColorEnabled(bool);
+  void setCompositeMode(bool);
 
   // REGION OF INTERESTS //////////////////////////////////////////////
   void setRegionsOfInterestFromObjectList();
@@ -224,6 +226,8 @@ private:
   processor::DisplayImages *mPreviewImages = nullptr;
   joda::image::Image *mImageToShow         = nullptr;
   joda::image::Image *mEditedImage         = nullptr;
+  joda::image::CompositeImage mCompositeImage;
+  QImage mCompositeImageToPaint;    // Copy of the composite owned by the GUI thread, the painter points to it
 
   float mOpaque = 0.6F;
   joda::enums::PlaneId mPlane{0, 0, 0};
@@ -293,6 +297,7 @@ private:
   bool mShowRuler                 = true;
   bool mHideManualAnnotations     = false;
   bool mWaitBannerVisible         = true;
+  bool mCompositeMode             = false;
 
   // ROI///////////////////////////////////////////////////
   bool mFillRoi    = false;
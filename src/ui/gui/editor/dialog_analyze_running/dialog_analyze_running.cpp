@@ -32,9 +32,11 @@ using namespace std::chrono_literals;
 /// \author     Joachim Danmayr
 ///
 DialogAnalyzeRunning::DialogAnalyzeRunning(WindowMain *windowMain, const joda::settings::AnalyzeSettings &settings,
-                                           const std::optional<std::filesystem::path> &fileToAnalyze) :
+                                           const std::optional<std::filesystem::path> &fileToAnalyze,
+                                           const std::optional<std::filesystem::path> &resumeDatabase,
+                                           const std::optional<joda::processor::LiveModeSettings> &liveMode) :
     QDialog(windowMain),
-    mWindowMain(windowMain), mSettings(settings), mFileToAnalyze(fileToAnalyze)
+    mWindowMain(windowMain), mSettings(settings), mFileToAnalyze(fileToAnalyze), mResumeDatabase(resumeDatabase), mLiveMode(liveMode)
 {
   //
   // Layout
@@ -75,7 +77,15 @@ DialogAnalyzeRunning::DialogAnalyzeRunning(WindowMain *windowMain, const joda::s
   CHECK_GUI_THREAD(closeAndOpenButton)
   closeAndOpenButton->setEnabled(false);
 
-  stopButton = new QPushButton("Stop", this);
+  // Live mode: The results stored so far can be shown while the job is running
+  showResultsButton = new QPushButton("Show results", this);
+  showResultsButton->setObjectName("ToolButton");
+  showResultsButton->setToolTip("Show the results stored so far, they are refreshed while the job is running");
+  CHECK_GUI_THREAD(showResultsButton)
+  showResultsButton->setEnabled(false);
+  showResultsButton->setVisible(mLiveMode.has_value());
+
+  stopButton = new QPushButton(mLiveMode.has_value() ? "Stop watching" : "Stop", this);
   stopButton->setObjectName("ToolButton");
   CHECK_GUI_THREAD(stopButton)
   stopButton->setEnabled(true);
@@ -87,11 +97,13 @@ DialogAnalyzeRunning::DialogAnalyzeRunning(WindowMain *windowMain, const joda::s
   connect(closeButton, &QPushButton::clicked, this, &DialogAnalyzeRunning::onCloseClicked);
   connect(closeAndOpenButton, &QPushButton::clicked, this, &DialogAnalyzeRunning::onCloseAndOpenClicked);
   connect(stopButton, &QPushButton::clicked, this, &DialogAnalyzeRunning::onStopClicked);
+  connect(showResultsButton, &QPushButton::clicked, this, &DialogAnalyzeRunning::onShowResultsClicked);
   connect(openResultsFolder, &QPushButton::clicked, this, &DialogAnalyzeRunning::onOpenResultsFolderClicked);
 
   buttonLayout->addWidget(openResultsFolder);
 
   buttonLayout->addStretch();
+  buttonLayout->addWidget(showResultsButton);
   buttonLayout->addWidget(stopButton);
   buttonLayout->addWidget(closeButton);
   buttonLayout->addWidget(closeAndOpenButton);
@@ -110,6 +122,13 @@ DialogAnalyzeRunning::DialogAnalyzeRunning(WindowMain *windowMain, const joda::s
 void DialogAnalyzeRunning::onStopClicked()
 {
   CHECK_GUI_THREAD(stopButton)
+  // Live mode: The images found so far are finished, a second click stops the job
+  if(mLiveMode.has_value() && !mWatchingStopped) {
+    mWatchingStopped = true;
+    mWindowMain->getController()->stopWatching();
+    stopButton->setText("Stop");
+    return;
+  }
   stopButton->setEnabled(false);
   mWindowMain->getController()->stop();
   mStopping = true;
@@ -133,6 +152,11 @@ void DialogAnalyzeRunning::onCloseAndOpenClicked()
   close();
 }
 
+void DialogAnalyzeRunning::onShowResultsClicked()
+{
+  mWindowMain->openLiveResults();
+}
+
 void DialogAnalyzeRunning::onOpenResultsFolderClicked()
 {
   QString folderPath = mWindowMain->getController()->getJobInformation()->resultsOutputFolder.string().data();
@@ -141,7 +165,7 @@ void DialogAnalyzeRunning::onOpenResultsFolderClicked()
 
 void DialogAnalyzeRunning::refreshThread()
 {
-  mWindowMain->getController()->start(mSettings, mWindowMain->getJobName().toStdString(), mFileToAnalyze);
+  mWindowMain->getController()->start(mSettings, mWindowMain->getJobName().toStdString(), mFileToAnalyze, mResumeDatabase, mLiveMode);
   mStartedTime = std::chrono::system_clock::now();
 
   // Wait unit new pipeline has been started. It could be that we are still waiting for finishing the prev thread.
@@ -171,7 +195,8 @@ void DialogAnalyzeRunning::onRefreshData()
   QString newTextImage            = "Processing Tile 0/0";
   QString newTextPipelineProgress = "Processing Tile 0/0";
 
-  auto actState = joda::processor::ProcessState::INITIALIZING;
+  auto actState         = joda::processor::ProcessState::INITIALIZING;
+  bool waitingForImages = false;
   try {
     const auto &state = mWindowMain->getController()->getState();
     if(state.getState() == joda::processor::ProcessState::RUNNING || state.getState() == joda::processor::ProcessState::RUNNING_PREPARING_PIPELINE) {
@@ -181,6 +206,7 @@ void DialogAnalyzeRunning::onRefreshData()
     newTextAllOver          = QString("Processing Image %1/%2").arg(state.finishedImages()).arg(state.totalImages());
     newTextImage            = QString("Processing Tile %1/%2").arg(state.finishedTiles()).arg(state.totalTiles());
     newTextPipelineProgress = QString("Processing pipelines %1").arg(state.finishedPipelineSteps());
+    waitingForImages        = state.isWatchingForImages() && state.finishedTiles() >= state.totalTiles();
 
   } catch(const std::exception &ex) {
     joda::log::logWarning("Pipeline error: " + std::string(ex.what()));
@@ -239,11 +265,15 @@ void DialogAnalyzeRunning::onRefreshData()
     progressText = "<html>" + newTextAllOver + "<br/>" + newTextImage + "<br/>Finished ...";
   } else if(actState == joda::processor::ProcessState::RUNNING_PREPARING_PIPELINE) {
     progressText = "<html>" + newTextAllOver + "<br/>" + newTextImage + "<br/>Preparing images ...";
+  } else if(waitingForImages) {
+    progressText = "<html>" + newTextAllOver + "<br/>" + newTextImage + "<br/>Waiting for new images ...";
   } else {
     progressText = "<html>" + newTextAllOver + "<br/>" + newTextImage + "<br/>" + newTextPipelineProgress;
   }
 
   mProgressText->setText(progressText);
+  CHECK_GUI_THREAD(showResultsButton)
+  showResultsButton->setEnabled(actState == joda::processor::ProcessState::RUNNING);
 
   // mLabelReporting->SetLabel(timeDiffStr);
 }
@@ -16,6 +16,7 @@
 #include <qprogressbar.h>
 #include <memory>
 #include <thread>
+#include "backend/processor/processor.hpp"
 #include "backend/settings/analze_settings.hpp"
 
 namespace joda::ui::gui {
@@ -29,7 +30,9 @@ class DialogAnalyzeRunning : public QDialog
 public:
   /////////////////////////////////////////////////////
   DialogAnalyzeRunning(WindowMain *windowMain, const joda::settings::AnalyzeSettings &settings,
-                       const std::optional<std::filesystem::path> &fileToAnalyze);
+                       const std::optional<std::filesystem::path> &fileToAnalyze,
+                       const std::optional<std::filesystem::path> &resumeDatabase = std::nullopt,
+                       const std::optional<joda::processor::LiveModeSettings> &liveMode = std::nullopt);
 
 signals:
   void refreshEvent();
@@ -41,7 +44,8 @@ private:
 
   std::shared_ptr<std::thread> mRefreshThread;
   bool mStopped  = false;
-  bool mStopping = false;
+  bool mStopping        = false;
+  bool mWatchingStopped = false;    // Live mode: First click on stop only ends watching the folder
   std::string mLastErrorMsg;
   std::chrono::system_clock::time_point mStartedTime;
   std::chrono::system_clock::time_point mEndedTime;
@@ -52,15 +56,19 @@ private:
   QProgressBar *progressBar;
   QPushButton *closeButton;
   QPushButton *closeAndOpenButton;
+  QPushButton *showResultsButton;
   QPushButton *stopButton;
   WindowMain *mWindowMain;
 
   const joda::settings::AnalyzeSettings mSettings;
   const std::optional<std::filesystem::path> mFileToAnalyze;
+  const std::optional<std::filesystem::path> mResumeDatabase;
+  const std::optional<joda::processor::LiveModeSettings> mLiveMode;
 
 private slots:
   void onStopClicked();
   void onCloseAndOpenClicked();
+  void onShowResultsClicked();
   void onCloseClicked();
   void onRefreshData();
   void onOpenResultsFolderClicked();
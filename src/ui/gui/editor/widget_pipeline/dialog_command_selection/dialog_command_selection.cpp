@@ -37,6 +37,7 @@
 #include "backend/commands/image_functions/watershed/watershed_settings.hpp"
 #include "backend/commands/image_functions/weighted_deviation/weighted_deviation_settings.hpp"
 #include "backend/commands/object_functions/measure_distance/measure_distance_settings.hpp"
+#include "backend/commands/object_functions/object_tracking/object_tracking_settings.hpp"
 #include "backend/commands/object_functions/object_transform/object_transform_settings.hpp"
 #include "backend/commands/object_functions/validator_threshold/validator_threshold_settings.hpp"
 #include "backend/commands/object_functions/voronoi_grid/voronoi_grid_settings.hpp"
@@ -197,6 +198,7 @@ void DialogCommandSelection::addCommandsToTable()
     addCommandToTable(settings::PipelineStep{.$classify = defaultClassify}, Group::OBJECT_CLASSIFICATION);
     addCommandToTable(settings::PipelineStep{.$aiClassify = settings::AiClassifierSettings{}}, Group::OBJECT_CLASSIFICATION);
     addCommandToTable(settings::PipelineStep{.$houghTransform = settings::HoughTransformSettings{}}, Group::OBJECT_CLASSIFICATION);
+    addCommandToTable(settings::PipelineStep{.$volumeSegmentation = settings::VolumeSegmentationSettings{}}, Group::OBJECT_CLASSIFICATION);
   }
 
   {
@@ -212,6 +214,7 @@ void DialogCommandSelection::addCommandsToTable()
     addCommandToTable(settings::PipelineStep{.$colocalization = settings::ColocalizationSettings{}}, Group::MEASUREMENT);
     addCommandToTable(settings::PipelineStep{.$measureIntensity = settings::MeasureIntensitySettings{}}, Group::MEASUREMENT);
     addCommandToTable(settings::PipelineStep{.$measureDistance = settings::MeasureDistanceSettings{}}, Group::MEASUREMENT);
+    addCommandToTable(settings::PipelineStep{.$objectTracking = settings::ObjectTrackingSettings{}}, Group::MEASUREMENT);
   }
 
   {
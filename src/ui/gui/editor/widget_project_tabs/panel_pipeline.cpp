@@ -25,6 +25,7 @@
 #include "backend/enums/enums_units.hpp"
 #include "backend/helper/logger/console_logger.hpp"
 #include "backend/helper/uuid.hpp"
+#include "backend/processor/cache/pipeline_cache.hpp"
 #include "backend/settings/pipeline/pipeline.hpp"
 #include "ui/gui/editor/widget_pipeline/dialog_command_selection/dialog_command_selection.hpp"
 #include "ui/gui/editor/widget_pipeline/dialog_pipeline_settings/dialog_pipeline_settings.hpp"
@@ -208,6 +209,7 @@ PanelPipeline::PanelPipeline(joda::processor::Preview *previewResults, WindowMai
     mStackHandlingZ = new QComboBox();
     mStackHandlingZ->addItem("Each one", static_cast<int32_t>(joda::settings::ProjectImageSetup::ZStackHandling::EACH_ONE));
     mStackHandlingZ->addItem("Defined by pipeline", static_cast<int32_t>(joda::settings::ProjectImageSetup::ZStackHandling::EXACT_ONE));
+    mStackHandlingZ->addItem("Volume (3D)", static_cast<int32_t>(joda::settings::ProjectImageSetup::ZStackHandling::VOLUME));
     formLayout->addRow(new QLabel(tr("Z-Stack")), mStackHandlingZ);
 
     //
@@ -236,6 +238,32 @@ PanelPipeline::PanelPipeline(joda::processor::Preview *previewResults, WindowMai
     mMeasureUnit->addItem("km", static_cast<int32_t>(enums::Units::km));
     formLayout->addRow(new QLabel(tr("Measure unit")), mMeasureUnit);
 
+    addSeparator();
+    mCacheIntermediateResults = new QCheckBox(tr("Cache intermediate results"));
+    mCacheIntermediateResults->setStatusTip(
+        "Stores intermediate pipeline results in the project folder. A re-run only executes the changed pipeline steps.");
+    auto *clearCache = new QPushButton(tr("Clear cache"));
+    clearCache->setStatusTip("Removes all intermediate pipeline results stored in the project folder.");
+    connect(clearCache, &QPushButton::clicked, [this]() {
+      QMessageBox messageBox(mStackOptionsDialog);
+      messageBox.setIconPixmap(generateSvgIcon<Style::REGULAR, Color::YELLOW>("warning").pixmap(48, 48));
+      messageBox.setWindowTitle("Clear cache?");
+      messageBox.setText("Remove all cached intermediate results? The next run executes all pipeline steps again.");
+      QPushButton *noButton = messageBox.addButton(tr("No"), QMessageBox::NoRole);
+      messageBox.addButton(tr("Yes"), QMessageBox::YesRole);
+      messageBox.setDefaultButton(noButton);
+      messageBox.exec();
+      if(messageBox.clickedButton() == noButton) {
+        return;
+      }
+      joda::processor::PipelineCache::clear(
+          joda::processor::PipelineCache::getCacheFolder(std::filesystem::path(mAnalyzeSettings->projectSettings.plate.imageFolder)));
+    });
+    auto *cacheLayout = new QHBoxLayout;
+    cacheLayout->addWidget(mCacheIntermediateResults);
+    cacheLayout->addWidget(clearCache);
+    formLayout->addRow(new QLabel(tr("Re-analysis")), cacheLayout);
+
     // Okay and canlce
     auto *buttonBox = new IconlessDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, Qt::Horizontal, mStackOptionsDialog);
     connect(buttonBox, &QDialogButtonBox::accepted, mStackOptionsDialog, &QDialog::accept);
@@ -708,7 +736,8 @@ void PanelPipeline::toSettings()
   mAnalyzeSettings->imageSetup.tStackSettings.startFrame = mTStackFrameStart->text().toInt();
   mAnalyzeSettings->imageSetup.tStackSettings.endFrame   = mTStackFrameEnd->text().toInt();
 
-  mAnalyzeSettings->pipelineSetup.realSizesUnit = static_cast<enums::Units>(mMeasureUnit->currentData().toInt());
+  mAnalyzeSettings->pipelineSetup.realSizesUnit            = static_cast<enums::Units>(mMeasureUnit->currentData().toInt());
+  mAnalyzeSettings->pipelineSetup.cacheIntermediateResults = mCacheIntermediateResults->isChecked();
 }
 
 ///
@@ -749,6 +778,7 @@ void PanelPipeline::fromSettings(const joda::settings::AnalyzeSettings &settings
       mMeasureUnit->setCurrentIndex(0);
     }
   }
+  mCacheIntermediateResults->setChecked(settings.pipelineSetup.cacheIntermediateResults);
 }
 
 ///
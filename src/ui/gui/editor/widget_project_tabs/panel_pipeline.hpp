@@ -89,6 +89,7 @@ private:
   QComboBox *mStackHandlingZ;
   QComboBox *mStackHandlingT;
   QComboBox *mMeasureUnit;
+  QCheckBox *mCacheIntermediateResults;
   QLineEdit *mTStackFrameStart;
   QLineEdit *mTStackFrameEnd;
 
@@ -40,6 +40,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include "backend/database/database.hpp"
 #include "backend/enums/enums_file_endians.hpp"
 #include "backend/helper/ai_model_parser/ai_model_parser.hpp"
 #include "backend/helper/duration_count/duration_count.h"
@@ -307,6 +308,12 @@ void WindowMain::createTopToolbar()
   connect(analyzeAllButton, &QAction::triggered, [this] { onStartClicked(AnalyzeMode::AllImages); });
   auto *analyzeSingleButton = analysisMenu->addAction(generateSvgIcon<Style::REGULAR, Color::BLACK>("play-circle"), "Analyze selected image");
   connect(analyzeSingleButton, &QAction::triggered, [this] { onStartClicked(AnalyzeMode::SingleImage); });
+  auto *analyzeLiveButton = analysisMenu->addAction(generateSvgIcon<Style::REGULAR, Color::BLACK>("eye"), "Analyze and watch for new images");
+  analyzeLiveButton->setStatusTip("Images added to the image folder while the job is running are analyzed too");
+  connect(analyzeLiveButton, &QAction::triggered, [this] { onStartClicked(AnalyzeMode::LiveJob); });
+  analysisMenu->addSeparator();
+  auto *resumeJobButton = analysisMenu->addAction(generateSvgIcon<Style::REGULAR, Color::BLACK>("arrow-clockwise"), "Resume interrupted job");
+  connect(resumeJobButton, &QAction::triggered, [this] { onStartClicked(AnalyzeMode::ResumeJob); });
 
   mStartAnalysisToolButton = new QAction(generateSvgIcon<Style::REGULAR, Color::BLACK>("person-simple-run"), "Start analyze", mTopToolBar);
   mStartAnalysisToolButton->setMenu(analysisMenu);
@@ -581,14 +588,17 @@ void WindowMain::openImage(const std::filesystem::path &imagePath, const ome::Om
 ///
 /// \brief      Open results settings
 /// \author     Joachim Danmayr
+/// \param[in]  filePath    Results database file
+/// \param[in]  runningJob  Database of the running job if its results should be shown live
 ///
-void WindowMain::openResultsSettings(const QString &filePath)
+void WindowMain::openResultsSettings(const QString &filePath, const joda::db::Database *runningJob)
 {
   onBackClicked();
 
   try {
-    mPanelReporting->openFromFile(filePath);
+    mPanelReporting->openFromFile(filePath, runningJob);
     mPanelReporting->show();
+    mPanelReporting->raise();
   } catch(const std::exception &ex) {
     joda::log::logError(ex.what());
     QMessageBox messageBox(this);
@@ -600,6 +610,21 @@ void WindowMain::openResultsSettings(const QString &filePath)
   }
 }
 
+///
+/// \brief      Shows the results the running job stored so far. The database of the
+///             job is shared, the view is refreshed until the job finished.
+/// \author     Joachim Danmayr
+///
+void WindowMain::openLiveResults()
+{
+  const auto &jobInfo  = getController()->getJobInformation();
+  const auto *database = dynamic_cast<const joda::db::Database *>(jobInfo->database.get());
+  if(database == nullptr) {
+    return;
+  }
+  openResultsSettings(jobInfo->resultsDatabaseFilePath.string().data(), database);
+}
+
 ///
 /// \brief      Open project settings
 /// \author     Joachim Danmayr
@@ -868,6 +893,13 @@ void WindowMain::loadLastOpened()
 ///
 void WindowMain::onStartClicked(AnalyzeMode mode)
 {
+  // A live job is still running
+  if(mLiveJobDialog != nullptr) {
+    mLiveJobDialog->raise();
+    mLiveJobDialog->activateWindow();
+    return;
+  }
+
   // If there are errors, starting the pipeline is not allowed
   if(mCompilerLog->getNumberOfErrors() > 0) {
     mCompilerLog->showDialog();
@@ -886,14 +918,32 @@ void WindowMain::onStartClicked(AnalyzeMode mode)
     if(AnalyzeMode::SingleImage == mode) {
       const auto [imagePath, series, omeInfo] = getImagePanel()->getSelectedImageOrFirst();
       analyzeRunningDialog                    = new DialogAnalyzeRunning(this, mAnalyzeSettings, imagePath);
+    } else if(AnalyzeMode::ResumeJob == mode) {
+      QString folderToOpen = QDir::homePath();
+      if(!mAnalyzeSettings.projectSettings.plate.imageFolder.empty()) {
+        folderToOpen = mAnalyzeSettings.projectSettings.plate.imageFolder.data();
+      }
+      QFileDialog::Options opt = QFileDialog::DontUseNativeDialog;
+      QString filePath         = QFileDialog::getOpenFileName(this, "Resume interrupted job", folderToOpen,
+                                                              "ImageC results files (*" + QString(joda::fs::EXT_DATABASE.data()) + ")", nullptr, opt);
+      if(filePath.isEmpty()) {
+        return;
+      }
+      analyzeRunningDialog = new DialogAnalyzeRunning(this, mAnalyzeSettings, std::nullopt, std::filesystem::path(filePath.toStdString()));
+    } else if(AnalyzeMode::LiveJob == mode) {
+      // Not modal, the results can be looked at while the job is running
+      mLiveJobDialog = new DialogAnalyzeRunning(this, mAnalyzeSettings, std::nullopt, std::nullopt, joda::processor::LiveModeSettings{});
+      connect(mLiveJobDialog, &QDialog::finished, this, [this]() {
+        mLiveJobDialog = nullptr;
+        onAnalyzeFinished();
+      });
+      mLiveJobDialog->show();
+      return;
     } else {
       analyzeRunningDialog = new DialogAnalyzeRunning(this, mAnalyzeSettings, std::nullopt);
     }
     analyzeRunningDialog->exec();
-    const auto &jobIinfo = getController()->getJobInformation();
-    addToLastLoadedResults(jobIinfo->resultsDatabaseFilePath.string().data(), jobIinfo->jobName.data());
-    // Analysis finished -> generate new name
-    mPanelProjectSettings->generateNewJobName();
+    onAnalyzeFinished();
   } catch(const std::exception &ex) {
     QMessageBox messageBox(this);
     messageBox.setIconPixmap(generateSvgIcon<Style::REGULAR, Color::RED>("warning-diamond").pixmap(48, 48));
@@ -904,6 +954,18 @@ void WindowMain::onStartClicked(AnalyzeMode mode)
   }
 }
 
+///
+/// \brief      Remembers the results of the finished job
+/// \author     Joachim Danmayr
+///
+void WindowMain::onAnalyzeFinished()
+{
+  const auto &jobIinfo = getController()->getJobInformation();
+  addToLastLoadedResults(jobIinfo->resultsDatabaseFilePath.string().data(), jobIinfo->jobName.data());
+  // Analysis finished -> generate new name
+  mPanelProjectSettings->generateNewJobName();
+}
+
 ///
 /// \brief
 /// \author     Joachim Danmayr
@@ -30,6 +30,10 @@
 #include <duckdb/function/table_function.hpp>
 #include <nlohmann/json_fwd.hpp>
 
+namespace joda::db {
+class Database;
+}
+
 namespace joda::updater {
 class Updater;
 }
@@ -46,6 +50,7 @@ class PanelImages;
 class PanelProjectSettings;
 class PanelCompilerLog;
 class DialogImageViewer;
+class DialogAnalyzeRunning;
 
 ///
 /// \class
@@ -61,7 +66,8 @@ public:
   ~WindowMain();
   bool showPanelStartPage();
   void openProjectSettings(const QString &filePath, bool openFromTemplate);
-  void openResultsSettings(const QString &filePath);
+  void openResultsSettings(const QString &filePath, const joda::db::Database *runningJob = nullptr);
+  void openLiveResults();
   void openImage(const std::filesystem::path &imagePath, const ome::OmeInfo *omeInfo);
 
   joda::ctrl::Controller *getController()
@@ -143,7 +149,9 @@ private:
   enum class AnalyzeMode
   {
     AllImages,
-    SingleImage
+    SingleImage,
+    ResumeJob,
+    LiveJob
   };
 
   /////////////////////////////////////////////////////
@@ -158,6 +166,7 @@ private:
   void resizeEvent(QResizeEvent *event) override;
   void updateProjectPath();
   void onStartClicked(AnalyzeMode mode);
+  void onAnalyzeFinished();
 
   QWidget *createChannelWidget();
   QWidget *createReportingWidget();
@@ -199,6 +208,7 @@ private:
 
   // RESULTS PANEL ////////////////////
   WindowResults *mPanelReporting;
+  DialogAnalyzeRunning *mLiveJobDialog = nullptr;    // Progress of a running live job, not modal
 
   ////Mutexes/////////////////////////////////////////////////
   std::mutex mCheckForSettingsChangedMutex;
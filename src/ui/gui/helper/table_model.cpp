@@ -92,8 +92,8 @@ QVariant TableModel::data(const QModelIndex &index, int role) const
   if(!mTable) {
     return {};
   }
-  const auto &cell = mTable->data(static_cast<uint32_t>(index.row()), static_cast<uint32_t>(index.column()));
-  if(cell == nullptr) {
+  const auto cell = mTable->data(static_cast<uint32_t>(index.row()), static_cast<uint32_t>(index.column()));
+  if(!cell.has_value()) {
     return {};
   }
 
@@ -115,7 +115,7 @@ QVariant TableModel::data(const QModelIndex &index, int role) const
     return {};
   }
 
-  auto generateMetaFooter = [](const std::shared_ptr<const joda::table::TableCell> & /*rowData*/) -> QString {
+  auto generateMetaFooter = [](const std::optional<joda::table::TableCell> & /*rowData*/) -> QString {
     return "";
     /*return "<br><span style=\"color:rgb(155, 153, 153);\"><i>🗝: " + QString(joda::helper::toBase32(rowData.getObjectId()).data()) + " ⬆ " +
            QString(joda::helper::toBase32(rowData.getParentId()).data()) + "<br> ↔ " +
@@ -155,7 +155,7 @@ void TableModel::setData(const std::shared_ptr<joda::table::Table> table, const
 /// \param[out]
 /// \return
 ///
-auto TableModel::getCell(int row, int col) -> const std::shared_ptr<const joda::table::TableCell>
+auto TableModel::getCell(int row, int col) -> std::optional<joda::table::TableCell>
 {
   return mTable->data(static_cast<uint32_t>(row), static_cast<uint32_t>(col));
 }
@@ -27,7 +27,7 @@ class TableModel : public QAbstractTableModel
 public:
   TableModel(QObject *parent = nullptr);
   void setData(const std::shared_ptr<joda::table::Table> table, const std::string &unit);
-  auto getCell(int row, int col) -> const std::shared_ptr<const joda::table::TableCell>;
+  auto getCell(int row, int col) -> std::optional<joda::table::TableCell>;
   [[nodiscard]] int rowCount(const QModelIndex &parent) const override;
   [[nodiscard]] int columnCount(const QModelIndex &parent) const override;
   [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
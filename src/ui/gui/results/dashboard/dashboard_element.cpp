@@ -48,15 +48,17 @@ DashboardElement::DashboardElement() /*: QMdiSubWindow(widget)*/
     mTableView->setModel(mTableModel);
 
     connect(mTableView, &QTableView::doubleClicked, [this](const QModelIndex &index) {
-      int row = index.row();
-      int col = index.column();
-      emit cellDoubleClicked(*mTable->data(row, col));
+      auto cell = mTable->data(index.row(), index.column());
+      if(cell.has_value()) {
+        emit cellDoubleClicked(*cell);
+      }
     });
 
     connect(mTableView->selectionModel(), &QItemSelectionModel::currentChanged, [this](const QModelIndex &index, const QModelIndex & /*previous*/) {
-      int row = index.row();
-      int col = index.column();
-      emit cellSelected(*mTable->data(row, col));
+      auto cell = mTable->data(index.row(), index.column());
+      if(cell.has_value()) {
+        emit cellSelected(*cell);
+      }
     });
     layout->addWidget(mTableView);
   }
@@ -172,7 +174,10 @@ auto DashboardElement::getSelectedRows() const -> std::vector<joda::table::Table
   }
   QModelIndexList selectedIndex = selectionModel->selectedIndexes();    // one QModelIndex per selected row
   foreach(const QModelIndex &index, selectedIndex) {
-    selectedCells.emplace_back(*mTable->data(index.row(), index.column()));
+    auto cell = mTable->data(index.row(), index.column());
+    if(cell.has_value()) {
+      selectedCells.emplace_back(*cell);
+    }
   }
 
   return selectedCells;
@@ -199,7 +204,7 @@ void DashboardElement::copyTableToClipboard() const
         rowData << mTable->getRowHeader(row).data();
       }
       const auto tmp = mTable->data(row, col);
-      if(tmp != nullptr) {
+      if(tmp.has_value()) {
         auto val = tmp->getValAsVariant(mTable->getColHeader(col).measureChannel);
         QString txtTemp;
         if(std::holds_alternative<std::string>(val)) {
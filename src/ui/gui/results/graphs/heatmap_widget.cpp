@@ -80,7 +80,7 @@ void HeatmapWidget::copyToClipboard() const
         rowData << table.getRowHeader(row).data();
       }
       const auto tmp = table.data(row, col);
-      if(tmp != nullptr) {
+      if(tmp.has_value()) {
         auto val = tmp->getValAsVariant(table.getColHeader(col).measureChannel);
         QString txtTemp;
         if(tmp->isNAN()) {
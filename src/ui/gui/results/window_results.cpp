@@ -127,6 +127,9 @@ WindowResults::WindowResults(WindowMain *windowMain) : mWindowMain(windowMain),
     });
     // connect(layout().getBackButton(), &QAction::triggered, [this] { mWindowMain->showPanelStartPage(); });
     connect(this, &WindowResults::finishedLoading, this, &WindowResults::onFinishedLoading);
+    mLiveRefreshTimer = new QTimer(this);
+    mLiveRefreshTimer->setInterval(LIVE_REFRESH_INTERVAL_MS);
+    connect(mLiveRefreshTimer, &QTimer::timeout, this, &WindowResults::onLiveRefresh);
     connect(mDockWidgetGraphSettings, &PanelGraphSettings::settingsChanged, [this]() { onColumnComboChanged(); });
   }
 
@@ -351,6 +354,8 @@ void WindowResults::setWindowTitlePrefix(const QString &txt)
 ///
 void WindowResults::resetSettings()
 {
+  mLiveRefreshTimer->stop();
+  mIsLive = false;
   std::lock_guard<std::mutex> lock(mLoadLock);
   mSelectedDataSet.analyzeMeta.reset();
   mSelectedDataSet.imageMeta.reset();
@@ -579,6 +584,10 @@ void WindowResults::loadLastOpened()
 ///
 void WindowResults::storeResultsTableSettingsToDatabase()
 {
+  // The running job writes the job entry too, the settings are stored once it finished
+  if(mIsLive) {
+    return;
+  }
   try {
     if(mAnalyzer != nullptr && mSelectedDataSet.analyzeMeta.has_value() && !mSelectedDataSet.analyzeMeta->jobId.empty()) {
       mAnalyzer->updateResultsTableSettings(mSelectedDataSet.analyzeMeta->jobId, nlohmann::json(mFilter).dump());
@@ -1119,17 +1128,25 @@ void WindowResults::goHome()
 }
 
 ///
-/// \brief
+/// \brief      Opens a results database
 /// \author     Joachim Danmayr
+/// \param[in]  pathToDbFile  Results database file
+/// \param[in]  runningJob    Database of a running job, its results are shown live.
+///                           The file is in use by the job, so the already opened
+///                           instance is shared instead of opening the file.
 ///
-void WindowResults::openFromFile(const QString &pathToDbFile)
+void WindowResults::openFromFile(const QString &pathToDbFile, const joda::db::Database *runningJob)
 {
   if(pathToDbFile.isEmpty()) {
     return;
   }
   resetSettings();
   mAnalyzer = std::make_unique<joda::db::Database>();
-  mAnalyzer->openDatabase(std::filesystem::path(pathToDbFile.toStdString()));
+  if(runningJob != nullptr) {
+    mAnalyzer->shareDatabase(*runningJob);
+  } else {
+    mAnalyzer->openDatabase(std::filesystem::path(pathToDbFile.toStdString()));
+  }
   mDbFilePath = std::filesystem::path(pathToDbFile.toStdString());
 
   // Database results file is stored in <IMAGE-PATH>/imagec/results/<JOB-NAME>/results.icdb
@@ -1177,6 +1194,25 @@ void WindowResults::openFromFile(const QString &pathToDbFile)
   mDockWidgetClassList->setDatabase(mAnalyzer.get());
   setWindowTitlePrefix(QString(mDbFilePath.filename().string().data()) + " (" + QString(mSelectedDataSet.analyzeMeta->jobName.data()) + ")");
 
+  mIsLive = runningJob != nullptr;
+  if(mIsLive) {
+    mLiveRefreshTimer->start();
+  }
+  refreshView();
+}
+
+///
+/// \brief      Reloads the actual view with the results the running job stored so far.
+///             After the job finished, the view is refreshed a last time.
+/// \author     Joachim Danmayr
+///
+void WindowResults::onLiveRefresh()
+{
+  const auto state = mWindowMain->getController()->getState().getState();
+  if(state == joda::processor::ProcessState::FINISHED || state == joda::processor::ProcessState::FINISHED_WITH_ERROR) {
+    mLiveRefreshTimer->stop();
+    mIsLive = false;
+  }
   refreshView();
 }
 
@@ -17,8 +17,10 @@
 #include <qcombobox.h>
 #include <qmainwindow.h>
 #include <qpushbutton.h>
+#include <qtimer.h>
 #include <qtoolbar.h>
 #include <qwidget.h>
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
@@ -67,7 +69,7 @@ public:
   /////////////////////////////////////////////////////
   WindowResults(WindowMain *win);
   ~WindowResults();
-  void openFromFile(const QString &pathToDbFile);
+  void openFromFile(const QString &pathToDbFile, const joda::db::Database *runningJob = nullptr);
   [[nodiscard]] Navigation getActualNavigation() const
   {
     return mNavigation;
@@ -232,6 +234,11 @@ private:
 
   bool mIsLoading = false;
 
+  /// LIVE MODE ///////////////////////////////////////////
+  static constexpr int32_t LIVE_REFRESH_INTERVAL_MS = 5000;
+  QTimer *mLiveRefreshTimer;
+  std::atomic<bool> mIsLive = false;    // Results of a running job are shown, they are refreshed periodically
+
 public slots:
   void onFinishedExport();
   void onFinishedLoading();
@@ -239,6 +246,7 @@ public slots:
   void onShowTable();
   void onShowHeatmap();
   void onColumnComboChanged();
+  void onLiveRefresh();
 };
 
 }    // namespace joda::ui::gui
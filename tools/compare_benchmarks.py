@@ -0,0 +1,43 @@
+import sys
+import xml.etree.ElementTree as ET
+
+
+def read_results(path):
+    """Returns {"<test case>/<benchmark>": mean in ns} of a Catch2 XML report."""
+    results = {}
+    for test_case in ET.parse(path).getroot().iter("TestCase"):
+        for benchmark in test_case.iter("BenchmarkResults"):
+            mean = benchmark.find("mean")
+            results[f"{test_case.get('name')}/{benchmark.get('name')}"] = float(mean.get("value"))
+    return results
+
+
+def compare(baseline_path, current_path, threshold):
+    baseline = read_results(baseline_path)
+    current = read_results(current_path)
+    regressions = 0
+
+    print(f"{'benchmark':<90} {'baseline ms':>12} {'current ms':>12} {'change':>8}")
+    for name in sorted(current):
+        if name not in baseline:
+            print(f"{name:<90} {'-':>12} {current[name] / 1e6:>12.3f} {'new':>8}")
+            continue
+        change = current[name] / baseline[name] - 1.0
+        marker = ""
+        if change > threshold:
+            marker = "  <-- regression"
+            regressions += 1
+        print(f"{name:<90} {baseline[name] / 1e6:>12.3f} {current[name] / 1e6:>12.3f} {change:>+8.1%}{marker}")
+
+    return regressions
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("Usage: compare_benchmarks.py <baseline.xml> <current.xml> [threshold, default 0.1]")
+        sys.exit(2)
+
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 0.1
+    regressions = compare(sys.argv[1], sys.argv[2], threshold)
+    print(f"{regressions} regression(s) slower than {threshold:.0%}")
+    sys.exit(1 if regressions > 0 else 0)